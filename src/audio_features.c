@@ -0,0 +1,466 @@
+#define _DEFAULT_SOURCE
+#include "audio_features.h"
+#include "audio_file.h"
+#include "audio_pipewire.h"
+#include "thread_pool.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define HOPS_PER_TASK 256           // Hops analysed per thread pool task
+#define HOP_RATE ((double)AUDIO_SAMPLE_RATE / FEATURE_TRACK_HOP)
+
+// Tempo search
+#define MIN_BPM 70.0
+#define MAX_BPM 180.0
+#define BPM_STEP 0.05
+#define BPM_PRIOR_CENTER 120.0      // Resolves half/double tempo ties
+#define BEAT_SNAP_WINDOW 0.1        // Fraction of a beat searched for an onset around each grid beat
+#define BEAT_SNAP_GAIN 0.25         // How far a grid beat moves towards that onset
+
+// Onset picking
+#define ONSET_WINDOW 15             // Hops either side for the adaptive threshold (~0.25 s)
+#define ONSET_THRESHOLD 1.5f
+#define BASS_FLUX_WEIGHT 8.0f
+
+// Sections, in bar-average bass energy relative to the track mean
+#define BREAKDOWN_LEVEL 0.5f
+#define DROP_LEVEL 0.8f
+#define MIN_BREAKDOWN_BARS 2
+#define SECTION_CHANGE 0.25f        // Bar-to-bar change that counts as a phrase boundary
+
+// Average bass energy of each bar when bars start on beats offset, offset + 4, ...
+static int measure_bars(const double* beat_hops, int beat_count, int offset, const float* levels,
+                        int hop_count, int* bar_starts, float* bar_energy) {
+    int bar_count = 0;
+    for (int i = offset; i < beat_count; i += 4) {
+        bar_starts[bar_count++] = (int)(beat_hops[i] + 0.5);
+    }
+    
+    for (int b = 0; b < bar_count; b++) {
+        int end = b + 1 < bar_count ? bar_starts[b + 1] : hop_count;
+        float sum = 0.0f;
+        for (int h = bar_starts[b]; h < end; h++) sum += levels[h * 4];
+        bar_energy[b] = end > bar_starts[b] ? sum / (end - bar_starts[b]) : 0.0f;
+    }
+    return bar_count;
+}
+
+static uint8_t quantize(float v) {
+    if (v <= 0.0f) return 0;
+    if (v >= 1.0f) return 255;
+    return (uint8_t)(v * 255.0f + 0.5f);
+}
+
+// ============= PARALLEL PASSES =============
+
+typedef struct {
+    const WavFile* wav;
+    int hop_count;
+    float* spectra;             // hop_count * FEATURE_TRACK_BINS
+    float* levels;              // hop_count * 4: bass, mid, treble, volume
+} HopJob;
+
+static void analyze_hops(void* ctx, int index) {
+    HopJob* job = ctx;
+    float buffer[FEATURE_TRACK_HOP * AUDIO_CHANNELS];
+    
+    int first = index * HOPS_PER_TASK;
+    int last = first + HOPS_PER_TASK < job->hop_count ? first + HOPS_PER_TASK : job->hop_count;
+    
+    for (int hop = first; hop < last; hop++) {
+        int n = wav_file_read_resampled(job->wav, (uint64_t)hop * FEATURE_TRACK_HOP, buffer, FEATURE_TRACK_HOP);
+        if (n < FEATURE_TRACK_HOP) {
+            memset(buffer + n * AUDIO_CHANNELS, 0, (FEATURE_TRACK_HOP - n) * AUDIO_CHANNELS * sizeof(float));
+        }
+        
+        // Same analysis as the live capture thread, so both paths look alike
+        float* spectrum = job->spectra + (size_t)hop * FEATURE_TRACK_BINS;
+        float* level = job->levels + (size_t)hop * 4;
+        audio_compute_spectrum(buffer, FEATURE_TRACK_HOP, spectrum, FEATURE_TRACK_BINS);
+        audio_compute_levels(spectrum, FEATURE_TRACK_BINS, &level[0], &level[1], &level[2], &level[3]);
+    }
+}
+
+typedef struct {
+    const float* flux;
+    int hop_count;
+    float* scores;              // Per candidate tempo
+    float* phases;
+} TempoJob;
+
+static void score_tempo(void* ctx, int index) {
+    TempoJob* job = ctx;
+    double bpm = MIN_BPM + index * BPM_STEP;
+    double period = HOP_RATE * 60.0 / bpm;
+    
+    // Best mean onset strength on a comb of this period over all phases
+    float best = 0.0f, best_phase = 0.0f;
+    for (int phase = 0; phase < (int)period; phase++) {
+        float sum = 0.0f;
+        int count = 0;
+        for (double t = phase; t < job->hop_count - 0.5; t += period) {
+            sum += job->flux[(int)(t + 0.5)];
+            count++;
+        }
+        if (count > 0 && sum / count > best) {
+            best = sum / count;
+            best_phase = (float)phase;
+        }
+    }
+    
+    double octaves = log2(bpm / BPM_PRIOR_CENTER);
+    job->scores[index] = best * (float)exp(-0.5 * octaves * octaves);
+    job->phases[index] = best_phase;
+}
+
+// ============= ANALYSIS =============
+
+bool feature_track_analyze(const char* wav_path, const char* out_path, int threads) {
+    WavFile wav;
+    if (!wav_file_open(&wav, wav_path)) {
+        return false;
+    }
+    
+    struct timespec started;
+    clock_gettime(CLOCK_MONOTONIC, &started);
+    
+    int hop_count = (int)(wav_file_output_frames(&wav) / FEATURE_TRACK_HOP);
+    if (hop_count < 2) {
+        fprintf(stderr, "CLIFT: %s is too short to analyse\n", wav_path);
+        wav_file_close(&wav);
+        return false;
+    }
+    
+    float* spectra = malloc((size_t)hop_count * FEATURE_TRACK_BINS * sizeof(float));
+    float* levels = malloc((size_t)hop_count * 4 * sizeof(float));
+    float* flux = calloc(hop_count, sizeof(float));
+    FeatureHop* hops = calloc(hop_count, sizeof(FeatureHop));
+    double* beat_hops = malloc(hop_count * sizeof(double));
+    FeatureBeat* beats = calloc(hop_count, sizeof(FeatureBeat));
+    FeatureMarker* markers = calloc(hop_count, sizeof(FeatureMarker));
+    int* bar_starts = malloc((hop_count / 4 + 1) * sizeof(int));
+    float* bar_energy = malloc((hop_count / 4 + 1) * sizeof(float));
+    int tempo_count = (int)((MAX_BPM - MIN_BPM) / BPM_STEP) + 1;
+    float* tempo_scores = malloc(tempo_count * sizeof(float));
+    float* tempo_phases = malloc(tempo_count * sizeof(float));
+    ThreadPool* pool = thread_pool_create(threads);
+    
+    bool success = false;
+    if (!spectra || !levels || !flux || !hops || !beat_hops || !beats || !markers ||
+        !bar_starts || !bar_energy || !tempo_scores || !tempo_phases) {
+        fprintf(stderr, "CLIFT: Out of memory analysing %s\n", wav_path);
+        goto cleanup;
+    }
+    
+    // Spectrum and band levels per hop
+    HopJob hop_job = { &wav, hop_count, spectra, levels };
+    thread_pool_run(pool, (hop_count + HOPS_PER_TASK - 1) / HOPS_PER_TASK, analyze_hops, &hop_job);
+    
+    // Onset strength: positive spectral flux between neighbouring hops, with
+    // the bass band weighted up so kicks outvote hi-hats on the beat grid
+    float flux_max = 0.0f, flux_mean = 0.0f;
+    for (int h = 1; h < hop_count; h++) {
+        const float* cur = spectra + (size_t)h * FEATURE_TRACK_BINS;
+        const float* prev = cur - FEATURE_TRACK_BINS;
+        float sum = 0.0f;
+        for (int b = 0; b < FEATURE_TRACK_BINS; b++) {
+            float diff = cur[b] - prev[b];
+            if (diff > 0.0f) sum += b < FEATURE_TRACK_BINS / 8 ? diff * BASS_FLUX_WEIGHT : diff;
+        }
+        flux[h] = sum;
+        flux_mean += sum;
+        if (sum > flux_max) flux_max = sum;
+    }
+    flux_mean /= hop_count;
+    
+    for (int h = 0; h < hop_count; h++) {
+        FeatureHop* hop = &hops[h];
+        const float* spectrum = spectra + (size_t)h * FEATURE_TRACK_BINS;
+        for (int b = 0; b < FEATURE_TRACK_BINS; b++) {
+            hop->spectrum[b] = quantize(spectrum[b]);
+        }
+        hop->bass = quantize(levels[h * 4]);
+        hop->mid = quantize(levels[h * 4 + 1]);
+        hop->treble = quantize(levels[h * 4 + 2]);
+        hop->volume = quantize(levels[h * 4 + 3]);
+        hop->onset = flux_max > 0.0f ? quantize(flux[h] / flux_max) : 0;
+        
+        // Local peak clearly above its neighbourhood
+        if (h > 0 && h + 1 < hop_count && flux[h] >= flux[h - 1] && flux[h] > flux[h + 1] &&
+            flux[h] > 0.1f * flux_max) {
+            int lo = h - ONSET_WINDOW < 0 ? 0 : h - ONSET_WINDOW;
+            int hi = h + ONSET_WINDOW >= hop_count ? hop_count - 1 : h + ONSET_WINDOW;
+            float local = 0.0f;
+            for (int i = lo; i <= hi; i++) local += flux[i];
+            local /= (hi - lo + 1);
+            if (flux[h] > local * ONSET_THRESHOLD) {
+                hop->flags |= FEATURE_ONSET;
+            }
+        }
+    }
+    
+    // Tempo and grid phase: best-scoring comb over the onset envelope
+    TempoJob tempo_job = { flux, hop_count, tempo_scores, tempo_phases };
+    thread_pool_run(pool, tempo_count, score_tempo, &tempo_job);
+    
+    int best_tempo = 0;
+    for (int i = 1; i < tempo_count; i++) {
+        if (tempo_scores[i] > tempo_scores[best_tempo]) best_tempo = i;
+    }
+    double bpm = MIN_BPM + best_tempo * BPM_STEP;
+    double period = HOP_RATE * 60.0 / bpm;
+    
+    // Walk the grid, pulling each beat part of the way towards a nearby strong
+    // onset: follows slow tempo drift without picking up hop-sized jitter
+    int beat_count = 0;
+    if (flux_max > 0.0f) {
+        int window = (int)(period * BEAT_SNAP_WINDOW + 0.5);
+        if (window < 1) window = 1;
+        
+        double t = tempo_phases[best_tempo];
+        while (t < hop_count - 0.5 && beat_count < hop_count) {
+            int center = (int)(t + 0.5);
+            int peak = center;
+            for (int i = center - window; i <= center + window; i++) {
+                if (i >= 0 && i < hop_count && flux[i] > flux[peak]) peak = i;
+            }
+            
+            double beat = flux[peak] > flux_mean ? t + (peak - t) * BEAT_SNAP_GAIN : t;
+            beat_hops[beat_count++] = beat;
+            t = beat + period;
+        }
+    }
+    
+    // Downbeats: phrase changes (breakdowns, drops) happen on bar lines, so
+    // pick the bar phase with the sharpest bar-to-bar energy changes, and the
+    // one with the heaviest first beat when the track has none
+    int downbeat_offset = 0;
+    float best_score = -1.0f;
+    for (int offset = 0; offset < 4; offset++) {
+        int bar_count = measure_bars(beat_hops, beat_count, offset, levels, hop_count, bar_starts, bar_energy);
+        
+        float mean = 0.0f, change = 0.0f, accent = 0.0f;
+        for (int i = 0; i < bar_count; i++) {
+            mean += bar_energy[i];
+            accent += levels[bar_starts[i] * 4];
+        }
+        if (bar_count > 0) {
+            mean /= bar_count;
+            accent /= bar_count;
+        }
+        
+        // Squared, so a change split across two straddling bars scores less
+        for (int i = 1; i < bar_count; i++) {
+            float diff = bar_energy[i] - bar_energy[i - 1];
+            if (fabsf(diff) > SECTION_CHANGE * mean) change += diff * diff;
+        }
+        
+        float score = change > 0.0f ? 1.0f + change : accent;
+        if (score > best_score) {
+            best_score = score;
+            downbeat_offset = offset;
+        }
+    }
+    
+    for (int i = 0; i < beat_count; i++) {
+        int hop = (int)(beat_hops[i] + 0.5);
+        beats[i].time = (float)(beat_hops[i] / HOP_RATE);
+        beats[i].beat_in_bar = (uint32_t)(((i - downbeat_offset) % 4 + 4) % 4);
+        hops[hop].flags |= FEATURE_BEAT;
+        if (beats[i].beat_in_bar == 0) hops[hop].flags |= FEATURE_DOWNBEAT;
+    }
+    
+    // Sections: runs of low-bass bars are breakdowns, the first full bar
+    // after one is the drop
+    int marker_count = 0;
+    int breakdowns = 0, drops = 0;
+    int bar_count = measure_bars(beat_hops, beat_count, downbeat_offset, levels, hop_count, bar_starts, bar_energy);
+    
+    float mean_energy = 0.0f;
+    for (int i = 0; i < bar_count; i++) mean_energy += bar_energy[i];
+    if (bar_count > 0) mean_energy /= bar_count;
+    
+    int bar = 0;
+    while (bar < bar_count) {
+        if (bar_energy[bar] >= BREAKDOWN_LEVEL * mean_energy) {
+            bar++;
+            continue;
+        }
+        
+        int run_start = bar;
+        while (bar < bar_count && bar_energy[bar] < BREAKDOWN_LEVEL * mean_energy) bar++;
+        if (bar - run_start < MIN_BREAKDOWN_BARS) continue;
+        
+        int run_end = bar < bar_count ? bar_starts[bar] : hop_count;
+        for (int h = bar_starts[run_start]; h < run_end; h++) hops[h].flags |= FEATURE_BREAKDOWN;
+        markers[marker_count].time = (float)(bar_starts[run_start] / HOP_RATE);
+        markers[marker_count++].type = FEATURE_MARKER_BREAKDOWN;
+        breakdowns++;
+        
+        // Build-ups sit between the breakdown and the drop
+        while (bar < bar_count && bar_energy[bar] < DROP_LEVEL * mean_energy &&
+               bar_energy[bar] >= BREAKDOWN_LEVEL * mean_energy) {
+            bar++;
+        }
+        if (bar < bar_count && bar_energy[bar] >= DROP_LEVEL * mean_energy) {
+            hops[bar_starts[bar]].flags |= FEATURE_DROP;
+            markers[marker_count].time = (float)(bar_starts[bar] / HOP_RATE);
+            markers[marker_count++].type = FEATURE_MARKER_DROP;
+            drops++;
+        }
+    }
+    
+    // Write the track
+    FILE* file = fopen(out_path, "wb");
+    if (!file) {
+        fprintf(stderr, "CLIFT: Cannot write feature track %s\n", out_path);
+        goto cleanup;
+    }
+    
+    FeatureTrackHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, FEATURE_TRACK_MAGIC, 4);
+    header.version = FEATURE_TRACK_VERSION;
+    header.sample_rate = AUDIO_SAMPLE_RATE;
+    header.hop_size = FEATURE_TRACK_HOP;
+    header.hop_count = hop_count;
+    header.beat_count = beat_count;
+    header.marker_count = marker_count;
+    header.bpm = beat_count > 0 ? (float)bpm : 0.0f;
+    
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fwrite(hops, sizeof(FeatureHop), hop_count, file) == (size_t)hop_count &&
+                   fwrite(beats, sizeof(FeatureBeat), beat_count, file) == (size_t)beat_count &&
+                   fwrite(markers, sizeof(FeatureMarker), marker_count, file) == (size_t)marker_count;
+    if (fclose(file) != 0 || !written) {
+        fprintf(stderr, "CLIFT: Error writing feature track %s\n", out_path);
+        goto cleanup;
+    }
+    
+    struct timespec finished;
+    clock_gettime(CLOCK_MONOTONIC, &finished);
+    double elapsed = (finished.tv_sec - started.tv_sec) + (finished.tv_nsec - started.tv_nsec) / 1e9;
+    
+    printf("Analysed %s (%.1f s) in %.2f s on %d threads\n",
+           wav_path, hop_count / HOP_RATE, elapsed, thread_pool_size(pool));
+    printf("  %.2f BPM, %d beats, %d breakdowns, %d drops -> %s\n",
+           header.bpm, beat_count, breakdowns, drops, out_path);
+    success = true;
+
+cleanup:
+    thread_pool_destroy(pool);
+    free(tempo_phases);
+    free(tempo_scores);
+    free(bar_energy);
+    free(bar_starts);
+    free(markers);
+    free(beats);
+    free(beat_hops);
+    free(hops);
+    free(flux);
+    free(levels);
+    free(spectra);
+    wav_file_close(&wav);
+    return success;
+}
+
+void feature_track_default_path(const char* audio_path, char* out, size_t out_size) {
+    const char* slash = strrchr(audio_path, '/');
+    const char* dot = strrchr(audio_path, '.');
+    int stem = (dot && (!slash || dot > slash)) ? (int)(dot - audio_path) : (int)strlen(audio_path);
+    snprintf(out, out_size, "%.*s.clft", stem, audio_path);
+}
+
+// ============= PLAYBACK =============
+
+bool feature_track_open(FeatureTrack* track, const char* path) {
+    memset(track, 0, sizeof(*track));
+    
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "CLIFT: Cannot open feature track %s\n", path);
+        return false;
+    }
+    
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(FeatureTrackHeader)) {
+        fprintf(stderr, "CLIFT: %s is too small to be a feature track\n", path);
+        close(fd);
+        return false;
+    }
+    
+    void* map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "CLIFT: Cannot map feature track %s\n", path);
+        return false;
+    }
+    
+    track->map = map;
+    track->map_size = st.st_size;
+    track->header = map;
+    
+    const FeatureTrackHeader* header = track->header;
+    size_t expected = sizeof(FeatureTrackHeader) +
+                      (size_t)header->hop_count * sizeof(FeatureHop) +
+                      (size_t)header->beat_count * sizeof(FeatureBeat) +
+                      (size_t)header->marker_count * sizeof(FeatureMarker);
+    
+    if (memcmp(header->magic, FEATURE_TRACK_MAGIC, 4) != 0 || header->version != FEATURE_TRACK_VERSION ||
+        header->sample_rate != AUDIO_SAMPLE_RATE || header->hop_size != FEATURE_TRACK_HOP ||
+        expected != track->map_size) {
+        fprintf(stderr, "CLIFT: %s is not a compatible feature track, re-run --analyze\n", path);
+        feature_track_close(track);
+        return false;
+    }
+    
+    track->hops = (const FeatureHop*)(track->map + sizeof(FeatureTrackHeader));
+    track->beats = (const FeatureBeat*)(track->hops + header->hop_count);
+    track->markers = (const FeatureMarker*)(track->beats + header->beat_count);
+    return true;
+}
+
+void feature_track_close(FeatureTrack* track) {
+    if (track->map) {
+        munmap((void*)track->map, track->map_size);
+    }
+    memset(track, 0, sizeof(*track));
+}
+
+const FeatureHop* feature_track_hop_at(const FeatureTrack* track, double time) {
+    if (!track->map || time < 0.0) return NULL;
+    
+    size_t hop = (size_t)(time * track->header->sample_rate / track->header->hop_size);
+    return hop < track->header->hop_count ? &track->hops[hop] : NULL;
+}
+
+int feature_track_beat_at(const FeatureTrack* track, double time) {
+    if (!track->map) return -1;
+    
+    // Last beat with beat.time <= time
+    int lo = 0, hi = (int)track->header->beat_count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (track->beats[mid].time <= time) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo - 1;
+}
+
+double feature_track_next_marker(const FeatureTrack* track, double time, FeatureMarkerType type) {
+    if (!track->map) return -1.0;
+    
+    for (uint32_t i = 0; i < track->header->marker_count; i++) {
+        if (track->markers[i].type == (uint32_t)type && track->markers[i].time > time) {
+            return track->markers[i].time;
+        }
+    }
+    return -1.0;
+}
@@ -0,0 +1,90 @@
+#ifndef AUDIO_FEATURES_H
+#define AUDIO_FEATURES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============= FEATURE TRACK =============
+// Offline analysis of an audio file into a compact, memory-mapped track of
+// per-hop features plus a beat grid and section markers. During the show it
+// is indexed by playback time instead of analysing the live signal.
+
+#define FEATURE_TRACK_MAGIC "CLFT"
+#define FEATURE_TRACK_VERSION 1
+#define FEATURE_TRACK_HOP 800          // Output frames per hop: one capture update at 60 Hz
+#define FEATURE_TRACK_BINS 64
+
+// Per-hop flags
+#define FEATURE_BEAT       0x01        // A beat falls in this hop
+#define FEATURE_DOWNBEAT   0x02        // ...and it is the first beat of a bar
+#define FEATURE_ONSET      0x04        // Onset (note/hit) starts in this hop
+#define FEATURE_BREAKDOWN  0x08        // Hop lies inside a breakdown section
+#define FEATURE_DROP       0x10        // A drop starts in this hop
+
+typedef struct {
+    uint8_t spectrum[FEATURE_TRACK_BINS];  // audio_compute_spectrum() output, 0..255
+    uint8_t bass, mid, treble, volume;     // audio_compute_levels() output, 0..255
+    uint8_t onset;                         // Spectral flux, scaled to the track maximum
+    uint8_t flags;
+    uint8_t reserved[2];
+} FeatureHop;
+
+typedef struct {
+    float time;                // Seconds from the start of the file
+    uint32_t beat_in_bar;      // 0 on downbeats, then 1..3
+} FeatureBeat;
+
+typedef enum {
+    FEATURE_MARKER_BREAKDOWN,
+    FEATURE_MARKER_DROP
+} FeatureMarkerType;
+
+typedef struct {
+    float time;
+    uint32_t type;             // FeatureMarkerType
+} FeatureMarker;
+
+// On-disk header; followed by hop_count FeatureHops, beat_count FeatureBeats
+// and marker_count FeatureMarkers
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t sample_rate;
+    uint32_t hop_size;
+    uint32_t hop_count;
+    uint32_t beat_count;
+    uint32_t marker_count;
+    float bpm;
+} FeatureTrackHeader;
+
+typedef struct {
+    const uint8_t* map;
+    size_t map_size;
+    const FeatureTrackHeader* header;
+    const FeatureHop* hops;
+    const FeatureBeat* beats;
+    const FeatureMarker* markers;
+} FeatureTrack;
+
+// Analyse a WAV file and write its feature track to 'out_path'.
+// 'threads' as for thread_pool_create (0 = all CPUs). Prints a summary.
+bool feature_track_analyze(const char* wav_path, const char* out_path, int threads);
+
+// Default track path for an audio file: the extension replaced by ".clft"
+void feature_track_default_path(const char* audio_path, char* out, size_t out_size);
+
+// Map a feature track written by feature_track_analyze
+bool feature_track_open(FeatureTrack* track, const char* path);
+void feature_track_close(FeatureTrack* track);
+
+// Hop covering 'time' seconds, or NULL outside the track
+const FeatureHop* feature_track_hop_at(const FeatureTrack* track, double time);
+
+// Index of the last beat at or before 'time', -1 if none yet
+int feature_track_beat_at(const FeatureTrack* track, double time);
+
+// Time of the next marker of 'type' strictly after 'time', or -1 if none
+double feature_track_next_marker(const FeatureTrack* track, double time, FeatureMarkerType type);
+
+#endif // AUDIO_FEATURES_H
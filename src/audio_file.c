@@ -0,0 +1,316 @@
+#define _DEFAULT_SOURCE
+#include "audio_file.h"
+#include "audio_pipewire.h"
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// WAV format tags
+#define WAV_FORMAT_PCM 1
+#define WAV_FORMAT_FLOAT 3
+#define WAV_FORMAT_EXTENSIBLE 0xFFFE
+
+static uint16_t read_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t read_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+bool wav_file_open(WavFile* wav, const char* path) {
+    memset(wav, 0, sizeof(*wav));
+    
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "CLIFT: Cannot open audio file %s\n", path);
+        return false;
+    }
+    
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size < 44) {
+        fprintf(stderr, "CLIFT: %s is too small to be a WAV file\n", path);
+        close(fd);
+        return false;
+    }
+    
+    void* map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "CLIFT: Cannot map audio file %s\n", path);
+        return false;
+    }
+    madvise(map, st.st_size, MADV_SEQUENTIAL);
+    
+    wav->map = map;
+    wav->map_size = st.st_size;
+    
+    const uint8_t* p = wav->map;
+    if (memcmp(p, "RIFF", 4) != 0 || memcmp(p + 8, "WAVE", 4) != 0) {
+        fprintf(stderr, "CLIFT: %s is not a RIFF/WAVE file\n", path);
+        wav_file_close(wav);
+        return false;
+    }
+    
+    // Walk the chunk list for "fmt " and "data"
+    int format = 0;
+    size_t data_size = 0;
+    size_t offset = 12;
+    while (offset + 8 <= wav->map_size) {
+        const uint8_t* chunk = p + offset;
+        size_t chunk_size = read_u32(chunk + 4);
+        size_t body = offset + 8;
+        
+        if (memcmp(chunk, "fmt ", 4) == 0 && chunk_size >= 16 && body + 16 <= wav->map_size) {
+            format = read_u16(p + body);
+            wav->channels = read_u16(p + body + 2);
+            wav->sample_rate = (int)read_u32(p + body + 4);
+            wav->block_align = read_u16(p + body + 12);
+            wav->bits_per_sample = read_u16(p + body + 14);
+            if (format == WAV_FORMAT_EXTENSIBLE && chunk_size >= 26 && body + 26 <= wav->map_size) {
+                format = read_u16(p + body + 24);  // First bytes of the sub-format GUID
+            }
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            wav->data = p + body;
+            data_size = chunk_size;
+            if (body + data_size > wav->map_size) {
+                data_size = wav->map_size - body;  // Truncated or streaming-written file
+            }
+            break;
+        }
+        
+        offset = body + chunk_size + (chunk_size & 1);  // Chunks are word aligned
+    }
+    
+    wav->is_float = (format == WAV_FORMAT_FLOAT);
+    bool supported = (format == WAV_FORMAT_PCM &&
+                      (wav->bits_per_sample == 8 || wav->bits_per_sample == 16 ||
+                       wav->bits_per_sample == 24 || wav->bits_per_sample == 32)) ||
+                     (format == WAV_FORMAT_FLOAT &&
+                      (wav->bits_per_sample == 32 || wav->bits_per_sample == 64));
+    
+    if (!wav->data || !supported || wav->channels <= 0 || wav->sample_rate <= 0 ||
+        wav->block_align < wav->channels * (wav->bits_per_sample / 8)) {
+        fprintf(stderr, "CLIFT: Unsupported WAV format in %s (format %d, %d-bit, %d ch)\n",
+                path, format, wav->bits_per_sample, wav->channels);
+        wav_file_close(wav);
+        return false;
+    }
+    
+    wav->frames = data_size / wav->block_align;
+    return true;
+}
+
+void wav_file_close(WavFile* wav) {
+    if (wav->map) {
+        munmap((void*)wav->map, wav->map_size);
+    }
+    memset(wav, 0, sizeof(*wav));
+}
+
+float wav_file_sample(const WavFile* wav, size_t frame, int channel) {
+    const uint8_t* s = wav->data + frame * wav->block_align + channel * (wav->bits_per_sample / 8);
+    
+    if (wav->is_float) {
+        if (wav->bits_per_sample == 32) {
+            float v;
+            memcpy(&v, s, sizeof(v));
+            return v;
+        }
+        double v;
+        memcpy(&v, s, sizeof(v));
+        return (float)v;
+    }
+    
+    switch (wav->bits_per_sample) {
+        case 8:  return (s[0] - 128) / 128.0f;
+        case 16: return (int16_t)read_u16(s) / 32768.0f;
+        case 24: return (int32_t)((uint32_t)s[0] << 8 | (uint32_t)s[1] << 16 | (uint32_t)s[2] << 24) / 2147483648.0f;
+        default: return (int32_t)read_u32(s) / 2147483648.0f;
+    }
+}
+
+uint64_t wav_file_output_frames(const WavFile* wav) {
+    if (wav->sample_rate <= 0) return 0;
+    return (uint64_t)wav->frames * AUDIO_SAMPLE_RATE / wav->sample_rate;
+}
+
+int wav_file_read_resampled(const WavFile* wav, uint64_t start, float* buffer, int frames) {
+    if (!wav->data || wav->frames == 0) return 0;
+    
+    int right = wav->channels > 1 ? 1 : 0;  // Mono is duplicated, extra channels dropped
+    int written = 0;
+    
+    if (wav->sample_rate == AUDIO_SAMPLE_RATE) {
+        for (; written < frames && start + written < wav->frames; written++) {
+            size_t frame = start + written;
+            buffer[written * 2] = wav_file_sample(wav, frame, 0);
+            buffer[written * 2 + 1] = wav_file_sample(wav, frame, right);
+        }
+        return written;
+    }
+    
+    // Linear interpolation between neighbouring source frames
+    double step = (double)wav->sample_rate / AUDIO_SAMPLE_RATE;
+    for (; written < frames; written++) {
+        double pos = (double)(start + written) * step;
+        size_t i0 = (size_t)pos;
+        if (i0 >= wav->frames) break;
+        size_t i1 = i0 + 1 < wav->frames ? i0 + 1 : i0;
+        float frac = (float)(pos - (double)i0);
+        
+        float l0 = wav_file_sample(wav, i0, 0), l1 = wav_file_sample(wav, i1, 0);
+        float r0 = wav_file_sample(wav, i0, right), r1 = wav_file_sample(wav, i1, right);
+        buffer[written * 2] = l0 + (l1 - l0) * frac;
+        buffer[written * 2 + 1] = r0 + (r1 - r0) * frac;
+    }
+    return written;
+}
+
+// ============= FILE INPUT BACKEND =============
+
+typedef struct {
+    WavFile wav;
+    bool open;
+    bool realtime;
+    bool loop;
+    uint64_t pos;               // Next output frame (read by other threads)
+    uint64_t total;
+    
+    // Real-time pacing
+    bool clock_started;
+    struct timespec clock_start;
+    uint64_t clock_delivered;
+} FileInput;
+
+static FileInput file_inputs[AUDIO_MAX_STREAMS];
+
+bool audio_file_open(const char* path, bool realtime, bool loop) {
+    return audio_file_open_stream(0, path, realtime, loop);
+}
+
+bool audio_file_open_stream(int stream, const char* path, bool realtime, bool loop) {
+    if (stream < 0 || stream >= AUDIO_MAX_STREAMS) return false;
+    FileInput* input = &file_inputs[stream];
+    
+    if (input->open) {
+        input->open = false;
+        wav_file_close(&input->wav);
+    }
+    
+    if (!wav_file_open(&input->wav, path)) {
+        return false;
+    }
+    
+    input->total = wav_file_output_frames(&input->wav);
+    input->realtime = realtime;
+    input->loop = loop;
+    input->pos = 0;
+    input->clock_started = false;
+    input->clock_delivered = 0;
+    input->open = true;
+    
+    fprintf(stderr, "CLIFT: Streaming %s (%d Hz, %d ch, %d-bit%s, %.1f s)%s\n",
+            path, input->wav.sample_rate, input->wav.channels, input->wav.bits_per_sample,
+            input->wav.is_float ? " float" : "", (double)input->total / AUDIO_SAMPLE_RATE,
+            realtime ? "" : " as fast as possible");
+    return true;
+}
+
+void audio_file_close(void) {
+    for (int i = 0; i < AUDIO_MAX_STREAMS; i++) {
+        if (file_inputs[i].open) {
+            file_inputs[i].open = false;
+            wav_file_close(&file_inputs[i].wav);
+        }
+    }
+}
+
+bool audio_file_active(void) {
+    return file_inputs[0].open;
+}
+
+bool audio_file_stream_active(int stream) {
+    return stream >= 0 && stream < AUDIO_MAX_STREAMS && file_inputs[stream].open;
+}
+
+bool audio_file_stream_unpaced(int stream) {
+    return audio_file_stream_active(stream) && !file_inputs[stream].realtime;
+}
+
+int audio_file_get_buffer(float* buffer, int max_frames) {
+    return audio_file_get_stream_buffer(0, buffer, max_frames);
+}
+
+int audio_file_get_stream_buffer(int stream, float* buffer, int max_frames) {
+    if (!audio_file_stream_active(stream) || max_frames <= 0) return 0;
+    FileInput* input = &file_inputs[stream];
+    
+    uint64_t pos = __atomic_load_n(&input->pos, __ATOMIC_RELAXED);
+    int frames = max_frames;
+    
+    if (input->realtime) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (!input->clock_started) {
+            input->clock_start = now;
+            input->clock_delivered = 0;
+            input->clock_started = true;
+        }
+        
+        double elapsed = (now.tv_sec - input->clock_start.tv_sec) + (now.tv_nsec - input->clock_start.tv_nsec) / 1e9;
+        int64_t due = (int64_t)(elapsed * AUDIO_SAMPLE_RATE) - (int64_t)input->clock_delivered;
+        if (due <= 0) return 0;
+        
+        if (due > max_frames) {
+            // Reader fell behind: drop the backlog so the stream stays on the wall clock
+            uint64_t skip = (uint64_t)due - max_frames;
+            pos += skip;
+            input->clock_delivered += skip;
+            due = max_frames;
+        }
+        frames = (int)due;
+        input->clock_delivered += frames;
+    }
+    
+    if (input->loop && input->total > 0) {
+        pos %= input->total;
+    }
+    
+    int written = 0;
+    while (written < frames) {
+        int n = wav_file_read_resampled(&input->wav, pos, buffer + written * AUDIO_CHANNELS, frames - written);
+        pos += n;
+        written += n;
+        
+        if (written < frames) {
+            if (!input->loop || input->total == 0) break;
+            pos = 0;
+        }
+    }
+    
+    __atomic_store_n(&input->pos, pos, __ATOMIC_RELAXED);
+    
+    if (written == 0) return 0;
+    
+    // Pad with silence at the end of a non-looping file
+    if (written < frames) {
+        memset(&buffer[written * AUDIO_CHANNELS], 0, (frames - written) * AUDIO_CHANNELS * sizeof(float));
+    }
+    
+    return frames;
+}
+
+double audio_file_position(void) {
+    if (!file_inputs[0].open) return 0.0;
+    return (double)__atomic_load_n(&file_inputs[0].pos, __ATOMIC_RELAXED) / AUDIO_SAMPLE_RATE;
+}
+
+double audio_file_duration(void) {
+    if (!file_inputs[0].open) return 0.0;
+    return (double)file_inputs[0].total / AUDIO_SAMPLE_RATE;
+}
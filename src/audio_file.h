@@ -0,0 +1,67 @@
+#ifndef AUDIO_FILE_H
+#define AUDIO_FILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Memory-mapped WAV file (PCM 8/16/24/32-bit or IEEE float 32/64-bit)
+typedef struct {
+    const uint8_t* map;       // Whole file mapping
+    size_t map_size;
+    const uint8_t* data;      // Start of the sample data chunk
+    size_t frames;            // Frames in the data chunk
+    int channels;
+    int sample_rate;
+    int bits_per_sample;
+    int block_align;
+    bool is_float;
+} WavFile;
+
+// Map a WAV file and parse its header. Returns false on any error.
+bool wav_file_open(WavFile* wav, const char* path);
+
+// Unmap a WAV file opened with wav_file_open
+void wav_file_close(WavFile* wav);
+
+// Read one sample as float in -1..1
+float wav_file_sample(const WavFile* wav, size_t frame, int channel);
+
+// Resample [start, start + frames) of the file to AUDIO_SAMPLE_RATE stereo.
+// 'start' is in output frames. Returns frames written (short at end of file).
+int wav_file_read_resampled(const WavFile* wav, uint64_t start, float* buffer, int frames);
+
+// Length of the file in output (AUDIO_SAMPLE_RATE) frames
+uint64_t wav_file_output_frames(const WavFile* wav);
+
+// ============= FILE INPUT BACKEND =============
+// Stand-in for PipeWire capture: while a file is open, audio_pipewire_init()
+// and audio_pipewire_get_buffer() stream from it instead of the sound server.
+
+// Open the input file for stream 0. 'realtime' paces delivery to the wall
+// clock, otherwise every call returns a full buffer. 'loop' restarts at EOF.
+bool audio_file_open(const char* path, bool realtime, bool loop);
+
+// Same for any capture stream (e.g. one stem per stream)
+bool audio_file_open_stream(int stream, const char* path, bool realtime, bool loop);
+
+// Close all input files (the PipeWire/test-signal path is used again)
+void audio_file_close(void);
+
+// Whether a file feeds stream 0 / the given stream
+bool audio_file_active(void);
+bool audio_file_stream_active(int stream);
+
+// Whether a file feeds the given stream as fast as possible rather than
+// paced to the wall clock
+bool audio_file_stream_unpaced(int stream);
+
+// Same contract as audio_pipewire_get_buffer / audio_pipewire_get_stream_buffer
+int audio_file_get_buffer(float* buffer, int max_frames);
+int audio_file_get_stream_buffer(int stream, float* buffer, int max_frames);
+
+// Playback position and length of stream 0's file in seconds
+double audio_file_position(void);
+double audio_file_duration(void);
+
+#endif // AUDIO_FILE_H
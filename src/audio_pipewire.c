@@ -1,4 +1,5 @@
 #include "audio_pipewire.h"
+#include "audio_file.h"
 #include <math.h>
 #include <string.h>
 #include <stdlib.h>
@@ -6,38 +7,52 @@
 #include <errno.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <time.h>
+
+// Source registry lifecycle (see SOURCE REGISTRY below)
+static void registry_start(const char* app_name);
+static void registry_stop(void);
+
+// Open streams; stream 0 is the main input
+static int stream_count = 0;
+static char stream_app_name[64] = "CLIFT";
 
 #ifdef USE_PIPEWIRE
 #include <pipewire/pipewire.h>
 #include <spa/param/audio/format-utils.h>
 #include <spa/param/props.h>
 
+// One capture stream with its own ring buffer, so each can be drained by
+// a different analysis thread
+typedef struct {
+    struct pw_stream *pw;
+    float* ring;
+    int ring_size;
+    int write_pos;
+    int read_pos;
+    pthread_mutex_t ring_mutex;
+} CaptureStream;
+
 // PipeWire state
 static struct pw_thread_loop *pw_loop = NULL;
-static struct pw_stream *pw_stream = NULL;
 static bool pw_initialized = false;
-
-// Ring buffer for thread-safe audio transfer
-static float* audio_ring_buffer = NULL;
-static int ring_buffer_size = 0;
-static int write_pos = 0;
-static int read_pos = 0;
-static pthread_mutex_t ring_mutex = PTHREAD_MUTEX_INITIALIZER;
+static CaptureStream streams[AUDIO_MAX_STREAMS];
 
 // PipeWire stream events
 static void on_process(void *userdata) {
+    CaptureStream *stream = userdata;
     struct pw_buffer *b;
     struct spa_buffer *buf;
     float *samples;
     uint32_t n_samples;
     
-    if ((b = pw_stream_dequeue_buffer(pw_stream)) == NULL) {
+    if ((b = pw_stream_dequeue_buffer(stream->pw)) == NULL) {
         return;
     }
     
     buf = b->buffer;
     if (buf->datas[0].data == NULL) {
-        pw_stream_queue_buffer(pw_stream, b);
+        pw_stream_queue_buffer(stream->pw, b);
         return;
     }
     
@@ -45,73 +60,69 @@ static void on_process(void *userdata) {
     n_samples = buf->datas[0].chunk->size / sizeof(float);
     
     // Copy to ring buffer
-    pthread_mutex_lock(&ring_mutex);
+    pthread_mutex_lock(&stream->ring_mutex);
     
-    for (uint32_t i = 0; i < n_samples && i < ring_buffer_size; i++) {
-        audio_ring_buffer[write_pos] = samples[i];
-        write_pos = (write_pos + 1) % ring_buffer_size;
+    for (uint32_t i = 0; i < n_samples && i < stream->ring_size; i++) {
+        stream->ring[stream->write_pos] = samples[i];
+        stream->write_pos = (stream->write_pos + 1) % stream->ring_size;
         
         // Handle buffer overflow by moving read position
-        if (write_pos == read_pos) {
-            read_pos = (read_pos + 1) % ring_buffer_size;
+        if (stream->write_pos == stream->read_pos) {
+            stream->read_pos = (stream->read_pos + 1) % stream->ring_size;
         }
     }
     
-    pthread_mutex_unlock(&ring_mutex);
+    pthread_mutex_unlock(&stream->ring_mutex);
+    
+    pw_stream_queue_buffer(stream->pw, b);
+}
+
+static void registry_set_own_node(uint32_t node_id);
+
+static void on_state_changed(void *userdata, enum pw_stream_state old,
+                             enum pw_stream_state state, const char *error) {
+    CaptureStream *stream = userdata;
+    (void)old;
+    (void)state;
+    (void)error;
     
-    pw_stream_queue_buffer(pw_stream, b);
+    // Our node id is only known once the stream has been exported. The
+    // source browser links into the main input only.
+    if (stream == &streams[0]) {
+        registry_set_own_node(pw_stream_get_node_id(stream->pw));
+    }
 }
 
 static const struct pw_stream_events stream_events = {
     PW_VERSION_STREAM_EVENTS,
+    .state_changed = on_state_changed,
     .process = on_process,
 };
 
-bool audio_pipewire_init(const char* app_name) {
-    // Save stdout and stderr, redirect to /dev/null during init
-    int saved_stdout = dup(STDOUT_FILENO);
-    int saved_stderr = dup(STDERR_FILENO);
-    int null_fd = open("/dev/null", O_WRONLY);
-    if (null_fd >= 0) {
-        dup2(null_fd, STDOUT_FILENO);
-        dup2(null_fd, STDERR_FILENO);
-        close(null_fd);
+static void capture_stream_destroy(CaptureStream* stream) {
+    if (stream->pw) {
+        pw_stream_destroy(stream->pw);
+        stream->pw = NULL;
     }
-    
-    // Initialize PipeWire
-    pw_init(NULL, NULL);
-    
-    // Allocate ring buffer
-    ring_buffer_size = AUDIO_BUFFER_SIZE * 8;  // 8x buffer for smooth operation
-    audio_ring_buffer = calloc(ring_buffer_size, sizeof(float));
-    if (!audio_ring_buffer) {
-        // Restore stdout/stderr
-        if (saved_stdout >= 0) {
-            dup2(saved_stdout, STDOUT_FILENO);
-            close(saved_stdout);
-        }
-        if (saved_stderr >= 0) {
-            dup2(saved_stderr, STDERR_FILENO);
-            close(saved_stderr);
-        }
-        return false;
+    if (stream->ring) {
+        free(stream->ring);
+        stream->ring = NULL;
+        pthread_mutex_destroy(&stream->ring_mutex);
     }
+}
+
+// Create and connect a capture stream on pw_loop. Call with the loop locked
+// once it is running.
+static bool capture_stream_create(CaptureStream* stream, const char* node_name) {
+    memset(stream, 0, sizeof(*stream));
     
-    // Create thread loop
-    pw_loop = pw_thread_loop_new("clift-audio", NULL);
-    if (!pw_loop) {
-        free(audio_ring_buffer);
-        // Restore stdout/stderr
-        if (saved_stdout >= 0) {
-            dup2(saved_stdout, STDOUT_FILENO);
-            close(saved_stdout);
-        }
-        if (saved_stderr >= 0) {
-            dup2(saved_stderr, STDERR_FILENO);
-            close(saved_stderr);
-        }
+    // Allocate ring buffer
+    stream->ring_size = AUDIO_BUFFER_SIZE * 8;  // 8x buffer for smooth operation
+    stream->ring = calloc(stream->ring_size, sizeof(float));
+    if (!stream->ring) {
         return false;
     }
+    pthread_mutex_init(&stream->ring_mutex, NULL);
     
     // Create stream
     struct spa_audio_info_raw spa_audio_info = {
@@ -127,59 +138,38 @@ bool audio_pipewire_init(const char* app_name) {
     
     params[0] = spa_format_audio_raw_build(&b, SPA_PARAM_EnumFormat, &spa_audio_info);
     
-    pw_stream = pw_stream_new_simple(
+    stream->pw = pw_stream_new_simple(
         pw_thread_loop_get_loop(pw_loop),
-        app_name,
+        node_name,
         pw_properties_new(
             PW_KEY_MEDIA_TYPE, "Audio",
             PW_KEY_MEDIA_CATEGORY, "Capture",
             PW_KEY_MEDIA_ROLE, "Music",
             NULL),
         &stream_events,
-        NULL);
+        stream);
     
-    if (!pw_stream) {
-        pw_thread_loop_destroy(pw_loop);
-        free(audio_ring_buffer);
-        // Restore stdout/stderr
-        if (saved_stdout >= 0) {
-            dup2(saved_stdout, STDOUT_FILENO);
-            close(saved_stdout);
-        }
-        if (saved_stderr >= 0) {
-            dup2(saved_stderr, STDERR_FILENO);
-            close(saved_stderr);
-        }
+    if (!stream->pw) {
+        capture_stream_destroy(stream);
         return false;
     }
     
     // Connect stream
-    if (pw_stream_connect(pw_stream,
+    if (pw_stream_connect(stream->pw,
                          PW_DIRECTION_INPUT,
                          PW_ID_ANY,
                          PW_STREAM_FLAG_AUTOCONNECT |
                          PW_STREAM_FLAG_MAP_BUFFERS |
                          PW_STREAM_FLAG_RT_PROCESS,
                          params, 1) < 0) {
-        pw_stream_destroy(pw_stream);
-        pw_thread_loop_destroy(pw_loop);
-        free(audio_ring_buffer);
-        // Restore stdout/stderr
-        if (saved_stdout >= 0) {
-            dup2(saved_stdout, STDOUT_FILENO);
-            close(saved_stdout);
-        }
-        if (saved_stderr >= 0) {
-            dup2(saved_stderr, STDERR_FILENO);
-            close(saved_stderr);
-        }
+        capture_stream_destroy(stream);
         return false;
     }
     
-    // Start the loop
-    pw_thread_loop_start(pw_loop);
-    
-    // Restore stdout/stderr now that PipeWire is initialized
+    return true;
+}
+
+static void restore_stdio(int saved_stdout, int saved_stderr) {
     if (saved_stdout >= 0) {
         dup2(saved_stdout, STDOUT_FILENO);
         close(saved_stdout);
@@ -188,31 +178,90 @@ bool audio_pipewire_init(const char* app_name) {
         dup2(saved_stderr, STDERR_FILENO);
         close(saved_stderr);
     }
+}
+
+bool audio_pipewire_init(const char* app_name) {
+    snprintf(stream_app_name, sizeof(stream_app_name), "%s", app_name);
+    stream_count = 1;
+    
+    // A file input replaces the PipeWire stream entirely
+    if (audio_file_active()) {
+        return true;
+    }
+    
+    // Save stdout and stderr, redirect to /dev/null during init
+    int saved_stdout = dup(STDOUT_FILENO);
+    int saved_stderr = dup(STDERR_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd >= 0) {
+        dup2(null_fd, STDOUT_FILENO);
+        dup2(null_fd, STDERR_FILENO);
+        close(null_fd);
+    }
+    
+    // Initialize PipeWire
+    pw_init(NULL, NULL);
+    
+    // Create thread loop
+    pw_loop = pw_thread_loop_new("clift-audio", NULL);
+    if (!pw_loop) {
+        restore_stdio(saved_stdout, saved_stderr);
+        return false;
+    }
+    
+    // The main stream keeps the bare app name so existing links still match
+    if (!capture_stream_create(&streams[0], app_name)) {
+        pw_thread_loop_destroy(pw_loop);
+        pw_loop = NULL;
+        restore_stdio(saved_stdout, saved_stderr);
+        return false;
+    }
+    
+    // Watch the graph for sources and links before events start flowing
+    registry_start(app_name);
+    
+    // Start the loop
+    pw_thread_loop_start(pw_loop);
+    
+    // Restore stdout/stderr now that PipeWire is initialized
+    restore_stdio(saved_stdout, saved_stderr);
     
     pw_initialized = true;
     return true;
 }
 
+int audio_pipewire_open_stream(const char* name) {
+    if (stream_count == 0 || stream_count >= AUDIO_MAX_STREAMS) return -1;
+    
+    int index = stream_count;
+    if (pw_initialized && !audio_file_stream_active(index)) {
+        char node_name[128];
+        snprintf(node_name, sizeof(node_name), "%s-%s", stream_app_name, name);
+        
+        pw_thread_loop_lock(pw_loop);
+        bool created = capture_stream_create(&streams[index], node_name);
+        pw_thread_loop_unlock(pw_loop);
+        
+        if (!created) return -1;
+    }
+    
+    stream_count++;
+    return index;
+}
+
 #else // !USE_PIPEWIRE
 
 // Fallback implementation without PipeWire
-static float* audio_ring_buffer = NULL;
-static int ring_buffer_size = 0;
-static int write_pos = 0;
-static int read_pos = 0;
-
 bool audio_pipewire_init(const char* app_name) {
-    (void)app_name;
+    snprintf(stream_app_name, sizeof(stream_app_name), "%s", app_name);
+    stream_count = 1;
     
-    // Allocate ring buffer for audio
-    ring_buffer_size = AUDIO_BUFFER_SIZE * 4;  // 4x buffer for smooth playback
-    audio_ring_buffer = calloc(ring_buffer_size * AUDIO_CHANNELS, sizeof(float));
-    if (!audio_ring_buffer) {
-        return false;
+    if (audio_file_active()) {
+        return true;
     }
     
-    write_pos = 0;
-    read_pos = 0;
+    // pw-link may still be available even without the development headers
+    registry_start(app_name);
     
     fprintf(stderr, "CLIFT: PipeWire support not compiled in. Using test signal.\n");
     fprintf(stderr, "CLIFT: To enable PipeWire, install libpipewire-0.3-dev and rebuild with USE_PIPEWIRE=1\n");
@@ -220,45 +269,65 @@ bool audio_pipewire_init(const char* app_name) {
     return true;
 }
 
+int audio_pipewire_open_stream(const char* name) {
+    (void)name;
+    
+    // Extra streams play their own test signal unless a file backs them
+    if (stream_count == 0 || stream_count >= AUDIO_MAX_STREAMS) return -1;
+    return stream_count++;
+}
+
 #endif // USE_PIPEWIRE
 
 void audio_pipewire_cleanup(void) {
 #ifdef USE_PIPEWIRE
     if (pw_initialized) {
-        if (pw_stream) {
-            pw_thread_loop_stop(pw_loop);
-            pw_stream_destroy(pw_stream);
-        }
-        if (pw_loop) {
-            pw_thread_loop_destroy(pw_loop);
+        pw_thread_loop_stop(pw_loop);
+        registry_stop();
+        for (int i = 0; i < stream_count; i++) {
+            capture_stream_destroy(&streams[i]);
         }
+        pw_thread_loop_destroy(pw_loop);
+        pw_loop = NULL;
         pw_initialized = false;
     }
-    pthread_mutex_destroy(&ring_mutex);
+#else
+    registry_stop();
 #endif
     
-    if (audio_ring_buffer) {
-        free(audio_ring_buffer);
-        audio_ring_buffer = NULL;
-    }
+    stream_count = 0;
+}
+
+int audio_pipewire_stream_count(void) {
+    return stream_count;
 }
 
 int audio_pipewire_get_buffer(float* buffer, int max_frames) {
-    if (!audio_ring_buffer) return 0;
+    return audio_pipewire_get_stream_buffer(0, buffer, max_frames);
+}
+
+int audio_pipewire_get_stream_buffer(int stream, float* buffer, int max_frames) {
+    if (stream < 0 || stream >= AUDIO_MAX_STREAMS) return 0;
+    
+    if (audio_file_stream_active(stream)) {
+        return audio_file_get_stream_buffer(stream, buffer, max_frames);
+    }
+    
+    if (stream >= stream_count) return 0;
     
 #ifdef USE_PIPEWIRE
-    if (pw_initialized) {
+    CaptureStream *capture = &streams[stream];
+    if (pw_initialized && capture->ring) {
         // Copy from ring buffer
-        pthread_mutex_lock(&ring_mutex);
+        pthread_mutex_lock(&capture->ring_mutex);
         
         int frames_available = 0;
-        int temp_read = read_pos;
         
         // Calculate available frames
-        if (write_pos >= read_pos) {
-            frames_available = (write_pos - read_pos) / AUDIO_CHANNELS;
+        if (capture->write_pos >= capture->read_pos) {
+            frames_available = (capture->write_pos - capture->read_pos) / AUDIO_CHANNELS;
         } else {
-            frames_available = (ring_buffer_size - read_pos + write_pos) / AUDIO_CHANNELS;
+            frames_available = (capture->ring_size - capture->read_pos + capture->write_pos) / AUDIO_CHANNELS;
         }
         
         int frames_to_copy = frames_available < max_frames ? frames_available : max_frames;
@@ -266,12 +335,12 @@ int audio_pipewire_get_buffer(float* buffer, int max_frames) {
         // Copy audio data
         for (int i = 0; i < frames_to_copy; i++) {
             for (int ch = 0; ch < AUDIO_CHANNELS; ch++) {
-                buffer[i * AUDIO_CHANNELS + ch] = audio_ring_buffer[read_pos];
-                read_pos = (read_pos + 1) % ring_buffer_size;
+                buffer[i * AUDIO_CHANNELS + ch] = capture->ring[capture->read_pos];
+                capture->read_pos = (capture->read_pos + 1) % capture->ring_size;
             }
         }
         
-        pthread_mutex_unlock(&ring_mutex);
+        pthread_mutex_unlock(&capture->ring_mutex);
         
         // If not enough data, pad with silence
         if (frames_to_copy < max_frames) {
@@ -283,9 +352,14 @@ int audio_pipewire_get_buffer(float* buffer, int max_frames) {
     }
 #endif
     
-    // Fallback: generate test signal
-    static float phase = 0.0f;
+    // Fallback: generate test signal. Extra streams get their own pitch and
+    // a pulse at their own rate so per-stream analysis is easy to tell apart.
+    static float phases[AUDIO_MAX_STREAMS] = {0};
+    static unsigned long positions[AUDIO_MAX_STREAMS] = {0};
+    float base_freq = 440.0f / (1 << stream);
+    int pulse_period = stream > 0 ? AUDIO_SAMPLE_RATE / (stream + 1) : 0;
     int frames = max_frames < AUDIO_BUFFER_SIZE ? max_frames : AUDIO_BUFFER_SIZE;
+    float phase = phases[stream];
     
     for (int i = 0; i < frames; i++) {
         // Generate a test tone with harmonics
@@ -298,37 +372,102 @@ int audio_pipewire_get_buffer(float* buffer, int max_frames) {
         // Add some noise for high frequency content
         sample += 0.02f * ((float)rand() / RAND_MAX - 0.5f);
         
+        if (pulse_period > 0) {
+            float t = (float)(positions[stream]++ % pulse_period) / AUDIO_SAMPLE_RATE;
+            sample *= expf(-t * 8.0f);
+        }
+        
         // Stereo
         buffer[i * 2] = sample;
         buffer[i * 2 + 1] = sample;
         
-        phase += 2.0f * M_PI * 440.0f / AUDIO_SAMPLE_RATE;
+        phase += 2.0f * M_PI * base_freq / AUDIO_SAMPLE_RATE;
         if (phase > 2.0f * M_PI) phase -= 2.0f * M_PI;
     }
+    phases[stream] = phase;
     
     return frames;
 }
 
-// Simple DFT for spectrum analysis (replace with FFT in production)
+// ============= SPECTRUM =============
+
+// Twiddle factors for the AUDIO_FFT_SIZE-point FFT, built once
+static float fft_cos[AUDIO_FFT_SIZE / 2];
+static float fft_sin[AUDIO_FFT_SIZE / 2];
+static pthread_once_t fft_once = PTHREAD_ONCE_INIT;
+
+static void fft_init_tables(void) {
+    for (int i = 0; i < AUDIO_FFT_SIZE / 2; i++) {
+        double angle = 2.0 * M_PI * i / AUDIO_FFT_SIZE;
+        fft_cos[i] = (float)cos(angle);
+        fft_sin[i] = (float)sin(angle);
+    }
+}
+
+// In-place iterative radix-2 FFT of AUDIO_FFT_SIZE points
+static void fft_transform(float* re, float* im) {
+    // Bit-reversal permutation
+    for (int i = 1, j = 0; i < AUDIO_FFT_SIZE; i++) {
+        int bit = AUDIO_FFT_SIZE >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) {
+            float t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+    
+    for (int len = 2; len <= AUDIO_FFT_SIZE; len <<= 1) {
+        int half = len >> 1;
+        int stride = AUDIO_FFT_SIZE / len;
+        for (int start = 0; start < AUDIO_FFT_SIZE; start += len) {
+            for (int k = 0; k < half; k++) {
+                float wr = fft_cos[k * stride];
+                float wi = -fft_sin[k * stride];
+                int a = start + k, b = a + half;
+                float tr = re[b] * wr - im[b] * wi;
+                float ti = re[b] * wi + im[b] * wr;
+                re[b] = re[a] - tr;
+                im[b] = im[a] - ti;
+                re[a] += tr;
+                im[a] += ti;
+            }
+        }
+    }
+}
+
 void audio_compute_spectrum(const float* audio_buffer, int frames, float* spectrum, int spectrum_size) {
+    pthread_once(&fft_once, fft_init_tables);
+    
     // Clear spectrum
     memset(spectrum, 0, spectrum_size * sizeof(float));
+    if (frames <= 0) return;
+    
+    float re[AUDIO_FFT_SIZE], im[AUDIO_FFT_SIZE];
+    int n = frames < AUDIO_FFT_SIZE ? frames : AUDIO_FFT_SIZE;
+    for (int i = 0; i < AUDIO_FFT_SIZE; i++) {
+        re[i] = i < n ? audio_buffer[i * 2] : 0.0f;
+        im[i] = 0.0f;
+    }
+    
+    fft_transform(re, im);
+    
+    // Output bins keep the old linear 0..Nyquist layout; each takes the peak
+    // of the FFT bins around its centre so tones between centres still show
+    int step = AUDIO_FFT_SIZE / 2 / spectrum_size;
+    if (step < 1) step = 1;
     
-    // Simple frequency bins
     for (int bin = 0; bin < spectrum_size; bin++) {
-        float freq = (float)bin / spectrum_size * (AUDIO_SAMPLE_RATE / 2.0f);
-        float real = 0.0f, imag = 0.0f;
-        
-        // Simple DFT for this frequency bin
-        for (int i = 0; i < frames && i < 512; i++) {
-            float t = (float)i / AUDIO_SAMPLE_RATE;
-            float angle = 2.0f * M_PI * freq * t;
-            real += audio_buffer[i * 2] * cosf(angle);
-            imag += audio_buffer[i * 2] * sinf(angle);
+        int first = bin * step - step / 2;
+        float peak = 0.0f;
+        for (int k = first; k < first + step; k++) {
+            if (k < 0 || k > AUDIO_FFT_SIZE / 2) continue;
+            float magnitude = sqrtf(re[k] * re[k] + im[k] * im[k]);
+            if (magnitude > peak) peak = magnitude;
         }
         
         // Magnitude
-        spectrum[bin] = sqrtf(real * real + imag * imag) / frames;
+        spectrum[bin] = peak / frames;
         
         // Apply logarithmic scaling
         spectrum[bin] = logf(1.0f + spectrum[bin] * 10.0f) / logf(11.0f);
@@ -375,25 +514,24 @@ void audio_compute_levels(const float* spectrum, int spectrum_size,
     *volume = fminf(1.0f, *volume);
 }
 
-bool audio_detect_beat(float current_volume, float* beat_intensity) {
-    static float volume_history[8] = {0};
-    static int history_index = 0;
-    static float last_beat_time = 0.0f;
-    static float beat_threshold = 0.0f;
-    
+void audio_beat_detector_reset(AudioBeatDetector* detector) {
+    memset(detector, 0, sizeof(*detector));
+}
+
+bool audio_beat_detector_process(AudioBeatDetector* detector, float current_volume, float* beat_intensity) {
     // Update history
-    volume_history[history_index] = current_volume;
-    history_index = (history_index + 1) % 8;
+    detector->volume_history[detector->history_index] = current_volume;
+    detector->history_index = (detector->history_index + 1) % 8;
     
     // Calculate average
     float avg = 0.0f;
     for (int i = 0; i < 8; i++) {
-        avg += volume_history[i];
+        avg += detector->volume_history[i];
     }
     avg /= 8.0f;
     
     // Dynamic threshold
-    beat_threshold = avg * 1.5f;
+    float beat_threshold = avg * 1.5f;
     
     // Detect beat
     bool beat = false;
@@ -405,4 +543,715 @@ bool audio_detect_beat(float current_volume, float* beat_intensity) {
     }
     
     return beat;
-}
\ No newline at end of file
+}
+
+bool audio_detect_beat(float current_volume, float* beat_intensity) {
+    static AudioBeatDetector detector;
+    return audio_beat_detector_process(&detector, current_volume, beat_intensity);
+}
+
+// ============= ANALYSIS HISTORY =============
+
+// Entries this close to the write head may be overwritten while a reader
+// walks the view, so views never expose them.
+#define AUDIO_WAVE_GUARD (AUDIO_BUFFER_SIZE / AUDIO_WAVE_DECIMATION * 2)
+#define AUDIO_SPECTRO_GUARD 4
+
+void audio_history_reset(AudioHistory* history) {
+    memset(history, 0, sizeof(*history));
+}
+
+void audio_history_push_waveform(AudioHistory* history, const float* audio_buffer, int frames) {
+    uint32_t head = history->wave_head;
+    
+    for (int i = 0; i < frames; i++) {
+        // Mono mix, box-filtered down to the history rate
+        history->decim_acc += (audio_buffer[i * 2] + audio_buffer[i * 2 + 1]) * 0.5f;
+        if (++history->decim_count == AUDIO_WAVE_DECIMATION) {
+            history->wave[head & (AUDIO_WAVE_HISTORY - 1)] = history->decim_acc / AUDIO_WAVE_DECIMATION;
+            head++;
+            history->decim_acc = 0.0f;
+            history->decim_count = 0;
+        }
+    }
+    
+    __atomic_store_n(&history->wave_head, head, __ATOMIC_RELEASE);
+}
+
+void audio_history_push_spectrum(AudioHistory* history, const float* spectrum, int spectrum_size) {
+    uint32_t head = history->spectro_head;
+    uint8_t* row = history->spectro[head & (AUDIO_SPECTRO_ROWS - 1)];
+    
+    for (int bin = 0; bin < AUDIO_SPECTRO_BINS; bin++) {
+        float val = bin < spectrum_size ? spectrum[bin] : 0.0f;
+        if (val < 0.0f) val = 0.0f;
+        if (val > 1.0f) val = 1.0f;
+        row[bin] = (uint8_t)(val * 255.0f + 0.5f);
+    }
+    
+    __atomic_store_n(&history->spectro_head, head + 1, __ATOMIC_RELEASE);
+}
+
+AudioWaveView audio_history_wave_view(const AudioHistory* history, int max_length) {
+    AudioWaveView view;
+    view.samples = history->wave;
+    view.head = __atomic_load_n(&history->wave_head, __ATOMIC_ACQUIRE);
+    
+    int available = view.head < AUDIO_WAVE_HISTORY - AUDIO_WAVE_GUARD ?
+                    (int)view.head : AUDIO_WAVE_HISTORY - AUDIO_WAVE_GUARD;
+    view.length = max_length < available ? max_length : available;
+    return view;
+}
+
+AudioSpectroView audio_history_spectro_view(const AudioHistory* history, int max_rows) {
+    AudioSpectroView view;
+    view.rows = (const uint8_t (*)[AUDIO_SPECTRO_BINS])history->spectro;
+    view.head = __atomic_load_n(&history->spectro_head, __ATOMIC_ACQUIRE);
+    
+    int available = view.head < AUDIO_SPECTRO_ROWS - AUDIO_SPECTRO_GUARD ?
+                    (int)view.head : AUDIO_SPECTRO_ROWS - AUDIO_SPECTRO_GUARD;
+    view.length = max_rows < available ? max_rows : available;
+    return view;
+}
+
+// ============= SOURCE REGISTRY =============
+
+static int compare_sources(const void* a, const void* b) {
+    return strcmp(((const AudioSource*)a)->name, ((const AudioSource*)b)->name);
+}
+
+static bool name_is_monitor(const char* name) {
+    return strstr(name, "Monitor") != NULL || strstr(name, "monitor") != NULL;
+}
+
+#ifdef USE_PIPEWIRE
+
+// Mirror of the PipeWire graph, maintained from registry events on the
+// PipeWire loop thread and read by the UI thread under registry_mutex.
+#define REGISTRY_MAX_NODES 128
+#define REGISTRY_MAX_PORTS 512
+
+typedef struct {
+    uint32_t id;
+    char name[128];
+} RegistryNode;
+
+typedef struct {
+    uint32_t id;
+    uint32_t node_id;
+    bool is_output;
+    char name[96];
+    char channel[8];
+} RegistryPort;
+
+typedef struct {
+    uint32_t id;
+    uint32_t output_port;
+    uint32_t input_port;
+} RegistryLink;
+
+static struct pw_registry *pw_registry = NULL;
+static struct spa_hook registry_listener;
+static pthread_mutex_t registry_mutex = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t own_node_id = SPA_ID_INVALID;
+
+static RegistryNode reg_nodes[REGISTRY_MAX_NODES];
+static int reg_node_count = 0;
+static RegistryPort reg_ports[REGISTRY_MAX_PORTS];
+static int reg_port_count = 0;
+static RegistryLink reg_links[AUDIO_MAX_LINKS];
+static int reg_link_count = 0;
+
+// Links we created; destroyed with the registry
+static struct pw_proxy *link_proxies[AUDIO_MAX_LINKS];
+static int link_proxy_count = 0;
+
+static uint32_t dict_get_id(const struct spa_dict *props, const char *key) {
+    const char *value = spa_dict_lookup(props, key);
+    return value ? (uint32_t)strtoul(value, NULL, 10) : SPA_ID_INVALID;
+}
+
+static void registry_event_global(void *data, uint32_t id, uint32_t permissions,
+                                  const char *type, uint32_t version,
+                                  const struct spa_dict *props) {
+    (void)data;
+    (void)permissions;
+    (void)version;
+    
+    if (!props) return;
+    
+    pthread_mutex_lock(&registry_mutex);
+    
+    if (strcmp(type, PW_TYPE_INTERFACE_Node) == 0 && reg_node_count < REGISTRY_MAX_NODES) {
+        const char *name = spa_dict_lookup(props, PW_KEY_NODE_NAME);
+        RegistryNode *node = &reg_nodes[reg_node_count++];
+        node->id = id;
+        snprintf(node->name, sizeof(node->name), "%s", name ? name : "unknown");
+    } else if (strcmp(type, PW_TYPE_INTERFACE_Port) == 0 && reg_port_count < REGISTRY_MAX_PORTS) {
+        const char *name = spa_dict_lookup(props, PW_KEY_PORT_NAME);
+        const char *direction = spa_dict_lookup(props, PW_KEY_PORT_DIRECTION);
+        const char *channel = spa_dict_lookup(props, PW_KEY_AUDIO_CHANNEL);
+        RegistryPort *port = &reg_ports[reg_port_count++];
+        port->id = id;
+        port->node_id = dict_get_id(props, PW_KEY_NODE_ID);
+        port->is_output = direction && strcmp(direction, "out") == 0;
+        snprintf(port->name, sizeof(port->name), "%s", name ? name : "");
+        snprintf(port->channel, sizeof(port->channel), "%s", channel ? channel : "");
+    } else if (strcmp(type, PW_TYPE_INTERFACE_Link) == 0 && reg_link_count < AUDIO_MAX_LINKS) {
+        RegistryLink *link = &reg_links[reg_link_count++];
+        link->id = id;
+        link->output_port = dict_get_id(props, PW_KEY_LINK_OUTPUT_PORT);
+        link->input_port = dict_get_id(props, PW_KEY_LINK_INPUT_PORT);
+    }
+    
+    pthread_mutex_unlock(&registry_mutex);
+}
+
+static void registry_event_global_remove(void *data, uint32_t id) {
+    (void)data;
+    
+    pthread_mutex_lock(&registry_mutex);
+    
+    // Ids are unique across object types, so swap-remove wherever it lives
+    for (int i = 0; i < reg_node_count; i++) {
+        if (reg_nodes[i].id == id) {
+            reg_nodes[i] = reg_nodes[--reg_node_count];
+            break;
+        }
+    }
+    for (int i = 0; i < reg_port_count; i++) {
+        if (reg_ports[i].id == id) {
+            reg_ports[i] = reg_ports[--reg_port_count];
+            break;
+        }
+    }
+    for (int i = 0; i < reg_link_count; i++) {
+        if (reg_links[i].id == id) {
+            reg_links[i] = reg_links[--reg_link_count];
+            break;
+        }
+    }
+    
+    pthread_mutex_unlock(&registry_mutex);
+}
+
+static const struct pw_registry_events registry_events = {
+    PW_VERSION_REGISTRY_EVENTS,
+    .global = registry_event_global,
+    .global_remove = registry_event_global_remove,
+};
+
+static void registry_start(const char* app_name) {
+    (void)app_name;
+    
+    struct pw_core *core = pw_stream_get_core(streams[0].pw);
+    if (!core) return;
+    
+    pw_registry = pw_core_get_registry(core, PW_VERSION_REGISTRY, 0);
+    if (pw_registry) {
+        spa_zero(registry_listener);
+        pw_registry_add_listener(pw_registry, &registry_listener, &registry_events, NULL);
+    }
+}
+
+// Called with the loop stopped
+static void registry_stop(void) {
+    for (int i = 0; i < link_proxy_count; i++) {
+        pw_proxy_destroy(link_proxies[i]);
+    }
+    link_proxy_count = 0;
+    
+    if (pw_registry) {
+        spa_hook_remove(&registry_listener);
+        pw_proxy_destroy((struct pw_proxy*)pw_registry);
+        pw_registry = NULL;
+    }
+    
+    pthread_mutex_lock(&registry_mutex);
+    reg_node_count = reg_port_count = reg_link_count = 0;
+    own_node_id = SPA_ID_INVALID;
+    pthread_mutex_unlock(&registry_mutex);
+}
+
+static void registry_set_own_node(uint32_t node_id) {
+    pthread_mutex_lock(&registry_mutex);
+    own_node_id = node_id;
+    pthread_mutex_unlock(&registry_mutex);
+}
+
+// Lookups below expect registry_mutex to be held
+static const RegistryNode* registry_find_node(uint32_t id) {
+    for (int i = 0; i < reg_node_count; i++) {
+        if (reg_nodes[i].id == id) return &reg_nodes[i];
+    }
+    return NULL;
+}
+
+static const RegistryPort* registry_find_port(uint32_t id) {
+    for (int i = 0; i < reg_port_count; i++) {
+        if (reg_ports[i].id == id) return &reg_ports[i];
+    }
+    return NULL;
+}
+
+static bool port_is_channel(const RegistryPort *port, const char *channel) {
+    if (strcmp(port->channel, channel) == 0) return true;
+    
+    size_t len = strlen(port->name);
+    return len > 3 && port->name[len - 3] == '_' && strcmp(port->name + len - 2, channel) == 0;
+}
+
+static bool link_is_ours(const RegistryLink *link) {
+    const RegistryPort *port = registry_find_port(link->input_port);
+    return port && own_node_id != SPA_ID_INVALID && port->node_id == own_node_id;
+}
+
+int audio_get_sources(AudioSource* sources, int max_sources) {
+    if (!pw_initialized) return 0;
+    
+    int count = 0;
+    pthread_mutex_lock(&registry_mutex);
+    
+    for (int i = 0; i < reg_port_count && count < max_sources; i++) {
+        const RegistryPort *fl = &reg_ports[i];
+        if (!fl->is_output || fl->node_id == own_node_id || !port_is_channel(fl, "FL")) continue;
+        
+        const RegistryNode *node = registry_find_node(fl->node_id);
+        if (!node) continue;
+        
+        // The matching right channel lives on the same node
+        const RegistryPort *fr = NULL;
+        for (int j = 0; j < reg_port_count; j++) {
+            if (reg_ports[j].node_id == fl->node_id && reg_ports[j].is_output &&
+                port_is_channel(&reg_ports[j], "FR")) {
+                fr = &reg_ports[j];
+                break;
+            }
+        }
+        if (!fr) continue;
+        
+        // Base name without the channel suffix, as pw-link would print it
+        char base[160];
+        snprintf(base, sizeof(base), "%s:%s", node->name, fl->name);
+        size_t len = strlen(base);
+        if (len > 3 && strcmp(base + len - 3, "_FL") == 0) base[len - 3] = '\0';
+        
+        AudioSource *source = &sources[count++];
+        snprintf(source->name, sizeof(source->name), "%s", base);
+        snprintf(source->port_fl, sizeof(source->port_fl), "%s:%s", node->name, fl->name);
+        snprintf(source->port_fr, sizeof(source->port_fr), "%s:%s", node->name, fr->name);
+        source->is_monitor = name_is_monitor(source->name);
+        source->port_fl_id = fl->id;
+        source->port_fr_id = fr->id;
+    }
+    
+    pthread_mutex_unlock(&registry_mutex);
+    
+    qsort(sources, count, sizeof(AudioSource), compare_sources);
+    return count;
+}
+
+// Called with the thread loop locked
+static bool create_link(uint32_t output_port, uint32_t input_port) {
+    if (link_proxy_count >= AUDIO_MAX_LINKS) return false;
+    
+    struct pw_properties *props = pw_properties_new(NULL, NULL);
+    if (!props) return false;
+    pw_properties_setf(props, PW_KEY_LINK_OUTPUT_PORT, "%u", output_port);
+    pw_properties_setf(props, PW_KEY_LINK_INPUT_PORT, "%u", input_port);
+    pw_properties_set(props, PW_KEY_OBJECT_LINGER, "true");
+    
+    struct pw_proxy *proxy = pw_core_create_object(pw_stream_get_core(streams[0].pw),
+                                                   "link-factory",
+                                                   PW_TYPE_INTERFACE_Link,
+                                                   PW_VERSION_LINK,
+                                                   &props->dict, 0);
+    pw_properties_free(props);
+    
+    if (!proxy) return false;
+    link_proxies[link_proxy_count++] = proxy;
+    return true;
+}
+
+bool audio_connect_to_source(const AudioSource* source) {
+    if (!pw_initialized || !source) return false;
+    
+    // Find our own input ports
+    uint32_t input_fl = SPA_ID_INVALID, input_fr = SPA_ID_INVALID;
+    pthread_mutex_lock(&registry_mutex);
+    for (int i = 0; i < reg_port_count; i++) {
+        const RegistryPort *port = &reg_ports[i];
+        if (port->node_id != own_node_id || port->is_output) continue;
+        if (port_is_channel(port, "FL")) input_fl = port->id;
+        else if (port_is_channel(port, "FR")) input_fr = port->id;
+    }
+    pthread_mutex_unlock(&registry_mutex);
+    
+    if (input_fl == SPA_ID_INVALID || input_fr == SPA_ID_INVALID ||
+        source->port_fl_id == 0 || source->port_fr_id == 0) {
+        return false;
+    }
+    
+    // Only queues the requests; the graph reports the new links as globals
+    pw_thread_loop_lock(pw_loop);
+    bool success = create_link(source->port_fl_id, input_fl);
+    success &= create_link(source->port_fr_id, input_fr);
+    pw_thread_loop_unlock(pw_loop);
+    
+    return success;
+}
+
+bool audio_disconnect_all(void) {
+    if (!pw_initialized) return true;
+    
+    uint32_t ids[AUDIO_MAX_LINKS];
+    int count = 0;
+    
+    pthread_mutex_lock(&registry_mutex);
+    for (int i = 0; i < reg_link_count; i++) {
+        if (link_is_ours(&reg_links[i])) {
+            ids[count++] = reg_links[i].id;
+        }
+    }
+    pthread_mutex_unlock(&registry_mutex);
+    
+    pw_thread_loop_lock(pw_loop);
+    for (int i = 0; i < count; i++) {
+        pw_registry_destroy(pw_registry, ids[i]);
+    }
+    for (int i = 0; i < link_proxy_count; i++) {
+        pw_proxy_destroy(link_proxies[i]);
+    }
+    link_proxy_count = 0;
+    pw_thread_loop_unlock(pw_loop);
+    
+    return true;
+}
+
+int audio_count_connections(void) {
+    if (!pw_initialized) return 0;
+    
+    int count = 0;
+    pthread_mutex_lock(&registry_mutex);
+    for (int i = 0; i < reg_link_count; i++) {
+        if (link_is_ours(&reg_links[i])) count++;
+    }
+    pthread_mutex_unlock(&registry_mutex);
+    
+    return count;
+}
+
+bool audio_get_connection_info(char* info, size_t info_size) {
+    if (!info || info_size == 0) return false;
+    
+    bool found = false;
+    if (pw_initialized) {
+        pthread_mutex_lock(&registry_mutex);
+        for (int i = 0; i < reg_link_count && !found; i++) {
+            if (!link_is_ours(&reg_links[i])) continue;
+            
+            const RegistryPort *port = registry_find_port(reg_links[i].output_port);
+            const RegistryNode *node = port ? registry_find_node(port->node_id) : NULL;
+            if (node) {
+                snprintf(info, info_size, "Connected to: %s", node->name);
+                found = true;
+            }
+        }
+        pthread_mutex_unlock(&registry_mutex);
+    }
+    
+    if (!found) {
+        snprintf(info, info_size, "No audio connections");
+    }
+    return found;
+}
+
+#else // !USE_PIPEWIRE
+
+// Without the PipeWire API, a background thread polls pw-link and applies
+// queued connection changes, so callers only ever touch the cache. The
+// thread only starts if pw-link answers once at startup, and polls less
+// often while it keeps failing.
+#define REGISTRY_POLL_INTERVAL 1   // Seconds between pw-link polls
+#define REGISTRY_POLL_MAX_INTERVAL 32  // Longest wait while pw-link fails
+#define REGISTRY_MAX_REQUESTS 8
+
+typedef enum {
+    REGISTRY_CONNECT,
+    REGISTRY_DISCONNECT_ALL
+} RegistryRequestType;
+
+typedef struct {
+    RegistryRequestType type;
+    AudioSource source;
+} RegistryRequest;
+
+typedef struct {
+    char source_port[256];
+    char input_port[256];
+} RegistryLink;
+
+static pthread_t registry_thread;
+static bool registry_running = false;
+static pthread_mutex_t registry_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t registry_cond = PTHREAD_COND_INITIALIZER;
+static char registry_input_prefix[64] = "CLIFT:input";
+
+static AudioSource cached_sources[AUDIO_MAX_SOURCES];
+static int cached_source_count = 0;
+static RegistryLink cached_links[AUDIO_MAX_LINKS];
+static int cached_link_count = 0;
+
+static RegistryRequest pending_requests[REGISTRY_MAX_REQUESTS];
+static int pending_count = 0;
+
+// Runs on the registry thread, or once at startup. The shell redirects the
+// child's stderr; our own stdout/stderr belong to ncurses and must not be
+// touched from here.
+static bool run_command(const char* cmd, char* output, size_t output_size) {
+    char safe_cmd[1100];
+    snprintf(safe_cmd, sizeof(safe_cmd), "%s 2>/dev/null", cmd);
+    
+    FILE *fp = popen(safe_cmd, "r");
+    if (!fp) return false;
+    
+    size_t len = 0;
+    if (output && output_size > 0) {
+        output[0] = '\0';
+        char line[256];
+        while (fgets(line, sizeof(line), fp) != NULL) {
+            size_t line_len = strlen(line);
+            if (len + line_len < output_size - 1) {
+                memcpy(output + len, line, line_len + 1);
+                len += line_len;
+            }
+        }
+    } else {
+        char discard[256];
+        while (fgets(discard, sizeof(discard), fp) != NULL) {}
+    }
+    
+    return pclose(fp) == 0;
+}
+
+// Returns false if pw-link could not list the ports
+static bool registry_refresh(void) {
+    static char output[16384];
+    AudioSource sources[AUDIO_MAX_SOURCES];
+    RegistryLink links[AUDIO_MAX_LINKS];
+    int source_count = 0, link_count = 0;
+    
+    // Output ports: one "node:port" per line
+    bool listed = run_command("pw-link -o", output, sizeof(output));
+    if (listed) {
+        for (char *line = strtok(output, "\n"); line && source_count < AUDIO_MAX_SOURCES; line = strtok(NULL, "\n")) {
+            size_t len = strlen(line);
+            if (len < 4 || strcmp(line + len - 3, "_FL") != 0) continue;
+            
+            AudioSource *source = &sources[source_count++];
+            memset(source, 0, sizeof(*source));
+            snprintf(source->name, sizeof(source->name), "%.*s", (int)(len - 3), line);
+            snprintf(source->port_fl, sizeof(source->port_fl), "%s", line);
+            snprintf(source->port_fr, sizeof(source->port_fr), "%.*s_FR", (int)(len - 3), line);
+            source->is_monitor = name_is_monitor(source->name);
+        }
+    }
+    qsort(sources, source_count, sizeof(AudioSource), compare_sources);
+    
+    // Links: a port line followed by indented "|-> target" lines
+    if (run_command("pw-link -l", output, sizeof(output))) {
+        char current[256] = "";
+        for (char *line = strtok(output, "\n"); line && link_count < AUDIO_MAX_LINKS; line = strtok(NULL, "\n")) {
+            if (line[0] != ' ' && line[0] != '\t') {
+                snprintf(current, sizeof(current), "%s", line);
+                continue;
+            }
+            
+            char *arrow = strstr(line, "|->");
+            if (!arrow) continue;
+            
+            char *target = arrow + 3;
+            while (*target == ' ') target++;
+            if (strncmp(target, registry_input_prefix, strlen(registry_input_prefix)) == 0) {
+                snprintf(links[link_count].source_port, sizeof(links[link_count].source_port), "%s", current);
+                snprintf(links[link_count].input_port, sizeof(links[link_count].input_port), "%s", target);
+                link_count++;
+            }
+        }
+    }
+    
+    pthread_mutex_lock(&registry_mutex);
+    memcpy(cached_sources, sources, source_count * sizeof(AudioSource));
+    cached_source_count = source_count;
+    memcpy(cached_links, links, link_count * sizeof(RegistryLink));
+    cached_link_count = link_count;
+    pthread_mutex_unlock(&registry_mutex);
+    return listed;
+}
+
+static void registry_apply(const RegistryRequest* request) {
+    char cmd[1024];
+    
+    if (request->type == REGISTRY_CONNECT) {
+        snprintf(cmd, sizeof(cmd), "pw-link \"%s\" \"%s_FL\"", request->source.port_fl, registry_input_prefix);
+        run_command(cmd, NULL, 0);
+        snprintf(cmd, sizeof(cmd), "pw-link \"%s\" \"%s_FR\"", request->source.port_fr, registry_input_prefix);
+        run_command(cmd, NULL, 0);
+    } else {
+        pthread_mutex_lock(&registry_mutex);
+        RegistryLink links[AUDIO_MAX_LINKS];
+        int count = cached_link_count;
+        memcpy(links, cached_links, count * sizeof(RegistryLink));
+        pthread_mutex_unlock(&registry_mutex);
+        
+        for (int i = 0; i < count; i++) {
+            snprintf(cmd, sizeof(cmd), "pw-link -d \"%.255s\" \"%.255s\"", links[i].source_port, links[i].input_port);
+            run_command(cmd, NULL, 0);
+        }
+    }
+}
+
+static void* registry_thread_main(void* arg) {
+    (void)arg;
+    
+    int interval = REGISTRY_POLL_INTERVAL;
+    pthread_mutex_lock(&registry_mutex);
+    while (registry_running) {
+        // Drain queued changes, then refresh the cache so the UI sees them
+        while (pending_count > 0) {
+            RegistryRequest request = pending_requests[0];
+            memmove(pending_requests, pending_requests + 1, (pending_count - 1) * sizeof(RegistryRequest));
+            pending_count--;
+            
+            pthread_mutex_unlock(&registry_mutex);
+            registry_apply(&request);
+            registry_refresh();
+            pthread_mutex_lock(&registry_mutex);
+        }
+        
+        pthread_mutex_unlock(&registry_mutex);
+        if (registry_refresh()) {
+            interval = REGISTRY_POLL_INTERVAL;
+        } else if (interval < REGISTRY_POLL_MAX_INTERVAL) {
+            interval *= 2;
+        }
+        pthread_mutex_lock(&registry_mutex);
+        
+        if (!registry_running || pending_count > 0) continue;
+        
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += interval;
+        pthread_cond_timedwait(&registry_cond, &registry_mutex, &deadline);
+    }
+    pthread_mutex_unlock(&registry_mutex);
+    
+    return NULL;
+}
+
+static void registry_start(const char* app_name) {
+    if (registry_running) return;
+    
+    snprintf(registry_input_prefix, sizeof(registry_input_prefix), "%s:input", app_name ? app_name : "CLIFT");
+    cached_source_count = 0;
+    cached_link_count = 0;
+    pending_count = 0;
+    
+    // Without pw-link there is nothing to poll
+    if (!run_command("pw-link -o", NULL, 0)) return;
+    
+    registry_running = true;
+    if (pthread_create(&registry_thread, NULL, registry_thread_main, NULL) != 0) {
+        registry_running = false;
+    }
+}
+
+static void registry_stop(void) {
+    pthread_mutex_lock(&registry_mutex);
+    bool was_running = registry_running;
+    registry_running = false;
+    pthread_cond_signal(&registry_cond);
+    pthread_mutex_unlock(&registry_mutex);
+    
+    if (was_running) {
+        pthread_join(registry_thread, NULL);
+    }
+}
+
+static bool registry_post(RegistryRequestType type, const AudioSource* source) {
+    bool queued = false;
+    
+    pthread_mutex_lock(&registry_mutex);
+    if (registry_running && pending_count < REGISTRY_MAX_REQUESTS) {
+        RegistryRequest *request = &pending_requests[pending_count++];
+        request->type = type;
+        if (source) request->source = *source;
+        pthread_cond_signal(&registry_cond);
+        queued = true;
+    }
+    pthread_mutex_unlock(&registry_mutex);
+    
+    return queued;
+}
+
+int audio_get_sources(AudioSource* sources, int max_sources) {
+    pthread_mutex_lock(&registry_mutex);
+    int count = cached_source_count < max_sources ? cached_source_count : max_sources;
+    memcpy(sources, cached_sources, count * sizeof(AudioSource));
+    pthread_mutex_unlock(&registry_mutex);
+    return count;
+}
+
+bool audio_connect_to_source(const AudioSource* source) {
+    if (!source) return false;
+    return registry_post(REGISTRY_CONNECT, source);
+}
+
+bool audio_disconnect_all(void) {
+    return registry_post(REGISTRY_DISCONNECT_ALL, NULL);
+}
+
+int audio_count_connections(void) {
+    pthread_mutex_lock(&registry_mutex);
+    int count = cached_link_count;
+    pthread_mutex_unlock(&registry_mutex);
+    return count;
+}
+
+bool audio_get_connection_info(char* info, size_t info_size) {
+    if (!info || info_size == 0) return false;
+    
+    bool found = false;
+    pthread_mutex_lock(&registry_mutex);
+    if (cached_link_count > 0) {
+        // Strip the port to get the node name
+        char source[256];
+        snprintf(source, sizeof(source), "%s", cached_links[0].source_port);
+        char *colon = strrchr(source, ':');
+        if (colon) *colon = '\0';
+        snprintf(info, info_size, "Connected to: %s", source);
+        found = true;
+    }
+    pthread_mutex_unlock(&registry_mutex);
+    
+    if (!found) {
+        snprintf(info, info_size, "No audio connections");
+    }
+    return found;
+}
+
+#endif // USE_PIPEWIRE
+
+// Connect to the first monitor source (system output loopback)
+bool audio_connect_to_monitor(void) {
+    AudioSource sources[AUDIO_MAX_SOURCES];
+    int count = audio_get_sources(sources, AUDIO_MAX_SOURCES);
+    
+    for (int i = 0; i < count; i++) {
+        if (sources[i].is_monitor) {
+            return audio_connect_to_source(&sources[i]);
+        }
+    }
+    
+    return false;
+}
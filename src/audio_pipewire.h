@@ -2,30 +2,128 @@
 #define AUDIO_PIPEWIRE_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <pthread.h>
 
 // Audio configuration
 #define AUDIO_SAMPLE_RATE 48000
 #define AUDIO_CHANNELS 2
 #define AUDIO_BUFFER_SIZE 1024
+#define AUDIO_MAX_STREAMS 4         // Main input plus up to three stems/buses
+#define AUDIO_FFT_SIZE 512          // Samples per spectrum (power of two)
 
-// Initialize PipeWire audio capture
+// Analysis history configuration
+#define AUDIO_WAVE_DECIMATION 8     // 48 kHz capture -> 6 kHz waveform history
+#define AUDIO_WAVE_HISTORY 4096     // Decimated mono samples kept (~0.7 s, power of two)
+#define AUDIO_SPECTRO_BINS 64       // Matches AudioData.spectrum
+#define AUDIO_SPECTRO_ROWS 256      // ~4 s of spectrogram at the ~60 Hz analysis rate (power of two)
+
+// History rings written by the analysis thread. Heads count entries ever
+// written and are published after the data, so readers can take a view
+// without locking or copying.
+typedef struct {
+    float wave[AUDIO_WAVE_HISTORY];
+    uint32_t wave_head;
+    uint8_t spectro[AUDIO_SPECTRO_ROWS][AUDIO_SPECTRO_BINS];  // Quantized 0-255
+    uint32_t spectro_head;
+    float decim_acc;                // Decimator state (analysis thread only)
+    int decim_count;
+} AudioHistory;
+
+// Read-only views over the rings. Age 0 is the newest entry.
+typedef struct {
+    const float* samples;
+    uint32_t head;
+    int length;
+} AudioWaveView;
+
+typedef struct {
+    const uint8_t (*rows)[AUDIO_SPECTRO_BINS];
+    uint32_t head;
+    int length;
+} AudioSpectroView;
+
+// Source registry limits
+#define AUDIO_MAX_SOURCES 64
+#define AUDIO_MAX_LINKS 64
+
+// A stereo output that can be linked to CLIFT's input ports
+typedef struct {
+    char name[256];
+    char port_fl[256];
+    char port_fr[256];
+    bool is_monitor;
+    uint32_t port_fl_id;    // PipeWire global ids (0 when only names are known)
+    uint32_t port_fr_id;
+} AudioSource;
+
+// Beat detector state; one per analysed stream
+typedef struct {
+    float volume_history[8];
+    int history_index;
+} AudioBeatDetector;
+
+// Initialize PipeWire audio capture (opens stream 0, the main input)
 bool audio_pipewire_init(const char* app_name);
 
 // Cleanup PipeWire
 void audio_pipewire_cleanup(void);
 
-// Get current audio buffer (returns number of frames available)
+// Open an extra capture stream after audio_pipewire_init, shown in PipeWire
+// as "<app>-<name>". Returns the stream index, or -1 when all are in use.
+int audio_pipewire_open_stream(const char* name);
+
+// Number of open streams (at least 1 after init)
+int audio_pipewire_stream_count(void);
+
+// Get current audio buffer of stream 0 (returns number of frames available)
 int audio_pipewire_get_buffer(float* buffer, int max_frames);
 
-// Simple FFT for spectrum analysis
+// Same for any stream. Each stream has its own ring, so streams can be
+// drained from different threads.
+int audio_pipewire_get_stream_buffer(int stream, float* buffer, int max_frames);
+
+// Radix-2 FFT of the first AUDIO_FFT_SIZE frames (left channel) into
+// spectrum_size linearly spaced, log-scaled bins. Thread safe.
 void audio_compute_spectrum(const float* audio_buffer, int frames, float* spectrum, int spectrum_size);
 
 // Compute audio levels (bass, mid, treble, volume)
 void audio_compute_levels(const float* spectrum, int spectrum_size, 
                          float* bass, float* mid, float* treble, float* volume);
 
-// Simple beat detection
+// Beat detection with caller-owned state
+void audio_beat_detector_reset(AudioBeatDetector* detector);
+bool audio_beat_detector_process(AudioBeatDetector* detector, float current_volume, float* beat_intensity);
+
+// Simple beat detection (single shared detector)
 bool audio_detect_beat(float current_volume, float* beat_intensity);
 
+// Source registry. The cache is fed asynchronously (PipeWire registry
+// events, or a background pw-link poller without PipeWire) so these never
+// block the caller; connection changes are applied in the background.
+int audio_get_sources(AudioSource* sources, int max_sources);
+bool audio_connect_to_source(const AudioSource* source);
+bool audio_connect_to_monitor(void);
+bool audio_disconnect_all(void);
+int audio_count_connections(void);
+bool audio_get_connection_info(char* info, size_t info_size);
+
+// Analysis history rings (writer side)
+void audio_history_reset(AudioHistory* history);
+void audio_history_push_waveform(AudioHistory* history, const float* audio_buffer, int frames);
+void audio_history_push_spectrum(AudioHistory* history, const float* spectrum, int spectrum_size);
+
+// Analysis history rings (reader side, zero-copy)
+AudioWaveView audio_history_wave_view(const AudioHistory* history, int max_length);
+AudioSpectroView audio_history_spectro_view(const AudioHistory* history, int max_rows);
+
+static inline float audio_wave_sample(const AudioWaveView* view, int age) {
+    return view->samples[(view->head - 1u - (uint32_t)age) & (AUDIO_WAVE_HISTORY - 1)];
+}
+
+static inline const uint8_t* audio_spectro_row(const AudioSpectroView* view, int age) {
+    return view->rows[(view->head - 1u - (uint32_t)age) & (AUDIO_SPECTRO_ROWS - 1)];
+}
+
 #endif // AUDIO_PIPEWIRE_H
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include "automaton.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Rows per pool task
+#define AUTOMATON_BAND_ROWS 16
+
+typedef struct {
+    Automaton* automaton;
+    int counts[9];          // Neighbour counts with any effect
+    int count;
+    uint16_t birth, survive;
+} AutomatonJob;
+
+bool automaton_parse_rule(const char* text, AutomatonRule* rule) {
+    AutomatonRule parsed = { 0, 0 };
+    uint16_t* target = NULL;
+
+    for (const char* c = text; *c; c++) {
+        if (*c == 'B' || *c == 'b') {
+            target = &parsed.birth;
+        } else if (*c == 'S' || *c == 's') {
+            target = &parsed.survive;
+        } else if (*c >= '0' && *c <= '8' && target) {
+            *target |= 1u << (*c - '0');
+        } else if (*c != '/') {
+            return false;
+        }
+    }
+    if (!target) return false;
+    *rule = parsed;
+    return true;
+}
+
+bool automaton_resize(Automaton* automaton, int width, int height) {
+    if (width < 1) width = 1;
+    if (height < 1) height = 1;
+    if (width == automaton->width && height == automaton->height) return true;
+
+    int words = (width + 63) / 64;
+    int needed = words * height;
+    if (needed > automaton->capacity) {
+        uint64_t* cells = realloc(automaton->cells, sizeof(uint64_t) * needed);
+        if (!cells) return false;
+        automaton->cells = cells;
+        uint64_t* next = realloc(automaton->next, sizeof(uint64_t) * needed);
+        if (!next) return false;
+        automaton->next = next;
+        automaton->capacity = needed;
+    }
+    memset(automaton->cells, 0, sizeof(uint64_t) * needed);
+    automaton->width = width;
+    automaton->height = height;
+    automaton->words = words;
+    return true;
+}
+
+static uint64_t automaton_random(Automaton* automaton) {
+    // xorshift64*
+    if (automaton->rng == 0) automaton->rng = 0x9E3779B97F4A7C15ull;
+    automaton->rng ^= automaton->rng >> 12;
+    automaton->rng ^= automaton->rng << 25;
+    automaton->rng ^= automaton->rng >> 27;
+    return automaton->rng * 0x2545F4914F6CDD1Dull;
+}
+
+// Bits of the last word that hold cells
+static inline uint64_t last_word_mask(const Automaton* automaton) {
+    int used = automaton->width - (automaton->words - 1) * 64;
+    return used == 64 ? ~0ull : (1ull << used) - 1;
+}
+
+void automaton_randomize(Automaton* automaton, float density) {
+    // Each fair random word ANDed or ORed in, from the lowest bit of the
+    // density up, halves the bits' distance to 0 or 1
+    int level = (int)(density * 256.0f + 0.5f);
+    if (level < 0) level = 0;
+    if (level > 256) level = 256;
+
+    for (int y = 0; y < automaton->height; y++) {
+        uint64_t* row = automaton->cells + y * automaton->words;
+        for (int i = 0; i < automaton->words; i++) {
+            uint64_t bits = 0;
+            if (level == 256) {
+                bits = ~0ull;
+            } else {
+                for (int b = 0; b < 8; b++) {
+                    bits = (level >> b) & 1 ? bits | automaton_random(automaton) : bits & automaton_random(automaton);
+                }
+            }
+            row[i] = bits;
+        }
+        row[automaton->words - 1] &= last_word_mask(automaton);
+    }
+}
+
+// Each cell's west and east neighbours, moved into the cell's own bit,
+// wrapping around the row
+static inline void neighbour_words(const uint64_t* row, int i, int words, int used, uint64_t* west, uint64_t* east) {
+    uint64_t word = row[i];
+    uint64_t before = i > 0 ? row[i - 1] >> 63 : (row[words - 1] >> (used - 1)) & 1;
+    uint64_t after = i < words - 1 ? row[i + 1] << 63 : (row[0] & 1) << (used - 1);
+    *west = (word << 1) | before;
+    *east = (word >> 1) | after;
+}
+
+static void automaton_band(void* ctx, int band) {
+    const AutomatonJob* job = ctx;
+    const Automaton* automaton = job->automaton;
+    int words = automaton->words, height = automaton->height;
+    int used = automaton->width - (words - 1) * 64;
+    uint64_t last_mask = last_word_mask(automaton);
+
+    int end = (band + 1) * AUTOMATON_BAND_ROWS;
+    if (end > height) end = height;
+    for (int y = band * AUTOMATON_BAND_ROWS; y < end; y++) {
+        const uint64_t* up = automaton->cells + ((y + height - 1) % height) * words;
+        const uint64_t* row = automaton->cells + y * words;
+        const uint64_t* down = automaton->cells + ((y + 1) % height) * words;
+        uint64_t* out = automaton->next + y * words;
+
+        for (int i = 0; i < words; i++) {
+            uint64_t a, c, d, e, f, h;
+            neighbour_words(up, i, words, used, &a, &c);
+            neighbour_words(row, i, words, used, &d, &e);
+            neighbour_words(down, i, words, used, &f, &h);
+            uint64_t b = up[i], g = down[i];
+
+            // Eight one-bit inputs summed into the count bits s0..s3:
+            // full adders over (a b c) and (d e f), a half adder over (g h)
+            uint64_t abc = a ^ b ^ c, abc_carry = (a & b) | (c & (a ^ b));
+            uint64_t def = d ^ e ^ f, def_carry = (d & e) | (f & (d ^ e));
+            uint64_t gh = g ^ h, gh_carry = g & h;
+            uint64_t s0 = abc ^ def ^ gh;
+            uint64_t ones_carry = (abc & def) | (gh & (abc ^ def));
+            // Four twos: abc_carry, def_carry, gh_carry, ones_carry
+            uint64_t twos = abc_carry ^ def_carry ^ gh_carry;
+            uint64_t twos_carry = (abc_carry & def_carry) | (gh_carry & (abc_carry ^ def_carry));
+            uint64_t s1 = twos ^ ones_carry;
+            uint64_t fours = twos & ones_carry;
+            uint64_t s2 = twos_carry ^ fours;
+            uint64_t s3 = twos_carry & fours;
+
+            uint64_t born = 0, kept = 0;
+            for (int k = 0; k < job->count; k++) {
+                int n = job->counts[k];
+                uint64_t match = (n & 1 ? s0 : ~s0) & (n & 2 ? s1 : ~s1) & (n & 4 ? s2 : ~s2) & (n & 8 ? s3 : ~s3);
+                if (job->birth & (1u << n)) born |= match;
+                if (job->survive & (1u << n)) kept |= match;
+            }
+            uint64_t self = row[i];
+            out[i] = (born & ~self) | (kept & self);
+        }
+        out[words - 1] &= last_mask;
+    }
+}
+
+void automaton_step(Automaton* automaton, const AutomatonRule* rule, int generations, ThreadPool* pool) {
+    if (!automaton->cells) return;
+    AutomatonJob job = { automaton, { 0 }, 0, rule->birth, rule->survive };
+    for (int n = 0; n <= 8; n++) {
+        if ((rule->birth | rule->survive) & (1u << n)) job.counts[job.count++] = n;
+    }
+
+    int bands = (automaton->height + AUTOMATON_BAND_ROWS - 1) / AUTOMATON_BAND_ROWS;
+    for (int g = 0; g < generations; g++) {
+        thread_pool_run(pool, bands, automaton_band, &job);
+        uint64_t* swap = automaton->cells;
+        automaton->cells = automaton->next;
+        automaton->next = swap;
+    }
+}
+
+int automaton_population(const Automaton* automaton) {
+    int count = 0;
+    for (int i = 0; i < automaton->words * automaton->height; i++) {
+        count += __builtin_popcountll(automaton->cells[i]);
+    }
+    return count;
+}
+
+void automaton_free(Automaton* automaton) {
+    free(automaton->cells);
+    free(automaton->next);
+    memset(automaton, 0, sizeof(*automaton));
+}
@@ -0,0 +1,54 @@
+#ifndef AUTOMATON_H
+#define AUTOMATON_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "thread_pool.h"
+
+// Life-like cellular automata on a toroidal grid packed 64 cells to a
+// word. A generation counts the eight neighbours of 64 cells at once with
+// bitwise full adders, so even grids far finer than the deck step in a
+// fraction of a millisecond.
+
+// Outer-totalistic rule: bit n of 'birth' makes a dead cell with n live
+// neighbours come alive, bit n of 'survive' keeps a live one alive
+typedef struct {
+    uint16_t birth;
+    uint16_t survive;
+} AutomatonRule;
+
+typedef struct {
+    int width, height;
+    int words;              // Words per row
+    uint64_t* cells;        // Row y, cell x is bit x % 64 of cells[y * words + x / 64]
+    uint64_t* next;
+    int capacity;           // Words allocated in each of cells and next
+    uint64_t rng;
+} Automaton;
+
+// Parse a rule in B/S notation, e.g. "B3/S23". Returns false if the text
+// isn't one.
+bool automaton_parse_rule(const char* text, AutomatonRule* rule);
+
+// Size the grid. A grid that changes size is cleared. Returns false if
+// the rows could not be allocated.
+bool automaton_resize(Automaton* automaton, int width, int height);
+
+// Set every cell alive with probability 'density' (to 1/256)
+void automaton_randomize(Automaton* automaton, float density);
+
+// Advance 'generations' generations. Rows are split over 'pool' (NULL runs
+// on the calling thread).
+void automaton_step(Automaton* automaton, const AutomatonRule* rule, int generations, ThreadPool* pool);
+
+// Live cells in the grid
+int automaton_population(const Automaton* automaton);
+
+static inline bool automaton_cell(const Automaton* automaton, int x, int y) {
+    return (automaton->cells[y * automaton->words + (x >> 6)] >> (x & 63)) & 1;
+}
+
+// Release a grid's rows
+void automaton_free(Automaton* automaton);
+
+#endif // AUTOMATON_H
@@ -21,6 +21,20 @@
 #include <openssl/buffer.h>
 #include "link_wrapper.hpp"
 #include "audio_pipewire.h"
+#include "audio_file.h"
+#include "audio_features.h"
+#include "resample.h"
+#include "fractal.h"
+#include "voronoi.h"
+#include "flock.h"
+#include "particles.h"
+#include "grid_sim.h"
+#include "automaton.h"
+#include "maze.h"
+#include "mesh.h"
+#include "raster.h"
+#include "raymarch.h"
+#include "terrain.h"
 
 // ============= CLIFT (CLI-Shift) ENGINE =============
 
@@ -32,6 +46,15 @@ typedef struct {
     float beat_intensity;
     float spectrum[64];
     bool valid;
+    AudioHistory history;  // Waveform/spectrogram rings, read via audio_history_*_view()
+    
+    // Look-ahead from a pre-analysed feature track (--analyze), when has_features
+    bool has_features;
+    bool downbeat;         // beat_detected is the first beat of a bar
+    bool in_breakdown;
+    float beat_phase;      // 0..1 through the current beat
+    float next_beat_in;    // Seconds until the next beat
+    float next_drop_in;    // Seconds until the next drop, -1 if none ahead
 } AudioData;
 
 // Post effect types (15 total)
@@ -75,6 +98,13 @@ const char* gradient_names[] = {
     "Diamond", "Wave-H", "Wave-V", "Noise", "Spiral"
 };
 
+// Deck internal render resolutions, relative to the terminal grid
+#define RENDER_SCALE_COUNT 5
+#define RENDER_SCALE_NATIVE 2
+#define RENDER_SCALE_MAX 2.0f
+const float render_scales[RENDER_SCALE_COUNT] = { 0.5f, 0.75f, 1.0f, 1.5f, 2.0f };
+const char* render_scale_names[RENDER_SCALE_COUNT] = { "1/2", "3/4", "1", "3/2", "2" };
+
 // Parameter with automation
 typedef struct {
     float value;
@@ -99,6 +129,10 @@ typedef struct {
     int primary_color;    // Primary color pair (1-7)
     int secondary_color;  // Secondary color pair for intensity
     GradientType gradient_type;  // How to blend the two colors
+    int audio_stream;     // Audio input stream the deck's scenes follow (0 = main)
+    int render_scale;     // Index into render_scales
+    char* render_buffer;  // Scene output at the internal resolution (when not native)
+    float* render_zbuffer;
 } CLIFTDeck;
 
 // Crossfade states for simple 3-state mixing
@@ -204,13 +238,160 @@ void cycle_preset_name(int preset_id);
 void init_live_coding_monitor();
 void update_cpu_usage();
 void parse_websocket_message(const char* message);
-void render_live_coding_overlay();
+void render_live_coding_overlay(char* buffer);
 void* websocket_server_thread(void* arg);
 void start_websocket_server();
 void stop_websocket_server();
 void handle_websocket_handshake(int client_socket);
 void process_websocket_frame(int client_socket, unsigned char* frame, size_t len);
 
+// Frame scheduler. Frames start on an absolute grid anchored at startup, so
+// render time never stretches the period and the cadence stays beat-stable.
+#define FRAME_PACER_DEFAULT_FPS 60
+#define FRAME_PACER_MAX_LAG 2   // Periods a frame may run behind before grid slots are dropped
+
+typedef struct {
+    int target_fps;
+    int64_t period_ns;
+    int64_t anchor_ns;      // CLOCK_MONOTONIC time of grid slot 0
+    uint64_t slot;          // Grid slot of the next deadline
+    uint64_t frames;
+    uint64_t missed;        // Frames that finished after their deadline
+    uint64_t skipped;       // Slots dropped to get back onto the grid
+    float work_ms;          // Render stage time of the last frame
+    float load;             // Smoothed work time / period
+} FramePacer;
+
+// Adaptive quality. Each deck has a level of detail that scenes scale their
+// work by (particle counts, iterations, object counts). The governor lowers
+// it while the deck's render time is over its share of the frame period and
+// raises it again once there is headroom, so one heavy scene degrades on its
+// own instead of dragging the whole show's frame rate down.
+#define RENDER_QUALITY_MIN 0.25f
+#define QUALITY_BUDGET_SHARE 0.8f   // Part of the frame period the decks may use between them
+#define QUALITY_RAISE_BELOW 0.6f    // Raise the level once under this fraction of the budget
+
+typedef struct {
+    float level;            // RENDER_QUALITY_MIN..1
+    float render_ms;        // Smoothed scene + post effect time
+    int scene_id;           // Scene the level was measured on
+} QualityGovernor;
+
+// Scene output memo. A scene that declares an update rate or a change key
+// is only redrawn when what it draws from changes, and a deck whose scene
+// inputs match the other deck's in the same frame copies its plane instead
+// of rendering the scene a second time.
+typedef struct {
+    int scene_id;
+    int width, height;          // Render size
+    ResampleMode resample_mode; // The memo holds the plane after resampling
+    float params[8];
+    float quality;
+    // Only for audio-reactive scenes. The pointer names the deck's source, not
+    // its contents; that is enough only because these scenes also key on the
+    // exact frame time.
+    const AudioData* audio;
+    uint64_t time_key;          // Update step, change key, or the exact frame time
+} SceneKey;
+
+typedef struct {
+    SceneKey key;
+    bool valid;
+    char* plane;                // Scene output on the terminal grid, before the post effect
+} SceneMemo;
+
+static int64_t monotonic_ns(void);
+
+// Frame pipeline. Render (update + scenes), compose (mix + colorize) and
+// output (curses flush, UI, input) each run on their own thread and pass
+// frames along through a pool of slots, so frame N+1 is rendered while
+// frame N is still being written to the terminal. Curses is only ever
+// touched by the output stage, which is the main thread.
+#define FRAME_PIPELINE_SLOTS 3      // One per stage; every hand-off is double-buffered
+#define FRAME_OUTPUT_POLL_MS 20     // Longest the output stage waits before polling input anyway
+
+// A deck the crossfade hides still renders every HIDDEN_DECK_DIVIDER frames
+// if its scene is stateful, so simulations keep running, and at full rate
+// for DECK_WARMUP_FRAMES before the automation may switch it into view
+#define HIDDEN_DECK_DIVIDER 4
+#define DECK_WARMUP_FRAMES 8
+
+typedef enum {
+    FRAME_SLOT_FREE,
+    FRAME_SLOT_RENDERING,
+    FRAME_SLOT_RENDERED,
+    FRAME_SLOT_COMPOSING,
+    FRAME_SLOT_COMPOSED,
+    FRAME_SLOT_DISPLAYING
+} FrameSlotState;
+
+typedef struct {
+    FrameSlotState state;
+    uint64_t seq;               // Render order
+    char* deck_planes[2];       // Deck A/B output after post effects
+    char* plane;                // Crossfaded characters
+    chtype* cells;              // Characters with color pairs, ready for curses
+    CLIFTDeck decks[2];         // Deck settings the frame was rendered with
+    bool render_deck[2];        // Decks rendered this frame; a skipped one keeps its last output
+    CrossfadeState crossfade_state;
+    float time;
+} FrameSlot;
+
+typedef struct {
+    FrameSlot slots[FRAME_PIPELINE_SLOTS];
+    uint64_t next_seq;
+    uint64_t dropped;           // Composed frames superseded before they were shown
+    uint64_t hidden_skips;      // Deck renders skipped while the deck was hidden
+    bool colors;                // has_colors(), sampled on the curses thread
+    bool started;
+    pthread_mutex_t mutex;
+    pthread_cond_t changed;
+    pthread_t render_thread;
+    pthread_t compose_thread;
+    ThreadPool* scene_pool;     // Workers the render stage lends scenes for splitting rows
+} FramePipeline;
+
+#define SCENE_COUNT 190
+
+// Full-auto prewarm. The scene each deck gets at its next automatic change
+// is picked one change ahead, and a background thread renders a stateful
+// one once into a scratch plane so its lazy setup (particle pools, meshes,
+// simulation grids) is done before it is switched in. Fields other than
+// the scratch planes are guarded by vj.state_mutex.
+typedef struct {
+    int next_scene[2];          // Deck A/B's next auto scene, -1 until picked
+    int request[2];             // Scene waiting to be warmed for deck A/B, -1 if none
+    CLIFTDeck request_deck[2];  // Deck settings to warm it with
+    int busy;                   // Scene the thread is rendering, -1 if none
+    int rendering[2];           // Scenes of the frame on the render stage
+    bool warmed[SCENE_COUNT];
+    char* buffer;               // Scratch planes at the largest render scale
+    float* zbuffer;
+    uint64_t warmups;
+    bool started;
+    pthread_mutex_t mutex;      // Held while a scene is being warmed
+    pthread_cond_t wake;        // Paired with vj.state_mutex
+    pthread_t thread;
+} ScenePrewarm;
+
+// Render cost table for the full-auto picker, in nanoseconds per cell so it
+// carries over to any resolution and render scale. Scenes start from their
+// registry cost class and are profiled in the background while the render
+// stage is idle; post effects are timed at startup. Both are then refined
+// from every frame the render stage draws.
+#define COST_PROFILE_IDLE_MS 100    // Pace of background profiling
+#define COST_PROFILE_IDLE_LOAD 0.5f // Render stage load under which it counts as idle
+#define AUTO_PICK_TRIES 8           // Random candidates the picker tries before settling for the cheapest
+
+typedef struct {
+    float scene_ns[SCENE_COUNT];    // Per cell, at full quality
+    float effect_ns[POST_COUNT];    // Per terminal cell
+    bool measured[SCENE_COUNT];     // Replaced the cost class estimate with a timing
+    int cursor;                     // Next scene the idle profiler considers
+    uint64_t profiled;
+    pthread_mutex_t mutex;
+} CostTable;
+
 // Main CLIFT Engine
 typedef struct {
     CLIFTDeck deck_a;
@@ -219,7 +400,6 @@ typedef struct {
     Parameter master_volume;
     Parameter master_speed;
     
-    char* output_buffer;
     char* temp_buffer;
     float* output_zbuffer;
     
@@ -257,7 +437,10 @@ typedef struct {
     AbletonLinkState link;
     
     // Audio input system
-    AudioData audio_data;
+    AudioData audio_data;                           // Stream 0, the main input
+    AudioData audio_stems[AUDIO_MAX_STREAMS - 1];   // Streams 1.. (stems / extra buses)
+    char audio_stream_names[AUDIO_MAX_STREAMS][32];
+    int audio_stream_count;
     bool audio_enabled;
     float audio_gain;
     float audio_smoothing;
@@ -267,12 +450,52 @@ typedef struct {
     pthread_mutex_t audio_mutex;
     bool audio_thread_running;
     int selected_audio_source;  // For cycling through available sources
+    FeatureTrack features;      // Pre-analysed track for the file input
+    bool features_loaded;
+    
+    // Main loop timing
+    FramePacer pacer;
+    FramePipeline pipeline;
+    ScenePrewarm prewarm;
+    CostTable costs;
+    QualityGovernor governors[2];   // Deck A/B, owned by the render stage
+    SceneMemo memos[2];             // Same
+    uint64_t scene_reuses;          // Deck renders served from a memo
+    ResampleMode resample_mode;     // How non-native deck resolutions map to the terminal
+    bool quality_governor;          // Off: every deck renders at full quality
+    pthread_mutex_t state_mutex;    // Engine state shared by the render stage and input/UI
 } CLIFTEngine;
 
 // Global engine
 CLIFTEngine vj;
 bool running = true;
 
+// Analysis results for an audio stream
+static AudioData* audio_stream_data(int stream) {
+    return stream > 0 && stream < AUDIO_MAX_STREAMS ? &vj.audio_stems[stream - 1] : &vj.audio_data;
+}
+
+// Audio the deck's scenes react to, or NULL while audio input is off
+static AudioData* deck_audio(const CLIFTDeck* deck) {
+    if (!vj.audio_enabled) return NULL;
+    return audio_stream_data(deck->audio_stream < vj.audio_stream_count ? deck->audio_stream : 0);
+}
+
+static void audio_data_reset(AudioData* data) {
+    data->bass = 0.0f;
+    data->mid = 0.0f;
+    data->treble = 0.0f;
+    data->volume = 0.0f;
+    data->bpm = 120.0f;
+    data->beat_detected = false;
+    data->beat_intensity = 0.0f;
+    data->valid = false;
+    memset(data->spectrum, 0, sizeof(data->spectrum));
+    audio_history_reset(&data->history);
+    data->has_features = false;
+    data->next_drop_in = -1.0f;
+}
+
 // Constants for buffer sizes
 #define MAX_WIDTH 256
 #define MAX_HEIGHT 128
@@ -282,85 +505,75 @@ void draw_fractal_building(char* buffer, float* zbuffer, int width, int height,
                           float x, float y, float z, float size, int depth,
                           float t, float twist_factor);
 
-// Scene names - 190 scenes across 19 categories
-const char* scene_names[] = {
-    // Basic (0-9)
-    "Audio Bars", "Rotating Cube", "DNA Helix", "Particle Field", 
-    "Torus", "Fractal Tree", "Wave Mesh", "Sphere", "Spirograph", "Matrix Rain",
-    
-    // Geometric (10-19)
-    "Tunnels", "Kaleidoscope", "Mandala", "Sierpinski", "Hexagon Grid",
-    "Tessellations", "Voronoi Cells", "Sacred Geometry", "Polyhedra", "Maze Generator",
-    
-    // Organic (20-29) 
-    "Fire Simulation", "Water Waves", "Lightning", "Plasma Clouds", "Galaxy Spiral",
-    "Tree of Life", "Cellular Automata", "Flocking Birds", "Wind Patterns", "Neural Networks",
-    
-    // Text/Code (30-39)
-    "Code Rain", "Terminal Hacking", "Binary Waterfall", "ASCII Art Morph", "Glitch Text",
-    "Data Streams", "Circuit Patterns", "QR Code Rain", "Font Showcase", "Terminal Commands",
-    
-    // Abstract (40-49)
-    "Noise Field", "Interference", "Hologram", "Digital Rain", "Glitch Corruption",
-    "Signal Static", "Bitmap Fade", "Pixel Sort", "Datamosh", "Buffer Overflow",
-    
-    // Infinite Tunnels (50-59)
-    "Spiral Tunnel", "Hex Tunnel", "Star Tunnel", "Wormhole", "Cyber Tunnel",
-    "Ring Tunnel", "Matrix Tunnel", "Speed Tunnel", "Pulse Tunnel", "Vortex Tunnel",
-    
-    // Nature (60-69)
-    "Ocean Waves", "Rain Storm", "Infinite Forest", "Growing Trees", "Mountain Range",
-    "Aurora Borealis", "Flowing River", "Desert Dunes", "Coral Reef", "Butterfly Garden",
-    
-    // Explosions (70-79)
-    "Nuclear Blast", "Building Collapse", "Meteor Impact", "Chain Explosions", "Volcanic Eruption",
-    "Shockwave Blast", "Glass Shatter", "Demolition Blast", "Supernova Burst", "Plasma Discharge",
-    
-    // Cities (80-89)
-    "Cyberpunk City", "City Lights", "Skyscraper Forest", "Urban Decay", "Future Metropolis",
-    "City Grid", "Digital City", "City Flythrough", "Neon Districts", "Urban Canyon",
-    
-    // Freestyle (90-99)
-    "Black Hole", "Quantum Field", "Dimensional Rift", "Alien Landscape", "Robot Factory",
-    "Time Vortex", "Glitch World", "Neural Network", "Cosmic Dance", "Reality Glitch",
-    
-    // Human (100-109)
-    "Human Walker", "Dance Party", "Martial Arts", "Human Pyramid", "Yoga Flow",
-    "Sports Stadium", "Robot Dance", "Crowd Wave", "Mirror Dance", "Human Evolution",
-    
-    // Warfare (110-119)
-    "Fighter Squadron", "Drone Swarm", "Strategic Bombing", "Dogfight", "Helicopter Assault",
-    "Stealth Mission", "Carrier Strike", "Missile Defense", "Recon Drone", "Air Command",
-    
-    // Revolution & Eyes (120-129)
-    "Street Revolution", "Barricade Building", "CCTV Camera", "Giant Eye", "Crowd March",
-    "Displaced Sphere", "Morphing Cube", "Protest Rally", "Surveillance Eyes", "Fractal Displacement",
-    
-    // Film Noir (130-139)
-    "Venetian Blinds", "Silhouette Door", "Rain Window", "Detective Coat", "Femme Fatale",
-    "Smoke Room", "Stair Shadows", "Car Headlights", "Neon Rain", "Film Strip",
-    
-    // Escher 3D Illusions (140-149)
-    "Impossible Stairs", "Möbius Strip", "Impossible Cube", "Penrose Triangle", "Infinite Corridor",
-    "Tessellated Reality", "Gravity Wells", "Dimensional Shift", "Fractal Architecture", "Escher Waterfall",
-    
-    // Ikeda-Inspired (150-159)
-    "Data Matrix", "Test Pattern", "Sine Wave", "Barcode", "Pulse",
-    "Glitch", "Spectrum", "Phase", "Binary", "Circuit",
-    
-    // Giger-Inspired (160-169)
-    "Biomech Spine", "Alien Eggs", "Mech Tentacles", "Xenomorph Hive", "Biomech Skull",
-    "Face Hugger", "Biomech Heart", "Alien Architecture", "Chestburster", "Space Jockey",
-    
-    // Revolt (170-179)
-    "Rising Fists", "Breaking Chains", "Crowd March", "Barricade Building", "Molotov Cocktails",
-    "Tear Gas", "Graffiti Wall", "Police Line Breaking", "Flag Burning", "Victory Dance",
-    
-    // Audio Reactive (180-189)
-    "Audio 3D Cubes", "Audio Strobes", "Audio Explosions", "Audio Wave Tunnel", "Audio Spectrum 3D",
-    "Audio Particles", "Audio Pulse Rings", "Audio Waveform 3D", "Audio Matrix Grid", "Audio Fractals"
+// Scene entry point. Every scene draws a full frame into a width x height
+// plane; the engine clears it (and the depth buffer) first unless the
+// scene's flags say otherwise.
+typedef void (*SceneFn)(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio);
+
+// Optional change key: a value that only changes when the scene's output
+// would (for the same size and parameters)
+typedef uint64_t (*SceneKeyFn)(int width, int height, Parameter* params, float time);
+
+// Scene capabilities
+#define SCENE_USES_DEPTH        (1u << 0)   // Depth-tests against zbuffer, which is reset to far first
+#define SCENE_STATEFUL          (1u << 1)   // Keeps state between frames (simulations, lazy setup)
+#define SCENE_AUDIO_REACTIVE    (1u << 2)   // Reads the deck's audio analysis
+#define SCENE_OVERWRITES_BUFFER (1u << 3)   // Paints every cell itself or builds on its last frame, so isn't cleared
+#define SCENE_PARALLEL          (1u << 4)   // Splits its work over render_ctx.pool
+
+typedef enum {
+    SCENE_CAT_BASIC,
+    SCENE_CAT_GEOMETRIC,
+    SCENE_CAT_ORGANIC,
+    SCENE_CAT_TEXT,
+    SCENE_CAT_ABSTRACT,
+    SCENE_CAT_TUNNELS,
+    SCENE_CAT_NATURE,
+    SCENE_CAT_EXPLOSIONS,
+    SCENE_CAT_CITIES,
+    SCENE_CAT_FREESTYLE,
+    SCENE_CAT_HUMAN,
+    SCENE_CAT_WARFARE,
+    SCENE_CAT_REVOLUTION,
+    SCENE_CAT_FILM_NOIR,
+    SCENE_CAT_ESCHER,
+    SCENE_CAT_IKEDA,
+    SCENE_CAT_GIGER,
+    SCENE_CAT_REVOLT,
+    SCENE_CAT_AUDIO,
+    SCENE_CATEGORY_COUNT
+} SceneCategory;
+
+// Render cost class, measured at 160x45 on one core
+typedef enum {
+    SCENE_COST_LIGHT,       // Under 0.01 ms per frame
+    SCENE_COST_MEDIUM,
+    SCENE_COST_HEAVY        // 0.1 ms per frame or more
+} SceneCost;
+
+typedef struct {
+    const char* name;
+    SceneCategory category;     // Scenes are grouped ten per category by id
+    SceneFn render;
+    unsigned flags;             // SCENE_* capability bits
+    SceneCost cost;
+    float update_hz;            // Rate the output changes at on its own, 0 = every frame
+    SceneKeyFn change_key;      // Or: redraw only when this changes
+} SceneDesc;
+
+const char* scene_category_names[SCENE_CATEGORY_COUNT] = {
+    "Basic", "Geometric", "Organic", "Text/Code", "Abstract", "Tunnels", "Nature", "Explosions", "Cities", "Freestyle",
+    "Human", "Warfare", "Revolution&Eyes", "Film Noir", "Escher 3D", "Ikeda", "Giger", "Revolt", "Audio React"
 };
 
+extern const SceneDesc scene_registry[SCENE_COUNT];
+
+// Audio a scene renders with. Only audio-reactive scenes get any, as only
+// their memo keys cover it.
+static AudioData* scene_audio(const SceneDesc* scene, const CLIFTDeck* deck) {
+    return (scene->flags & SCENE_AUDIO_REACTIVE) ? deck_audio(deck) : NULL;
+}
+
 const char* post_effect_names[] = {
     "None", "Glow", "Blur", "Edge", "Invert", "ASCII", "Scanlines", 
     "Chromatic", "WaveWarp", "CharEmit", "Ripple", "Spiral", "Echo", "Kaleidoscope", "Droste"
@@ -405,6 +618,64 @@ void param_update(Parameter* p, float dt) {
 
 // ============= VISUAL UTILITIES =============
 
+// Per-deck settings the render stage sets up before calling a scene.
+// Scenes keep their signatures and read it through the helpers below.
+typedef struct {
+    float quality;          // Level of detail from the deck's quality governor
+    ThreadPool* pool;       // Workers for row-parallel scenes (NULL: render serially)
+    int deck;               // 0 or 1, for scenes that keep state per deck
+} RenderContext;
+
+// Per thread, since the prewarm thread renders scenes alongside the render stage
+static __thread RenderContext render_ctx = { 1.0f, NULL, 0 };
+
+// Scale a scene's work amount by the current level of detail, keeping at
+// least 'minimum'
+static inline int lod_count(int full, int minimum) {
+    int n = (int)(full * render_ctx.quality + 0.5f);
+    return n < minimum ? minimum : n;
+}
+
+// Fixed-timestep simulation clock. A stateful scene steps its simulation
+// at a fixed rate of scene time instead of once per rendered frame, so it
+// runs at the same speed and cost at any frame rate, and draws in between
+// steps by interpolating the last two states.
+#define SIM_RATE_HZ 30.0f
+#define SIM_MAX_STEPS 8     // Most steps one call catches up; time beyond that is dropped
+
+typedef struct {
+    float rate;             // Steps per second of scene time
+    float time;             // Scene time of the latest step
+    bool started;
+} SimClock;
+
+// Number of steps due by 'time' (none on the first call, which starts the
+// clock). *alpha is how far 'time' is past the latest step, 0..1.
+static int sim_clock_advance(SimClock* clock, float time, float* alpha) {
+    float step = 1.0f / clock->rate;
+    int steps = 0;
+    
+    if (!clock->started || time < clock->time) {
+        clock->time = time;
+        clock->started = true;
+    } else {
+        steps = (int)((time - clock->time) * clock->rate);
+        if (steps > SIM_MAX_STEPS) {
+            clock->time = time - SIM_MAX_STEPS * step;
+            steps = SIM_MAX_STEPS;
+        }
+        clock->time += steps * step;
+    }
+    
+    *alpha = fminf(1.0f, fmaxf(0.0f, (time - clock->time) * clock->rate));
+    return steps;
+}
+
+// Scene time of step 'i' of the 'steps' just returned by sim_clock_advance
+static inline float sim_clock_step_time(const SimClock* clock, int i, int steps) {
+    return clock->time - (steps - 1 - i) / clock->rate;
+}
+
 void clear_buffer(char* buffer, float* zbuffer, int width, int height) {
     memset(buffer, ' ', width * height);
     for (int i = 0; i < width * height; i++) {
@@ -460,7 +731,6 @@ void draw_text(char* buffer, float* zbuffer, int width, int height, int x, int y
 // Scene 0: Audio Bars
 void scene_audio_bars(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)time;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float bar_spacing = params[0].value * 3.0f + 0.5f;
     float bar_width_factor = params[1].value * 0.8f + 0.2f;
@@ -607,78 +877,36 @@ void draw_circle(char* buffer, float* zbuffer, int width, int height, int cx, in
 
 // Scene 1: Rotating Cube (MUCH LARGER)
 void scene_cube(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
-    clear_buffer(buffer, zbuffer, width, height);
+    static __thread MeshView view;
     
     // Much larger base size
     float size = 8.0f + (params[0].value - 1.0f) * 4.0f;
     float speed = params[1].value;
     
-    if (false) {
-        size *= (1.0f + 0.3f * 0.8f);
-        speed *= (1.0f + 0.5f * 2.0f);
-    }
-    
-    float angle_x = time * speed * 30.0f;
-    float angle_y = time * speed * 45.0f;
-    
-    // 3D cube vertices
-    float vertices[8][3] = {
-        {-size, -size, -size}, { size, -size, -size},
-        { size,  size, -size}, {-size,  size, -size},
-        {-size, -size,  size}, { size, -size,  size},
-        { size,  size,  size}, {-size,  size,  size}
-    };
-    
-    // Rotate and project
-    int projected[8][2];
-    float cos_x = cosf(angle_x * M_PI / 180.0f);
-    float sin_x = sinf(angle_x * M_PI / 180.0f);
-    float cos_y = cosf(angle_y * M_PI / 180.0f);
-    float sin_y = sinf(angle_y * M_PI / 180.0f);
+    float angle_x = time * speed * 30.0f * M_PI / 180.0f;
+    float angle_y = time * speed * 45.0f * M_PI / 180.0f;
     
-    for (int i = 0; i < 8; i++) {
-        // Y rotation
-        float x = vertices[i][0] * cos_y - vertices[i][2] * sin_y;
-        float z = vertices[i][0] * sin_y + vertices[i][2] * cos_y;
-        float y = vertices[i][1];
-        
-        // X rotation
-        float new_y = y * cos_x - z * sin_x;
-        z = y * sin_x + z * cos_x;
-        y = new_y;
-        
-        // Project to screen with much closer camera and larger scale
-        z += 25.0f;  // Camera distance
-        if (z > 0.1f) {
-            // Much larger projection scale
-            projected[i][0] = (int)(width/2 + x * (width/4.0f) / z);
-            projected[i][1] = (int)(height/2 + y * (height/3.0f) / z);
-        }
-    }
+    // Spin, then push out to the camera distance
+    Mat4 spin = mat4_rotation(angle_x, angle_y, 0.0f);
+    Mat4 scale = mat4_scaling(size, size, size);
+    Mat4 place = mat4_translation(0.0f, 0.0f, 25.0f);
+    Mat4 model = mat4_multiply(&spin, &scale);
+    model = mat4_multiply(&place, &model);
     
-    // Draw edges with lines
-    int edges[12][2] = {
-        {0,1}, {1,2}, {2,3}, {3,0}, {4,5}, {5,6}, {6,7}, {7,4},
-        {0,4}, {1,5}, {2,6}, {3,7}
-    };
+    MeshCamera camera = mesh_camera(width, height, width / 4.0f);
+    if (!mesh_transform(&mesh_cube, &model, &camera, &view)) return;
+    mesh_draw_edges(&mesh_cube, &view, &camera, '*', buffer, zbuffer, width, height);
     
-    char edge_char = false ? '#' : '*';
-    for (int e = 0; e < 12; e++) {
-        int p1 = edges[e][0], p2 = edges[e][1];
-        
-        // Draw thick lines for better visibility
-        draw_line(buffer, width, height, projected[p1][0], projected[p1][1], projected[p2][0], projected[p2][1], edge_char);
-        
-        // Draw vertices as points
-        set_pixel(buffer, zbuffer, width, height, projected[p1][0], projected[p1][1], 'o', 1.0f);
-        set_pixel(buffer, zbuffer, width, height, projected[p2][0], projected[p2][1], 'o', 1.0f);
+    // Vertices as points, just in front of the edges meeting there
+    for (int i = 0; i < view.count; i++) {
+        if (view.z[i] < camera.near) continue;
+        set_pixel(buffer, zbuffer, width, height, (int)floorf(view.screen_x[i] + 0.5f),
+                  (int)floorf(view.screen_y[i] + 0.5f), 'o', view.z[i] - 0.5f);
     }
 }
 
 // Scene 2: DNA Helix (MUCH LARGER)
 void scene_dna_helix(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
     // Much larger helix
     float radius = 8.0f + params[0].value * 3.0f;
     float height_span = height * 0.8f;  // Use most of screen height
@@ -746,9 +974,7 @@ void scene_dna_helix(char* buffer, float* zbuffer, int width, int height, Parame
 
 // Scene 3: Particle Field
 void scene_particle_field(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
-    int num_particles = 150 + (int)(params[0].value * 100);
+    int num_particles = lod_count(150 + (int)(params[0].value * 100), 30);
     
     if (false) {
         num_particles += (int)(0.5f * 100);
@@ -779,41 +1005,36 @@ void scene_particle_field(char* buffer, float* zbuffer, int width, int height, P
 
 // Scene 4: Torus
 void scene_torus(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+    static __thread MeshBuffer torus;
+    static __thread MeshView view;
+    static __thread float built_radius = -1.0f;
     float major_radius = 4.0f;
     float minor_radius = 1.5f + params[0].value;
     int major_segments = 20;
     int minor_segments = 15;
     
-    if (false) {
-        minor_radius += 0.3f * 2.0f;
+    if (minor_radius != built_radius) {
+        if (!mesh_build_torus(&torus, major_radius, minor_radius, major_segments, minor_segments)) return;
+        built_radius = minor_radius;
     }
     
+    // Spin about the vertical axis, tilted toward the camera
+    Mat4 spin = mat4_rotation(0.5f, time * 30.0f * M_PI / 180.0f, 0.0f);
+    Mat4 place = mat4_translation(0.0f, 0.0f, 10.0f);
+    Mat4 model = mat4_multiply(&place, &spin);
+    
+    Mesh mesh = mesh_buffer_mesh(&torus);
+    MeshCamera camera = mesh_camera(width, height, 24.0f);
+    if (!mesh_transform(&mesh, &model, &camera, &view)) return;
+    
     for (int i = 0; i < major_segments; i++) {
-        float theta = (float)i / major_segments * 2 * M_PI;
-        
         for (int j = 0; j < minor_segments; j++) {
-            float phi = (float)j / minor_segments * 2 * M_PI;
-            
-            float x = (major_radius + minor_radius * cosf(phi)) * cosf(theta);
-            float y = minor_radius * sinf(phi);
-            float z = (major_radius + minor_radius * cosf(phi)) * sinf(theta) + 10.0f;
-            
-            // Rotate around Y and X
-            float cos_t = cosf(time * 30.0f * M_PI / 180.0f);
-            float sin_t = sinf(time * 30.0f * M_PI / 180.0f);
-            float new_x = x * cos_t - z * sin_t;
-            z = x * sin_t + z * cos_t;
-            x = new_x;
-            
-            if (z > 0.1f) {
-                int px = width/2 + (int)(x * 12.0f / z);
-                int py = height/2 + (int)(y * 12.0f / z);
-                
-                char torus_char = (i + j) % 4 == 0 ? '#' : '+';
-                set_pixel(buffer, zbuffer, width, height, px, py, torus_char, z);
-            }
+            int v = i * minor_segments + j;
+            if (view.z[v] < camera.near) continue;
+            
+            char torus_char = (i + j) % 4 == 0 ? '#' : '+';
+            set_pixel(buffer, zbuffer, width, height, (int)floorf(view.screen_x[v] + 0.5f),
+                      (int)floorf(view.screen_y[v] + 0.5f), torus_char, view.z[v]);
         }
     }
 }
@@ -855,7 +1076,6 @@ void draw_tree_branch(char* buffer, int width, int height, int x, int y, float a
 // Scene 5: Proper Fractal Tree (MUCH LARGER)
 void scene_fractal_tree(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer;
-    clear_buffer(buffer, zbuffer, width, height);
     
     // Multiple trees for forest effect
     int num_trees = 3;
@@ -890,7 +1110,6 @@ void scene_fractal_tree(char* buffer, float* zbuffer, int width, int height, Par
 
 void scene_wave_mesh(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float intensity = false ? 0.5f : 0.5f;
     
@@ -909,7 +1128,9 @@ void scene_wave_mesh(char* buffer, float* zbuffer, int width, int height, Parame
 
 void scene_sphere(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
+    static __thread MeshBuffer meridians;
+    static __thread MeshView view;
+    static __thread float built_radius = -1.0f;
     
     // Much larger sphere
     float radius = width * 0.3f;  // Use 30% of screen width
@@ -920,6 +1141,10 @@ void scene_sphere(char* buffer, float* zbuffer, int width, int height, Parameter
     int center_x = width / 2;
     int center_y = height / 2;
     
+    // Four radii back, the camera shows a column per unit at the centre
+    float distance = radius * 4.0f;
+    MeshCamera camera = mesh_camera(width, height, distance);
+    
     // Draw multiple concentric spheres for depth
     for (int ring = 0; ring < 4; ring++) {
         float ring_radius = radius - ring * 3;
@@ -943,34 +1168,26 @@ void scene_sphere(char* buffer, float* zbuffer, int width, int height, Parameter
                         sphere_char = ((int)(angle * 4 + latitude * 3) % 3 == 0) ? '+' : '.';
                     }
                     
-                    set_pixel(buffer, zbuffer, width, height, x, y, sphere_char, ring);
+                    set_pixel(buffer, zbuffer, width, height, x, y, sphere_char, distance + ring);
                 }
             }
         }
     }
     
-    // Add rotating meridians
-    for (int meridian = 0; meridian < 8; meridian++) {
-        float meridian_angle = meridian * M_PI / 4 + time * 0.5f;
-        
-        for (int point = 0; point < 50; point++) {
-            float t = (float)point / 49.0f * M_PI;  // 0 to PI
-            float x = radius * sinf(t) * cosf(meridian_angle);
-            float y = radius * cosf(t) * 0.5f;  // Aspect correction
-            
-            int px = center_x + (int)x;
-            int py = center_y + (int)y;
-            
-            if (px >= 0 && px < width && py >= 0 && py < height) {
-                set_pixel(buffer, zbuffer, width, height, px, py, '|', 0.5f);
-            }
-        }
+    // Rotating meridians: the near halves cross in front of the rings
+    if (radius != built_radius) {
+        if (!mesh_build_sphere(&meridians, radius, 8, 24)) return;
+        built_radius = radius;
     }
+    Mat4 spin = mat4_rotation_y(time * 0.5f);
+    Mat4 place = mat4_translation(0.0f, 0.0f, distance);
+    Mat4 model = mat4_multiply(&place, &spin);
+    Mesh mesh = mesh_buffer_mesh(&meridians);
+    if (!mesh_transform(&mesh, &model, &camera, &view)) return;
+    mesh_draw_edges(&mesh, &view, &camera, '|', buffer, zbuffer, width, height);
 }
 
 void scene_spirograph(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
     // Much larger spirograph - scale to screen size
     float scale = fminf(width, height * 2) * 0.35f;  // Use 35% of smaller dimension
     float R = scale * 0.8f;  // Outer radius
@@ -1000,8 +1217,9 @@ void scene_spirograph(char* buffer, float* zbuffer, int width, int height, Param
         int prev_x = 0, prev_y = 0;
         bool first_point = true;
         
-        for (int i = 0; i < 500; i++) {
-            float t = (float)i / 500.0f * 20 * M_PI * speed2 + pattern_time;
+        int points = lod_count(500, 125);
+        for (int i = 0; i < points; i++) {
+            float t = (float)i / points * 20 * M_PI * speed2 + pattern_time;
             
             // Spirograph equations
             float x = (pattern_R - pattern_r) * cosf(t) + pattern_d * cosf((pattern_R - pattern_r) / pattern_r * t);
@@ -1038,7 +1256,6 @@ void scene_spirograph(char* buffer, float* zbuffer, int width, int height, Param
 
 void scene_matrix_rain(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer; (void)params; (void)audio;
-    memset(buffer, ' ', width * height);
     
     // Matrix rain effect
     static float columns[200];
@@ -1088,7 +1305,6 @@ void scene_matrix_rain(char* buffer, float* zbuffer, int width, int height, Para
 // Scene 10: Tunnels
 void scene_tunnels(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)params; (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float speed = 2.0f + (false ? 0.5f * 3.0f : 0.0f);
     float tunnel_z = fmodf(time * speed, 10.0f);
@@ -1120,7 +1336,6 @@ void scene_tunnels(char* buffer, float* zbuffer, int width, int height, Paramete
 // Scene 11: Kaleidoscope
 void scene_kaleidoscope(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
     
     int center_x = width / 2;
     int center_y = height / 2;
@@ -1149,7 +1364,6 @@ void scene_kaleidoscope(char* buffer, float* zbuffer, int width, int height, Par
 // Scene 12: Mandala
 void scene_mandala(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
     
     int center_x = width / 2;
     int center_y = height / 2;
@@ -1179,7 +1393,6 @@ void scene_mandala(char* buffer, float* zbuffer, int width, int height, Paramete
 // Scene 13: Sierpinski Triangle
 void scene_sierpinski(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)params; (void)zbuffer; (void)audio;
-    memset(buffer, ' ', width * height);
     
     // Sierpinski triangle fractal
     int scale = (int)(height * 0.8f);
@@ -1221,7 +1434,6 @@ void scene_sierpinski(char* buffer, float* zbuffer, int width, int height, Param
 // Scene 14: Hexagon Grid
 void scene_hexagon_grid(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float hex_size = 8.0f + (false ? 0.3f * 4.0f : 0.0f);
     float anim_offset = time * 2.0f;
@@ -1252,7 +1464,6 @@ void scene_hexagon_grid(char* buffer, float* zbuffer, int width, int height, Par
 // Scene 15: Tessellations
 void scene_tessellations(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
     
     int tile_size = 12 + (false ? (int)(0.5f * 8) : 0);
     float rotation = time * 0.3f;
@@ -1312,58 +1523,62 @@ void scene_tessellations(char* buffer, float* zbuffer, int width, int height, Pa
     }
 }
 
+// Per-thread Voronoi buffers shared by the cell and shard scenes
+static __thread VoronoiField scene_voronoi;
+
+#define VORONOI_RING_SEEDS 15
+#define VORONOI_MAX_SEEDS (VORONOI_RING_SEEDS + 300)
+
 // Scene 16: Voronoi Cells
 void scene_voronoi_cells(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
-    (void)params; (void)zbuffer;
-    clear_buffer(buffer, zbuffer, width, height);
+    (void)zbuffer; (void)audio;
     
-    // Generate Voronoi diagram with moving seed points
-    int num_seeds = 15 + (false ? (int)(0.5f * 10) : 0);
-    if (num_seeds > 25) num_seeds = 25;
+    // A ring of seeds, joined by up to 300 drifting ones as params[0] rises past 1
+    int drifting = (int)((params[0].value - 1.0f) * 150.0f);
+    drifting = drifting < 0 ? 0 : lod_count(drifting, 0);
+    int num_seeds = VORONOI_RING_SEEDS + drifting;
+    if (num_seeds > VORONOI_MAX_SEEDS) num_seeds = VORONOI_MAX_SEEDS;
     
     // Calculate seed positions that move over time
-    float seeds_x[25], seeds_y[25];
-    for (int i = 0; i < num_seeds; i++) {
-        float angle = (i * 2.0f * M_PI) / num_seeds + time * 0.3f;
+    float seeds_x[VORONOI_MAX_SEEDS], seeds_y[VORONOI_MAX_SEEDS];
+    for (int i = 0; i < VORONOI_RING_SEEDS; i++) {
+        float angle = (i * 2.0f * M_PI) / VORONOI_RING_SEEDS + time * 0.3f;
         float radius = (height / 4.0f) * (1.0f + sinf(time * 0.5f + i) * 0.5f);
         seeds_x[i] = width / 2.0f + cosf(angle) * radius;
         seeds_y[i] = height / 2.0f + sinf(angle) * radius;
     }
+    for (int i = VORONOI_RING_SEEDS; i < num_seeds; i++) {
+        float phase = i * 2.399963f;  // Golden angle spreads the starting points
+        seeds_x[i] = width * (0.5f + 0.48f * sinf(time * (0.05f + (i % 7) * 0.02f) + phase));
+        seeds_y[i] = height * (0.5f + 0.48f * cosf(time * (0.04f + (i % 5) * 0.025f) + phase * 1.3f));
+    }
+    
+    if (!voronoi_compute(&scene_voronoi, seeds_x, seeds_y, num_seeds, width, height, 1.0f, render_ctx.pool)) {
+        return;
+    }
+    
+    // Edges and seed dots shrink once the cells get smaller than the ring's
+    float spacing = sqrtf((float)(width * height) / num_seeds);
+    float edge_width = fminf(2.0f, spacing * 0.15f);
+    float dot_radius = fminf(5.0f, spacing * 0.25f);
     
     // Draw Voronoi cells
     for (int y = 0; y < height; y++) {
         for (int x = 0; x < width; x++) {
-            float min_dist = 99999.0f;
-            float second_min_dist = 99999.0f;
-            int closest_seed = 0;
-            
-            // Find closest and second closest seed points
-            for (int i = 0; i < num_seeds; i++) {
-                float dx = x - seeds_x[i];
-                float dy = y - seeds_y[i];
-                float dist = sqrtf(dx * dx + dy * dy);
-                
-                if (dist < min_dist) {
-                    second_min_dist = min_dist;
-                    min_dist = dist;
-                    closest_seed = i;
-                } else if (dist < second_min_dist) {
-                    second_min_dist = dist;
-                }
-            }
+            const VoronoiCell* cell = &scene_voronoi.cells[y * width + x];
             
             // Draw cell boundaries and patterns
-            float edge_distance = second_min_dist - min_dist;
-            if (edge_distance < 2.0f) {
+            float edge_distance = cell->d2 - cell->d1;
+            if (edge_distance < edge_width) {
                 // Cell boundary
                 buffer[y * width + x] = '+';
-            } else if (min_dist < 5.0f) {
+            } else if (cell->d1 < dot_radius) {
                 // Seed point
                 buffer[y * width + x] = '@';
             } else {
                 // Fill cells with different patterns based on seed index
                 char patterns[] = ".:-=*#";
-                int pattern_idx = closest_seed % 6;
+                int pattern_idx = cell->nearest % 6;
                 if ((x + y) % 3 == 0) {
                     buffer[y * width + x] = patterns[pattern_idx];
                 }
@@ -1375,7 +1590,6 @@ void scene_voronoi_cells(char* buffer, float* zbuffer, int width, int height, Pa
 // Scene 17: Sacred Geometry
 void scene_sacred_geometry(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)params; (void)zbuffer;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float scale = 1.0f + (false ? 0.5f * 0.5f : 0.0f);
     float rotation = time * 0.2f;
@@ -1452,75 +1666,18 @@ void scene_sacred_geometry(char* buffer, float* zbuffer, int width, int height,
     }
 }
 
-// Helper function for 3D line drawing with rotation and projection
-void project_and_draw_line(char* buffer, float* zbuffer, int width, int height,
-                          float x1, float y1, float z1, float x2, float y2, float z2,
-                          float angle_x, float angle_y, float angle_z,
-                          int center_x, int center_y, char c) {
-    // Rotation matrices
-    float cos_x = cosf(angle_x);
-    float sin_x = sinf(angle_x);
-    float cos_y = cosf(angle_y);
-    float sin_y = sinf(angle_y);
-    float cos_z = cosf(angle_z);
-    float sin_z = sinf(angle_z);
-    
-    // Rotate and project first point
-    // Z rotation
-    float rx1 = x1 * cos_z - y1 * sin_z;
-    float ry1 = x1 * sin_z + y1 * cos_z;
-    float rz1 = z1;
-    
-    // Y rotation
-    float tx1 = rx1 * cos_y - rz1 * sin_y;
-    rz1 = rx1 * sin_y + rz1 * cos_y;
-    rx1 = tx1;
-    
-    // X rotation
-    float ty1 = ry1 * cos_x - rz1 * sin_x;
-    rz1 = ry1 * sin_x + rz1 * cos_x;
-    ry1 = ty1;
-    
-    // Rotate and project second point
-    // Z rotation
-    float rx2 = x2 * cos_z - y2 * sin_z;
-    float ry2 = x2 * sin_z + y2 * cos_z;
-    float rz2 = z2;
-    
-    // Y rotation
-    float tx2 = rx2 * cos_y - rz2 * sin_y;
-    rz2 = rx2 * sin_y + rz2 * cos_y;
-    rx2 = tx2;
-    
-    // X rotation
-    float ty2 = ry2 * cos_x - rz2 * sin_x;
-    rz2 = ry2 * sin_x + rz2 * cos_x;
-    ry2 = ty2;
-    
-    // Perspective projection
-    float camera_distance = 40.0f;
-    rz1 += camera_distance;
-    rz2 += camera_distance;
-    
-    if (rz1 > 0.1f && rz2 > 0.1f) {
-        int px1 = center_x + (int)(rx1 * 30.0f / rz1);
-        int py1 = center_y + (int)(ry1 * 20.0f / rz1);
-        int px2 = center_x + (int)(rx2 * 30.0f / rz2);
-        int py2 = center_y + (int)(ry2 * 20.0f / rz2);
-        
-        draw_line(buffer, width, height, px1, py1, px2, py2, c);
-    }
-}
-
 // Scene 18: Polyhedra
 void scene_polyhedra(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
-    (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
-    
-    float rotation_speed = 1.0f + (false ? 0.5f * 2.0f : 0.0f);
-    float scale = 15.0f;
+    static __thread MeshView view;
+    static __thread Rasterizer raster;
     
     // Platonic solids cycling
+    static const struct { const Mesh* mesh; char glyph; } solids[] = {
+        { &mesh_tetrahedron, '=' }, { &mesh_octahedron, '#' }, { &mesh_icosahedron, '*' },
+        { &mesh_dodecahedron, '+' }, { &mesh_cube, '@' }
+    };
+    float rotation_speed = 1.0f;
+    float scale = 15.0f;
     int solid_type = ((int)(time * 0.3f)) % 5;
     
     // Rotation angles
@@ -1528,163 +1685,34 @@ void scene_polyhedra(char* buffer, float* zbuffer, int width, int height, Parame
     float angle_y = time * rotation_speed;
     float angle_z = time * rotation_speed * 0.3f;
     
-    int center_x = width / 2;
-    int center_y = height / 2;
+    Mat4 spin = mat4_rotation(angle_x, angle_y, angle_z);
+    Mat4 size = mat4_scaling(scale, scale, scale);
+    Mat4 place = mat4_translation(0.0f, 0.0f, 40.0f);
+    Mat4 model = mat4_multiply(&spin, &size);
+    model = mat4_multiply(&place, &model);
     
-    switch (solid_type) {
-        case 0: // Tetrahedron
-        {
-            float vertices[][3] = {
-                {1, 1, 1}, {1, -1, -1}, {-1, 1, -1}, {-1, -1, 1}
-            };
-            int edges[][2] = {
-                {0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3}
-            };
-            
-            // Draw edges
-            for (int i = 0; i < 6; i++) {
-                float x1 = vertices[edges[i][0]][0] * scale;
-                float y1 = vertices[edges[i][0]][1] * scale;
-                float z1 = vertices[edges[i][0]][2] * scale;
-                float x2 = vertices[edges[i][1]][0] * scale;
-                float y2 = vertices[edges[i][1]][1] * scale;
-                float z2 = vertices[edges[i][1]][2] * scale;
-                
-                // Rotate and project
-                project_and_draw_line(buffer, zbuffer, width, height,
-                    x1, y1, z1, x2, y2, z2,
-                    angle_x, angle_y, angle_z,
-                    center_x, center_y, '=');
-            }
-            break;
-        }
-        
-        case 1: // Octahedron
-        {
-            float vertices[][3] = {
-                {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}
-            };
-            int edges[][2] = {
-                {0, 2}, {0, 3}, {0, 4}, {0, 5},
-                {1, 2}, {1, 3}, {1, 4}, {1, 5},
-                {2, 4}, {2, 5}, {3, 4}, {3, 5}
-            };
-            
-            for (int i = 0; i < 12; i++) {
-                float x1 = vertices[edges[i][0]][0] * scale;
-                float y1 = vertices[edges[i][0]][1] * scale;
-                float z1 = vertices[edges[i][0]][2] * scale;
-                float x2 = vertices[edges[i][1]][0] * scale;
-                float y2 = vertices[edges[i][1]][1] * scale;
-                float z2 = vertices[edges[i][1]][2] * scale;
-                
-                project_and_draw_line(buffer, zbuffer, width, height,
-                    x1, y1, z1, x2, y2, z2,
-                    angle_x, angle_y, angle_z,
-                    center_x, center_y, '#');
-            }
-            break;
-        }
-        
-        case 2: // Icosahedron (simplified)
-        {
-            // Golden ratio
-            float phi = 1.618033988749f;
-            float a = 1.0f;
-            float b = 1.0f / phi;
-            
-            // Draw simplified icosahedron with main edges
-            int num_vertices = 12;
-            for (int i = 0; i < num_vertices; i++) {
-                float angle = i * 2.0f * M_PI / num_vertices;
-                float x = cosf(angle) * scale;
-                float y = sinf(angle) * scale;
-                float z = (i % 2 == 0) ? scale * 0.5f : -scale * 0.5f;
-                
-                // Connect to nearby vertices
-                for (int j = 0; j < 3; j++) {
-                    int next = (i + j + 1) % num_vertices;
-                    float angle2 = next * 2.0f * M_PI / num_vertices;
-                    float x2 = cosf(angle2) * scale;
-                    float y2 = sinf(angle2) * scale;
-                    float z2 = (next % 2 == 0) ? scale * 0.5f : -scale * 0.5f;
-                    
-                    project_and_draw_line(buffer, zbuffer, width, height,
-                        x, y, z, x2, y2, z2,
-                        angle_x, angle_y, angle_z,
-                        center_x, center_y, '*');
-                }
-            }
-            break;
-        }
-        
-        case 3: // Dodecahedron (simplified using pentagon)
-        {
-            // Draw pentagonal faces
-            for (int face = 0; face < 3; face++) {
-                float face_angle = face * 2.0f * M_PI / 3.0f;
-                float fx = cosf(face_angle) * scale * 0.7f;
-                float fy = sinf(face_angle) * scale * 0.7f;
-                float fz = (face - 1) * scale * 0.5f;
-                
-                // Draw pentagon
-                for (int i = 0; i < 5; i++) {
-                    float angle1 = i * 2.0f * M_PI / 5.0f;
-                    float angle2 = ((i + 1) % 5) * 2.0f * M_PI / 5.0f;
-                    
-                    float x1 = fx + cosf(angle1) * scale * 0.4f;
-                    float y1 = fy + sinf(angle1) * scale * 0.4f;
-                    float z1 = fz;
-                    float x2 = fx + cosf(angle2) * scale * 0.4f;
-                    float y2 = fy + sinf(angle2) * scale * 0.4f;
-                    float z2 = fz;
-                    
-                    project_and_draw_line(buffer, zbuffer, width, height,
-                        x1, y1, z1, x2, y2, z2,
-                        angle_x, angle_y, angle_z,
-                        center_x, center_y, '+');
-                }
-            }
-            break;
-        }
-        
-        case 4: // Cube (already exists but adding here for completeness)
-        {
-            float size = scale;
-            float vertices[][3] = {
-                {-size, -size, -size}, {size, -size, -size},
-                {size, size, -size}, {-size, size, -size},
-                {-size, -size, size}, {size, -size, size},
-                {size, size, size}, {-size, size, size}
-            };
-            
-            int edges[][2] = {
-                {0, 1}, {1, 2}, {2, 3}, {3, 0},
-                {4, 5}, {5, 6}, {6, 7}, {7, 4},
-                {0, 4}, {1, 5}, {2, 6}, {3, 7}
-            };
-            
-            for (int i = 0; i < 12; i++) {
-                project_and_draw_line(buffer, zbuffer, width, height,
-                    vertices[edges[i][0]][0], vertices[edges[i][0]][1], vertices[edges[i][0]][2],
-                    vertices[edges[i][1]][0], vertices[edges[i][1]][1], vertices[edges[i][1]][2],
-                    angle_x, angle_y, angle_z,
-                    center_x, center_y, '@');
-            }
-            break;
-        }
+    const Mesh* mesh = solids[solid_type].mesh;
+    MeshCamera camera = mesh_camera(width, height, 30.0f);
+    if (!mesh_transform(mesh, &model, &camera, &view)) return;
+    
+    // Param 1 below 0.5 keeps the wireframe; above, faces are shaded solid
+    if (params[0].value < 0.5f) {
+        mesh_draw_edges(mesh, &view, &camera, solids[solid_type].glyph, buffer, zbuffer, width, height);
+        return;
     }
+    RasterStyle style = { ".:-=+*#%@", RASTER_FLAT, { -0.4f, -0.6f, -0.7f }, 0.1f, true };
+    raster_begin(&raster, width, height);
+    raster_add_mesh(&raster, mesh, &view, &camera, &style);
+    raster_flush(&raster, buffer, zbuffer, render_ctx.pool);
 }
 
 // Scene 19: Maze Generator
 void scene_maze_generator(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)params; (void)zbuffer;
-    clear_buffer(buffer, zbuffer, width, height);
-    
-    // Generate maze using recursive backtracker algorithm
-    int maze_width = (width - 4) / 4;  // Each cell is 4 chars wide
-    int maze_height = (height - 2) / 2; // Each cell is 2 chars tall
+    static __thread Maze maze = { .seed = -1 };
     
+    int maze_width, maze_height;
+    maze_size(width, height, &maze_width, &maze_height);
     if (maze_width < 5 || maze_height < 5) {
         // Fallback for small screens
         for (int y = 0; y < height; y++) {
@@ -1699,176 +1727,104 @@ void scene_maze_generator(char* buffer, float* zbuffer, int width, int height, P
     
     // Use time to generate different mazes
     int seed = (int)(time * 0.2f) % 100;
+    maze_generate(&maze, width, height, seed);
+    
+    // Animated solution path
+    float solution_progress = (sinf(time) + 1.0f) * 0.5f;
+    maze_draw(&maze, buffer, width, height, (int)(solution_progress * maze_width));
+}
+
+// The maze changes when a new one is generated and when the solution path
+// gains or loses a step
+uint64_t scene_maze_change_key(int width, int height, Parameter* params, float time) {
+    (void)params;
+    int maze_width, maze_height;
+    maze_size(width, height, &maze_width, &maze_height);
+    int seed = (int)(time * 0.2f) % 100;
+    int path_length = (int)((sinf(time) + 1.0f) * 0.5f * maze_width);
+    return (uint64_t)seed << 32 | (uint32_t)path_length;
+}
+
+// ============= ORGANIC SCENES (20-29) =============
+
+void scene_fire_simulation(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
+    (void)zbuffer; (void)params; (void)audio;
     
-    // Initialize maze grid (walls everywhere)
-    static bool h_walls[50][50]; // Horizontal walls
-    static bool v_walls[50][50]; // Vertical walls
-    static bool visited[50][50];
-    static int maze_seed = -1;
+    static GridSim fire;
+    static SimClock clock = { SIM_RATE_HZ };
     
-    if (maze_seed != seed) {
-        maze_seed = seed;
-        
-        // Reset maze
-        for (int y = 0; y < 50; y++) {
-            for (int x = 0; x < 50; x++) {
-                h_walls[y][x] = true;
-                v_walls[y][x] = true;
-                visited[y][x] = false;
-            }
+    if (!grid_sim_resize(&fire, width, height, 1, GRID_EDGE_ZERO)) return;
+    
+    float alpha;
+    int steps = sim_clock_advance(&clock, time, &alpha);
+    for (int step = 0; step < steps; step++) {
+        grid_sim_fire(&fire, 0.96f, render_ctx.pool); // Cooling
+    
+        // Fire sources along the bottom feed the next step
+        float step_time = sim_clock_step_time(&clock, step, steps);
+        float* source = grid_sim_row(&fire, 0, height - 1);
+        for (int x = 0; x < width; x++) {
+            source[x] = 1.0f + sinf(step_time * 3.0f + x * 0.1f) * 0.3f;
         }
-        
-        // Generate maze using simplified algorithm
-        // Start from center
-        int cx = maze_width / 2;
-        int cy = maze_height / 2;
-        visited[cy][cx] = true;
-        
-        // Create paths
-        for (int i = 0; i < maze_width * maze_height / 2; i++) {
-            int x = (seed * 73 + i * 31) % maze_width;
-            int y = (seed * 97 + i * 43) % maze_height;
-            
-            if (x > 0 && x < maze_width - 1 && y > 0 && y < maze_height - 1) {
-                visited[y][x] = true;
-                
-                // Remove random walls
-                int dir = (seed + i) % 4;
-                switch (dir) {
-                    case 0: if (y > 0) h_walls[y][x] = false; break;
-                    case 1: if (x < maze_width - 1) v_walls[y][x] = false; break;
-                    case 2: if (y < maze_height - 1) h_walls[y + 1][x] = false; break;
-                    case 3: if (x > 0) v_walls[y][x - 1] = false; break;
-                }
+    }
+    
+    // Render fire, blended between the last two steps
+    char fire_chars[] = " .'\":;*%#@";
+    for (int y = 0; y < height; y++) {
+        const float* row = grid_sim_row(&fire, 0, y);
+        const float* prev = grid_sim_prev_row(&fire, 0, y);
+        for (int x = 0; x < width; x++) {
+            float intensity = prev[x] + (row[x] - prev[x]) * alpha;
+            if (intensity > 0.1f) {
+                int char_idx = (int)(intensity * 8);
+                if (char_idx > 8) char_idx = 8;
+                buffer[y * width + x] = fire_chars[char_idx];
             }
         }
     }
-    
-    // Draw maze
-    for (int my = 0; my < maze_height && my < 50; my++) {
-        for (int mx = 0; mx < maze_width && mx < 50; mx++) {
-            int x_base = mx * 4 + 2;
-            int y_base = my * 2 + 1;
-            
-            // Draw cell
-            if (x_base < width - 2 && y_base < height - 1) {
-                // Top wall
-                if (h_walls[my][mx]) {
-                    for (int i = 0; i < 3 && x_base + i < width; i++) {
-                        buffer[y_base * width + x_base + i] = '=';
-                    }
-                }
-                
-                // Left wall
-                if (v_walls[my][mx]) {
-                    buffer[y_base * width + x_base - 1] = '|';
-                    if (y_base + 1 < height) {
-                        buffer[(y_base + 1) * width + x_base - 1] = '|';
-                    }
-                }
-                
-                // Corners
-                buffer[y_base * width + x_base - 1] = '+';
-            }
-        }
-    }
-    
-    // Add animated solution path
-    float solution_progress = (sinf(time * (false ? 1.0f + 0.5f : 1.0f)) + 1.0f) * 0.5f;
-    int path_length = (int)(solution_progress * maze_width);
-    
-    int px = 2, py = 1;
-    for (int step = 0; step < path_length && px < width - 3 && py < height - 2; step++) {
-        buffer[py * width + px] = '*';
-        
-        // Move through maze (simplified pathfinding)
-        int dir = (step + seed) % 4;
-        switch (dir) {
-            case 0: if (py < height - 3) py += 2; break;
-            case 1: if (px < width - 5) px += 4; break;
-            case 2: if (py > 3) py -= 2; break;
-            case 3: if (px > 5) px -= 4; break;
-        }
-    }
 }
-
-// ============= ORGANIC SCENES (20-29) =============
-
-void scene_fire_simulation(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
-    (void)zbuffer; (void)params; (void)audio;
-    memset(buffer, ' ', width * height);
-    
-    static float fire_map[200][100];
-    static bool fire_initialized = false;
     
-    int w = width > 200 ? 200 : width;
-    int h = height > 100 ? 100 : height;
+void scene_water_waves(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
+    (void)zbuffer; (void)audio;
     
-    if (!fire_initialized) {
-        for (int y = 0; y < h; y++) {
-            for (int x = 0; x < w; x++) {
-                fire_map[x][y] = 0.0f;
-            }
-        }
-        fire_initialized = true;
-    }
+    static GridSim water;
+    static SimClock clock = { SIM_RATE_HZ };
     
-    // Add fire sources at bottom
-    for (int x = 0; x < w; x++) {
-        fire_map[x][h-1] = 1.0f + sinf(time * 3.0f + x * 0.1f) * 0.3f;
-    }
+    // Drops strike the surface about 9 times a second at the default params[0]
+    float drop_chance = params[0].value * 0.3f;
     
-    // Fire simulation
-    for (int y = h - 2; y >= 0; y--) {
-        for (int x = 1; x < w - 1; x++) {
-            float sum = fire_map[x-1][y+1] + fire_map[x][y+1] + fire_map[x+1][y+1];
-            fire_map[x][y] = (sum / 3.0f) * 0.96f; // Cooling
-        }
-    }
+    if (!grid_sim_resize(&water, width, height, 1, GRID_EDGE_CLAMP)) return;
     
-    // Render fire
-    char fire_chars[] = " .'\":;*%#@";
-    for (int y = 0; y < h && y < height; y++) {
-        for (int x = 0; x < w && x < width; x++) {
-            float intensity = fire_map[x][y];
-            if (intensity > 0.1f) {
-                int char_idx = (int)(intensity * 8);
-                if (char_idx > 8) char_idx = 8;
-                buffer[y * width + x] = fire_chars[char_idx];
-            }
+    float alpha;
+    int steps = sim_clock_advance(&clock, time, &alpha);
+    for (int step = 0; step < steps; step++) {
+        if (rand() % 1000 < (int)(drop_chance * 1000.0f)) {
+            grid_sim_row(&water, 0, rand() % height)[rand() % width] = 12.0f;
         }
+        grid_sim_ripple(&water, 0.95f, render_ctx.pool);
     }
-}
-
-void scene_water_waves(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
-    (void)zbuffer; (void)params; (void)audio;
-    memset(buffer, ' ', width * height);
-    
-    char wave_chars[] = "~-=*#@+oO";
-    int char_count = 9;
     
+    // Shade by the surface slope, blended between the last two steps
+    char wave_chars[] = "~-=*#@";
+    int char_count = 6;
     for (int y = 0; y < height; y++) {
+        const float* row = grid_sim_row(&water, 0, y);
+        const float* prev = grid_sim_prev_row(&water, 0, y);
         for (int x = 0; x < width; x++) {
-            float wave1 = sinf((x * 0.1f) + (time * 2.0f)) * 0.5f;
-            float wave2 = sinf((x * 0.05f) + (time * 1.5f) + (y * 0.1f)) * 0.3f;
-            float wave3 = sinf((x * 0.2f) + (time * 3.0f)) * 0.2f;
-            
-            float combined = wave1 + wave2 + wave3;
-            int wave_y = y + (int)(combined * 3.0f);
-            
-            if (wave_y >= 0 && wave_y < height && wave_y == y) {
-                float intensity = (combined + 1.0f) * 0.5f;
-                int char_idx = (int)(intensity * char_count);
+            float left = prev[x - 1] + (row[x - 1] - prev[x - 1]) * alpha;
+            float right = prev[x + 1] + (row[x + 1] - prev[x + 1]) * alpha;
+            float slope = fabsf(right - left);
+            if (slope > 0.3f) {
+                int char_idx = (int)(slope * 2.0f);
                 if (char_idx >= char_count) char_idx = char_count - 1;
                 buffer[y * width + x] = wave_chars[char_idx];
             }
         }
     }
 }
-
+    
 void scene_lightning(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer; (void)params; (void)audio;
-    memset(buffer, ' ', width * height);
     
     static float next_bolt = 0.0f;
     static int bolt_x, bolt_y;
@@ -1913,7 +1869,6 @@ void scene_lightning(char* buffer, float* zbuffer, int width, int height, Parame
 
 void scene_plasma_clouds(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer; (void)params; (void)audio;
-    memset(buffer, ' ', width * height);
     
     char plasma_chars[] = " .:;+=xX#%@";
     int char_count = 11;
@@ -1940,7 +1895,6 @@ void scene_plasma_clouds(char* buffer, float* zbuffer, int width, int height, Pa
 
 void scene_galaxy_spiral(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer; (void)params; (void)audio;
-    memset(buffer, ' ', width * height);
     
     int center_x = width / 2;
     int center_y = height / 2;
@@ -1983,7 +1937,6 @@ void scene_galaxy_spiral(char* buffer, float* zbuffer, int width, int height, Pa
 // Scene 25: Tree of Life
 void scene_tree_of_life(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
     
     int center_x = width / 2;
     int center_y = height - 5;
@@ -2026,163 +1979,110 @@ void scene_tree_of_life(char* buffer, float* zbuffer, int width, int height, Par
 }
 
 // Scene 26: Cellular Automata
+// Life-like rules by param 3, from Seeds through Life to Diamoeba
+static const char* const automata_rules[] = {
+    "B2/S", "B36/S23", "B3/S23", "B3678/S34678", "B368/S245", "B1357/S1357", "B35678/S5678"
+};
+
 void scene_cellular_automata(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
-    (void)zbuffer; (void)params;
-    static char grid[200][100];
-    static bool initialized = false;
-    static float last_update = 0.0f;
-    
-    int w = width > 200 ? 200 : width;
-    int h = height > 100 ? 100 : height;
-    
-    if (!initialized) {
-        // Initialize with random pattern
-        for (int y = 0; y < h; y++) {
-            for (int x = 0; x < w; x++) {
-                grid[x][y] = (rand() % 100) < 30 ? 1 : 0;
-            }
-        }
-        initialized = true;
-        last_update = time;
-    }
-    
-    // Update automata every 0.2 seconds
-    if (time - last_update > 0.2f) {
-        char new_grid[200][100];
-        
-        for (int y = 0; y < h; y++) {
-            for (int x = 0; x < w; x++) {
-                int neighbors = 0;
-                
-                // Count neighbors
-                for (int dy = -1; dy <= 1; dy++) {
-                    for (int dx = -1; dx <= 1; dx++) {
-                        if (dx == 0 && dy == 0) continue;
-                        int nx = x + dx;
-                        int ny = y + dy;
-                        if (nx >= 0 && nx < w && ny >= 0 && ny < h) {
-                            neighbors += grid[nx][ny];
-                        }
-                    }
-                }
-                
-                // Conway's Game of Life rules
-                if (grid[x][y] == 1) {
-                    new_grid[x][y] = (neighbors == 2 || neighbors == 3) ? 1 : 0;
-                } else {
-                    new_grid[x][y] = (neighbors == 3) ? 1 : 0;
-                }
+    (void)zbuffer;
+    static Automaton life;
+    static SimClock clock = { 5.0f };   // A step every 0.2 seconds
+    static int rule_index = -1;
+    
+    // Param 1 packs 1x1 up to 8x16 cells into each character
+    int level = (int)params[0].value;
+    if (level < 0) level = 0;
+    if (level > 3) level = 3;
+    int cells_x = 1 << level;
+    int cells_y = level > 0 ? cells_x * 2 : 1;
+    // Param 2: generations per step, 1 up to 16
+    int generations = (int)powf(4.0f, params[1].value - 1.0f);
+    if (generations < 1) generations = 1;
+    int rule_count = (int)(sizeof(automata_rules) / sizeof(automata_rules[0]));
+    int index = (int)(params[2].value * 2.0f);
+    if (index < 0) index = 0;
+    if (index >= rule_count) index = rule_count - 1;
+    AutomatonRule rule;
+    automaton_parse_rule(automata_rules[index], &rule);
+    
+    bool resized = life.width != width * cells_x || life.height != height * cells_y;
+    if (!automaton_resize(&life, width * cells_x, height * cells_y)) return;
+    if (resized || index != rule_index) {
+        automaton_randomize(&life, 0.3f);
+        rule_index = index;
+    }
+    
+    // Generations are discrete, so there is nothing to interpolate
+    float alpha;
+    int steps = sim_clock_advance(&clock, time, &alpha);
+    if (steps > 0) {
+        automaton_step(&life, &rule, steps * generations, render_ctx.pool);
+        if (automaton_population(&life) == 0) automaton_randomize(&life, 0.3f);
+    }
+    
+    // Each character shows how full its block of cells is. Blocks are at
+    // most 8 cells wide and aligned to their width, so a block row never
+    // straddles two words.
+    static const char ramp[] = ".:+*";
+    int area = cells_x * cells_y;
+    uint64_t block_mask = (1ull << cells_x) - 1;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int cx = x * cells_x;
+            int live = 0;
+            for (int sy = 0; sy < cells_y; sy++) {
+                uint64_t word = life.cells[(y * cells_y + sy) * life.words + (cx >> 6)];
+                live += __builtin_popcountll((word >> (cx & 63)) & block_mask);
             }
-        }
-        
-        memcpy(grid, new_grid, sizeof(grid));
-        last_update = time;
-    }
-    
-    // Render automata
-    memset(buffer, ' ', width * height);
-    for (int y = 0; y < h && y < height; y++) {
-        for (int x = 0; x < w && x < width; x++) {
-            if (grid[x][y]) {
-                char cell_char = false ? '#' : '*';
-                buffer[y * width + x] = cell_char;
+            if (live > 0) {
+                buffer[y * width + x] = ramp[(live * 4 - 1) / area];
             }
         }
     }
 }
-
+    
 // Scene 27: Flocking Birds
 void scene_flocking_birds(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
-    (void)params; (void)zbuffer;
-    clear_buffer(buffer, zbuffer, width, height);
+    (void)zbuffer;
     
-    static float birds[50][4]; // x, y, vx, vy
-    static bool initialized = false;
+    static Flock flock;
+    static SimClock clock = { SIM_RATE_HZ };
+    
+    // 50 birds at the default params[0] of 1, ten times as many per unit above it
+    int count = lod_count((int)(50.0f * powf(10.0f, params[0].value - 1.0f)), 10);
+    if (!flock_resize(&flock, count, width, height, 1.41f)) return;
+    
+    // Bigger flocks fly smaller: radius, speed and separation shrink with
+    // the spacing so the flock behaves the same at any size
+    float scale = fmaxf(sqrtf(50.0f / flock.count), 0.08f);
+    FlockRules rules = {
+        .radius = 20.0f * scale,
+        .separation = 0.1f * scale,
+        .alignment = 0.05f,
+        .cohesion = 0.01f,
+        .friction = 1.0f,
+        .max_speed = 2.0f * scale,
+        .edges = FLOCK_WRAP
+    };
     
-    if (!initialized) {
-        for (int i = 0; i < 50; i++) {
-            birds[i][0] = rand() % width;   // x
-            birds[i][1] = rand() % height;  // y
-            birds[i][2] = (rand() % 200 - 100) / 100.0f; // vx
-            birds[i][3] = (rand() % 200 - 100) / 100.0f; // vy
-        }
-        initialized = true;
+    float alpha;
+    int steps = sim_clock_advance(&clock, time, &alpha);
+    for (int step = 0; step < steps; step++) {
+        flock_step(&flock, &rules, render_ctx.pool);
     }
     
-    float flock_speed = 1.0f + (false ? 0.5f : 0.0f);
-    
-    // Update bird positions with simple flocking behavior
-    for (int i = 0; i < 50; i++) {
-        float sep_x = 0, sep_y = 0;
-        float align_x = 0, align_y = 0;
-        float coh_x = 0, coh_y = 0;
-        int neighbors = 0;
-        
-        // Check neighbors
-        for (int j = 0; j < 50; j++) {
-            if (i == j) continue;
-            
-            float dx = birds[j][0] - birds[i][0];
-            float dy = birds[j][1] - birds[i][1];
-            float dist = sqrtf(dx * dx + dy * dy);
-            
-            if (dist < 20.0f && dist > 0) {
-                // Separation
-                sep_x -= dx / dist;
-                sep_y -= dy / dist;
-                
-                // Alignment
-                align_x += birds[j][2];
-                align_y += birds[j][3];
-                
-                // Cohesion
-                coh_x += dx;
-                coh_y += dy;
-                
-                neighbors++;
-            }
-        }
-        
-        if (neighbors > 0) {
-            align_x /= neighbors;
-            align_y /= neighbors;
-            coh_x /= neighbors;
-            coh_y /= neighbors;
-            
-            // Apply flocking forces
-            birds[i][2] += (sep_x * 0.1f + align_x * 0.05f + coh_x * 0.01f) * flock_speed;
-            birds[i][3] += (sep_y * 0.1f + align_y * 0.05f + coh_y * 0.01f) * flock_speed;
-        }
-        
-        // Limit velocity
-        float vel = sqrtf(birds[i][2] * birds[i][2] + birds[i][3] * birds[i][3]);
-        if (vel > 2.0f) {
-            birds[i][2] = (birds[i][2] / vel) * 2.0f;
-            birds[i][3] = (birds[i][3] / vel) * 2.0f;
-        }
-        
-        // Update position
-        birds[i][0] += birds[i][2];
-        birds[i][1] += birds[i][3];
-        
-        // Wrap around screen
-        if (birds[i][0] < 0) birds[i][0] = width;
-        if (birds[i][0] >= width) birds[i][0] = 0;
-        if (birds[i][1] < 0) birds[i][1] = height;
-        if (birds[i][1] >= height) birds[i][1] = 0;
-        
-        // Draw bird
-        int x = (int)birds[i][0];
-        int y = (int)birds[i][1];
+    for (int i = 0; i < flock.count; i++) {
+        float fx, fy;
+        flock_position(&flock, i, alpha, &fx, &fy);
         char bird_char = i % 3 == 0 ? '>' : i % 3 == 1 ? '^' : 'v';
-        set_pixel(buffer, zbuffer, width, height, x, y, bird_char, 1.0f);
+        set_pixel(buffer, zbuffer, width, height, (int)fx, (int)fy, bird_char, 1.0f);
     }
 }
 
 // Scene 28: Wind Patterns
 void scene_wind_patterns(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)params; (void)zbuffer;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float wind_strength = 1.0f + (false ? 0.5f * 2.0f : 0.0f);
     
@@ -2214,7 +2114,6 @@ void scene_wind_patterns(char* buffer, float* zbuffer, int width, int height, Pa
 // Scene 29: Neural Networks
 void scene_neural_networks(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
     
     int layers = 4;
     int nodes_per_layer = 8;
@@ -2264,7 +2163,6 @@ void scene_neural_networks(char* buffer, float* zbuffer, int width, int height,
 // Scene 31: ASCII Art Generator
 void scene_ascii_art_generator(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer; (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
     
     char ascii_chars[] = " .:-=+*#%@";
     int char_count = 10;
@@ -2339,8 +2237,6 @@ void scene_code_rain(char* buffer, float* zbuffer, int width, int height, Parame
         initialized = true;
     }
     
-    memset(buffer, ' ', width * height);
-    
     // Programming language characters
     char code_chars[] = "{}();[]+=*&|<>?:.,01";
     int char_count = 20;
@@ -2370,7 +2266,6 @@ void scene_code_rain(char* buffer, float* zbuffer, int width, int height, Parame
 // Scene 33: Binary Stream
 void scene_binary_stream(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer; (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float flow_speed = 2.0f + (false ? 0.5f * 4.0f : 0.0f);
     
@@ -2419,8 +2314,6 @@ void scene_terminal_glitch(char* buffer, float* zbuffer, int width, int height,
     };
     int line_count = 10;
     
-    memset(buffer, ' ', width * height);
-    
     // Draw terminal text
     for (int line = 0; line < line_count && line * 2 < height; line++) {
         const char* text = terminal_lines[line];
@@ -2464,7 +2357,6 @@ void scene_terminal_glitch(char* buffer, float* zbuffer, int width, int height,
 // Scene 35: Syntax Highlighting
 void scene_syntax_highlighting(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer; (void)params;
-    memset(buffer, ' ', width * height);
     
     // Simulate syntax highlighted code
     const char* code_lines[] = {
@@ -2518,7 +2410,6 @@ void scene_syntax_highlighting(char* buffer, float* zbuffer, int width, int heig
 // Scene 36: Data Visualization
 void scene_data_visualization(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer; (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
     
     // Create animated bar chart
     int num_bars = 12;
@@ -2573,7 +2464,6 @@ void scene_data_visualization(char* buffer, float* zbuffer, int width, int heigh
 // Scene 37: Network Nodes
 void scene_network_nodes(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer; (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
     
     int num_nodes = 20;
     static float nodes[20][2]; // x, y positions
@@ -2644,7 +2534,6 @@ void scene_network_nodes(char* buffer, float* zbuffer, int width, int height, Pa
 // Scene 38: System Monitor
 void scene_system_monitor(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer; (void)params;
-    memset(buffer, ' ', width * height);
     
     // System metrics that change over time
     float cpu_usage = (sinf(time * 1.2f) * 0.3f + 0.7f) * 100;
@@ -2716,7 +2605,6 @@ void scene_system_monitor(char* buffer, float* zbuffer, int width, int height, P
 // Scene 39: Command Line Interface
 void scene_command_line(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer; (void)params;
-    memset(buffer, ' ', width * height);
     
     // Terminal prompt and commands
     const char* commands[] = {
@@ -2768,7 +2656,6 @@ void scene_command_line(char* buffer, float* zbuffer, int width, int height, Par
 
 void scene_noise_field(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer; (void)params; (void)audio;
-    memset(buffer, ' ', width * height);
     
     char noise_chars[] = " .'\":;!/\\|()[]{}";
     int char_count = 16;
@@ -2847,57 +2734,39 @@ void scene_glitch_corruption(char* buffer, float* zbuffer, int width, int height
 
 // Scene 41: Swarm Intelligence
 void scene_swarm_intelligence(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
-    (void)zbuffer; (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
+    (void)zbuffer;
     
-    static float particles[200][4]; // x, y, vx, vy
-    static bool initialized = false;
+    static Flock swarm;
+    static SimClock clock = { SIM_RATE_HZ };
+    
+    int count = lod_count((int)(200.0f * powf(10.0f, params[0].value - 1.0f)), 50);
+    if (!flock_resize(&swarm, count, width, height, 1.41f)) return;
+    
+    // Drawn to the centre, while keeping a little apart and lining up with
+    // close neighbours
+    FlockRules rules = {
+        .radius = 3.0f,
+        .separation = 0.01f,
+        .alignment = 0.02f,
+        .attract_x = width / 2.0f,
+        .attract_y = height / 2.0f,
+        .attract = 0.01f,
+        .friction = 0.98f,
+        .edges = FLOCK_WRAP
+    };
     
-    if (!initialized) {
-        for (int i = 0; i < 200; i++) {
-            particles[i][0] = rand() % width;
-            particles[i][1] = rand() % height;
-            particles[i][2] = (rand() % 200 - 100) / 100.0f;
-            particles[i][3] = (rand() % 200 - 100) / 100.0f;
-        }
-        initialized = true;
+    float alpha;
+    int steps = sim_clock_advance(&clock, time, &alpha);
+    for (int step = 0; step < steps; step++) {
+        flock_step(&swarm, &rules, render_ctx.pool);
     }
     
-    float energy = false ? 0.5f * 3.0f : 1.0f;
-    
-    // Update particles
-    for (int i = 0; i < 200; i++) {
-        // Apply forces
-        float center_x = width / 2.0f;
-        float center_y = height / 2.0f;
-        float dx = center_x - particles[i][0];
-        float dy = center_y - particles[i][1];
-        float dist = sqrtf(dx * dx + dy * dy);
-        
-        if (dist > 0) {
-            float force = energy / (dist + 1.0f);
-            particles[i][2] += (dx / dist) * force * 0.01f;
-            particles[i][3] += (dy / dist) * force * 0.01f;
-        }
-        
-        // Update position
-        particles[i][0] += particles[i][2];
-        particles[i][1] += particles[i][3];
-        
-        // Friction
-        particles[i][2] *= 0.98f;
-        particles[i][3] *= 0.98f;
-        
-        // Wrap around
-        if (particles[i][0] < 0) particles[i][0] = width;
-        if (particles[i][0] >= width) particles[i][0] = 0;
-        if (particles[i][1] < 0) particles[i][1] = height;
-        if (particles[i][1] >= height) particles[i][1] = 0;
-        
-        // Draw particle
-        int x = (int)particles[i][0];
-        int y = (int)particles[i][1];
-        float speed = sqrtf(particles[i][2] * particles[i][2] + particles[i][3] * particles[i][3]);
+    for (int i = 0; i < swarm.count; i++) {
+        float fx, fy;
+        flock_position(&swarm, i, alpha, &fx, &fy);
+        int x = (int)fx;
+        int y = (int)fy;
+        float speed = sqrtf(swarm.vx[i] * swarm.vx[i] + swarm.vy[i] * swarm.vy[i]);
         char particle_char = speed > 0.5f ? '*' : speed > 0.2f ? '+' : '.';
         
         if (x >= 0 && x < width && y >= 0 && y < height) {
@@ -2906,46 +2775,63 @@ void scene_swarm_intelligence(char* buffer, float* zbuffer, int width, int heigh
     }
 }
 
+// Scratch plane of smooth escape counts for the fractal scenes, per
+// thread and grown on demand
+static float* fractal_scratch(int cells) {
+    static __thread float* plane = NULL;
+    static __thread int capacity = 0;
+    
+    if (cells > capacity) {
+        float* grown = realloc(plane, sizeof(float) * cells);
+        if (!grown) return NULL;
+        plane = grown;
+        capacity = cells;
+    }
+    return plane;
+}
+
+// Shade a smooth escape count onto a glyph ramp. The ramp rises and falls
+// every 'period' iterations, so bands blend into each other instead of
+// wrapping from the densest glyph straight back to the lightest.
+static char fractal_glyph(float smooth, float period, const char* ramp, int ramp_len) {
+    float phase = fmodf(smooth / period, 2.0f);
+    float level = phase < 1.0f ? phase : 2.0f - phase;
+    return ramp[(int)(level * (ramp_len - 1) + 0.5f)];
+}
+
+#define FRACTAL_ZOOM_DECADES 15.0f      // Depth the zoom reaches before starting over
+#define FRACTAL_ZOOM_RATE 0.25f         // Decades per second
+
 // Scene 42: Fractal Zoom
 void scene_fractal_zoom(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
-    (void)zbuffer; (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
+    (void)zbuffer; (void)params; (void)audio;
     
-    float zoom = 1.0f + time * 0.1f;
-    if (false) {
-        zoom += 0.5f * 0.5f;
-    }
+    // The repelling fixed point beta = (1 + sqrt(1 - 4c)) / 2 lies on the
+    // Julia set for every c, so zooming in on it never runs out of detail
+    long double complex c = (-0.7 + sin(time * 0.3) * 0.2) + (0.27015 + cos(time * 0.2) * 0.1) * I;
+    long double complex beta = (1.0L + csqrtl(1.0L - 4.0L * c)) / 2.0L;
+    
+    float decades = fmodf(time * FRACTAL_ZOOM_RATE, FRACTAL_ZOOM_DECADES);
+    double zoom = pow(10.0, decades);
+    // Pan from the origin onto beta within the first decade, then hold it centred
+    long double complex center = beta * (1.0L - 1.0L / (zoom * zoom));
+    
+    // Orbits near beta take a few extra iterations per decade to escape
+    FractalView view = {
+        FRACTAL_JULIA, creall(center), cimagl(center),
+        1.0 / (width * 0.25 * zoom), 1.0 / (height * 0.25 * zoom),
+        (double)creall(c), (double)cimagl(c),
+        lod_count(50 + (int)(decades * 4.0f), 12)
+    };
     
-    float center_x = width / 2.0f;
-    float center_y = height / 2.0f;
+    float* smooth = fractal_scratch(width * height);
+    if (!smooth) return;
+    fractal_render(&view, smooth, width, height, render_ctx.pool);
     
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            // Map screen coordinates to complex plane
-            float real = (x - center_x) / (width * 0.25f * zoom) - 0.75f;
-            float imag = (y - center_y) / (height * 0.25f * zoom);
-            
-            // Julia set calculation
-            float zr = real;
-            float zi = imag;
-            float cr = -0.7f + sinf(time * 0.3f) * 0.2f;
-            float ci = 0.27015f + cosf(time * 0.2f) * 0.1f;
-            
-            int iterations = 0;
-            int max_iter = 50;
-            
-            while (iterations < max_iter && (zr * zr + zi * zi) < 4.0f) {
-                float temp = zr * zr - zi * zi + cr;
-                zi = 2.0f * zr * zi + ci;
-                zr = temp;
-                iterations++;
-            }
-            
-            if (iterations < max_iter) {
-                char fractal_chars[] = " .'\":;!/\\|()1";
-                int char_idx = iterations % 12;
-                buffer[y * width + x] = fractal_chars[char_idx];
-            }
+    static const char ramp[] = ".,:;=+*#%@";
+    for (int i = 0; i < width * height; i++) {
+        if (smooth[i] != FRACTAL_INSIDE) {
+            buffer[i] = fractal_glyph(smooth[i], 6.0f, ramp, (int)sizeof(ramp) - 1);
         }
     }
 }
@@ -2953,7 +2839,6 @@ void scene_fractal_zoom(char* buffer, float* zbuffer, int width, int height, Par
 // Scene 43: Morphing Shapes
 void scene_morphing_shapes(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer; (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float morph_factor = sinf(time * 0.5f) * 0.5f + 0.5f;
     if (false) {
@@ -3000,7 +2885,6 @@ void scene_morphing_shapes(char* buffer, float* zbuffer, int width, int height,
 // Scene 45: Energy Waves
 void scene_energy_waves(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer; (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float energy = false ? 0.5f : 0.5f;
     
@@ -3041,8 +2925,6 @@ void scene_digital_rain(char* buffer, float* zbuffer, int width, int height, Par
         initialized = true;
     }
     
-    memset(buffer, ' ', width * height);
-    
     float speed = 1.5f + (false ? 0.5f * 2.0f : 0.0f);
     
     for (int x = 0; x < w; x++) {
@@ -3070,7 +2952,6 @@ void scene_digital_rain(char* buffer, float* zbuffer, int width, int height, Par
 // Scene 47: Psychedelic Patterns
 void scene_psychedelic_patterns(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer; (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float intensity = false ? 0.5f : 0.5f;
     
@@ -3095,7 +2976,6 @@ void scene_psychedelic_patterns(char* buffer, float* zbuffer, int width, int hei
 // Scene 48: Quantum Field
 void scene_quantum_field(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer; (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float quantum_energy = false ? 0.5f : 0.3f;
     
@@ -3138,7 +3018,6 @@ void scene_quantum_field(char* buffer, float* zbuffer, int width, int height, Pa
 // Scene 49: Abstract Flow
 void scene_abstract_flow(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)zbuffer; (void)params;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float flow_speed = 1.0f + (false ? 0.5f * 2.0f : 0.0f);
     
@@ -3169,47 +3048,82 @@ void scene_abstract_flow(char* buffer, float* zbuffer, int width, int height, Pa
 
 // ============= INFINITE TUNNEL SCENES (50-59) =============
 
+#define TUNNEL_FAR 40.0f    // Depth at which raymarched tunnel rays give up
+
+// Raymarched view through 'camera' for the tunnel scenes. The quality
+// governor trades march steps and, below full quality, marches half the
+// cells each frame.
+static RaymarchView tunnel_view(RaymarchDistance distance, RaymarchShade shade, const void* ctx,
+                                const Mat4* camera, int width, int height) {
+    RaymarchView view = {
+        distance, shade, ctx, *camera,
+        mesh_camera(width, height, width * 0.5f),
+        lod_count(64, 16), TUNNEL_FAR, 0.5f,
+        render_ctx.quality < 1.0f
+    };
+    return view;
+}
+
+// Square tube of half-width 2 along z, turned 'twist' radians per unit of z
+typedef struct {
+    float twist, spin;
+    float lipschitz;        // Keeps steps short enough for the twist
+    float ring_spacing;
+} SpiralTunnel;
+
+static void spiral_tunnel_distance(const void* ctx, const float* x, const float* y, const float* z, float* distance) {
+    const SpiralTunnel* tunnel = (const SpiralTunnel*)ctx;
+    for (int i = 0; i < RAYMARCH_PACKET; i++) {
+        float angle = z[i] * tunnel->twist + tunnel->spin;
+        float c = cosf(angle), s = sinf(angle);
+        float u = x[i] * c - y[i] * s;
+        float v = x[i] * s + y[i] * c;
+        distance[i] = (2.0f - fmaxf(fabsf(u), fabsf(v))) * tunnel->lipschitz;
+    }
+}
+
+// Rings across the tube and its four corners, brighter when nearer
+static char spiral_tunnel_shade(const void* ctx, const RaymarchHit* hit) {
+    const SpiralTunnel* tunnel = (const SpiralTunnel*)ctx;
+    if (!hit->hit) return ' ';
+    float angle = hit->z * tunnel->twist + tunnel->spin;
+    float c = cosf(angle), s = sinf(angle);
+    float u = fabsf(hit->x * c - hit->y * s);
+    float v = fabsf(hit->x * s + hit->y * c);
+    bool ring = hit->z - floorf(hit->z / tunnel->ring_spacing) * tunnel->ring_spacing < 0.5f;
+    bool corner = fabsf(u - v) < 0.25f;
+    if (!ring && !corner) return ' ';
+    const char tunnel_chars[] = ".+*#@";
+    int char_idx = (int)((1.0f - hit->t / TUNNEL_FAR) * 5.0f);
+    if (char_idx < 0) char_idx = 0;
+    if (char_idx > 4) char_idx = 4;
+    return tunnel_chars[char_idx];
+}
+
 // Scene 50: Spiral Tunnel
 void scene_spiral_tunnel(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
+    static __thread Raymarcher marchers[2];     // Frame history is per deck
     
     float speed = params[1].value * 2.0f;
-    float twist = params[0].value * 3.0f;
+    float twist = params[0].value * 0.3f;
     float density = params[2].value;
     
-    int center_x = width / 2;
-    int center_y = height / 2;
+    SpiralTunnel tunnel;
+    tunnel.twist = twist;
+    tunnel.spin = time * 0.5f;
+    tunnel.lipschitz = 1.0f / sqrtf(1.0f + 8.0f * twist * twist); // Corners sit 2.83 from the axis
+    tunnel.ring_spacing = 2.0f + density;
     
-    // Create spiral tunnel effect
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            float dx = x - center_x;
-            float dy = (y - center_y) * 2.0f; // Aspect correction
-            
-            float dist = sqrtf(dx * dx + dy * dy);
-            float angle = atan2f(dy, dx);
-            
-            // Spiral tunnel calculation
-            float tunnel_z = fmodf(dist * 0.3f - time * speed, 10.0f);
-            float spiral_angle = angle + tunnel_z * twist + time * 0.5f;
-            
-            float spiral_dist = tunnel_z * 2.0f;
-            
-            // Draw tunnel rings with spiral twist
-            if (fmodf(spiral_dist, 2.0f + density) < 0.5f) {
-                char tunnel_chars[] = ".+*#@";
-                int char_idx = (int)(fmodf(spiral_angle * 2.0f, 5.0f));
-                set_pixel(buffer, zbuffer, width, height, x, y, tunnel_chars[char_idx], tunnel_z);
-            }
-        }
-    }
+    // Fly down the tube
+    Mat4 camera = mat4_translation(0.0f, 0.0f, time * speed * 4.0f);
+    RaymarchView view = tunnel_view(spiral_tunnel_distance, spiral_tunnel_shade, &tunnel, &camera, width, height);
+    raymarch_render(&marchers[render_ctx.deck], &view, buffer, zbuffer, width, height, render_ctx.pool);
 }
 
 // Scene 51: Hex Tunnel
 void scene_hex_tunnel(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float speed = params[1].value * 3.0f;
     float size = params[0].value * 2.0f + 1.0f;
@@ -3246,7 +3160,6 @@ void scene_hex_tunnel(char* buffer, float* zbuffer, int width, int height, Param
 // Scene 52: Star Tunnel  
 void scene_star_tunnel(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float speed = params[1].value * 4.0f;
     float star_count = params[2].value * 50.0f + 20.0f;
@@ -3275,48 +3188,67 @@ void scene_star_tunnel(char* buffer, float* zbuffer, int width, int height, Para
     }
 }
 
+// Round tube whose centre line wanders and whose radius breathes
+typedef struct {
+    float sway;             // How far the centre line wanders
+    float time;
+} Wormhole;
+
+static void wormhole_centre(const Wormhole* hole, float z, float* cx, float* cy) {
+    *cx = sinf(z * 0.15f) * hole->sway;
+    *cy = cosf(z * 0.11f) * hole->sway * 0.6f;
+}
+
+static void wormhole_distance(const void* ctx, const float* x, const float* y, const float* z, float* distance) {
+    const Wormhole* hole = (const Wormhole*)ctx;
+    for (int i = 0; i < RAYMARCH_PACKET; i++) {
+        float cx, cy;
+        wormhole_centre(hole, z[i], &cx, &cy);
+        float dx = x[i] - cx, dy = y[i] - cy;
+        float radius = 2.0f + 0.4f * sinf(z[i] * 0.5f - hole->time * 2.0f);
+        distance[i] = (radius - sqrtf(dx * dx + dy * dy)) * 0.6f;
+    }
+}
+
+// Energy ripples spiralling along the wall
+static char wormhole_shade(const void* ctx, const RaymarchHit* hit) {
+    const Wormhole* hole = (const Wormhole*)ctx;
+    if (!hit->hit) return ' ';
+    float cx, cy;
+    wormhole_centre(hole, hit->z, &cx, &cy);
+    float angle = atan2f(hit->y - cy, hit->x - cx);
+    float ripple = sinf(hit->z * 1.5f + angle * 3.0f + hole->time * 3.0f);
+    if (ripple <= 0.3f) return ' ';
+    const char wormhole_chars[] = ".:-=*#@";
+    int char_idx = (int)((ripple + 1.0f) * 3.5f * (1.0f - 0.5f * hit->t / TUNNEL_FAR));
+    if (char_idx >= 7) char_idx = 6;
+    return wormhole_chars[char_idx];
+}
+
 // Scene 53: Wormhole
 void scene_wormhole(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
+    static __thread Raymarcher marchers[2];     // Frame history is per deck
     
     float speed = params[1].value * 2.0f;
     float distortion = params[3].value * 2.0f;
     
-    int center_x = width / 2;
-    int center_y = height / 2;
+    Wormhole hole = { distortion * 1.5f, time };
     
-    // Wormhole effect with space-time distortion
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            float dx = x - center_x;
-            float dy = (y - center_y) * 2.0f;
-            
-            float dist = sqrtf(dx * dx + dy * dy);
-            float angle = atan2f(dy, dx);
-            
-            // Wormhole distortion
-            float warp_factor = 1.0f + distortion * sinf(dist * 0.1f + time * 2.0f);
-            float tunnel_z = fmodf(dist * 0.2f * warp_factor - time * speed, 15.0f);
-            
-            // Energy ripples
-            float ripple = sinf(tunnel_z * 2.0f + angle * 3.0f + time * 3.0f);
-            
-            if (ripple > 0.3f) {
-                char wormhole_chars[] = ".:-=*#@";
-                int char_idx = (int)((ripple + 1.0f) * 3.5f);
-                if (char_idx >= 7) char_idx = 6;
-                
-                set_pixel(buffer, zbuffer, width, height, x, y, wormhole_chars[char_idx], tunnel_z);
-            }
-        }
-    }
+    // Ride the centre line, rolling slowly
+    float camera_z = time * speed * 4.0f;
+    float cx, cy;
+    wormhole_centre(&hole, camera_z, &cx, &cy);
+    Mat4 position = mat4_translation(cx, cy, camera_z);
+    Mat4 roll = mat4_rotation_z(time * 0.2f);
+    Mat4 camera = mat4_multiply(&position, &roll);
+    RaymarchView view = tunnel_view(wormhole_distance, wormhole_shade, &hole, &camera, width, height);
+    raymarch_render(&marchers[render_ctx.deck], &view, buffer, zbuffer, width, height, render_ctx.pool);
 }
 
 // Scene 54: Cyber Tunnel
 void scene_cyber_tunnel(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float speed = params[1].value * 3.0f;
     float grid_size = params[0].value * 2.0f + 2.0f;
@@ -3365,7 +3297,6 @@ void scene_cyber_tunnel(char* buffer, float* zbuffer, int width, int height, Par
 // Scene 55: Ring Tunnel
 void scene_ring_tunnel(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float speed = params[1].value * 2.5f;
     float ring_spacing = params[2].value * 3.0f + 2.0f;
@@ -3400,7 +3331,6 @@ void scene_ring_tunnel(char* buffer, float* zbuffer, int width, int height, Para
 // Scene 56: Matrix Tunnel
 void scene_matrix_tunnel(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float tunnel_depth = params[0].value * 40.0f + 20.0f;
     float speed = params[1].value * 5.0f + 1.0f;
@@ -3484,7 +3414,6 @@ void scene_matrix_tunnel(char* buffer, float* zbuffer, int width, int height, Pa
 // Scene 57: Speed Tunnel
 void scene_speed_tunnel(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float speed = params[1].value * 5.0f + 1.0f;
     float line_count = params[2].value * 30.0f + 10.0f;
@@ -3523,7 +3452,6 @@ void scene_speed_tunnel(char* buffer, float* zbuffer, int width, int height, Par
 // Scene 58: Pulse Tunnel
 void scene_pulse_tunnel(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float pulse_speed = params[1].value * 2.0f + 0.5f;
     float pulse_freq = params[3].value * 3.0f + 1.0f;
@@ -3557,43 +3485,60 @@ void scene_pulse_tunnel(char* buffer, float* zbuffer, int width, int height, Par
     }
 }
 
+// Round tube with three ridges that coil around it
+typedef struct {
+    float coil;             // Turn of the ridges per unit of z
+    float spin;
+    float lipschitz;
+} VortexTunnel;
+
+// sin(3 * angle) of (x, y) turned back by 'angle0', without atan2f
+static float vortex_ridge(float x, float y, float r, float angle0) {
+    float s = (y * cosf(angle0) - x * sinf(angle0)) / (r + 1e-6f);
+    return 3.0f * s - 4.0f * s * s * s;
+}
+
+static void vortex_tunnel_distance(const void* ctx, const float* x, const float* y, const float* z, float* distance) {
+    const VortexTunnel* vortex = (const VortexTunnel*)ctx;
+    for (int i = 0; i < RAYMARCH_PACKET; i++) {
+        float r = sqrtf(x[i] * x[i] + y[i] * y[i]);
+        float ridge = vortex_ridge(x[i], y[i], r, z[i] * vortex->coil + vortex->spin);
+        distance[i] = (2.0f - r - 0.35f * ridge) * vortex->lipschitz;
+    }
+}
+
+// Ridges bright and valleys dark, fading with depth
+static char vortex_tunnel_shade(const void* ctx, const RaymarchHit* hit) {
+    const VortexTunnel* vortex = (const VortexTunnel*)ctx;
+    if (!hit->hit) return ' ';
+    float r = sqrtf(hit->x * hit->x + hit->y * hit->y);
+    float spiral_intensity = vortex_ridge(hit->x, hit->y, r, hit->z * vortex->coil + vortex->spin);
+    float fade = 1.0f - hit->t / TUNNEL_FAR;
+    if (spiral_intensity < -0.6f || fade <= 0.0f) return ' ';
+    const char vortex_chars[] = ".:-=*#@";
+    int char_idx = (int)((spiral_intensity + 1.0f) * 3.5f * fade);
+    if (char_idx >= 7) char_idx = 6;
+    return vortex_chars[char_idx];
+}
+
 // Scene 59: Vortex Tunnel
 void scene_vortex_tunnel(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
+    static __thread Raymarcher marchers[2];     // Frame history is per deck
     
     float rotation_speed = params[1].value * 2.0f;
     float vortex_power = params[3].value * 2.0f + 1.0f;
     float depth_speed = params[0].value * 3.0f + 1.0f;
     
-    int center_x = width / 2;
-    int center_y = height / 2;
+    VortexTunnel vortex;
+    vortex.coil = vortex_power * 0.1f;
+    vortex.spin = time * rotation_speed;
+    // The ridges steepen the field by their slope around and along the tube
+    vortex.lipschitz = 0.6f / sqrtf(1.0f + 4.0f * vortex.coil * vortex.coil);
     
-    // Swirling vortex tunnel
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            float dx = x - center_x;
-            float dy = (y - center_y) * 2.0f;
-            
-            float dist = sqrtf(dx * dx + dy * dy);
-            float angle = atan2f(dy, dx);
-            
-            // Vortex transformation
-            float vortex_angle = angle + (vortex_power / (dist + 1.0f)) + time * rotation_speed;
-            float tunnel_z = fmodf(dist * 0.3f - time * depth_speed, 15.0f);
-            
-            // Spiral arms
-            float spiral_intensity = sinf(vortex_angle * 3.0f + tunnel_z * 2.0f);
-            
-            if (spiral_intensity > 0.2f) {
-                char vortex_chars[] = ".:-=*#@";
-                int char_idx = (int)((spiral_intensity + 1.0f) * 3.5f);
-                if (char_idx >= 7) char_idx = 6;
-                
-                set_pixel(buffer, zbuffer, width, height, x, y, vortex_chars[char_idx], tunnel_z);
-            }
-        }
-    }
+    Mat4 camera = mat4_translation(0.0f, 0.0f, time * depth_speed * 3.0f);
+    RaymarchView view = tunnel_view(vortex_tunnel_distance, vortex_tunnel_shade, &vortex, &camera, width, height);
+    raymarch_render(&marchers[render_ctx.deck], &view, buffer, zbuffer, width, height, render_ctx.pool);
 }
 
 // Function declarations
@@ -3603,43 +3548,78 @@ void draw_growing_tree_branch(char* buffer, float* zbuffer, int width, int heigh
 
 // ============= NATURE SCENES (60-69) =============
 
+#define LANDSCAPE_FAR 48.0f         // Farthest terrain drawn
+#define LANDSCAPE_SPACING 0.25f     // World units between heightmap samples
+
+// What the landscape shaders need besides the sample
+typedef struct {
+    float peak;             // World height of a map value of 1
+    float far;
+    float time;
+} LandscapeLook;
+
+// Size a landscape scene's heightmap for its noise and scroll it to the
+// camera. Rows run from just behind the camera past LANDSCAPE_FAR, and
+// columns cover the widest view the scenes use (focal = width / 2) at that
+// depth with room to sway. Returns false if the map could not be sized.
+static bool landscape_map(Heightmap* map, const TerrainNoise* noise, float camera_z) {
+    int columns = (int)(2.4f * LANDSCAPE_FAR / LANDSCAPE_SPACING);
+    int rows = (int)(LANDSCAPE_FAR / LANDSCAPE_SPACING) + 16;
+    if (!heightmap_configure(map, columns, rows, LANDSCAPE_SPACING, noise)) return false;
+    heightmap_scroll(map, camera_z - 2.0f, render_ctx.pool);
+    return true;
+}
+
+// Flyover view with the deck's level of detail setting the depth step
+static TerrainView landscape_view(float x, float y, float z, float yaw, int width, int height, float horizon,
+                                  float far, const LandscapeLook* look, TerrainShade shade) {
+    TerrainView view = {
+        x, y, z, yaw,
+        height * horizon, width * 0.5f,
+        1.0f, far, 0.1f / render_ctx.quality,
+        look->peak, -INFINITY,
+        shade, look
+    };
+    return view;
+}
+
+// Index into a ramp of 'count' glyphs for a 0..1 level
+static inline int landscape_glyph(float level, int count) {
+    int index = (int)(level * count);
+    return index < 0 ? 0 : (index >= count ? count - 1 : index);
+}
+
+// Crests catch foam, faces toward the camera read brighter than the backs
+static char ocean_shade(const void* ctx, const TerrainSample* sample) {
+    const LandscapeLook* look = (const LandscapeLook*)ctx;
+    if (sample->height > look->peak * 0.68f && sample->slope > 0.0f) return '^';
+    const char water_chars[] = "_.-~=";
+    float fade = 1.0f - 0.6f * sample->distance / look->far;
+    float shimmer = 0.1f * sinf(sample->x * 2.0f + look->time * 3.0f);
+    return water_chars[landscape_glyph((0.45f + sample->slope * 2.0f + shimmer) * fade, 5)];
+}
+
 void scene_ocean_waves(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
+    static __thread Heightmap swell;
     
     float wave_speed = params[1].value + 0.5f;
     float wave_height = params[0].value * 0.3f + 0.1f;
     float detail = params[2].value * 2.0f + 1.0f;
     
-    // Multiple wave layers for realistic ocean
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            float wave1 = sinf(x * 0.1f + time * wave_speed) * wave_height;
-            float wave2 = sinf(x * 0.05f + time * wave_speed * 0.7f) * wave_height * 0.8f;
-            float wave3 = sinf(x * 0.15f + time * wave_speed * 1.3f) * wave_height * 0.6f;
-            
-            float combined_wave = wave1 + wave2 + wave3;
-            float wave_y = height * 0.6f + combined_wave * height * 0.2f;
-            
-            if (y > wave_y) {
-                // Water characters based on depth
-                float depth = (y - wave_y) / (height - wave_y);
-                char water_chars[] = "~≈≋∞";
-                int char_idx = (int)(depth * detail) % 4;
-                set_pixel(buffer, zbuffer, width, height, x, y, water_chars[char_idx], depth);
-            } else if (y > wave_y - 2) {
-                // Wave foam
-                if ((int)(x + time * 10) % 3 == 0) {
-                    set_pixel(buffer, zbuffer, width, height, x, y, '.', 0.1f);
-                }
-            }
-        }
-    }
+    // Rolling swell; the camera drifts over it so the waves run past
+    TerrainNoise noise = { 0.15f, (int)detail + 1, 0.5f, false, 3 };
+    LandscapeLook look = { wave_height * 8.0f, LANDSCAPE_FAR, time };
+    float camera_z = time * wave_speed * 4.0f;
+    if (!landscape_map(&swell, &noise, camera_z)) return;
+    
+    TerrainView view = landscape_view(sinf(time * 0.2f) * 2.0f, look.peak + 1.5f, camera_z, sinf(time * 0.11f) * 0.1f,
+                                      width, height, 0.4f, LANDSCAPE_FAR, &look, ocean_shade);
+    terrain_render(&swell, &view, buffer, zbuffer, width, height, render_ctx.pool);
 }
 
 void scene_rain_storm(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float rain_intensity = params[0].value * 200.0f + 50.0f;
     float wind_effect = params[2].value * 2.0f;
@@ -3675,7 +3655,6 @@ void scene_rain_storm(char* buffer, float* zbuffer, int width, int height, Param
 
 void scene_infinite_forest(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float depth_speed = params[1].value + 0.5f;
     float tree_density = params[0].value * 20.0f + 10.0f;
@@ -3725,7 +3704,6 @@ void scene_infinite_forest(char* buffer, float* zbuffer, int width, int height,
 
 void scene_growing_trees(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float growth_speed = params[1].value + 0.3f;
     int tree_count = (int)(params[0].value * 5.0f + 3.0f);
@@ -3787,43 +3765,36 @@ void draw_growing_tree_branch(char* buffer, float* zbuffer, int width, int heigh
     }
 }
 
+// Snow above the tree line, rock lit by how steeply it faces the camera,
+// hazing with distance
+static char mountain_shade(const void* ctx, const TerrainSample* sample) {
+    const LandscapeLook* look = (const LandscapeLook*)ctx;
+    if (sample->water) return '~';
+    if (sample->height > look->peak * 0.9f) return '^';
+    const char mountain_chars[] = ".:-=+*#";
+    float fade = 1.0f - 0.7f * sample->distance / look->far;
+    return mountain_chars[landscape_glyph((0.5f + sample->slope * 0.4f) * fade, 7)];
+}
+
 void scene_mountain_range(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
+    static __thread Heightmap range;
     
     float cloud_speed = params[1].value * 0.5f;
     float mountain_height = params[0].value * 0.4f + 0.3f;
     float detail_level = params[2].value * 3.0f + 1.0f;
     
-    // Multiple mountain layers for depth
-    for (int layer = 0; layer < 4; layer++) {
-        float layer_height = mountain_height * (1.0f - layer * 0.2f);
-        float parallax = layer * 0.1f;
-        
-        for (int x = 0; x < width; x++) {
-            // Fractal mountain generation
-            float mountain_y = 0.0f;
-            float freq = 0.01f;
-            float amp = layer_height;
-            
-            for (int octave = 0; octave < (int)detail_level; octave++) {
-                mountain_y += sinf((x + time * parallax) * freq) * amp;
-                freq *= 2.0f;
-                amp *= 0.5f;
-            }
-            
-            int peak_y = (int)(height * (0.7f - mountain_y));
-            
-            // Draw mountain silhouette
-            for (int y = peak_y; y < height; y++) {
-                float depth = layer * 2.0f;
-                char mountain_chars[] = "^∧▲";
-                int char_idx = (y - peak_y) / 3;
-                if (char_idx >= 3) char_idx = 2;
-                
-                set_pixel(buffer, zbuffer, width, height, x, y, mountain_chars[char_idx], depth);
-            }
-        }
+    // Ridged peaks with lakes in the lowest valleys, flown over slowly
+    int octaves = (int)detail_level + 2;
+    TerrainNoise noise = { 0.05f, octaves > 8 ? 8 : octaves, 0.5f, true, 7 };
+    LandscapeLook look = { mountain_height * 20.0f, LANDSCAPE_FAR, time };
+    float camera_z = time * 2.0f;
+    if (landscape_map(&range, &noise, camera_z)) {
+        TerrainView view = landscape_view(sinf(time * 0.1f) * 4.0f, look.peak * 0.85f + 2.0f, camera_z,
+                                          sinf(time * 0.13f) * 0.15f, width, height, 0.35f, LANDSCAPE_FAR,
+                                          &look, mountain_shade);
+        view.water = look.peak * 0.3f;
+        terrain_render(&range, &view, buffer, zbuffer, width, height, render_ctx.pool);
     }
     
     // Moving clouds
@@ -3849,7 +3820,6 @@ void scene_mountain_range(char* buffer, float* zbuffer, int width, int height, P
 
 void scene_aurora_borealis(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float wave_speed = params[1].value * 2.0f + 1.0f;
     float intensity = params[0].value + 0.3f;
@@ -3900,7 +3870,6 @@ void scene_aurora_borealis(char* buffer, float* zbuffer, int width, int height,
 
 void scene_flowing_river(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float flow_speed = params[1].value * 3.0f + 1.0f;
     float river_width = params[0].value * 20.0f + 10.0f;
@@ -3957,40 +3926,30 @@ void scene_flowing_river(char* buffer, float* zbuffer, int width, int height, Pa
     }
 }
 
+// Windward faces bright, lee faces dark
+static char dune_shade(const void* ctx, const TerrainSample* sample) {
+    const LandscapeLook* look = (const LandscapeLook*)ctx;
+    const char sand_chars[] = ".,:;=";
+    float fade = 1.0f - 0.6f * sample->distance / look->far;
+    return sand_chars[landscape_glyph((0.45f + sample->slope * 0.8f) * fade, 5)];
+}
+
 void scene_desert_dunes(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
+    static __thread Heightmap dunes;
     
     float wind_speed = params[1].value * 0.5f + 0.1f;
     float dune_height = params[0].value * 0.3f + 0.2f;
     float sand_detail = params[2].value * 5.0f + 2.0f;
     
-    // Dune layers with wind effect
-    for (int layer = 0; layer < 3; layer++) {
-        float layer_depth = layer * 2.0f;
-        float wind_offset = time * wind_speed * (layer + 1);
-        
-        for (int x = 0; x < width; x++) {
-            // Multiple sine waves for realistic dune shapes
-            float dune_y = 0.0f;
-            float freq = 0.02f * (layer + 1);
-            float amp = dune_height * (1.0f - layer * 0.3f);
-            
-            for (int octave = 0; octave < (int)sand_detail; octave++) {
-                dune_y += sinf((x + wind_offset * 20.0f) * freq) * amp;
-                freq *= 2.0f;
-                amp *= 0.6f;
-            }
-            
-            int peak_y = (int)(height * (0.6f + dune_y));
-            
-            // Draw sand dune
-            for (int y = peak_y; y < height; y++) {
-                char sand_chars[] = ".·°∘";
-                int char_idx = ((x + y + (int)(wind_offset * 10.0f)) % 4);
-                set_pixel(buffer, zbuffer, width, height, x, y, sand_chars[char_idx], layer_depth);
-            }
-        }
+    // Sharp-crested dunes skimmed at low altitude, drifting with the wind
+    TerrainNoise noise = { 0.08f, 1 + (int)sand_detail / 3, 0.35f, true, 21 };
+    LandscapeLook look = { dune_height * 12.0f, LANDSCAPE_FAR, time };
+    float camera_z = time * wind_speed * 6.0f;
+    if (landscape_map(&dunes, &noise, camera_z)) {
+        TerrainView view = landscape_view(0.0f, look.peak * 0.9f + 1.0f, camera_z, sinf(time * 0.07f) * 0.2f,
+                                          width, height, 0.4f, LANDSCAPE_FAR, &look, dune_shade);
+        terrain_render(&dunes, &view, buffer, zbuffer, width, height, render_ctx.pool);
     }
     
     // Blowing sand particles
@@ -4014,7 +3973,6 @@ void scene_desert_dunes(char* buffer, float* zbuffer, int width, int height, Par
 
 void scene_coral_reef(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float current_speed = params[1].value + 0.3f;
     float coral_density = params[0].value * 30.0f + 20.0f;
@@ -4075,7 +4033,6 @@ void scene_coral_reef(char* buffer, float* zbuffer, int width, int height, Param
 
 void scene_butterfly_garden(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float flutter_speed = params[1].value * 2.0f + 1.0f;
     int butterfly_count = (int)(params[0].value * 20.0f + 10.0f);
@@ -4154,7 +4111,6 @@ void scene_butterfly_garden(char* buffer, float* zbuffer, int width, int height,
 
 void scene_nuclear_blast(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float blast_power = params[0].value * 3.0f + 1.0f;
     float shockwave_speed = params[1].value * 5.0f + 2.0f;
@@ -4246,7 +4202,6 @@ void scene_nuclear_blast(char* buffer, float* zbuffer, int width, int height, Pa
 
 void scene_building_collapse(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float collapse_speed = params[1].value + 0.5f;
     float building_height = params[0].value * 30.0f + 20.0f;
@@ -4305,7 +4260,6 @@ void scene_building_collapse(char* buffer, float* zbuffer, int width, int height
 
 void scene_meteor_impact(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float impact_power = params[0].value * 3.0f + 2.0f;
     float atmospheric_effects = params[1].value + 0.5f;
@@ -4552,7 +4506,6 @@ void scene_meteor_impact(char* buffer, float* zbuffer, int width, int height, Pa
 
 void scene_chain_explosions(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float chain_speed = params[1].value * 2.0f + 1.0f;
     float explosion_size = params[0].value * 15.0f + 8.0f;
@@ -4605,7 +4558,6 @@ void scene_chain_explosions(char* buffer, float* zbuffer, int width, int height,
 
 void scene_volcanic_eruption(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float eruption_power = params[0].value * 3.0f + 1.0f;
     float lava_flow_speed = params[1].value * 2.0f + 0.5f;
@@ -4686,7 +4638,6 @@ void scene_volcanic_eruption(char* buffer, float* zbuffer, int width, int height
 
 void scene_shockwave_blast(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float wave_speed = params[1].value * 5.0f + 3.0f;
     float wave_power = params[0].value * 2.0f + 1.0f;
@@ -4756,9 +4707,10 @@ void scene_shockwave_blast(char* buffer, float* zbuffer, int width, int height,
     }
 }
 
+#define GLASS_MAX_SHARDS 210     // Three per crack at the densest setting
+
 void scene_glass_shatter(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float shatter_speed = params[1].value * 2.0f + 1.0f;
     float crack_density = params[2].value * 20.0f + 10.0f;
@@ -4803,16 +4755,28 @@ void scene_glass_shatter(char* buffer, float* zbuffer, int width, int height, Pa
             }
         }
         
-        // Concentric cracks
-        for (int ring = 1; ring <= 5; ring++) {
-            float ring_radius = ring * 8.0f;
-            if (ring_radius < crack_reach) {
-                for (int a = 0; a < 360; a += 10) {
-                    float ring_x = impact_x + cosf(a * 0.0174f) * ring_radius;
-                    float ring_y = impact_y + sinf(a * 0.0174f) * ring_radius;
-                    
-                    if (ring_x >= 0 && ring_x < width && ring_y >= 0 && ring_y < height) {
-                        set_pixel(buffer, zbuffer, width, height, (int)ring_x, (int)ring_y, '\\', 1.5f);
+        // Shard outlines: Voronoi edges around seeds packed tighter near
+        // the impact, revealed as the cracks spread
+        int shard_count = (int)crack_density * 3;
+        if (shard_count > GLASS_MAX_SHARDS) shard_count = GLASS_MAX_SHARDS;
+        float shard_x[GLASS_MAX_SHARDS], shard_y[GLASS_MAX_SHARDS];
+        float max_radius = sqrtf((float)(width * width + height * height)) * 0.5f;
+        for (int k = 0; k < shard_count; k++) {
+            float t = (k + 0.5f) / shard_count;
+            float angle = k * 2.399963f + sinf(k * 1.7f) * 0.3f;
+            float radius = max_radius * t * sqrtf(t);
+            shard_x[k] = impact_x + cosf(angle) * radius;
+            shard_y[k] = impact_y + sinf(angle) * radius * 0.5f;
+        }
+        
+        // Rows are scaled by 2 so shards come out roughly square on screen
+        if (voronoi_compute(&scene_voronoi, shard_x, shard_y, shard_count, width, height, 2.0f, render_ctx.pool)) {
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    const VoronoiCell* cell = &scene_voronoi.cells[y * width + x];
+                    float dx = x - impact_x, dy = y - impact_y;
+                    if (cell->d2 - cell->d1 < 1.2f && dx * dx + dy * dy < crack_reach * crack_reach) {
+                        set_pixel(buffer, zbuffer, width, height, x, y, '\\', 1.5f);
                     }
                 }
             }
@@ -4849,7 +4813,6 @@ void scene_glass_shatter(char* buffer, float* zbuffer, int width, int height, Pa
 
 void scene_demolition_blast(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float blast_sequence_speed = params[1].value + 0.5f;
     float building_count = params[0].value * 3.0f + 2.0f;
@@ -4949,7 +4912,6 @@ void scene_demolition_blast(char* buffer, float* zbuffer, int width, int height,
 
 void scene_supernova_burst(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float explosion_scale = params[0].value * 3.0f + 1.0f;
     float energy_waves = params[1].value * 5.0f + 3.0f;
@@ -5076,7 +5038,6 @@ void scene_supernova_burst(char* buffer, float* zbuffer, int width, int height,
 
 void scene_plasma_discharge(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float discharge_frequency = params[1].value * 3.0f + 2.0f;
     float arc_intensity = params[0].value * 2.0f + 1.0f;
@@ -5204,50 +5165,44 @@ void scene_plasma_discharge(char* buffer, float* zbuffer, int width, int height,
 
 void scene_city_flythrough(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
+    static __thread MeshView view;
+    static __thread Rasterizer raster;
     
     float camera_speed = params[1].value * 2.0f + 1.0f;
     float building_density = params[0].value * 20.0f + 15.0f;
     float perspective_depth = params[2].value * 50.0f + 30.0f;
     
-    float camera_z = fmodf(time * camera_speed * 10.0f, 100.0f);
-    
-    // Draw buildings in perspective
-    for (int b = 0; b < (int)building_density; b++) {
-        float building_x = fmodf(b * 17.3f, width) - width * 0.5f;
-        float building_z = fmodf(b * 23.7f, perspective_depth) + camera_z;
-        
-        if (building_z > 0 && building_z < perspective_depth) {
-            // Perspective projection
-            float screen_x = building_x / building_z * perspective_depth + width * 0.5f;
-            float building_height = (20.0f + sinf(b) * 15.0f) / building_z * perspective_depth;
-            float building_width = 4.0f / building_z * perspective_depth;
-            
-            if (screen_x > -building_width && screen_x < width + building_width) {
-                // Draw building
-                for (int h = 0; h < (int)building_height && h < height; h++) {
-                    int y = height - 1 - h;
-                    
-                    for (int w = -(int)(building_width * 0.5f); w <= (int)(building_width * 0.5f); w++) {
-                        int x = (int)(screen_x + w);
-                        if (x >= 0 && x < width) {
-                            // Building structure
-                            char building_chars[] = "|#H";
-                            int char_idx = (int)(building_z / perspective_depth * 2.0f);
-                            if (char_idx >= 3) char_idx = 2;
-                            
-                            set_pixel(buffer, zbuffer, width, height, x, y, building_chars[char_idx], building_z);
-                            
-                            // Windows
-                            if (h % 3 == 0 && w % 2 == 0) {
-                                set_pixel(buffer, zbuffer, width, height, x, y, 'o', building_z - 0.1f);
-                            }
-                        }
-                    }
-                }
-            }
+    float camera_z = time * camera_speed * 10.0f;
+    
+    // Lots line both sides of the street at a fixed spacing, so a lot keeps
+    // its building as the camera flies past
+    int buildings = lod_count((int)building_density, 5);
+    float spacing = 2.0f * perspective_depth / buildings;
+    int first_lot = (int)floorf(camera_z / spacing);
+    float street = 6.0f, ground = 10.0f;
+    
+    MeshCamera camera = mesh_camera(width, height, width * 0.6f);
+    RasterStyle style = { ".:|H#", RASTER_FLAT, { -0.6f, -0.8f, -0.3f }, 0.15f, true };
+    raster_begin(&raster, width, height);
+    for (int lot = first_lot; lot < first_lot + buildings / 2 + 1; lot++) {
+        float lot_z = lot * spacing - camera_z;
+        if (lot_z > perspective_depth) break;
+        for (int side = -1; side <= 1; side += 2) {
+            float seed = fabsf(sinf(lot * 12.9898f + side * 78.233f)) * 43758.5453f;
+            float r1 = seed - floorf(seed), r2 = seed * 7.0f - floorf(seed * 7.0f);
+            float building_height = 6.0f + r1 * 18.0f;
+            float building_width = 3.0f + r2 * 3.0f;
+            float depth = spacing * 0.8f;
+            
+            Mat4 size = mat4_scaling(building_width * 0.5f, building_height * 0.5f, depth * 0.5f);
+            Mat4 place = mat4_translation(side * (street + building_width * 0.5f + r2 * 2.0f),
+                                          ground - building_height * 0.5f, lot_z);
+            Mat4 model = mat4_multiply(&place, &size);
+            if (!mesh_transform(&mesh_cube, &model, &camera, &view)) return;
+            raster_add_mesh(&raster, &mesh_cube, &view, &camera, &style);
         }
     }
+    raster_flush(&raster, buffer, zbuffer, render_ctx.pool);
     
     // Street level
     for (int x = 0; x < width; x++) {
@@ -5492,7 +5447,6 @@ void scene_neon_cyberpunk(char* buffer, float* zbuffer, int width, int height, P
 
 void scene_city_lights(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float light_density = params[0].value * 200.0f + 150.0f;
     float twinkle_speed = params[1].value * 3.0f + 2.0f;
@@ -5598,7 +5552,6 @@ void scene_city_lights(char* buffer, float* zbuffer, int width, int height, Para
 
 void scene_skyscraper_forest(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float density = params[0].value * 30.0f + 20.0f;
     float height_variation = params[1].value + 0.5f;
@@ -5691,7 +5644,6 @@ void scene_skyscraper_forest(char* buffer, float* zbuffer, int width, int height
 
 void scene_urban_decay(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float decay_level = params[0].value + 0.3f;
     float nature_reclaim = params[1].value;
@@ -5825,7 +5777,6 @@ void scene_urban_decay(char* buffer, float* zbuffer, int width, int height, Para
 
 void scene_future_metropolis(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float tech_level = params[0].value + 0.5f;
     float aerial_traffic = params[1].value * 20.0f + 10.0f;
@@ -5981,7 +5932,6 @@ void scene_future_metropolis(char* buffer, float* zbuffer, int width, int height
 
 void scene_city_grid(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float grid_density = params[0].value * 2.0f + 1.0f;
     float data_flow = params[1].value * 5.0f + 2.0f;
@@ -6122,7 +6072,6 @@ void scene_city_grid(char* buffer, float* zbuffer, int width, int height, Parame
 
 void scene_digital_city(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float wireframe_density = params[0].value + 0.5f;
     float digital_noise = params[1].value * 3.0f;
@@ -6264,7 +6213,6 @@ void scene_digital_city(char* buffer, float* zbuffer, int width, int height, Par
 
 void scene_black_hole(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float gravity_strength = params[0].value * 2.0f + 1.0f;
     float accretion_speed = params[1].value * 3.0f + 2.0f;
@@ -6397,7 +6345,6 @@ void scene_black_hole(char* buffer, float* zbuffer, int width, int height, Param
 
 void scene_cyberpunk_city(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float neon_intensity = params[0].value + 0.5f;
     float rain_amount = params[1].value * 50.0f + 30.0f;
@@ -6458,7 +6405,6 @@ void scene_cyberpunk_city(char* buffer, float* zbuffer, int width, int height, P
 
 void scene_neon_districts(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float neon_frequency = params[0].value * 5.0f + 3.0f;
     float district_count = params[1].value * 8.0f + 4.0f;
@@ -6509,7 +6455,6 @@ void scene_neon_districts(char* buffer, float* zbuffer, int width, int height, P
 
 void scene_urban_canyon(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float canyon_depth = params[0].value * 20.0f + 15.0f;
     float building_variation = params[1].value + 0.5f;
@@ -6587,7 +6532,6 @@ void scene_urban_canyon(char* buffer, float* zbuffer, int width, int height, Par
 
 void scene_dimensional_rift(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float rift_size = params[0].value * 15.0f + 10.0f;
     float dimensional_drift = params[1].value * 3.0f + 1.0f;
@@ -6647,23 +6591,33 @@ void scene_dimensional_rift(char* buffer, float* zbuffer, int width, int height,
     }
 }
 
+// Acid sea rippling, ground in the old terrain glyphs by light
+static char alien_shade(const void* ctx, const TerrainSample* sample) {
+    const LandscapeLook* look = (const LandscapeLook*)ctx;
+    if (sample->water) return sinf(sample->x * 1.5f + sample->z + look->time * 2.0f) > 0.0f ? '~' : '-';
+    const char terrain_chars[] = ":=+#";
+    float fade = 1.0f - 0.5f * sample->distance / look->far;
+    return terrain_chars[landscape_glyph((0.5f + sample->slope * 0.5f) * fade, 4)];
+}
+
 void scene_alien_landscape(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
+    static __thread Heightmap ground;
     
     float crystal_density = params[0].value * 30.0f + 20.0f;
     float atmosphere_thickness = params[1].value * 3.0f + 1.0f;
     float alien_life = params[2].value;
     
-    // Alien terrain
-    for (int x = 0; x < width; x++) {
-        float terrain_height = height * 0.7f + sinf(x * 0.1f + time * 0.2f) * 5.0f + sinf(x * 0.03f) * 10.0f;
-        
-        for (int y = (int)terrain_height; y < height; y++) {
-            char terrain_chars[] = "~:=";
-            int char_idx = (y - (int)terrain_height) % 3;
-            set_pixel(buffer, zbuffer, width, height, x, y, terrain_chars[char_idx], 6.0f);
-        }
+    // Jagged ground around an acid sea; thicker atmosphere hides the distance
+    TerrainNoise noise = { 0.1f, 4, 0.55f, true, 99 };
+    float far = LANDSCAPE_FAR / (0.5f + atmosphere_thickness * 0.25f);
+    LandscapeLook look = { 8.0f, far, time };
+    float camera_z = time * 1.5f;
+    if (landscape_map(&ground, &noise, camera_z)) {
+        TerrainView view = landscape_view(0.0f, look.peak + 1.0f, camera_z, sinf(time * 0.09f) * 0.25f,
+                                          width, height, 0.45f, far, &look, alien_shade);
+        view.water = look.peak * 0.35f;
+        terrain_render(&ground, &view, buffer, zbuffer, width, height, render_ctx.pool);
     }
     
     // Crystal formations with shimmer
@@ -6703,7 +6657,6 @@ void scene_alien_landscape(char* buffer, float* zbuffer, int width, int height,
 
 void scene_robot_factory(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float production_speed = params[0].value * 5.0f + 2.0f;
     float robot_count = params[1].value * 10.0f + 5.0f;
@@ -6751,7 +6704,6 @@ void scene_robot_factory(char* buffer, float* zbuffer, int width, int height, Pa
 
 void scene_time_vortex(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float vortex_speed = params[0].value * 5.0f + 2.0f;
     float temporal_distortion = params[1].value * 3.0f + 1.0f;
@@ -6803,7 +6755,6 @@ void scene_time_vortex(char* buffer, float* zbuffer, int width, int height, Para
 
 void scene_glitch_world(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float glitch_intensity = params[0].value + 0.2f;
     float corruption_level = params[1].value;
@@ -6861,7 +6812,6 @@ void scene_glitch_world(char* buffer, float* zbuffer, int width, int height, Par
 
 void scene_neural_network(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float network_complexity = params[0].value * 5.0f + 3.0f;
     float signal_speed = params[1].value * 5.0f + 2.0f;
@@ -6910,7 +6860,6 @@ void scene_neural_network(char* buffer, float* zbuffer, int width, int height, P
 
 void scene_cosmic_dance(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float dance_speed = params[0].value * 3.0f + 1.0f;
     float body_count = params[1].value * 8.0f + 4.0f;
@@ -6964,7 +6913,6 @@ void scene_cosmic_dance(char* buffer, float* zbuffer, int width, int height, Par
 
 void scene_reality_glitch(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float reality_stability = 1.0f - params[0].value;
     float glitch_frequency = params[1].value * 10.0f + 5.0f;
@@ -7378,7 +7326,6 @@ void draw_radar_overlay(char* buffer, float* zbuffer, int width, int height, flo
 // Scene 100: Human Walker - Single figure walking
 void scene_human_walker(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float walk_speed = params[0].value * 5.0f + 1.0f;
     float stride_length = params[1].value * 2.0f + 0.5f;
@@ -7422,7 +7369,6 @@ void scene_human_walker(char* buffer, float* zbuffer, int width, int height, Par
 // Scene 101: Dance Party - Multiple figures dancing
 void scene_dance_party(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     int num_dancers = (int)(params[0].value * 5.0f) + 1;
     float dance_energy = params[1].value * 2.0f + 0.5f;
@@ -7470,7 +7416,6 @@ void scene_dance_party(char* buffer, float* zbuffer, int width, int height, Para
 // Scene 102: Martial Arts - Figure performing martial arts moves
 void scene_martial_arts(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float move_speed = params[0].value * 3.0f + 0.5f;
     float kick_height = params[1].value * 2.0f + 1.0f;
@@ -7542,7 +7487,6 @@ void scene_martial_arts(char* buffer, float* zbuffer, int width, int height, Par
 // Scene 103: Human Pyramid - Multiple figures forming a pyramid
 void scene_human_pyramid(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     int pyramid_size = (int)(params[0].value * 3.0f) + 2;
     float stability = params[1].value;
@@ -7588,7 +7532,6 @@ void scene_human_pyramid(char* buffer, float* zbuffer, int width, int height, Pa
 // Scene 104: Yoga Flow - Figure transitioning between yoga poses
 void scene_yoga_flow(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float flow_speed = params[0].value * 2.0f + 0.3f;
     float flexibility = params[1].value * 2.0f + 0.5f;
@@ -7673,7 +7616,6 @@ void scene_yoga_flow(char* buffer, float* zbuffer, int width, int height, Parame
 // Scene 105: Sports Stadium - Multiple figures playing sports
 void scene_sports_stadium(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float game_speed = params[0].value * 3.0f + 1.0f;
     int num_players = (int)(params[1].value * 4.0f) + 2;
@@ -7736,7 +7678,6 @@ void scene_sports_stadium(char* buffer, float* zbuffer, int width, int height, P
 // Scene 106: Robot Dance - Mechanical human movements
 void scene_robot_dance(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float robot_speed = params[0].value * 4.0f + 1.0f;
     float stiffness = params[1].value;
@@ -7819,7 +7760,6 @@ void scene_robot_dance(char* buffer, float* zbuffer, int width, int height, Para
 // Scene 107: Crowd Wave - Stadium crowd doing the wave
 void scene_crowd_wave(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float wave_speed = params[0].value * 3.0f + 0.5f;
     float wave_height = params[1].value * 2.0f + 0.5f;
@@ -7877,7 +7817,6 @@ void scene_crowd_wave(char* buffer, float* zbuffer, int width, int height, Param
 // Scene 108: Mirror Dance - Figure dancing with mirror reflection
 void scene_mirror_dance(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float dance_complexity = params[0].value * 3.0f + 1.0f;
     float mirror_delay = params[1].value * 0.5f;
@@ -7950,7 +7889,6 @@ void scene_mirror_dance(char* buffer, float* zbuffer, int width, int height, Par
 // Scene 109: Evolution - Figure evolving from primitive to modern
 void scene_human_evolution(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float evolution_speed = params[0].value * 2.0f + 0.5f;
     int num_stages = (int)(params[1].value * 4.0f) + 3;
@@ -8030,7 +7968,6 @@ void scene_human_evolution(char* buffer, float* zbuffer, int width, int height,
 // Scene 110: Fighter Squadron - Multiple fighter jets in formation
 void scene_fighter_squadron(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     int squadron_size = (int)(params[0].value * 8.0f) + 3;
     float formation_tightness = params[1].value;
@@ -8091,7 +8028,6 @@ void scene_fighter_squadron(char* buffer, float* zbuffer, int width, int height,
 // Scene 111: Drone Swarm Attack - Multiple small drones
 void scene_drone_swarm(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     int swarm_size = (int)(params[0].value * 20.0f) + 10;
     float swarm_aggression = params[1].value;
@@ -8110,17 +8046,42 @@ void scene_drone_swarm(char* buffer, float* zbuffer, int width, int height, Para
         draw_strategic_target(buffer, zbuffer, width, height, &target);
     }
     
+    // The swarm flocks over the ground plane (x -10..10, z -2..6) toward
+    // a strike point sweeping across the targets
+    static Flock swarm;
+    static SimClock clock = { SIM_RATE_HZ };
+    if (!flock_resize(&swarm, swarm_size, 20.0f, 8.0f, 0.2f)) return;
+    
+    FlockRules rules = {
+        .radius = 2.0f,
+        .separation = 0.02f,
+        .alignment = 0.05f,
+        .cohesion = 0.01f,
+        .attract_x = 10.0f + sinf(time * 0.4f) * 8.0f,
+        .attract_y = 4.0f + sinf(time * 0.23f) * 3.0f,
+        .attract = 0.02f + swarm_aggression * 0.03f,
+        .friction = 0.99f,
+        .max_speed = 0.3f,
+        .edges = FLOCK_BOUNCE
+    };
+    
+    float alpha;
+    int steps = sim_clock_advance(&clock, time, &alpha);
+    for (int step = 0; step < steps; step++) {
+        flock_step(&swarm, &rules, render_ctx.pool);
+    }
+    
     // Draw drone swarm
-    for (int i = 0; i < swarm_size; i++) {
+    for (int i = 0; i < swarm.count; i++) {
         Aircraft drone;
+        float fx, fz;
+        flock_position(&swarm, i, alpha, &fx, &fz);
         
-        // Swarm behavior - follow other drones but spread out
+        // Altitude bobs on its own
         float swarm_phase = time * 2.0f + i * 0.2f;
-        float neighbor_influence = sinf(swarm_phase) * 2.0f;
-        
-        drone.pos.x = sinf(swarm_phase * 0.7f + i) * 8.0f + neighbor_influence;
+        drone.pos.x = fx - 10.0f;
         drone.pos.y = cosf(swarm_phase * 0.5f + i) * 3.0f + 2.0f;
-        drone.pos.z = sinf(swarm_phase * 0.3f + i) * 4.0f + 2.0f;
+        drone.pos.z = fz - 2.0f;
         drone.aircraft_type = 2; // Drone
         drone.is_active = true;
         
@@ -8151,7 +8112,6 @@ void scene_drone_swarm(char* buffer, float* zbuffer, int width, int height, Para
 // Scene 112: Strategic Bombing - Large bombers attacking cities
 void scene_strategic_bombing(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     int bomber_count = (int)(params[0].value * 4.0f) + 2;
     float bombing_intensity = params[1].value;
@@ -8214,7 +8174,6 @@ void scene_strategic_bombing(char* buffer, float* zbuffer, int width, int height
 // Scene 113: Air-to-Air Combat - Dogfighting aircraft
 void scene_dogfight(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float combat_intensity = params[0].value;
     int aircraft_count = (int)(params[1].value * 6.0f) + 4;
@@ -8286,7 +8245,6 @@ void scene_dogfight(char* buffer, float* zbuffer, int width, int height, Paramet
 // Scene 114: Helicopter Assault - Attack helicopters and ground targets
 void scene_helicopter_assault(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     int helo_count = (int)(params[0].value * 4.0f) + 2;
     float assault_intensity = params[1].value;
@@ -8378,7 +8336,6 @@ void scene_helicopter_assault(char* buffer, float* zbuffer, int width, int heigh
 // Scene 115: Stealth Operation - Hard to detect aircraft
 void scene_stealth_mission(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float stealth_level = params[0].value;
     float detection_range = params[1].value * 20.0f + 10.0f;
@@ -8465,7 +8422,6 @@ void scene_stealth_mission(char* buffer, float* zbuffer, int width, int height,
 // Scene 116: Carrier Strike - Aircraft launching from carrier
 void scene_carrier_strike(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float launch_rate = params[0].value * 3.0f + 1.0f;
     int strike_size = (int)(params[1].value * 8.0f) + 4;
@@ -8544,7 +8500,6 @@ void scene_carrier_strike(char* buffer, float* zbuffer, int width, int height, P
 // Scene 117: Missile Defense - Intercepting incoming missiles
 void scene_missile_defense(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float threat_level = params[0].value;
     float defense_efficiency = params[1].value;
@@ -8641,7 +8596,6 @@ void scene_missile_defense(char* buffer, float* zbuffer, int width, int height,
 // Scene 118: Reconnaissance Drone - Surveillance and intelligence
 void scene_recon_drone(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float surveillance_area = params[0].value * 15.0f + 5.0f;
     float intel_gathering = params[1].value;
@@ -8737,7 +8691,6 @@ void scene_recon_drone(char* buffer, float* zbuffer, int width, int height, Para
 // Scene 119: Air Command Center - Strategic overview with multiple operations
 void scene_air_command(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     (void)audio;
-    clear_buffer(buffer, zbuffer, width, height);
     
     float operation_scale = params[0].value;
     int active_missions = (int)(params[1].value * 5.0f) + 2;
@@ -9009,7 +8962,7 @@ void draw_displaced_vertex(char* buffer, float* zbuffer, int width, int height,
 // ============= NEW SCENES 120-129 =============
 
 // Scene 120: Street Revolution - Crowd dynamics and protest action
-void scene_120(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_120(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float protest_intensity = params[0].value;
     float police_response = params[1].value;
     float crowd_density = params[2].value;
@@ -9118,7 +9071,7 @@ void scene_120(char* buffer, float* zbuffer, int width, int height, float time,
 }
 
 // Scene 121: Barricade Building - Revolutionary construction and defense
-void scene_121(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_121(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float construction_speed = params[0].value;
     float barricade_height = params[1].value;
     float defender_count = params[2].value;
@@ -9197,13 +9150,11 @@ void scene_121(char* buffer, float* zbuffer, int width, int height, float time,
 }
 
 // Scene 122: CCTV Camera - Close-up security camera graphic
-void scene_122(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_122(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float zoom_level = params[0].value;
     float scan_speed = params[1].value;
     float interference = params[2].value;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     // CCTV Camera lens - large circular view filling screen
     int center_x = width / 2;
     int center_y = height / 2;
@@ -9286,7 +9237,7 @@ void scene_122(char* buffer, float* zbuffer, int width, int height, float time,
 }
 
 // Scene 123: Giant Eye - Single massive eye with detailed movement
-void scene_123(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_123(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float pupil_dilation = params[0].value;
     float blink_speed = params[1].value;
     float gaze_intensity = params[2].value;
@@ -9361,7 +9312,7 @@ void scene_123(char* buffer, float* zbuffer, int width, int height, float time,
 }
 
 // Scene 124: Crowd March - Revolutionary parade and formation
-void scene_124(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_124(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float march_speed = params[0].value;
     float formation_tightness = params[1].value;
     float revolutionary_fervor = params[2].value;
@@ -9437,7 +9388,7 @@ void scene_124(char* buffer, float* zbuffer, int width, int height, float time,
 }
 
 // Scene 125: Displaced Sphere - Geometric displacement with shading
-void scene_125(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_125(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float displacement_amount = params[0].value;
     float geometry_complexity = params[1].value;
     float wave_frequency = params[2].value;
@@ -9536,7 +9487,7 @@ void scene_125(char* buffer, float* zbuffer, int width, int height, float time,
 }
 
 // Scene 126: Morphing Cube - Geometric transformation with displacement
-void scene_126(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_126(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float morph_speed = params[0].value;
     float displacement_chaos = params[1].value;
     float surface_detail = params[2].value;
@@ -9702,7 +9653,7 @@ void scene_126(char* buffer, float* zbuffer, int width, int height, float time,
 }
 
 // Scene 127: Protest Rally - Large gathering with speakers
-void scene_127(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_127(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float crowd_energy = params[0].value;
     float speaker_volume = params[1].value;
     float rally_size = params[2].value;
@@ -9817,7 +9768,7 @@ void scene_127(char* buffer, float* zbuffer, int width, int height, float time,
 }
 
 // Scene 128: Surveillance Eyes - Multiple tracking eyes with paranoia theme
-void scene_128(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_128(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float surveillance_intensity = params[0].value;
     float paranoia_level = params[1].value;
     float tracking_precision = params[2].value;
@@ -9923,7 +9874,7 @@ void scene_128(char* buffer, float* zbuffer, int width, int height, float time,
 }
 
 // Scene 129: Fractal Displacement - Complex geometric patterns
-void scene_129(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_129(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float fractal_depth = params[0].value;
     float displacement_complexity = params[1].value;
     float pattern_evolution = params[2].value;
@@ -10041,13 +9992,11 @@ void scene_129(char* buffer, float* zbuffer, int width, int height, float time,
 // ============= FILM NOIR SCENES (130-139) =============
 
 // Scene 130: Venetian Blinds - Classic film noir shadow pattern
-void scene_130(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_130(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float blind_angle = params[0].value;
     float light_intensity = params[1].value;
     float zoom = params[2].value;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float rotation = time * 0.1f + blind_angle * M_PI;
     float scale = 1.0f + zoom * 2.0f;
     
@@ -10103,13 +10052,11 @@ void scene_130(char* buffer, float* zbuffer, int width, int height, float time,
 }
 
 // Scene 131: Silhouette Doorway - Mystery figure in doorframe
-void scene_131(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_131(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float figure_position = params[0].value;
     float door_angle = params[1].value;
     float atmosphere = params[2].value;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     // Doorframe
     int door_left = width / 3;
     int door_right = width * 2 / 3;
@@ -10194,64 +10141,68 @@ void scene_131(char* buffer, float* zbuffer, int width, int height, float time,
     }
 }
 
+// Top up a rain pool to 'target' drops from 'emitter', spread evenly over
+// 'kinds'. The first drops fill the screen; later ones start within a
+// step above the top, so the rain stays even as drops leave the bottom.
+static void rain_refill(ParticlePool* rain, ParticleEmitter emitter, int target, int kinds, int width, int height) {
+    int missing = target - rain->count;
+    if (missing <= 0) return;
+    bool fill = rain->count == 0;
+    
+    emitter.x = width * 0.5f;
+    emitter.spread_x = width * 0.5f;
+    emitter.y = fill ? height * 0.5f : -emitter.vy * 0.5f;
+    emitter.spread_y = fill ? height * 0.5f : emitter.vy * 0.5f;
+    emitter.life = INFINITY;
+    for (int k = 0; k < kinds; k++) {
+        emitter.kind = k;
+        particles_emit(rain, &emitter, (missing + k) / kinds);
+    }
+}
+
 // Scene 132: Rain on Window - Water drops and distortion
-void scene_132(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_132(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float rain_intensity = params[0].value;
     float wind_speed = params[1].value;
     float zoom = params[2].value;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
-    static float drops[100][4]; // x, y, size, age
-    static bool initialized = false;
-    
-    if (!initialized) {
-        for (int i = 0; i < 100; i++) {
-            drops[i][0] = rand() % width;   // x
-            drops[i][1] = rand() % height;  // y
-            drops[i][2] = 1 + rand() % 4;   // size
-            drops[i][3] = rand() % 100;     // age
-        }
-        initialized = true;
+    static ParticlePool drops;      // Kind is the drop size, 0-3
+    static SimClock clock = { SIM_RATE_HZ };
+    
+    // 100 drops at the default intensity of 1, ten times as many per unit above it
+    int target = lod_count((int)(100.0f * powf(10.0f, rain_intensity - 1.0f)), 1);
+    particles_trim(&drops, target);
+    
+    float fall = 2.0f + rain_intensity * 3.0f;
+    float alpha;
+    int steps = sim_clock_advance(&clock, time, &alpha);
+    for (int step = 0; step < steps; step++) {
+        float step_time = sim_clock_step_time(&clock, step, steps);
+        float gust = wind_speed * sinf(step_time) * 0.5f;
+    
+        ParticleEmitter emitter = { .vx = gust, .vy = fall, .speed_max = 0.3f };
+        rain_refill(&drops, emitter, target, 4, width, height);
+    
+        // Every drop drifts with the gust on top of its own sideways speed
+        ParticleForces forces = {
+            .gravity_x = gust - wind_speed * sinf(step_time - 1.0f / SIM_RATE_HZ) * 0.5f,
+            .drag = 1.0f,
+            .edges = PARTICLES_KILL,
+            .width = width,
+            .height = height
+        };
+        particles_step(&drops, &forces);
     }
     
-    // Update rain drops
-    for (int i = 0; i < (int)(rain_intensity * 100); i++) {
-        drops[i][3] += 1.0f; // age
-        
-        // Rain motion
-        drops[i][1] += 2.0f + rain_intensity * 3.0f; // Fall down
-        drops[i][0] += wind_speed * sinf(time + i) * 0.5f; // Wind drift
-        
-        // Reset drop if it falls off screen
-        if (drops[i][1] > height || drops[i][0] < 0 || drops[i][0] >= width) {
-            drops[i][0] = rand() % width;
-            drops[i][1] = -10;
-            drops[i][2] = 1 + rand() % 4;
-            drops[i][3] = 0;
-        }
-        
-        // Draw rain drop
-        int x = (int)drops[i][0];
-        int y = (int)drops[i][1];
-        int size = (int)drops[i][2];
-        
-        if (x >= 0 && x < width && y >= 0 && y < height) {
-            // Drop center
-            set_pixel(buffer, zbuffer, width, height, x, y, 'o', 1.0f);
-            
-            // Drop trail
-            for (int trail = 1; trail < size + 2; trail++) {
-                int trail_y = y + trail;
-                if (trail_y < height) {
-                    char trail_char = (trail == 1) ? '*' : '.';
-                    set_pixel(buffer, zbuffer, width, height, x, trail_y, trail_char, 1.5f);
-                }
-            }
-        }
-    }
+    // Drop heads with a trail as long as the drop is big
+    ParticleStyle style = {
+        .ramp = { "o", "o", "o", "o" },
+        .trail = { "*.", "*..", "*...", "*...." },
+        .depth = 1.0f
+    };
+    particles_splat(&drops, &style, alpha, buffer, zbuffer, width, height);
     
-    // Window condensation pattern
+        // Window condensation pattern
     for (int y = 0; y < height; y += 3) {
         for (int x = 0; x < width; x += 4) {
             float condensation = sinf(x * 0.1f + time * 0.5f) * cosf(y * 0.08f + time * 0.3f);
@@ -10279,13 +10230,11 @@ void scene_132(char* buffer, float* zbuffer, int width, int height, float time,
 }
 
 // Scene 133: Detective Silhouette - Hat and coat figure
-void scene_133(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_133(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float detective_position = params[0].value;
     float coat_billow = params[1].value;
     float atmosphere = params[2].value;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     int center_x = width / 2 + (int)((detective_position - 0.5f) * width * 0.3f);
     int figure_bottom = height * 9 / 10;
     
@@ -10383,13 +10332,11 @@ void scene_133(char* buffer, float* zbuffer, int width, int height, float time,
 }
 
 // Scene 134: Femme Fatale - Elegant silhouette with curves
-void scene_134(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_134(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float pose_angle = params[0].value;
     float dress_flow = params[1].value;
     float zoom = params[2].value;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float scale = 1.0f + zoom * 0.5f;
     int center_x = width / 2;
     int figure_bottom = height * 9 / 10;
@@ -10482,61 +10429,57 @@ void scene_134(char* buffer, float* zbuffer, int width, int height, float time,
 }
 
 // Scene 135: Smoke Room - Atmospheric haze and shadows
-void scene_135(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_135(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float smoke_density = params[0].value;
     float light_rays = params[1].value;
     float ventilation = params[2].value;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
-    static float smoke_particles[200][4]; // x, y, z, age
-    static bool initialized = false;
-    
-    if (!initialized) {
-        for (int i = 0; i < 200; i++) {
-            smoke_particles[i][0] = rand() % width;
-            smoke_particles[i][1] = rand() % height;
-            smoke_particles[i][2] = rand() % 100 / 100.0f;
-            smoke_particles[i][3] = rand() % 100;
-        }
-        initialized = true;
+    static ParticlePool smoke;
+    static SimClock clock = { SIM_RATE_HZ };
+    static float last_ventilation = -1.0f;
+    
+    int target = lod_count((int)(smoke_density * 200), 0);
+    particles_trim(&smoke, target);
+    
+    float alpha;
+    int steps = sim_clock_advance(&clock, time, &alpha);
+    for (int step = 0; step < steps; step++) {
+        // Puffs rise from the floor, the first ones anywhere in the room
+        int missing = target - smoke.count;
+        if (missing > 0) {
+            bool fill = smoke.count == 0;
+            ParticleEmitter emitter = {
+                .x = width * 0.5f, .spread_x = width * 0.5f,
+                .y = fill ? height * 0.5f : height - 1.5f,
+                .spread_y = fill ? height * 0.5f : 1.5f,
+                .vx = ventilation * 2.0f, .vy = -0.3f,
+                .speed_max = fabsf(1.0f - ventilation) * 0.2f, .aspect_y = 0.5f,
+                .life = 200.0f, .life_spread = 200.0f
+            };
+            particles_emit(&smoke, &emitter, missing);
+        }
+    
+        // A ventilation change pushes the smoke already in the room
+        float push = last_ventilation >= 0.0f ? (ventilation - last_ventilation) * 2.0f : 0.0f;
+        last_ventilation = ventilation;
+        ParticleForces forces = {
+            .gravity_x = push,
+            .drag = 1.0f,
+            .edges = PARTICLES_WRAP,
+            .width = width,
+            .height = height
+        };
+        particles_step(&smoke, &forces);
     }
     
-    // Update smoke particles
-    int active_particles = (int)(smoke_density * 200);
-    for (int i = 0; i < active_particles; i++) {
-        smoke_particles[i][3] += 1.0f; // age
-        
-        // Smoke motion
-        smoke_particles[i][0] += sinf(time * 0.5f + i * 0.1f) * (1.0f - ventilation) + ventilation * 2.0f;
-        smoke_particles[i][1] += cosf(time * 0.3f + i * 0.15f) * 0.5f - 0.3f; // Slow rise
-        smoke_particles[i][2] += 0.01f;
-        
-        // Wrap around screen
-        if (smoke_particles[i][0] >= width) smoke_particles[i][0] = 0;
-        if (smoke_particles[i][0] < 0) smoke_particles[i][0] = width - 1;
-        if (smoke_particles[i][1] < 0) smoke_particles[i][1] = height - 1;
-        
-        // Reset old particles
-        if (smoke_particles[i][3] > 300) {
-            smoke_particles[i][0] = rand() % width;
-            smoke_particles[i][1] = height + rand() % 20;
-            smoke_particles[i][2] = 0;
-            smoke_particles[i][3] = 0;
-        }
-        
-        // Draw smoke particle
-        int x = (int)smoke_particles[i][0];
-        int y = (int)smoke_particles[i][1];
-        float z = smoke_particles[i][2];
-        
-        if (x >= 0 && x < width && y >= 0 && y < height) {
-            char smoke_char = (z < 0.3f) ? '.' : (z < 0.6f) ? '*' : '@';
-            set_pixel(buffer, zbuffer, width, height, x, y, smoke_char, z * 10.0f);
-        }
-    }
+    // Thickens and draws nearer as it ages
+    ParticleStyle style = {
+        .ramp = { ".*@@@@@@@@" },
+        .depth_fade = 30.0f
+    };
+    particles_splat(&smoke, &style, alpha, buffer, zbuffer, width, height);
     
-    // Light rays cutting through smoke
+        // Light rays cutting through smoke
     if (light_rays > 0.4f) {
         for (int ray = 0; ray < 5; ray++) {
             float ray_angle = ray * M_PI / 6.0f + time * 0.2f;
@@ -10585,13 +10528,11 @@ void scene_135(char* buffer, float* zbuffer, int width, int height, float time,
 }
 
 // Scene 136: Staircase Shadows - Dramatic ascending perspective
-void scene_136(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_136(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float perspective_angle = params[0].value;
     float shadow_length = params[1].value;
     float zoom = params[2].value;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float rotation = perspective_angle * M_PI / 4.0f;
     float scale = 1.0f + zoom;
     
@@ -10682,13 +10623,11 @@ void scene_136(char* buffer, float* zbuffer, int width, int height, float time,
 }
 
 // Scene 137: Car Headlights in Fog - Atmospheric night scene
-void scene_137(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_137(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float fog_density = params[0].value;
     float headlight_intensity = params[1].value;
     float car_distance = params[2].value;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     // Fog particles
     static float fog_particles[150][3]; // x, y, density
     static bool initialized = false;
@@ -10788,13 +10727,11 @@ void scene_137(char* buffer, float* zbuffer, int width, int height, float time,
 }
 
 // Scene 138: Neon Signs Rain - Reflected city lights
-void scene_138(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_138(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float neon_flicker = params[0].value;
     float rain_intensity = params[1].value;
     float zoom = params[2].value;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     // Neon signs - multiple levels
     const char* neon_texts[] = {"HOTEL", "BAR", "CAFE", "CLUB", "DINER"};
     int num_signs = 5;
@@ -10836,38 +10773,37 @@ void scene_138(char* buffer, float* zbuffer, int width, int height, float time,
     }
     
     // Rain drops
-    static float rain_drops[80][3]; // x, y, speed
-    static bool initialized = false;
-    
-    if (!initialized) {
-        for (int i = 0; i < 80; i++) {
-            rain_drops[i][0] = rand() % width;
-            rain_drops[i][1] = rand() % height;
-            rain_drops[i][2] = 1 + rand() % 3;
-        }
-        initialized = true;
+    static ParticlePool rain;
+    static SimClock clock = { SIM_RATE_HZ };
+    
+    // 80 drops at the default intensity of 1, ten times as many per unit above it
+    int target = lod_count((int)(80.0f * powf(10.0f, rain_intensity - 1.0f)), 1);
+    particles_trim(&rain, target);
+    
+    float alpha;
+    int steps = sim_clock_advance(&clock, time, &alpha);
+    for (int step = 0; step < steps; step++) {
+        float step_time = sim_clock_step_time(&clock, step, steps);
+        float gust = sinf(step_time) * 0.5f;
+    
+        // Drops fall 1-3 cells a step faster than the rain's base speed
+        ParticleEmitter emitter = { .vx = gust, .vy = 2.0f + rain_intensity * 2.0f, .speed_max = 0.3f, .aspect_y = 3.0f };
+        rain_refill(&rain, emitter, target, 1, width, height);
+    
+        ParticleForces forces = {
+            .gravity_x = gust - sinf(step_time - 1.0f / SIM_RATE_HZ) * 0.5f,
+            .drag = 1.0f,
+            .edges = PARTICLES_KILL,
+            .width = width,
+            .height = height
+        };
+        particles_step(&rain, &forces);
     }
     
-    // Update rain
-    for (int i = 0; i < (int)(rain_intensity * 80); i++) {
-        rain_drops[i][1] += rain_drops[i][2] + rain_intensity * 2.0f;
-        rain_drops[i][0] += sinf(time + i) * 0.5f; // Wind drift
-        
-        if (rain_drops[i][1] > height) {
-            rain_drops[i][0] = rand() % width;
-            rain_drops[i][1] = -5;
-            rain_drops[i][2] = 1 + rand() % 3;
-        }
-        
-        int x = (int)rain_drops[i][0];
-        int y = (int)rain_drops[i][1];
-        
-        if (x >= 0 && x < width && y >= 0 && y < height) {
-            set_pixel(buffer, zbuffer, width, height, x, y, '|', 8.0f);
-        }
-    }
+    ParticleStyle style = { .ramp = { "|" }, .depth = 8.0f };
+    particles_splat(&rain, &style, alpha, buffer, zbuffer, width, height);
     
-    // Wet street reflections
+        // Wet street reflections
     if (rain_intensity > 0.4f && zoom > 0.3f) {
         for (int sign = 0; sign < num_signs; sign++) {
             int sign_x = (sign * width / num_signs) + (int)(sinf(time * 0.3f + sign) * 20.0f);
@@ -10896,13 +10832,11 @@ void scene_138(char* buffer, float* zbuffer, int width, int height, float time,
 }
 
 // Scene 139: Film Strip - Movie camera effect with frames
-void scene_139(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_139(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float film_speed = params[0].value;
     float frame_zoom = params[1].value;
     float vintage_effect = params[2].value;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     // Film strip holes on sides
     int hole_spacing = height / 12;
     float film_scroll = time * film_speed * 50.0f;
@@ -11039,12 +10973,10 @@ void scene_139(char* buffer, float* zbuffer, int width, int height, float time,
 // ============= ESCHER 3D ILLUSION SCENES (140-149) =============
 
 // 140: Impossible Stairs - Ascending stairs that loop infinitely
-void scene_impossible_stairs(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_impossible_stairs(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float speed = params[1].value;
     int cx = width / 2, cy = height / 2;
     float t = time * speed;
@@ -11082,55 +11014,60 @@ void scene_impossible_stairs(char* buffer, float* zbuffer, int width, int height
 }
 
 // 141: Möbius Strip - Continuous surface with only one side
-void scene_mobius_strip(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_mobius_strip(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
+    static __thread MeshBuffer strip;
+    static __thread MeshView view;
+    static __thread float built_scale = -1.0f, built_twist = 0.0f;
     float scale = 0.5f + params[0].value * 1.5f;
     float rotation = time * params[1].value;
     float twist = params[2].value * 2.0f;
     
-    for (int i = 0; i < width * height; i++) {
-        buffer[i] = ' ';
-        zbuffer[i] = 1000.0f;
-    }
-    
-    int cx = width / 2, cy = height / 2;
-    
-    // Parametric Möbius strip
-    for (int u = 0; u < 360; u += 2) {
-        for (int v = -10; v <= 10; v += 1) {
-            float u_rad = u * M_PI / 180.0f;
-            float v_scale = v * 0.1f * scale;
-            
-            // Möbius strip parametric equations
-            float radius = 30.0f + v_scale * cos(u_rad / 2.0f + twist);
-            float x3d = radius * cos(u_rad + rotation);
-            float y3d = radius * sin(u_rad + rotation);
-            float z3d = v_scale * sin(u_rad / 2.0f + twist) + 50.0f + params[3].value * 20.0f;
-            
-            // Perspective projection
-            if (z3d > 1.0f) {
-                int x2d = cx + (int)(x3d * 30.0f / z3d);
-                int y2d = cy + (int)(y3d * 15.0f / z3d);
+    // 180 steps around by 21 across; rebuilt only when the shape changes
+    int across = 21;
+    if (scale != built_scale || twist != built_twist) {
+        if (!mesh_buffer_reserve(&strip, 180 * across, 0, 0)) return;
+        strip.vertex_count = 0;
+        strip.edge_count = 0;
+        strip.triangle_count = 0;
+        for (int u = 0; u < 360; u += 2) {
+            for (int v = -10; v <= 10; v += 1) {
+                float u_rad = u * M_PI / 180.0f;
+                float v_scale = v * 0.1f * scale;
                 
-                if (x2d >= 0 && x2d < width && y2d >= 0 && y2d < height) {
-                    char strip_char = (abs(v) < 2) ? '#' : (abs(v) < 5) ? '=' : '.';
-                    set_pixel(buffer, zbuffer, width, height, x2d, y2d, strip_char, z3d);
-                }
+                // Möbius strip parametric equations
+                float radius = 30.0f + v_scale * cosf(u_rad / 2.0f + twist);
+                float* vertex = strip.vertices + 3 * strip.vertex_count++;
+                vertex[0] = radius * cosf(u_rad);
+                vertex[1] = radius * sinf(u_rad);
+                vertex[2] = v_scale * sinf(u_rad / 2.0f + twist);
             }
         }
+        built_scale = scale;
+        built_twist = twist;
+    }
+    
+    Mat4 spin = mat4_rotation_z(rotation);
+    Mat4 place = mat4_translation(0.0f, 0.0f, 50.0f + params[3].value * 20.0f);
+    Mat4 model = mat4_multiply(&place, &spin);
+    Mesh mesh = mesh_buffer_mesh(&strip);
+    MeshCamera camera = mesh_camera(width, height, 30.0f);
+    if (!mesh_transform(&mesh, &model, &camera, &view)) return;
+    
+    for (int i = 0; i < view.count; i++) {
+        if (view.z[i] <= 1.0f) continue;
+        int v = i % across - 10;
+        char strip_char = (abs(v) < 2) ? '#' : (abs(v) < 5) ? '=' : '.';
+        set_pixel(buffer, zbuffer, width, height, (int)floorf(view.screen_x[i] + 0.5f),
+                  (int)floorf(view.screen_y[i] + 0.5f), strip_char, view.z[i]);
     }
 }
 
 // 142: Impossible Cube - Wireframe cube with impossible geometry
-void scene_impossible_cube(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_impossible_cube(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float scale = 0.5f + params[0].value * 1.5f;
     float rotation_speed = params[1].value;
     float wireframe_density = 1.0f + params[2].value * 3.0f;
     
-    for (int i = 0; i < width * height; i++) {
-        buffer[i] = ' ';
-        zbuffer[i] = 1000.0f;
-    }
-    
     int cx = width / 2, cy = height / 2;
     float t = time * rotation_speed;
     
@@ -11182,16 +11119,11 @@ void scene_impossible_cube(char* buffer, float* zbuffer, int width, int height,
 }
 
 // 143: Penrose Triangle - Impossible triangle that appears solid
-void scene_penrose_triangle(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_penrose_triangle(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float scale = 0.5f + params[0].value * 1.5f;
     float rotation = time * params[1].value * 0.3f;
     float thickness = 2.0f + params[2].value * 6.0f;
     
-    for (int i = 0; i < width * height; i++) {
-        buffer[i] = ' ';
-        zbuffer[i] = 1000.0f;
-    }
-    
     int cx = width / 2, cy = height / 2;
     
     // Three beams of the impossible triangle
@@ -11232,16 +11164,11 @@ void scene_penrose_triangle(char* buffer, float* zbuffer, int width, int height,
 }
 
 // 144: Infinite Corridor - Recursive hallway effect
-void scene_infinite_corridor(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_infinite_corridor(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float movement = time * params[1].value * 10.0f;
     float perspective = 1.0f + params[0].value * 2.0f;
     float wall_detail = params[2].value;
     
-    for (int i = 0; i < width * height; i++) {
-        buffer[i] = ' ';
-        zbuffer[i] = 1000.0f;
-    }
-    
     int cx = width / 2, cy = height / 2;
     
     // Draw recursive corridor segments
@@ -11307,16 +11234,11 @@ void scene_infinite_corridor(char* buffer, float* zbuffer, int width, int height
 }
 
 // 145: Tessellated Reality - MC Escher-style tessellation
-void scene_tessellated_reality(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_tessellated_reality(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float scale = 0.3f + params[0].value * 1.0f;
     float morph = sin(time * params[1].value) * 0.5f + 0.5f;
     float complexity = params[2].value;
     
-    for (int i = 0; i < width * height; i++) {
-        buffer[i] = ' ';
-        zbuffer[i] = 1000.0f;
-    }
-    
     // Create tessellated pattern that morphs between shapes
     for (int y = 0; y < height; y++) {
         for (int x = 0; x < width; x++) {
@@ -11366,18 +11288,13 @@ void scene_tessellated_reality(char* buffer, float* zbuffer, int width, int heig
 }
 
 // 146: Gravity Wells - Curved space visualization
-void scene_gravity_wells(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_gravity_wells(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params || width <= 0 || height <= 0) return;
     
     float well_strength = 1.0f + (params ? params[0].value : 0.5f) * 3.0f;
     float rotation = time * (params ? params[1].value : 0.5f) * 0.5f;
     float grid_density = 10.0f + (params ? params[2].value : 0.5f) * 20.0f;
     
-    for (int i = 0; i < width * height; i++) {
-        buffer[i] = ' ';
-        zbuffer[i] = 1000.0f;
-    }
-    
     int cx = width / 2, cy = height / 2;
     
     // Multiple gravity wells
@@ -11443,16 +11360,11 @@ void scene_gravity_wells(char* buffer, float* zbuffer, int width, int height, fl
 }
 
 // 147: Dimensional Shift - Reality folding and unfolding
-void scene_dimensional_shift(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_dimensional_shift(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float fold_intensity = params[0].value;
     float shift_speed = params[1].value;
     float layer_count = 3.0f + params[2].value * 7.0f;
     
-    for (int i = 0; i < width * height; i++) {
-        buffer[i] = ' ';
-        zbuffer[i] = 1000.0f;
-    }
-    
     int cx = width / 2, cy = height / 2;
     float t = time * shift_speed;
     
@@ -11599,12 +11511,10 @@ void draw_fractal_building(char* buffer, float* zbuffer, int width, int height,
 }
 
 // 148: Fractal Architecture - Recursive impossible buildings
-void scene_fractal_architecture(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_fractal_architecture(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float animation_speed = params[1].value;
     int cx = width / 2, cy = height / 2;
     float t = time * animation_speed;
@@ -11624,12 +11534,10 @@ void scene_fractal_architecture(char* buffer, float* zbuffer, int width, int hei
 }
 
 // 149: Escher Waterfall - Impossible water flow uphill
-void scene_escher_waterfall(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_escher_waterfall(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float flow_speed = params[1].value;
     int cx = width / 2, cy = height / 2;
     float t = time * flow_speed;
@@ -11650,31 +11558,43 @@ void scene_escher_waterfall(char* buffer, float* zbuffer, int width, int height,
 // ============= IKEDA-INSPIRED SCENES (150-159) =============
 
 // Scene 150: Ikeda Data Matrix - Binary data streams in grid formations
-void scene_ikeda_data_matrix(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_ikeda_data_matrix(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float scan_speed = params[0].value;
     float data_density = params[1].value;
     float glitch_amount = params[2].value;
     
-    // Binary data grid
+    // The bits are a HighLife grid, one cell per bit: each block shows 4
+    // cells of one grid row
+    static Automaton data;
+    static SimClock clock = { 10.0f };
     int grid_size = 4;
+    if (!automaton_resize(&data, width / grid_size * 4, height / grid_size)) return;
+    AutomatonRule rule;
+    automaton_parse_rule("B36/S23", &rule);
+    float alpha;
+    int steps = sim_clock_advance(&clock, time, &alpha);
+    int generations = (int)(scan_speed + 0.5f);
+    if (steps > 0 && generations > 0) {
+        automaton_step(&data, &rule, steps * generations, render_ctx.pool);
+    }
+    // Keep the stream busy once the grid settles into still lifes
+    if (automaton_population(&data) < data.width * data.height / 16) {
+        automaton_randomize(&data, 0.35f);
+    }
+    
+    // Binary data grid
     for (int gy = 0; gy < height / grid_size; gy++) {
         for (int gx = 0; gx < width / grid_size; gx++) {
-            // Data block
-            float block_time = time * scan_speed + gx * 0.1f + gy * 0.2f;
-            int block_state = ((int)(block_time * 10) + gx * 7 + gy * 13) % 16;
-            
             // Binary representation
             for (int bit = 0; bit < 4; bit++) {
                 int px = gx * grid_size + bit;
                 int py = gy * grid_size;
                 
                 if (px < width && py < height) {
-                    char bit_char = (block_state & (1 << bit)) ? '1' : '0';
+                    char bit_char = automaton_cell(&data, gx * 4 + bit, gy) ? '1' : '0';
                     
                     // Glitch effect
                     if (((float)rand() / RAND_MAX) < glitch_amount * 0.1f) {
@@ -11713,12 +11633,10 @@ void scene_ikeda_data_matrix(char* buffer, float* zbuffer, int width, int height
 }
 
 // Scene 151: Ikeda Test Pattern - Minimalist geometric test patterns
-void scene_ikeda_test_pattern(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_ikeda_test_pattern(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float pattern_shift = params[0].value;
     float line_density = params[1].value;
     float phase_shift = params[2].value;
@@ -11771,13 +11689,24 @@ void scene_ikeda_test_pattern(char* buffer, float* zbuffer, int width, int heigh
     }
 }
 
+// Only the pattern showing and its own scroll step change the output:
+// bars scroll at 10 steps/s, the diagonal scan at 20 * phase_shift
+uint64_t scene_ikeda_test_pattern_change_key(int width, int height, Parameter* params, float time) {
+    int pattern_type = ((int)(time * params[0].value)) % 4;
+    uint64_t step = 0;
+    if (pattern_type == 0 || pattern_type == 1) {
+        step = (uint32_t)(int)(time * 10);
+    } else if (pattern_type == 3) {
+        step = (uint32_t)((int)(time * 20 * params[2].value) % (width + height));
+    }
+    return (uint64_t)pattern_type << 32 | step;
+}
+
 // Scene 152: Ikeda Sine Wave - Pure sine wave visualizations
-void scene_ikeda_sine_wave(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_ikeda_sine_wave(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float frequency = params[0].value * 10.0f;
     float amplitude = params[1].value;
     float phase_mod = params[2].value;
@@ -11819,12 +11748,10 @@ void scene_ikeda_sine_wave(char* buffer, float* zbuffer, int width, int height,
 }
 
 // Scene 153: Ikeda Barcode - Dynamic barcode patterns
-void scene_ikeda_barcode(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_ikeda_barcode(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float scan_rate = params[0].value;
     float bar_width = params[1].value * 5.0f + 1.0f;
     float noise_level = params[2].value;
@@ -11875,12 +11802,10 @@ void scene_ikeda_barcode(char* buffer, float* zbuffer, int width, int height, fl
 }
 
 // Scene 154: Ikeda Pulse - Rhythmic pulse patterns
-void scene_ikeda_pulse(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_ikeda_pulse(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float pulse_rate = params[0].value * 5.0f;
     float pulse_width = params[1].value;
     float echo_count = params[2].value * 5.0f;
@@ -11923,12 +11848,10 @@ void scene_ikeda_pulse(char* buffer, float* zbuffer, int width, int height, floa
 }
 
 // Scene 155: Ikeda Glitch - Digital glitch artifacts
-void scene_ikeda_glitch(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_ikeda_glitch(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float glitch_rate = params[0].value;
     float corruption = params[1].value;
     float block_size = params[2].value * 10.0f + 2.0f;
@@ -11982,12 +11905,10 @@ void scene_ikeda_glitch(char* buffer, float* zbuffer, int width, int height, flo
 }
 
 // Scene 156: Ikeda Spectrum - Frequency spectrum visualization
-void scene_ikeda_spectrum(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_ikeda_spectrum(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float freq_shift = params[0].value * 10.0f;
     float amplitude = params[1].value;
     float band_count = params[2].value * 20.0f + 5.0f;
@@ -12039,12 +11960,10 @@ void scene_ikeda_spectrum(char* buffer, float* zbuffer, int width, int height, f
 }
 
 // Scene 157: Ikeda Phase - Phase shift patterns
-void scene_ikeda_phase(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_ikeda_phase(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float phase_speed = params[0].value * 5.0f;
     float phase_count = params[1].value * 8.0f + 2.0f;
     float interference = params[2].value;
@@ -12081,12 +12000,10 @@ void scene_ikeda_phase(char* buffer, float* zbuffer, int width, int height, floa
 }
 
 // Scene 158: Ikeda Binary - Binary number patterns
-void scene_ikeda_binary(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_ikeda_binary(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float scroll_speed = params[0].value * 10.0f;
     float bit_density = params[1].value;
     float pattern_type = params[2].value * 3.0f;
@@ -12159,12 +12076,10 @@ void scene_ikeda_binary(char* buffer, float* zbuffer, int width, int height, flo
 }
 
 // Scene 159: Ikeda Circuit - Circuit board patterns
-void scene_ikeda_circuit(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_ikeda_circuit(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float signal_speed = params[0].value * 5.0f;
     float complexity = params[1].value * 10.0f + 3.0f;
     float signal_density = params[2].value;
@@ -12256,12 +12171,10 @@ void scene_ikeda_circuit(char* buffer, float* zbuffer, int width, int height, fl
 // ============= GIGER-INSPIRED SCENES (160-169) =============
 
 // Scene 160: Biomechanical Spine - Animated vertebrae structure
-void scene_giger_spine(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_giger_spine(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float spine_wave = params[0].value * 2.0f;
     float bone_size = params[1].value * 5.0f + 3.0f;
     float mutation_rate = params[2].value;
@@ -12325,12 +12238,10 @@ void scene_giger_spine(char* buffer, float* zbuffer, int width, int height, floa
 }
 
 // Scene 161: Alien Egg Chamber - Pulsating organic pods
-void scene_giger_eggs(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_giger_eggs(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float pulse_rate = params[0].value * 3.0f;
     float egg_count = params[1].value * 8.0f + 4.0f;
     float hatch_progress = params[2].value;
@@ -12389,12 +12300,10 @@ void scene_giger_eggs(char* buffer, float* zbuffer, int width, int height, float
 }
 
 // Scene 162: Mechanical Tentacles - Writhing biomechanical appendages
-void scene_giger_tentacles(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_giger_tentacles(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float writhe_speed = params[0].value * 2.0f;
     float tentacle_count = params[1].value * 6.0f + 3.0f;
     float segment_detail = params[2].value * 3.0f + 1.0f;
@@ -12462,40 +12371,77 @@ void scene_giger_tentacles(char* buffer, float* zbuffer, int width, int height,
 }
 
 // Scene 163: Xenomorph Hive - Organic architecture with movement
-void scene_giger_hive(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_giger_hive(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float growth_rate = params[0].value;
     float density = params[1].value * 0.8f + 0.2f;
     float creature_activity = params[2].value;
     
-    // Organic walls
+    // Organic walls of resin, grown by reaction-diffusion and shown where
+    // the wall profiles reach
+    static GridSim resin;
+    static SimClock clock = { SIM_RATE_HZ };
+    
+    if (!grid_sim_resize(&resin, width, height, 2, GRID_EDGE_WRAP)) return;
+    if (resin.cleared) {
+        // All u, with scattered patches of v for the resin to grow from
+        for (int y = 0; y < height; y++) {
+            float* u = grid_sim_row(&resin, 0, y);
+            float* v = grid_sim_row(&resin, 1, y);
+            for (int x = 0; x < width; x++) {
+                u[x] = 1.0f;
+                v[x] = 0.0f;
+            }
+        }
+        for (int seed = 0; seed < width * height / 200 + 1; seed++) {
+            int sx = rand() % width;
+            int sy = rand() % height;
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -2; dx <= 2; dx++) {
+                    int x = (sx + dx + width) % width;
+                    int y = (sy + dy + height) % height;
+                    grid_sim_row(&resin, 0, y)[x] = 0.0f;
+                    grid_sim_row(&resin, 1, y)[x] = 1.0f;
+                }
+            }
+        }
+        resin.cleared = false;
+    }
+    
+    // The pattern changes too slowly to need interpolating
+    float alpha;
+    int steps = sim_clock_advance(&clock, time, &alpha);
+    int iterations = 1 + (int)(growth_rate * 3.0f);
+    for (int step = 0; step < steps * iterations; step++) {
+        grid_sim_gray_scott(&resin, 0.055f, 0.062f, 0.21f, 0.105f, render_ctx.pool);
+    }
+    
+    float threshold = 0.25f / density;
     for (int x = 0; x < width; x++) {
         float wall_phase = x * 0.1f + time * growth_rate;
         int wall_height = height / 3 + (int)(sinf(wall_phase) * height / 6);
-        
+    
         // Top resin structure
         for (int y = 0; y < wall_height; y++) {
-            if (((x + y) % 3 == 0) && ((float)rand() / RAND_MAX < density)) {
+            if (grid_sim_row(&resin, 1, y)[x] > threshold) {
                 char wall_char = "{}[]|/"[(x + y + (int)(time * 2)) % 6];
                 set_pixel(buffer, zbuffer, width, height, x, y, wall_char, 8.0f);
             }
         }
-        
+    
         // Bottom structure
         wall_height = height / 3 + (int)(cosf(wall_phase + M_PI) * height / 6);
         for (int y = height - wall_height; y < height; y++) {
-            if (((x + y) % 3 == 0) && ((float)rand() / RAND_MAX < density)) {
+            if (grid_sim_row(&resin, 1, y)[x] > threshold) {
                 char wall_char = "{}[]|\\"[(x + y + (int)(time * 2)) % 6];
                 set_pixel(buffer, zbuffer, width, height, x, y, wall_char, 8.0f);
             }
         }
     }
     
-    // Resin strands
+        // Resin strands
     for (int strand = 0; strand < 15; strand++) {
         float strand_x = width * (strand + 1) / 16.0f;
         float sway = sinf(time * 0.5f + strand * 0.3f) * 5;
@@ -12537,12 +12483,10 @@ void scene_giger_hive(char* buffer, float* zbuffer, int width, int height, float
 }
 
 // Scene 164: Biomech Skull - Animated skull with mechanical parts
-void scene_giger_skull(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_giger_skull(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float rotation = params[0].value * 2.0f;
     float jaw_movement = params[1].value;
     float decay_level = params[2].value;
@@ -12658,12 +12602,10 @@ void scene_giger_skull(char* buffer, float* zbuffer, int width, int height, floa
 }
 
 // Scene 165: Face Hugger - Animated parasitic creature
-void scene_giger_facehugger(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_giger_facehugger(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float scuttle_speed = params[0].value * 3.0f;
     float leg_movement = params[1].value * 2.0f;
     float tail_whip = params[2].value * 3.0f;
@@ -12748,12 +12690,10 @@ void scene_giger_facehugger(char* buffer, float* zbuffer, int width, int height,
 }
 
 // Scene 166: Biomech Heart - Pulsating mechanical organ
-void scene_giger_heart(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_giger_heart(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float beat_rate = params[0].value * 2.0f + 0.5f;
     float valve_count = params[1].value * 3.0f + 2.0f;
     float blood_flow = params[2].value;
@@ -12857,12 +12797,10 @@ void scene_giger_heart(char* buffer, float* zbuffer, int width, int height, floa
 }
 
 // Scene 167: Alien Architecture - Living building structures
-void scene_giger_architecture(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_giger_architecture(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float growth_phase = params[0].value * time * 0.5f;
     float structure_complexity = params[1].value * 5.0f + 3.0f;
     float organic_factor = params[2].value;
@@ -12963,12 +12901,10 @@ void scene_giger_architecture(char* buffer, float* zbuffer, int width, int heigh
 }
 
 // Scene 168: Chestburster - Emerging creature animation
-void scene_giger_chestburster(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_giger_chestburster(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float emergence_progress = fmodf(time * params[0].value * 0.3f, 1.0f);
     float writhe_speed = params[1].value * 3.0f;
     float gore_level = params[2].value;
@@ -13078,12 +13014,10 @@ void scene_giger_chestburster(char* buffer, float* zbuffer, int width, int heigh
 }
 
 // Scene 169: Space Jockey - Giant biomechanical pilot
-void scene_giger_space_jockey(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
+void scene_giger_space_jockey(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     if (!buffer || !zbuffer || !params) return;
     if (width <= 0 || height <= 0) return;
     
-    clear_buffer(buffer, zbuffer, width, height);
-    
     float chair_tilt = params[0].value * 0.3f;
     float trunk_sway = params[1].value * 2.0f;
     float control_activity = params[2].value;
@@ -13226,9 +13160,7 @@ void scene_giger_space_jockey(char* buffer, float* zbuffer, int width, int heigh
 // ============= REVOLT SCENES (170-179) =============
 
 // Scene 170: Rising Fists - Multiple fists rising in protest
-void scene_revolt_rising_fists(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+void scene_revolt_rising_fists(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float rise_speed = params[0].value; // 0.5-2.0
     float spread = params[1].value;     // 0.5-1.5
     float intensity = params[2].value;  // 0.5-1.0
@@ -13286,9 +13218,7 @@ void scene_revolt_rising_fists(char* buffer, float* zbuffer, int width, int heig
 }
 
 // Scene 171: Breaking Chains - Chains breaking apart symbolically
-void scene_revolt_breaking_chains(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+void scene_revolt_breaking_chains(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float break_progress = params[0].value; // 0.0-1.0
     float shake = params[1].value;          // 0.0-2.0
     float chain_count = params[2].value;    // 1-5
@@ -13341,9 +13271,7 @@ void scene_revolt_breaking_chains(char* buffer, float* zbuffer, int width, int h
 }
 
 // Scene 172: Crowd March - ASCII crowd marching forward
-void scene_revolt_crowd_march(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+void scene_revolt_crowd_march(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float march_speed = params[0].value;  // 0.5-2.0
     float crowd_density = params[1].value; // 0.5-1.5
     float unity = params[2].value;        // 0.0-1.0
@@ -13406,9 +13334,7 @@ void scene_revolt_crowd_march(char* buffer, float* zbuffer, int width, int heigh
 }
 
 // Scene 173: Barricade Building - Constructing barriers
-void scene_revolt_barricade_building(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+void scene_revolt_barricade_building(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float build_progress = params[0].value; // 0.0-1.0
     float chaos = params[1].value;          // 0.0-1.0
     float fortification = params[2].value;  // 0.0-1.0
@@ -13478,9 +13404,7 @@ void scene_revolt_barricade_building(char* buffer, float* zbuffer, int width, in
 }
 
 // Scene 174: Molotov Cocktails - Flaming bottles in arc trajectories
-void scene_revolt_molotov_cocktails(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+void scene_revolt_molotov_cocktails(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float throw_rate = params[0].value;    // 0.5-2.0
     float fire_intensity = params[1].value; // 0.5-1.5
     float spread = params[2].value;        // 0.5-1.5
@@ -13555,9 +13479,7 @@ void scene_revolt_molotov_cocktails(char* buffer, float* zbuffer, int width, int
 }
 
 // Scene 175: Tear Gas - Smoke clouds and people covering faces
-void scene_revolt_tear_gas(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+void scene_revolt_tear_gas(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float gas_density = params[0].value;   // 0.3-1.0
     float wind_speed = params[1].value;    // 0.0-2.0
     float dispersion = params[2].value;    // 0.5-1.5
@@ -13639,9 +13561,7 @@ void scene_revolt_tear_gas(char* buffer, float* zbuffer, int width, int height,
 }
 
 // Scene 176: Graffiti Wall - Revolutionary messages being spray painted
-void scene_revolt_graffiti_wall(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+void scene_revolt_graffiti_wall(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float write_speed = params[0].value;   // 0.5-2.0
     float layer_count = params[1].value;   // 1-3
     float vandalism = params[2].value;     // 0.0-1.0
@@ -13731,9 +13651,7 @@ void scene_revolt_graffiti_wall(char* buffer, float* zbuffer, int width, int hei
 }
 
 // Scene 177: Police Line Breaking - Protesters pushing through barriers
-void scene_revolt_police_line_breaking(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+void scene_revolt_police_line_breaking(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float push_force = params[0].value;    // 0.0-1.0
     float line_stability = params[1].value; // 1.0-0.0 (inverse)
     float chaos_level = params[2].value;   // 0.0-1.0
@@ -13811,9 +13729,7 @@ void scene_revolt_police_line_breaking(char* buffer, float* zbuffer, int width,
 }
 
 // Scene 178: Flag Burning - Symbolic burning of oppressive flags
-void scene_revolt_flag_burning(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+void scene_revolt_flag_burning(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float burn_progress = params[0].value;  // 0.0-1.0
     float flame_height = params[1].value;   // 0.5-2.0
     float smoke_density = params[2].value;  // 0.5-1.5
@@ -13898,9 +13814,7 @@ void scene_revolt_flag_burning(char* buffer, float* zbuffer, int width, int heig
 }
 
 // Scene 179: Victory Dance - Celebration of successful revolt
-void scene_revolt_victory_dance(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+void scene_revolt_victory_dance(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float celebration = params[0].value;    // 0.5-1.0
     float dance_speed = params[1].value;    // 0.5-2.0
     float fireworks = params[2].value;      // 0.0-1.0
@@ -14005,9 +13919,7 @@ void scene_revolt_victory_dance(char* buffer, float* zbuffer, int width, int hei
 // ============= AUDIO REACTIVE SCENES (180-189) =============
 
 // Scene 180: Audio Reactive 3D Cubes - Multiple cubes react to different frequency bands
-void scene_audio_reactive_cubes(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params, AudioData* audio) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+void scene_audio_reactive_cubes(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float cube_scale = params[0].value * 15.0f + 5.0f;       // 5-20
     float rotation_speed = params[1].value * 2.0f + 0.5f;    // 0.5-2.5
     float audio_sensitivity = params[2].value * 2.0f + 0.5f; // 0.5-2.5
@@ -14132,9 +14044,7 @@ void scene_audio_reactive_cubes(char* buffer, float* zbuffer, int width, int hei
 }
 
 // Scene 181: Audio Flash Strobes - Intense flashing patterns synced to beats
-void scene_audio_flash_strobes(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params, AudioData* audio) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+void scene_audio_flash_strobes(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float strobe_speed = params[0].value * 10.0f + 2.0f;     // 2-12 Hz
     float pattern_type = params[1].value * 5.0f;             // 0-5 patterns
     float audio_trigger = params[2].value;                   // 0-1 audio sensitivity
@@ -14236,112 +14146,95 @@ void scene_audio_flash_strobes(char* buffer, float* zbuffer, int width, int heig
 }
 
 // Scene 182: Audio Explosions - Particle explosions triggered by beats
-void scene_audio_explosions(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params, AudioData* audio) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+void scene_audio_explosions(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float explosion_size = params[0].value * 20.0f + 10.0f;    // 10-30
-    float particle_count = params[1].value * 100.0f + 50.0f;   // 50-150
+    float particle_count = 150.0f * powf(10.0f, params[1].value - 1.0f); // 15-15000
     float gravity = params[2].value * 2.0f;                    // 0-2
     
     static float last_beat_time = 0;
-    static float explosions[10][5]; // x, y, time, intensity, type
+    static float bursts[10][3]; // x, y, time of the latest explosions, for their flashes
     static int explosion_count = 0;
+    static ParticlePool sparks; // Kind is the explosion type
+    static SimClock clock = { SIM_RATE_HZ };
     
     // Check for new explosions
+    float intensity = 0.0f;
     if (audio && audio->valid && audio->beat_detected) {
         if (time - last_beat_time > 0.1f) { // Debounce beats
-            // Add new explosion
-            explosions[explosion_count % 10][0] = width * 0.2f + (rand() % (int)(width * 0.6f));
-            explosions[explosion_count % 10][1] = height * 0.2f + (rand() % (int)(height * 0.6f));
-            explosions[explosion_count % 10][2] = time;
-            explosions[explosion_count % 10][3] = audio->beat_intensity;
-            explosions[explosion_count % 10][4] = rand() % 3; // explosion type
-            explosion_count++;
-            last_beat_time = time;
+            intensity = audio->beat_intensity;
         }
     } else if (!audio || !audio->valid) {
         // Simulate explosions without audio
         if ((int)(time * 2) % 2 == 0 && time - last_beat_time > 0.5f) {
-            explosions[explosion_count % 10][0] = width * 0.2f + (rand() % (int)(width * 0.6f));
-            explosions[explosion_count % 10][1] = height * 0.2f + (rand() % (int)(height * 0.6f));
-            explosions[explosion_count % 10][2] = time;
-            explosions[explosion_count % 10][3] = 0.8f;
-            explosions[explosion_count % 10][4] = rand() % 3;
-            explosion_count++;
-            last_beat_time = time;
-        }
+            intensity = 0.8f;
+        }
+    }
+    
+    if (intensity > 0.0f) {
+        float* burst = bursts[explosion_count % 10];
+        burst[0] = width * 0.2f + (rand() % (int)(width * 0.6f));
+        burst[1] = height * 0.2f + (rand() % (int)(height * 0.6f));
+        burst[2] = time;
+        explosion_count++;
+        last_beat_time = time;
+    
+        // Sparks fly out at 0.5-1.1 times the explosion size per second,
+        // half as fast vertically, and burn for two seconds
+        int type = rand() % 3;
+        int n = lod_count((int)(particle_count * intensity), 1);
+        ParticleEmitter emitter = {
+            .x = burst[0], .y = burst[1],
+            .speed_min = explosion_size * 0.5f / SIM_RATE_HZ,
+            .speed_max = explosion_size * 1.1f / SIM_RATE_HZ,
+            .aspect_y = 0.5f,
+            .life = 2.0f * SIM_RATE_HZ,
+            .kind = type
+        };
+        particles_emit(&sparks, &emitter, type == 2 ? n / 3 : n);   // Sparkles are sparse
     }
     
-    // Render active explosions
+    // Gravity pulls the sparks down gravity * 10 cells per second squared
+    ParticleForces forces = {
+        .gravity_y = gravity * 10.0f / (SIM_RATE_HZ * SIM_RATE_HZ),
+        .drag = 1.0f,
+        .edges = PARTICLES_KILL,
+        .width = width,
+        .height = height
+    };
+    float alpha;
+    int steps = sim_clock_advance(&clock, time, &alpha);
+    for (int step = 0; step < steps; step++) {
+        particles_step(&sparks, &forces);
+    }
+    
+    // Glyphs over the two seconds, a tenth of a second each: standard
+    // sparks cool from '#' to '.', rings only show between 0.3 and 1.0 s
+    ParticleStyle style = {
+        .ramp = { "##***+++++..........", "   ooooooo          ", "********************" },
+        .depth = 50.0f,
+        .depth_fade = -40.0f
+    };
+    particles_splat(&sparks, &style, alpha, buffer, zbuffer, width, height);
+    
+    // Central flash
     for (int e = 0; e < 10; e++) {
-        if (explosions[e][2] > 0) {
-            float age = time - explosions[e][2];
-            if (age < 2.0f) {
-                float ex = explosions[e][0];
-                float ey = explosions[e][1];
-                float intensity = explosions[e][3];
-                int type = (int)explosions[e][4];
-                
-                int particles = (int)(particle_count * intensity);
-                
-                for (int p = 0; p < particles; p++) {
-                    float angle = (p / (float)particles) * M_PI * 2;
-                    float speed = explosion_size * (0.5f + (p % 3) * 0.3f);
-                    
-                    // Particle position with gravity
-                    float px = ex + cosf(angle) * speed * age;
-                    float py = ey + sinf(angle) * speed * age * 0.5f + gravity * age * age * 5;
-                    
-                    int x = (int)px;
-                    int y = (int)py;
-                    
+        float age = time - bursts[e][2];
+        if (bursts[e][2] > 0 && age >= 0.0f && age < 0.1f) {
+            for (int dy = -3; dy <= 3; dy++) {
+                for (int dx = -5; dx <= 5; dx++) {
+                    int x = (int)bursts[e][0] + dx;
+                    int y = (int)bursts[e][1] + dy;
                     if (x >= 0 && x < width && y >= 0 && y < height) {
-                        char c;
-                        if (age < 0.2f) c = '#';
-                        else if (age < 0.5f) c = '*';
-                        else if (age < 1.0f) c = '+';
-                        else c = '.';
-                        
-                        // Different explosion types
-                        switch (type) {
-                            case 0: // Standard
-                                set_pixel(buffer, zbuffer, width, height, x, y, c, 50.0f - age * 20);
-                                break;
-                            case 1: // Ring
-                                if (age > 0.3f && age < 1.0f) {
-                                    set_pixel(buffer, zbuffer, width, height, x, y, 'o', 50.0f - age * 20);
-                                }
-                                break;
-                            case 2: // Sparkles
-                                if (p % 3 == 0) {
-                                    set_pixel(buffer, zbuffer, width, height, x, y, '*', 50.0f - age * 20);
-                                }
-                                break;
-                        }
-                    }
-                }
-                
-                // Central flash
-                if (age < 0.1f) {
-                    for (int dy = -3; dy <= 3; dy++) {
-                        for (int dx = -5; dx <= 5; dx++) {
-                            int x = (int)ex + dx;
-                            int y = (int)ey + dy;
-                            if (x >= 0 && x < width && y >= 0 && y < height) {
-                                set_pixel(buffer, zbuffer, width, height, x, y, '#', 100.0f);
-                            }
-                        }
+                        set_pixel(buffer, zbuffer, width, height, x, y, '#', 100.0f);
                     }
                 }
             }
         }
     }
 }
-
-// Scene 183: Audio Wave Tunnel - 3D tunnel that pulses with audio
-void scene_audio_wave_tunnel(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params, AudioData* audio) {
-    clear_buffer(buffer, zbuffer, width, height);
     
+// Scene 183: Audio Wave Tunnel - 3D tunnel that pulses with audio
+void scene_audio_wave_tunnel(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float tunnel_speed = params[0].value * 3.0f + 0.5f;      // 0.5-3.5
     float wave_amplitude = params[1].value * 10.0f + 2.0f;   // 2-12
     float rotation_speed = params[2].value * 2.0f;           // 0-2
@@ -14405,15 +14298,40 @@ void scene_audio_wave_tunnel(char* buffer, float* zbuffer, int width, int height
 }
 
 // Scene 184: Audio Spectrum 3D - 3D visualization of frequency spectrum
-void scene_audio_spectrum_3d(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params, AudioData* audio) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+void scene_audio_spectrum_3d(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float bar_height_scale = params[0].value * 20.0f + 5.0f;  // 5-25
     float perspective = params[1].value * 30.0f + 20.0f;      // 20-50
     float rotation = params[2].value * time * 2.0f;           // rotation angle
     
     int num_bands = 32; // Use half of the 64 bands for cleaner display
     
+    // Spectrogram waterfall trailing behind the live bars
+    if (audio && audio->valid) {
+        int history_rows = (int)(params[3].value * 8.0f);     // 0-24 rows
+        AudioSpectroView spectro = audio_history_spectro_view(&audio->history, history_rows * 4);
+        
+        for (int row = 1; row * 4 < spectro.length; row++) {
+            const uint8_t* bins = audio_spectro_row(&spectro, row * 4);
+            float z3d = 10.0f + row * 3.0f;
+            
+            for (int band = 0; band < num_bands; band++) {
+                float value = (bins[band * 2] + bins[band * 2 + 1]) * (0.5f / 255.0f);
+                if (value < 0.2f) continue;
+                
+                float x3d = (band - num_bands/2.0f) * 3.0f;
+                float rx = x3d * cosf(rotation) - z3d * sinf(rotation);
+                float rz = x3d * sinf(rotation) + z3d * cosf(rotation) + 20;
+                if (rz < 1.0f) continue;
+                
+                int x = width/2 + (int)(rx * perspective / rz);
+                int y = height/2 + (int)((-value * bar_height_scale + 5) * perspective / rz);
+                if (x >= 0 && x < width && y >= 0 && y < height) {
+                    set_pixel(buffer, zbuffer, width, height, x, y, value > 0.6f ? ':' : '.', rz);
+                }
+            }
+        }
+    }
+    
     for (int band = 0; band < num_bands; band++) {
         float value = 0.3f; // Default value
         
@@ -14479,104 +14397,90 @@ void scene_audio_spectrum_3d(char* buffer, float* zbuffer, int width, int height
 }
 
 // Scene 185: Audio Reactive Particles - Particles that dance to the music
-void scene_audio_reactive_particles(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params, AudioData* audio) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
-    float particle_count = params[0].value * 200.0f + 50.0f;   // 50-250
+void scene_audio_reactive_particles(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
+    float particle_count = 250.0f * powf(10.0f, params[0].value - 1.0f); // 25-25000
     float movement_speed = params[1].value * 5.0f + 1.0f;      // 1-6
     float audio_influence = params[2].value * 3.0f + 0.5f;     // 0.5-3.5
     
-    static float particle_x[250];
-    static float particle_y[250];
-    static float particle_vx[250];
-    static float particle_vy[250];
-    static int initialized = 0;
-    
-    int count = (int)particle_count;
-    
-    // Initialize particles
-    if (!initialized) {
-        for (int i = 0; i < 250; i++) {
-            particle_x[i] = rand() % width;
-            particle_y[i] = rand() % height;
-            particle_vx[i] = (rand() % 100 - 50) / 50.0f;
-            particle_vy[i] = (rand() % 100 - 50) / 50.0f;
-        }
-        initialized = 1;
+    static ParticlePool particles;  // Kind is the band: 0 bass, 1 mid, 2 treble
+    static SimClock clock = { SIM_RATE_HZ };
+    
+    // Velocities are kept in cells per step
+    float scale = movement_speed * 0.1f;
+    int count = lod_count((int)particle_count, 10);
+    particles_trim(&particles, count);
+    for (int band = 0; particles.count < count && band < 3; band++) {
+        ParticleEmitter emitter = {
+            .x = width * 0.5f, .spread_x = width * 0.5f,
+            .y = height * 0.5f, .spread_y = height * 0.5f,
+            .speed_max = 1.41f * scale, .aspect_y = 1.0f,
+            .life = INFINITY,
+            .kind = band
+        };
+        particles_emit(&particles, &emitter, (count - particles.count) / (3 - band));
     }
     
-    float bass_force = 0, mid_force = 0, treble_force = 0;
+    float alpha;
+    int steps = sim_clock_advance(&clock, time, &alpha);
+    for (int step = 0; step < steps; step++) {
+        float step_time = sim_clock_step_time(&clock, step, steps);
+        float bass_force = 0, mid_force = 0, treble_force = 0;
     
-    if (audio && audio->valid) {
-        bass_force = audio->bass * audio_influence;
-        mid_force = audio->mid * audio_influence;
-        treble_force = audio->treble * audio_influence;
-    } else {
-        // Simulate audio forces
-        bass_force = (sinf(time * 1.5f) + 1.0f) * 0.5f;
-        mid_force = (sinf(time * 2.3f) + 1.0f) * 0.5f;
-        treble_force = (sinf(time * 3.7f) + 1.0f) * 0.5f;
-    }
-    
-    // Update and draw particles
-    for (int i = 0; i < count; i++) {
-        // Audio-influenced movement
-        float angle = atan2f(particle_y[i] - height/2.0f, particle_x[i] - width/2.0f);
-        
-        // Different frequency bands affect particles differently
-        if (i % 3 == 0) {
-            // Bass particles - move radially
-            particle_vx[i] += cosf(angle) * bass_force * 0.5f;
-            particle_vy[i] += sinf(angle) * bass_force * 0.5f;
-        } else if (i % 3 == 1) {
-            // Mid particles - circular motion
-            particle_vx[i] += -sinf(angle) * mid_force * 0.3f;
-            particle_vy[i] += cosf(angle) * mid_force * 0.3f;
+        if (audio && audio->valid) {
+            bass_force = audio->bass * audio_influence;
+            mid_force = audio->mid * audio_influence;
+            treble_force = audio->treble * audio_influence;
         } else {
-            // Treble particles - random jitter
-            particle_vx[i] += (rand() % 100 - 50) / 50.0f * treble_force;
-            particle_vy[i] += (rand() % 100 - 50) / 50.0f * treble_force;
-        }
-        
-        // Apply velocity with damping
-        particle_x[i] += particle_vx[i] * movement_speed * 0.1f;
-        particle_y[i] += particle_vy[i] * movement_speed * 0.1f;
-        particle_vx[i] *= 0.95f;
-        particle_vy[i] *= 0.95f;
-        
-        // Wrap around screen
-        if (particle_x[i] < 0) particle_x[i] = width - 1;
-        if (particle_x[i] >= width) particle_x[i] = 0;
-        if (particle_y[i] < 0) particle_y[i] = height - 1;
-        if (particle_y[i] >= height) particle_y[i] = 0;
-        
-        // Draw particle
-        int x = (int)particle_x[i];
-        int y = (int)particle_y[i];
-        
-        char c;
-        if (i % 3 == 0) c = '#';  // Bass
-        else if (i % 3 == 1) c = '*';  // Mid
-        else c = '.';  // Treble
-        
-        set_pixel(buffer, zbuffer, width, height, x, y, c, 10.0f);
-        
-        // Trail effect for moving particles
-        float speed = sqrtf(particle_vx[i]*particle_vx[i] + particle_vy[i]*particle_vy[i]);
-        if (speed > 2.0f) {
-            int tx = x - (int)(particle_vx[i] * 0.5f);
-            int ty = y - (int)(particle_vy[i] * 0.5f);
-            if (tx >= 0 && tx < width && ty >= 0 && ty < height) {
-                set_pixel(buffer, zbuffer, width, height, tx, ty, '.', 15.0f);
+            // Simulate audio forces
+            bass_force = (sinf(step_time * 1.5f) + 1.0f) * 0.5f;
+            mid_force = (sinf(step_time * 2.3f) + 1.0f) * 0.5f;
+            treble_force = (sinf(step_time * 3.7f) + 1.0f) * 0.5f;
+        }
+    
+        // Different frequency bands push particles differently
+        for (int i = 0; i < particles.count; i++) {
+            float dx = particles.x[i] - width / 2.0f;
+            float dy = particles.y[i] - height / 2.0f;
+            float inv = 1.0f / (sqrtf(dx * dx + dy * dy) + 1e-6f);
+    
+            switch (particles.kind[i]) {
+                case 0: // Bass particles - move radially
+                    particles.vx[i] += dx * inv * bass_force * 0.5f * scale;
+                    particles.vy[i] += dy * inv * bass_force * 0.5f * scale;
+                    break;
+                case 1: // Mid particles - circular motion
+                    particles.vx[i] += -dy * inv * mid_force * 0.3f * scale;
+                    particles.vy[i] += dx * inv * mid_force * 0.3f * scale;
+                    break;
+                default: // Treble particles - random jitter
+                    particles.vx[i] += (particles_random(&particles) * 2.0f - 1.0f) * treble_force * scale;
+                    particles.vy[i] += (particles_random(&particles) * 2.0f - 1.0f) * treble_force * scale;
+                    break;
             }
         }
+    
+        // Move with damping, wrapping around the screen
+        ParticleForces forces = {
+            .drag = 0.95f,
+            .edges = PARTICLES_WRAP,
+            .width = width,
+            .height = height
+        };
+        particles_step(&particles, &forces);
     }
+    
+    // Fast particles leave a trail
+    ParticleStyle style = {
+        .ramp = { "#", "*", "." },
+        .trail = { ".", ".", "." },
+        .trail_speed = 2.0f * scale,
+        .depth = 10.0f
+    };
+    particles_splat(&particles, &style, alpha, buffer, zbuffer, width, height);
 }
-
-// Scene 186: Audio Pulse Rings - Concentric rings that pulse with audio
-void scene_audio_pulse_rings(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params, AudioData* audio) {
-    clear_buffer(buffer, zbuffer, width, height);
     
+// Scene 186: Audio Pulse Rings - Concentric rings that pulse with audio
+void scene_audio_pulse_rings(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float ring_count = params[0].value * 10.0f + 3.0f;        // 3-13 rings
     float pulse_speed = params[1].value * 3.0f + 0.5f;        // 0.5-3.5
     float audio_scale = params[2].value * 2.0f + 0.5f;        // 0.5-2.5
@@ -14645,32 +14549,41 @@ void scene_audio_pulse_rings(char* buffer, float* zbuffer, int width, int height
 }
 
 // Scene 187: Audio Waveform 3D - 3D waveform visualization
-void scene_audio_waveform_3d(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params, AudioData* audio) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+void scene_audio_waveform_3d(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float wave_height = params[0].value * 15.0f + 5.0f;       // 5-20
     float wave_depth = params[1].value * 20.0f + 10.0f;       // 10-30
     float rotation_speed = params[2].value * 2.0f - 1.0f;     // -1 to 1
     
     float angle = time * rotation_speed;
     
+    // Each layer is an older slice of the waveform history, newest in front
+    const int layers = 5;
+    int layer_stride = AUDIO_WAVE_HISTORY / (layers + 1) - width;
+    if (layer_stride < 0) layer_stride = 0;
+    
+    AudioWaveView wave = {0};
+    if (audio && audio->valid) {
+        wave = audio_history_wave_view(&audio->history, AUDIO_WAVE_HISTORY);
+    }
+    
     // Draw multiple waveform layers in 3D
-    for (int layer = 0; layer < 5; layer++) {
+    for (int layer = 0; layer < layers; layer++) {
         float z = wave_depth - layer * 5;
         float layer_scale = 1.0f - layer * 0.15f;
         
         for (int x = 0; x < width; x++) {
-            float wave_value = 0.5f;
+            float wave_value = 0.0f;
             
-            if (audio && audio->valid) {
-                // Map x position to spectrum bands
-                int band = (x * 64) / width;
-                wave_value = audio->spectrum[band] * layer_scale;
+            int age = layer * (width + layer_stride) + (width - 1 - x);
+            if (age < wave.length) {
+                // Oscilloscope trace, oldest sample of the slice on the left
+                wave_value = audio_wave_sample(&wave, age) * 2.0f * layer_scale;
             } else {
                 // Simulate waveform
                 float freq = 0.1f + layer * 0.05f;
                 wave_value = (sinf(x * freq + time * 2) + 1.0f) * 0.25f * layer_scale;
             }
+            wave_value = clamp(wave_value, -1.0f, 1.0f);
             
             int wave_h = (int)(wave_value * wave_height);
             
@@ -14696,9 +14609,10 @@ void scene_audio_waveform_3d(char* buffer, float* zbuffer, int width, int height
                 
                 set_pixel(buffer, zbuffer, width, height, px, py, c, rz);
                 
-                // Draw vertical lines
+                // Draw vertical lines from the baseline to the trace
                 if (x % 4 == 0) {
-                    for (int h = 0; h < wave_h; h++) {
+                    int dir = wave_h < 0 ? -1 : 1;
+                    for (int h = 0; h != wave_h; h += dir) {
                         y3d = -h;
                         py = height/2 + (int)(y3d * 20 / rz);
                         if (py >= 0 && py < height) {
@@ -14721,9 +14635,7 @@ void scene_audio_waveform_3d(char* buffer, float* zbuffer, int width, int height
 }
 
 // Scene 188: Audio Matrix Grid - Matrix of cells that react to audio
-void scene_audio_matrix_grid(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params, AudioData* audio) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+void scene_audio_matrix_grid(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float grid_size = params[0].value * 8.0f + 4.0f;          // 4-12
     float reaction_speed = params[1].value * 5.0f + 1.0f;     // 1-6
     float threshold = params[2].value * 0.7f + 0.1f;          // 0.1-0.8
@@ -14811,9 +14723,7 @@ void scene_audio_matrix_grid(char* buffer, float* zbuffer, int width, int height
 }
 
 // Scene 189: Audio Reactive Fractals - Fractals that morph with audio
-void scene_audio_reactive_fractals(char* buffer, float* zbuffer, int width, int height, float time, Parameter* params, AudioData* audio) {
-    clear_buffer(buffer, zbuffer, width, height);
-    
+void scene_audio_reactive_fractals(char* buffer, float* zbuffer, int width, int height, Parameter* params, float time, AudioData* audio) {
     float zoom = params[0].value * 3.0f + 0.5f;               // 0.5-3.5
     float iterations = params[1].value * 20.0f + 10.0f;       // 10-30
     float audio_morph = params[2].value * 2.0f;               // 0-2
@@ -14836,7 +14746,14 @@ void scene_audio_reactive_fractals(char* buffer, float* zbuffer, int width, int
     float cx = -0.7f + cx_mod + sinf(time * 0.5f) * 0.1f;
     float cy = 0.27f + cy_mod + cosf(time * 0.5f) * 0.1f;
     
-    int max_iter = (int)iterations;
+    int max_iter = lod_count((int)iterations, 8);
+    int cells = width * height;
+    
+    // Smooth counts, then the warped start point of every cell
+    float* smooth = fractal_scratch(cells * 3);
+    if (!smooth) return;
+    float* start_re = smooth + cells;
+    float* start_im = start_re + cells;
     
     for (int py = 0; py < height; py++) {
         for (int px = 0; px < width; px++) {
@@ -14848,43 +14765,37 @@ void scene_audio_reactive_fractals(char* buffer, float* zbuffer, int width, int
             x += audio_mod * sinf(y * 5) * 0.1f;
             y += audio_mod * cosf(x * 5) * 0.1f;
             
-            // Julia set iteration
-            int iter;
-            for (iter = 0; iter < max_iter; iter++) {
-                float x2 = x * x;
-                float y2 = y * y;
-                
-                if (x2 + y2 > 4.0f) break;
-                
-                float xtemp = x2 - y2 + cx;
-                y = 2 * x * y + cy;
-                x = xtemp;
-            }
-            
-            // Color based on iteration count and audio
-            if (iter < max_iter) {
-                char c;
-                float norm_iter = (float)iter / max_iter;
-                
-                if (audio && audio->valid) {
-                    // Audio-reactive coloring
-                    if (norm_iter < audio->bass * 0.3f) c = '#';
-                    else if (norm_iter < audio->mid * 0.6f) c = '*';
-                    else if (norm_iter < audio->treble * 0.9f) c = '+';
-                    else c = '.';
-                } else {
-                    // Default coloring
-                    if (norm_iter < 0.25f) c = '#';
-                    else if (norm_iter < 0.5f) c = '*';
-                    else if (norm_iter < 0.75f) c = '+';
-                    else c = '.';
-                }
-                
-                set_pixel(buffer, zbuffer, width, height, px, py, c, 50.0f - iter);
-            }
+            start_re[py * width + px] = x;
+            start_im[py * width + px] = y;
         }
     }
     
+    fractal_escape_points(FRACTAL_JULIA, start_re, start_im, cells, cx, cy, max_iter, smooth);
+    
+    for (int i = 0; i < cells; i++) {
+        if (smooth[i] == FRACTAL_INSIDE) continue;
+        
+        // Color based on iteration count and audio
+        char c;
+        float norm_iter = smooth[i] / max_iter;
+        
+        if (audio && audio->valid) {
+            // Audio-reactive coloring
+            if (norm_iter < audio->bass * 0.3f) c = '#';
+            else if (norm_iter < audio->mid * 0.6f) c = '*';
+            else if (norm_iter < audio->treble * 0.9f) c = '+';
+            else c = '.';
+        } else {
+            // Default coloring
+            if (norm_iter < 0.25f) c = '#';
+            else if (norm_iter < 0.5f) c = '*';
+            else if (norm_iter < 0.75f) c = '+';
+            else c = '.';
+        }
+        
+        set_pixel(buffer, zbuffer, width, height, i % width, i / width, c, 50.0f - smooth[i]);
+    }
+    
     // Beat effect - invert center
     if (audio && audio->valid && audio->beat_detected) {
         int size = (int)(audio->beat_intensity * 20);
@@ -14905,6 +14816,240 @@ void scene_audio_reactive_fractals(char* buffer, float* zbuffer, int width, int
     }
 }
 
+// ============= SCENE REGISTRY =============
+
+// Every scene, indexed by scene id. vj_render dispatches through it and the
+// schedulers read the flags and cost class.
+const SceneDesc scene_registry[SCENE_COUNT] = {
+    // Basic (0-9)
+    { "Audio Bars", SCENE_CAT_BASIC, scene_audio_bars, SCENE_USES_DEPTH | SCENE_AUDIO_REACTIVE, SCENE_COST_LIGHT },
+    { "Rotating Cube", SCENE_CAT_BASIC, scene_cube, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "DNA Helix", SCENE_CAT_BASIC, scene_dna_helix, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Particle Field", SCENE_CAT_BASIC, scene_particle_field, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Torus", SCENE_CAT_BASIC, scene_torus, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Fractal Tree", SCENE_CAT_BASIC, scene_fractal_tree, 0, SCENE_COST_MEDIUM },
+    { "Wave Mesh", SCENE_CAT_BASIC, scene_wave_mesh, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Sphere", SCENE_CAT_BASIC, scene_sphere, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Spirograph", SCENE_CAT_BASIC, scene_spirograph, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Matrix Rain", SCENE_CAT_BASIC, scene_matrix_rain, SCENE_STATEFUL, SCENE_COST_MEDIUM },
+    
+    // Geometric (10-19)
+    { "Tunnels", SCENE_CAT_GEOMETRIC, scene_tunnels, SCENE_USES_DEPTH, SCENE_COST_HEAVY },
+    { "Kaleidoscope", SCENE_CAT_GEOMETRIC, scene_kaleidoscope, 0, SCENE_COST_HEAVY },
+    { "Mandala", SCENE_CAT_GEOMETRIC, scene_mandala, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Sierpinski", SCENE_CAT_GEOMETRIC, scene_sierpinski, 0, SCENE_COST_LIGHT },
+    { "Hexagon Grid", SCENE_CAT_GEOMETRIC, scene_hexagon_grid, 0, SCENE_COST_MEDIUM },
+    { "Tessellations", SCENE_CAT_GEOMETRIC, scene_tessellations, 0, SCENE_COST_LIGHT },
+    { "Voronoi Cells", SCENE_CAT_GEOMETRIC, scene_voronoi_cells, SCENE_PARALLEL, SCENE_COST_HEAVY },
+    { "Sacred Geometry", SCENE_CAT_GEOMETRIC, scene_sacred_geometry, 0, SCENE_COST_LIGHT },
+    { "Polyhedra", SCENE_CAT_GEOMETRIC, scene_polyhedra, SCENE_USES_DEPTH | SCENE_PARALLEL, SCENE_COST_LIGHT },
+    { "Maze Generator", SCENE_CAT_GEOMETRIC, scene_maze_generator, SCENE_STATEFUL, SCENE_COST_LIGHT, 0.0f, scene_maze_change_key },
+    
+    // Organic (20-29)
+    { "Fire Simulation", SCENE_CAT_ORGANIC, scene_fire_simulation, SCENE_STATEFUL | SCENE_PARALLEL, SCENE_COST_MEDIUM },
+    { "Water Waves", SCENE_CAT_ORGANIC, scene_water_waves, SCENE_STATEFUL | SCENE_PARALLEL, SCENE_COST_MEDIUM },
+    { "Lightning", SCENE_CAT_ORGANIC, scene_lightning, SCENE_STATEFUL, SCENE_COST_LIGHT },
+    { "Plasma Clouds", SCENE_CAT_ORGANIC, scene_plasma_clouds, 0, SCENE_COST_HEAVY },
+    { "Galaxy Spiral", SCENE_CAT_ORGANIC, scene_galaxy_spiral, 0, SCENE_COST_MEDIUM },
+    { "Tree of Life", SCENE_CAT_ORGANIC, scene_tree_of_life, 0, SCENE_COST_LIGHT },
+    { "Cellular Automata", SCENE_CAT_ORGANIC, scene_cellular_automata, SCENE_STATEFUL | SCENE_PARALLEL, SCENE_COST_MEDIUM },
+    { "Flocking Birds", SCENE_CAT_ORGANIC, scene_flocking_birds, SCENE_USES_DEPTH | SCENE_STATEFUL | SCENE_PARALLEL, SCENE_COST_MEDIUM },
+    { "Wind Patterns", SCENE_CAT_ORGANIC, scene_wind_patterns, 0, SCENE_COST_MEDIUM },
+    { "Neural Networks", SCENE_CAT_ORGANIC, scene_neural_networks, 0, SCENE_COST_MEDIUM },
+    
+    // Text/Code (30-39)
+    { "Code Rain", SCENE_CAT_TEXT, scene_matrix_rain, SCENE_STATEFUL, SCENE_COST_MEDIUM },
+    { "Terminal Hacking", SCENE_CAT_TEXT, scene_ascii_art_generator, 0, SCENE_COST_HEAVY },
+    { "Binary Waterfall", SCENE_CAT_TEXT, scene_code_rain, SCENE_STATEFUL, SCENE_COST_MEDIUM },
+    { "ASCII Art Morph", SCENE_CAT_TEXT, scene_binary_stream, 0, SCENE_COST_LIGHT, 20.0f },
+    { "Glitch Text", SCENE_CAT_TEXT, scene_terminal_glitch, SCENE_STATEFUL, SCENE_COST_LIGHT },
+    { "Data Streams", SCENE_CAT_TEXT, scene_syntax_highlighting, 0, SCENE_COST_LIGHT },
+    { "Circuit Patterns", SCENE_CAT_TEXT, scene_data_visualization, 0, SCENE_COST_LIGHT },
+    { "QR Code Rain", SCENE_CAT_TEXT, scene_network_nodes, SCENE_STATEFUL, SCENE_COST_LIGHT },
+    { "Font Showcase", SCENE_CAT_TEXT, scene_system_monitor, 0, SCENE_COST_LIGHT },
+    { "Terminal Commands", SCENE_CAT_TEXT, scene_command_line, 0, SCENE_COST_LIGHT },
+    
+    // Abstract (40-49)
+    { "Noise Field", SCENE_CAT_ABSTRACT, scene_noise_field, 0, SCENE_COST_HEAVY },
+    { "Interference", SCENE_CAT_ABSTRACT, scene_swarm_intelligence, SCENE_STATEFUL | SCENE_PARALLEL, SCENE_COST_LIGHT },
+    { "Hologram", SCENE_CAT_ABSTRACT, scene_fractal_zoom, SCENE_PARALLEL, SCENE_COST_HEAVY },
+    { "Digital Rain", SCENE_CAT_ABSTRACT, scene_morphing_shapes, 0, SCENE_COST_LIGHT },
+    { "Glitch Corruption", SCENE_CAT_ABSTRACT, scene_glitch_corruption, SCENE_STATEFUL | SCENE_OVERWRITES_BUFFER, SCENE_COST_MEDIUM },
+    { "Signal Static", SCENE_CAT_ABSTRACT, scene_energy_waves, 0, SCENE_COST_HEAVY },
+    { "Bitmap Fade", SCENE_CAT_ABSTRACT, scene_digital_rain, SCENE_STATEFUL, SCENE_COST_MEDIUM },
+    { "Pixel Sort", SCENE_CAT_ABSTRACT, scene_psychedelic_patterns, 0, SCENE_COST_HEAVY },
+    { "Datamosh", SCENE_CAT_ABSTRACT, scene_quantum_field, 0, SCENE_COST_MEDIUM },
+    { "Buffer Overflow", SCENE_CAT_ABSTRACT, scene_abstract_flow, 0, SCENE_COST_MEDIUM },
+    
+    // Infinite Tunnels (50-59)
+    { "Spiral Tunnel", SCENE_CAT_TUNNELS, scene_spiral_tunnel, SCENE_USES_DEPTH | SCENE_PARALLEL, SCENE_COST_HEAVY },
+    { "Hex Tunnel", SCENE_CAT_TUNNELS, scene_hex_tunnel, 0, SCENE_COST_LIGHT },
+    { "Star Tunnel", SCENE_CAT_TUNNELS, scene_star_tunnel, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Wormhole", SCENE_CAT_TUNNELS, scene_wormhole, SCENE_USES_DEPTH | SCENE_PARALLEL, SCENE_COST_HEAVY },
+    { "Cyber Tunnel", SCENE_CAT_TUNNELS, scene_cyber_tunnel, 0, SCENE_COST_MEDIUM },
+    { "Ring Tunnel", SCENE_CAT_TUNNELS, scene_ring_tunnel, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Matrix Tunnel", SCENE_CAT_TUNNELS, scene_matrix_tunnel, SCENE_USES_DEPTH, SCENE_COST_HEAVY },
+    { "Speed Tunnel", SCENE_CAT_TUNNELS, scene_speed_tunnel, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Pulse Tunnel", SCENE_CAT_TUNNELS, scene_pulse_tunnel, SCENE_USES_DEPTH, SCENE_COST_HEAVY },
+    { "Vortex Tunnel", SCENE_CAT_TUNNELS, scene_vortex_tunnel, SCENE_USES_DEPTH | SCENE_PARALLEL, SCENE_COST_HEAVY },
+    
+    // Nature (60-69)
+    { "Ocean Waves", SCENE_CAT_NATURE, scene_ocean_waves, SCENE_USES_DEPTH | SCENE_PARALLEL, SCENE_COST_HEAVY },
+    { "Rain Storm", SCENE_CAT_NATURE, scene_rain_storm, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Infinite Forest", SCENE_CAT_NATURE, scene_infinite_forest, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Growing Trees", SCENE_CAT_NATURE, scene_growing_trees, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Mountain Range", SCENE_CAT_NATURE, scene_mountain_range, SCENE_USES_DEPTH | SCENE_PARALLEL, SCENE_COST_HEAVY },
+    { "Aurora Borealis", SCENE_CAT_NATURE, scene_aurora_borealis, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Flowing River", SCENE_CAT_NATURE, scene_flowing_river, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Desert Dunes", SCENE_CAT_NATURE, scene_desert_dunes, SCENE_USES_DEPTH | SCENE_PARALLEL, SCENE_COST_MEDIUM },
+    { "Coral Reef", SCENE_CAT_NATURE, scene_coral_reef, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Butterfly Garden", SCENE_CAT_NATURE, scene_butterfly_garden, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    
+    // Explosions (70-79)
+    { "Nuclear Blast", SCENE_CAT_EXPLOSIONS, scene_nuclear_blast, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Building Collapse", SCENE_CAT_EXPLOSIONS, scene_building_collapse, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Meteor Impact", SCENE_CAT_EXPLOSIONS, scene_meteor_impact, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Chain Explosions", SCENE_CAT_EXPLOSIONS, scene_chain_explosions, SCENE_USES_DEPTH, SCENE_COST_HEAVY },
+    { "Volcanic Eruption", SCENE_CAT_EXPLOSIONS, scene_volcanic_eruption, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Shockwave Blast", SCENE_CAT_EXPLOSIONS, scene_shockwave_blast, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Glass Shatter", SCENE_CAT_EXPLOSIONS, scene_glass_shatter, SCENE_USES_DEPTH | SCENE_PARALLEL, SCENE_COST_MEDIUM },
+    { "Demolition Blast", SCENE_CAT_EXPLOSIONS, scene_demolition_blast, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Supernova Burst", SCENE_CAT_EXPLOSIONS, scene_supernova_burst, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Plasma Discharge", SCENE_CAT_EXPLOSIONS, scene_plasma_discharge, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    
+    // Cities (80-89)
+    { "Cyberpunk City", SCENE_CAT_CITIES, scene_cyberpunk_city, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "City Lights", SCENE_CAT_CITIES, scene_city_lights, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Skyscraper Forest", SCENE_CAT_CITIES, scene_skyscraper_forest, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Urban Decay", SCENE_CAT_CITIES, scene_urban_decay, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Future Metropolis", SCENE_CAT_CITIES, scene_future_metropolis, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "City Grid", SCENE_CAT_CITIES, scene_city_grid, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Digital City", SCENE_CAT_CITIES, scene_digital_city, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "City Flythrough", SCENE_CAT_CITIES, scene_city_flythrough, SCENE_USES_DEPTH | SCENE_PARALLEL, SCENE_COST_MEDIUM },
+    { "Neon Districts", SCENE_CAT_CITIES, scene_neon_districts, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Urban Canyon", SCENE_CAT_CITIES, scene_urban_canyon, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    
+    // Freestyle (90-99)
+    { "Black Hole", SCENE_CAT_FREESTYLE, scene_black_hole, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Quantum Field", SCENE_CAT_FREESTYLE, scene_quantum_field, 0, SCENE_COST_MEDIUM },
+    { "Dimensional Rift", SCENE_CAT_FREESTYLE, scene_dimensional_rift, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Alien Landscape", SCENE_CAT_FREESTYLE, scene_alien_landscape, SCENE_USES_DEPTH | SCENE_PARALLEL, SCENE_COST_MEDIUM },
+    { "Robot Factory", SCENE_CAT_FREESTYLE, scene_robot_factory, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Time Vortex", SCENE_CAT_FREESTYLE, scene_time_vortex, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Glitch World", SCENE_CAT_FREESTYLE, scene_glitch_world, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Neural Network", SCENE_CAT_FREESTYLE, scene_neural_network, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Cosmic Dance", SCENE_CAT_FREESTYLE, scene_cosmic_dance, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Reality Glitch", SCENE_CAT_FREESTYLE, scene_reality_glitch, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    
+    // Human (100-109)
+    { "Human Walker", SCENE_CAT_HUMAN, scene_human_walker, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Dance Party", SCENE_CAT_HUMAN, scene_dance_party, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Martial Arts", SCENE_CAT_HUMAN, scene_martial_arts, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Human Pyramid", SCENE_CAT_HUMAN, scene_human_pyramid, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Yoga Flow", SCENE_CAT_HUMAN, scene_yoga_flow, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Sports Stadium", SCENE_CAT_HUMAN, scene_sports_stadium, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Robot Dance", SCENE_CAT_HUMAN, scene_robot_dance, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Crowd Wave", SCENE_CAT_HUMAN, scene_crowd_wave, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Mirror Dance", SCENE_CAT_HUMAN, scene_mirror_dance, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Human Evolution", SCENE_CAT_HUMAN, scene_human_evolution, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    
+    // Warfare (110-119)
+    { "Fighter Squadron", SCENE_CAT_WARFARE, scene_fighter_squadron, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Drone Swarm", SCENE_CAT_WARFARE, scene_drone_swarm, SCENE_USES_DEPTH | SCENE_STATEFUL | SCENE_PARALLEL, SCENE_COST_LIGHT },
+    { "Strategic Bombing", SCENE_CAT_WARFARE, scene_strategic_bombing, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Dogfight", SCENE_CAT_WARFARE, scene_dogfight, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Helicopter Assault", SCENE_CAT_WARFARE, scene_helicopter_assault, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Stealth Mission", SCENE_CAT_WARFARE, scene_stealth_mission, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Carrier Strike", SCENE_CAT_WARFARE, scene_carrier_strike, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Missile Defense", SCENE_CAT_WARFARE, scene_missile_defense, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Recon Drone", SCENE_CAT_WARFARE, scene_recon_drone, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Air Command", SCENE_CAT_WARFARE, scene_air_command, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    
+    // Revolution & Eyes (120-129)
+    { "Street Revolution", SCENE_CAT_REVOLUTION, scene_120, SCENE_USES_DEPTH | SCENE_STATEFUL | SCENE_OVERWRITES_BUFFER, SCENE_COST_LIGHT },
+    { "Barricade Building", SCENE_CAT_REVOLUTION, scene_121, SCENE_USES_DEPTH | SCENE_OVERWRITES_BUFFER, SCENE_COST_LIGHT },
+    { "CCTV Camera", SCENE_CAT_REVOLUTION, scene_122, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Giant Eye", SCENE_CAT_REVOLUTION, scene_123, SCENE_USES_DEPTH | SCENE_OVERWRITES_BUFFER, SCENE_COST_LIGHT },
+    { "Crowd March", SCENE_CAT_REVOLUTION, scene_124, SCENE_USES_DEPTH | SCENE_OVERWRITES_BUFFER, SCENE_COST_LIGHT },
+    { "Displaced Sphere", SCENE_CAT_REVOLUTION, scene_125, SCENE_USES_DEPTH | SCENE_STATEFUL | SCENE_OVERWRITES_BUFFER, SCENE_COST_MEDIUM },
+    { "Morphing Cube", SCENE_CAT_REVOLUTION, scene_126, SCENE_USES_DEPTH | SCENE_STATEFUL | SCENE_OVERWRITES_BUFFER, SCENE_COST_MEDIUM },
+    { "Protest Rally", SCENE_CAT_REVOLUTION, scene_127, SCENE_USES_DEPTH | SCENE_OVERWRITES_BUFFER, SCENE_COST_MEDIUM },
+    { "Surveillance Eyes", SCENE_CAT_REVOLUTION, scene_128, SCENE_USES_DEPTH | SCENE_STATEFUL | SCENE_OVERWRITES_BUFFER, SCENE_COST_MEDIUM },
+    { "Fractal Displacement", SCENE_CAT_REVOLUTION, scene_129, SCENE_USES_DEPTH | SCENE_STATEFUL | SCENE_OVERWRITES_BUFFER, SCENE_COST_MEDIUM },
+    
+    // Film Noir (130-139)
+    { "Venetian Blinds", SCENE_CAT_FILM_NOIR, scene_130, SCENE_USES_DEPTH, SCENE_COST_HEAVY },
+    { "Silhouette Door", SCENE_CAT_FILM_NOIR, scene_131, SCENE_USES_DEPTH, SCENE_COST_LIGHT, 12.0f },
+    { "Rain Window", SCENE_CAT_FILM_NOIR, scene_132, SCENE_USES_DEPTH | SCENE_STATEFUL, SCENE_COST_LIGHT },
+    { "Detective Coat", SCENE_CAT_FILM_NOIR, scene_133, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Femme Fatale", SCENE_CAT_FILM_NOIR, scene_134, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Smoke Room", SCENE_CAT_FILM_NOIR, scene_135, SCENE_USES_DEPTH | SCENE_STATEFUL, SCENE_COST_LIGHT },
+    { "Stair Shadows", SCENE_CAT_FILM_NOIR, scene_136, SCENE_USES_DEPTH, SCENE_COST_MEDIUM, 2.0f },
+    { "Car Headlights", SCENE_CAT_FILM_NOIR, scene_137, SCENE_USES_DEPTH | SCENE_STATEFUL, SCENE_COST_MEDIUM },
+    { "Neon Rain", SCENE_CAT_FILM_NOIR, scene_138, SCENE_USES_DEPTH | SCENE_STATEFUL, SCENE_COST_LIGHT },
+    { "Film Strip", SCENE_CAT_FILM_NOIR, scene_139, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    
+    // Escher 3D Illusions (140-149)
+    { "Impossible Stairs", SCENE_CAT_ESCHER, scene_impossible_stairs, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Möbius Strip", SCENE_CAT_ESCHER, scene_mobius_strip, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Impossible Cube", SCENE_CAT_ESCHER, scene_impossible_cube, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Penrose Triangle", SCENE_CAT_ESCHER, scene_penrose_triangle, SCENE_USES_DEPTH, SCENE_COST_HEAVY },
+    { "Infinite Corridor", SCENE_CAT_ESCHER, scene_infinite_corridor, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Tessellated Reality", SCENE_CAT_ESCHER, scene_tessellated_reality, SCENE_USES_DEPTH, SCENE_COST_HEAVY },
+    { "Gravity Wells", SCENE_CAT_ESCHER, scene_gravity_wells, SCENE_USES_DEPTH, SCENE_COST_HEAVY },
+    { "Dimensional Shift", SCENE_CAT_ESCHER, scene_dimensional_shift, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Fractal Architecture", SCENE_CAT_ESCHER, scene_fractal_architecture, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Escher Waterfall", SCENE_CAT_ESCHER, scene_escher_waterfall, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    
+    // Ikeda-Inspired (150-159)
+    { "Data Matrix", SCENE_CAT_IKEDA, scene_ikeda_data_matrix, SCENE_USES_DEPTH | SCENE_STATEFUL | SCENE_PARALLEL, SCENE_COST_MEDIUM },
+    { "Test Pattern", SCENE_CAT_IKEDA, scene_ikeda_test_pattern, SCENE_USES_DEPTH, SCENE_COST_LIGHT, 0.0f, scene_ikeda_test_pattern_change_key },
+    { "Sine Wave", SCENE_CAT_IKEDA, scene_ikeda_sine_wave, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Barcode", SCENE_CAT_IKEDA, scene_ikeda_barcode, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Pulse", SCENE_CAT_IKEDA, scene_ikeda_pulse, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Glitch", SCENE_CAT_IKEDA, scene_ikeda_glitch, SCENE_USES_DEPTH, SCENE_COST_HEAVY },
+    { "Spectrum", SCENE_CAT_IKEDA, scene_ikeda_spectrum, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Phase", SCENE_CAT_IKEDA, scene_ikeda_phase, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Binary", SCENE_CAT_IKEDA, scene_ikeda_binary, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Circuit", SCENE_CAT_IKEDA, scene_ikeda_circuit, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    
+    // Giger-Inspired (160-169)
+    { "Biomech Spine", SCENE_CAT_GIGER, scene_giger_spine, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Alien Eggs", SCENE_CAT_GIGER, scene_giger_eggs, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Mech Tentacles", SCENE_CAT_GIGER, scene_giger_tentacles, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Xenomorph Hive", SCENE_CAT_GIGER, scene_giger_hive, SCENE_USES_DEPTH | SCENE_STATEFUL | SCENE_PARALLEL, SCENE_COST_HEAVY },
+    { "Biomech Skull", SCENE_CAT_GIGER, scene_giger_skull, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Face Hugger", SCENE_CAT_GIGER, scene_giger_facehugger, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Biomech Heart", SCENE_CAT_GIGER, scene_giger_heart, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Alien Architecture", SCENE_CAT_GIGER, scene_giger_architecture, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Chestburster", SCENE_CAT_GIGER, scene_giger_chestburster, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Space Jockey", SCENE_CAT_GIGER, scene_giger_space_jockey, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    
+    // Revolt (170-179)
+    { "Rising Fists", SCENE_CAT_REVOLT, scene_revolt_rising_fists, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Breaking Chains", SCENE_CAT_REVOLT, scene_revolt_breaking_chains, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Crowd March", SCENE_CAT_REVOLT, scene_revolt_crowd_march, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Barricade Building", SCENE_CAT_REVOLT, scene_revolt_barricade_building, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Molotov Cocktails", SCENE_CAT_REVOLT, scene_revolt_molotov_cocktails, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Tear Gas", SCENE_CAT_REVOLT, scene_revolt_tear_gas, SCENE_USES_DEPTH, SCENE_COST_MEDIUM },
+    { "Graffiti Wall", SCENE_CAT_REVOLT, scene_revolt_graffiti_wall, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Police Line Breaking", SCENE_CAT_REVOLT, scene_revolt_police_line_breaking, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Flag Burning", SCENE_CAT_REVOLT, scene_revolt_flag_burning, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    { "Victory Dance", SCENE_CAT_REVOLT, scene_revolt_victory_dance, SCENE_USES_DEPTH, SCENE_COST_LIGHT },
+    
+    // Audio Reactive (180-189)
+    { "Audio 3D Cubes", SCENE_CAT_AUDIO, scene_audio_reactive_cubes, SCENE_USES_DEPTH | SCENE_AUDIO_REACTIVE, SCENE_COST_LIGHT },
+    { "Audio Strobes", SCENE_CAT_AUDIO, scene_audio_flash_strobes, SCENE_USES_DEPTH | SCENE_AUDIO_REACTIVE, SCENE_COST_LIGHT },
+    { "Audio Explosions", SCENE_CAT_AUDIO, scene_audio_explosions, SCENE_USES_DEPTH | SCENE_STATEFUL | SCENE_AUDIO_REACTIVE, SCENE_COST_LIGHT },
+    { "Audio Wave Tunnel", SCENE_CAT_AUDIO, scene_audio_wave_tunnel, SCENE_USES_DEPTH | SCENE_AUDIO_REACTIVE, SCENE_COST_MEDIUM },
+    { "Audio Spectrum 3D", SCENE_CAT_AUDIO, scene_audio_spectrum_3d, SCENE_USES_DEPTH | SCENE_AUDIO_REACTIVE, SCENE_COST_LIGHT },
+    { "Audio Particles", SCENE_CAT_AUDIO, scene_audio_reactive_particles, SCENE_USES_DEPTH | SCENE_STATEFUL | SCENE_AUDIO_REACTIVE, SCENE_COST_MEDIUM },
+    { "Audio Pulse Rings", SCENE_CAT_AUDIO, scene_audio_pulse_rings, SCENE_USES_DEPTH | SCENE_AUDIO_REACTIVE, SCENE_COST_LIGHT },
+    { "Audio Waveform 3D", SCENE_CAT_AUDIO, scene_audio_waveform_3d, SCENE_USES_DEPTH | SCENE_AUDIO_REACTIVE, SCENE_COST_MEDIUM },
+    { "Audio Matrix Grid", SCENE_CAT_AUDIO, scene_audio_matrix_grid, SCENE_USES_DEPTH | SCENE_STATEFUL | SCENE_AUDIO_REACTIVE, SCENE_COST_MEDIUM },
+    { "Audio Fractals", SCENE_CAT_AUDIO, scene_audio_reactive_fractals, SCENE_USES_DEPTH | SCENE_AUDIO_REACTIVE | SCENE_PARALLEL, SCENE_COST_HEAVY },
+};
+
 // ============= ALL POST EFFECTS =============
 
 void post_effect_glow(char* buffer, int width, int height, float time) {
@@ -15372,6 +15517,27 @@ void apply_post_effect(char* buffer, PostEffect effect, int width, int height) {
     }
 }
 
+// ============= QUALITY GOVERNOR =============
+
+void quality_governor_reset(QualityGovernor* gov, int scene_id) {
+    gov->level = 1.0f;
+    gov->render_ms = 0.0f;
+    gov->scene_id = scene_id;
+}
+
+// Feed one measured render time. Drops fast when over budget, climbs back
+// slowly, and holds inside the band between so the level doesn't oscillate.
+void quality_governor_update(QualityGovernor* gov, float render_ms, float budget_ms) {
+    gov->render_ms = gov->render_ms > 0.0f ? gov->render_ms * 0.8f + render_ms * 0.2f : render_ms;
+    
+    if (gov->render_ms > budget_ms) {
+        gov->level *= 0.9f;
+    } else if (gov->render_ms < budget_ms * QUALITY_RAISE_BELOW) {
+        gov->level += 0.02f;
+    }
+    gov->level = fmaxf(RENDER_QUALITY_MIN, fminf(1.0f, gov->level));
+}
+
 void vj_init(int width, int height, bool start_hidden) {
     fprintf(stderr, "DEBUG: vj_init called with %dx%d\n", width, height);
     fflush(stderr);
@@ -15414,12 +15580,25 @@ void vj_init(int width, int height, bool start_hidden) {
         exit(1);
     }
     
-    vj.output_buffer = malloc(buffer_size);
-    if (!vj.output_buffer) {
-        fprintf(stderr, "ERROR: Failed to allocate output_buffer (%d bytes)\n", buffer_size);
+    // Internal render planes, sized for the largest render scale
+    int render_size = (int)(vj.width * RENDER_SCALE_MAX + 0.5f) * (int)(vj.height * RENDER_SCALE_MAX + 0.5f);
+    vj.deck_a.render_buffer = malloc(render_size);
+    vj.deck_a.render_zbuffer = malloc(render_size * sizeof(float));
+    vj.deck_b.render_buffer = malloc(render_size);
+    vj.deck_b.render_zbuffer = malloc(render_size * sizeof(float));
+    if (!vj.deck_a.render_buffer || !vj.deck_a.render_zbuffer || !vj.deck_b.render_buffer || !vj.deck_b.render_zbuffer) {
+        fprintf(stderr, "ERROR: Failed to allocate deck render buffers (%d cells)\n", render_size);
         exit(1);
     }
     
+    for (int d = 0; d < 2; d++) {
+        vj.memos[d].plane = malloc(buffer_size);
+        if (!vj.memos[d].plane) {
+            fprintf(stderr, "ERROR: Failed to allocate scene memo %d (%d bytes)\n", d, buffer_size);
+            exit(1);
+        }
+    }
+    
     vj.temp_buffer = malloc(buffer_size);
     if (!vj.temp_buffer) {
         fprintf(stderr, "ERROR: Failed to allocate temp_buffer (%d bytes)\n", buffer_size);
@@ -15454,6 +15633,7 @@ void vj_init(int width, int height, bool start_hidden) {
     vj.deck_a.primary_color = 1;    // Red
     vj.deck_a.secondary_color = 4;  // Yellow
     vj.deck_a.gradient_type = GRADIENT_LINEAR_H;  // Horizontal gradient
+    vj.deck_a.render_scale = RENDER_SCALE_NATIVE;
     
     vj.deck_b.active = true;
     vj.deck_b.scene_id = 53;  // Start with Wormhole
@@ -15462,6 +15642,7 @@ void vj_init(int width, int height, bool start_hidden) {
     vj.deck_b.primary_color = 3;    // Blue
     vj.deck_b.secondary_color = 6;  // Cyan
     vj.deck_b.gradient_type = GRADIENT_RADIAL;  // Radial gradient
+    vj.deck_b.render_scale = RENDER_SCALE_NATIVE;
     
     // Initialize parameters for each deck
     for (int i = 0; i < 8; i++) {
@@ -15469,6 +15650,11 @@ void vj_init(int width, int height, bool start_hidden) {
         param_init(&vj.deck_b.params[i], "Param", 1.0f, 0.0f, 3.0f);
     }
     
+    quality_governor_reset(&vj.governors[0], vj.deck_a.scene_id);
+    quality_governor_reset(&vj.governors[1], vj.deck_b.scene_id);
+    vj.quality_governor = true;
+    vj.resample_mode = RESAMPLE_COVERAGE;
+    
     vj.performance_mode = false;
     vj.selected_deck = 0;
     vj.selected_param = 0;
@@ -15510,335 +15696,247 @@ void vj_init(int width, int height, bool start_hidden) {
     vj.audio_thread_running = false;
     vj.selected_audio_source = 0;
     pthread_mutex_init(&vj.audio_mutex, NULL);
+    pthread_mutex_init(&vj.state_mutex, NULL);
     
     // Initialize audio data
-    vj.audio_data.bass = 0.0f;
-    vj.audio_data.mid = 0.0f;
-    vj.audio_data.treble = 0.0f;
-    vj.audio_data.volume = 0.0f;
-    vj.audio_data.bpm = 120.0f;
-    vj.audio_data.beat_detected = false;
-    vj.audio_data.beat_intensity = 0.0f;
-    vj.audio_data.valid = false;
-    memset(vj.audio_data.spectrum, 0, sizeof(vj.audio_data.spectrum));
+    for (int i = 0; i < AUDIO_MAX_STREAMS; i++) {
+        audio_data_reset(audio_stream_data(i));
+    }
+    vj.audio_stream_count = 1;
+    snprintf(vj.audio_stream_names[0], sizeof(vj.audio_stream_names[0]), "main");
+}
+
+// Fill beat and look-ahead fields from the feature track for the block
+// [start, start + duration). Called from the capture thread with audio_mutex held.
+static void update_feature_lookahead(AudioData* out, double start, double duration, const FeatureHop* hop) {
+    const FeatureTrack* track = &vj.features;
+    double end = start + duration;
+    
+    int beat = feature_track_beat_at(track, end);
+    int prev_beat = feature_track_beat_at(track, start);
+    bool beat_in_block = beat >= 0 && beat != prev_beat;
+    
+    out->has_features = true;
+    out->bpm = track->header->bpm > 0.0f ? track->header->bpm : out->bpm;
+    out->beat_detected = beat_in_block;
+    out->beat_intensity = beat_in_block ? 0.5f + 0.5f * hop->onset / 255.0f : 0.0f;
+    out->downbeat = beat_in_block && track->beats[beat].beat_in_bar == 0;
+    out->in_breakdown = (hop->flags & FEATURE_BREAKDOWN) != 0;
+    
+    // Position within the current beat and time to the next one
+    if (beat + 1 < (int)track->header->beat_count) {
+        float from = beat >= 0 ? track->beats[beat].time : 0.0f;
+        float to = track->beats[beat + 1].time;
+        out->next_beat_in = to - (float)end;
+        out->beat_phase = to > from ? ((float)end - from) / (to - from) : 0.0f;
+    } else {
+        out->next_beat_in = -1.0f;
+        out->beat_phase = 0.0f;
+    }
+    
+    double drop = feature_track_next_marker(track, end, FEATURE_MARKER_DROP);
+    out->next_drop_in = drop >= 0.0 ? (float)(drop - end) : -1.0f;
 }
 
-// Audio input functions
-void* audio_capture_thread(void* arg) {
-    (void)arg;
-    
-    // Initialize audio system
-    bool use_real_audio = audio_pipewire_init("CLIFT");
+// Capture and analysis loop for one stream. Every stream runs this on its
+// own thread, so analysis scales across cores; results are published into
+// the stream's AudioData under audio_mutex.
+static void audio_stream_loop(int stream, bool use_real_audio) {
+    AudioData* out = audio_stream_data(stream);
     float* audio_buffer = malloc(AUDIO_BUFFER_SIZE * AUDIO_CHANNELS * sizeof(float));
+    float smooth_spectrum[64] = {0};
+    AudioBeatDetector beat_detector;
     
     if (!audio_buffer) {
-        return NULL;
+        return;
     }
+    audio_beat_detector_reset(&beat_detector);
+    
+    pthread_mutex_lock(&vj.audio_mutex);
+    audio_history_reset(&out->history);
+    pthread_mutex_unlock(&vj.audio_mutex);
     
     while (vj.audio_thread_running) {
-        pthread_mutex_lock(&vj.audio_mutex);
-        
+        bool unpaced = false;       // Read again without waiting
         if (vj.audio_enabled) {
             if (use_real_audio) {
                 // Get audio from PipeWire
-                int frames = audio_pipewire_get_buffer(audio_buffer, AUDIO_BUFFER_SIZE);
+                int frames = audio_pipewire_get_stream_buffer(stream, audio_buffer, AUDIO_BUFFER_SIZE);
                 
                 if (frames > 0) {
-                    // Compute spectrum
-                    audio_compute_spectrum(audio_buffer, frames, vj.audio_data.spectrum, 64);
+                    unpaced = audio_file_stream_unpaced(stream);
+                    audio_history_push_waveform(&out->history, audio_buffer, frames);
+                    
+                    // Compute spectrum, or look it up when the file was pre-analysed
+                    float spectrum[64];
+                    const FeatureHop* hop = NULL;
+                    double block_start = 0.0;
+                    if (stream == 0 && vj.features_loaded) {
+                        block_start = audio_file_position() - (double)frames / AUDIO_SAMPLE_RATE;
+                        if (block_start < 0.0) block_start += audio_file_duration();  // Wrapped this block
+                        hop = feature_track_hop_at(&vj.features, block_start);
+                    }
+                    if (hop) {
+                        for (int i = 0; i < 64; i++) {
+                            spectrum[i] = hop->spectrum[i] / 255.0f;
+                        }
+                    } else {
+                        audio_compute_spectrum(audio_buffer, frames, spectrum, 64);
+                    }
                     
                     // Apply gain and smoothing
-                    static float smooth_spectrum[64] = {0};
                     for (int i = 0; i < 64; i++) {
-                        vj.audio_data.spectrum[i] *= vj.audio_gain;
+                        spectrum[i] *= vj.audio_gain;
                         smooth_spectrum[i] = smooth_spectrum[i] * vj.audio_smoothing + 
-                                           vj.audio_data.spectrum[i] * (1.0f - vj.audio_smoothing);
-                        vj.audio_data.spectrum[i] = smooth_spectrum[i];
+                                           spectrum[i] * (1.0f - vj.audio_smoothing);
+                        spectrum[i] = smooth_spectrum[i];
                     }
+                    audio_history_push_spectrum(&out->history, spectrum, 64);
                     
                     // Compute levels
-                    audio_compute_levels(vj.audio_data.spectrum, 64,
-                                       &vj.audio_data.bass, &vj.audio_data.mid,
-                                       &vj.audio_data.treble, &vj.audio_data.volume);
+                    float bass, mid, treble, volume;
+                    audio_compute_levels(spectrum, 64, &bass, &mid, &treble, &volume);
                     
                     // Beat detection
-                    vj.audio_data.beat_detected = audio_detect_beat(vj.audio_data.volume, 
-                                                                   &vj.audio_data.beat_intensity);
+                    float beat_intensity = 0.0f;
+                    bool beat = hop ? false : audio_beat_detector_process(&beat_detector, volume, &beat_intensity);
                     
-                    vj.audio_data.valid = true;
+                    pthread_mutex_lock(&vj.audio_mutex);
+                    memcpy(out->spectrum, spectrum, sizeof(out->spectrum));
+                    out->bass = bass;
+                    out->mid = mid;
+                    out->treble = treble;
+                    out->volume = volume;
+                    if (hop) {
+                        update_feature_lookahead(out, block_start, (double)frames / AUDIO_SAMPLE_RATE, hop);
+                    } else {
+                        out->beat_detected = beat;
+                        out->beat_intensity = beat_intensity;
+                        out->has_features = false;
+                    }
+                    out->valid = true;
+                    pthread_mutex_unlock(&vj.audio_mutex);
                 }
             } else {
-                // Fallback to simulation if audio init failed
-                float time = vj.time;
+                pthread_mutex_lock(&vj.audio_mutex);
+                
+                // Fallback to simulation if audio init failed; streams drift apart
+                float time = vj.time + stream * 0.37f;
                 
                 // Simulate varying audio levels
-                vj.audio_data.volume = (sinf(time * 2.0f) + 1.0f) * 0.5f * vj.audio_gain;
-                vj.audio_data.bass = (sinf(time * 1.5f) + 1.0f) * 0.5f * vj.audio_gain;
-                vj.audio_data.mid = (sinf(time * 3.0f) + 1.0f) * 0.5f * vj.audio_gain;
-                vj.audio_data.treble = (sinf(time * 5.0f) + 1.0f) * 0.5f * vj.audio_gain;
+                out->volume = (sinf(time * 2.0f) + 1.0f) * 0.5f * vj.audio_gain;
+                out->bass = (sinf(time * 1.5f) + 1.0f) * 0.5f * vj.audio_gain;
+                out->mid = (sinf(time * 3.0f) + 1.0f) * 0.5f * vj.audio_gain;
+                out->treble = (sinf(time * 5.0f) + 1.0f) * 0.5f * vj.audio_gain;
                 
                 // Simulate beat detection
-                float beat_phase = fmodf(time * (vj.audio_data.bpm / 60.0f), 1.0f);
-                vj.audio_data.beat_detected = (beat_phase < 0.1f);
-                vj.audio_data.beat_intensity = vj.audio_data.beat_detected ? 1.0f : 0.0f;
+                float beat_phase = fmodf(time * (out->bpm / 60.0f), 1.0f);
+                out->beat_detected = (beat_phase < 0.1f);
+                out->beat_intensity = out->beat_detected ? 1.0f : 0.0f;
                 
                 // Simulate spectrum
                 for (int i = 0; i < 64; i++) {
-                    vj.audio_data.spectrum[i] = sinf(time * (i + 1) * 0.5f) * 0.5f + 0.5f;
-                    vj.audio_data.spectrum[i] *= vj.audio_gain;
+                    out->spectrum[i] = sinf(time * (i + 1) * 0.5f) * 0.5f + 0.5f;
+                    out->spectrum[i] *= vj.audio_gain;
                     
                     // Apply smoothing
-                    static float smooth_spectrum[64] = {0};
                     smooth_spectrum[i] = smooth_spectrum[i] * vj.audio_smoothing + 
-                                       vj.audio_data.spectrum[i] * (1.0f - vj.audio_smoothing);
-                    vj.audio_data.spectrum[i] = smooth_spectrum[i];
+                                       out->spectrum[i] * (1.0f - vj.audio_smoothing);
+                    out->spectrum[i] = smooth_spectrum[i];
                 }
+                audio_history_push_spectrum(&out->history, out->spectrum, 64);
                 
-                vj.audio_data.valid = true;
+                // Simulate one analysis block of waveform from the fake levels
+                int sim_frames = AUDIO_SAMPLE_RATE / 60;
+                for (int i = 0; i < sim_frames; i++) {
+                    float t = time + (float)i / AUDIO_SAMPLE_RATE;
+                    float sample = out->bass * 0.3f * sinf(t * 2.0f * M_PI * 55.0f) +
+                                   out->mid * 0.2f * sinf(t * 2.0f * M_PI * 440.0f);
+                    audio_buffer[i * 2] = sample;
+                    audio_buffer[i * 2 + 1] = sample;
+                }
+                audio_history_push_waveform(&out->history, audio_buffer, sim_frames);
+                
+                out->valid = true;
+                pthread_mutex_unlock(&vj.audio_mutex);
             }
         } else {
-            vj.audio_data.valid = false;
+            pthread_mutex_lock(&vj.audio_mutex);
+            out->valid = false;
+            pthread_mutex_unlock(&vj.audio_mutex);
         }
         
-        pthread_mutex_unlock(&vj.audio_mutex);
-        
-        // Sleep for ~60fps update rate
-        usleep(16667);
+        // Sleep for ~60fps update rate, unless a file is being streamed as
+        // fast as possible and still has audio to give
+        if (!unpaced) {
+            usleep(16667);
+        }
     }
     
-    // Cleanup
-    if (use_real_audio) {
-        audio_pipewire_cleanup();
-    }
     free(audio_buffer);
-    
-    return NULL;
 }
 
-void start_audio_capture() {
-    if (!vj.audio_thread_running) {
-        vj.audio_thread_running = true;
-        pthread_create(&vj.audio_thread, NULL, audio_capture_thread, NULL);
-    }
-}
-
-void stop_audio_capture() {
-    if (vj.audio_thread_running) {
-        vj.audio_thread_running = false;
-        pthread_join(vj.audio_thread, NULL);
-    }
-}
-
-// Audio connection management functions
 typedef struct {
-    char name[256];
-    char port_fl[256];
-    char port_fr[256];
-    bool is_monitor;
-} AudioSource;
-
-// Execute a command and return the output
-bool exec_command(const char* cmd, char* output, size_t output_size) {
-    // Create a modified command that redirects stderr to /dev/null
-    char safe_cmd[1024];
-    snprintf(safe_cmd, sizeof(safe_cmd), "%s 2>/dev/null", cmd);
-    
-    // Save current stdout and stderr
-    fflush(stdout);
-    fflush(stderr);
-    int saved_stdout = dup(STDOUT_FILENO);
-    int saved_stderr = dup(STDERR_FILENO);
-    
-    // Redirect stdout and stderr to /dev/null during command execution
-    int null_fd = open("/dev/null", O_WRONLY);
-    if (null_fd >= 0) {
-        dup2(null_fd, STDOUT_FILENO);
-        dup2(null_fd, STDERR_FILENO);
-    }
-    
-    FILE *fp = popen(safe_cmd, "r");
-    
-    // Restore stdout and stderr immediately after popen
-    if (saved_stdout >= 0) {
-        dup2(saved_stdout, STDOUT_FILENO);
-        close(saved_stdout);
-    }
-    if (saved_stderr >= 0) {
-        dup2(saved_stderr, STDERR_FILENO);
-        close(saved_stderr);
-    }
-    if (null_fd >= 0) {
-        close(null_fd);
-    }
-    
-    if (!fp) return false;
-    
-    if (output && output_size > 0) {
-        output[0] = '\0';
-        char line[256];
-        while (fgets(line, sizeof(line), fp) != NULL) {
-            size_t len = strlen(output);
-            if (len + strlen(line) < output_size - 1) {
-                strcat(output, line);
-            }
-        }
-    }
-    
-    int status = pclose(fp);
-    return (status == 0 || status == 256); // 256 = exit code 1 (no matches found)
-}
+    int stream;
+    bool use_real_audio;
+} AudioStreamWorker;
 
-// Get available audio sources
-int get_audio_sources(AudioSource* sources, int max_sources) {
-    char output[8192];
-    if (!exec_command("pw-link -o | grep -E '_FL$|:output_FL$' | sort", output, sizeof(output))) {
-        return 0;
-    }
-    
-    int count = 0;
-    char* line = strtok(output, "\n");
-    
-    while (line != NULL && count < max_sources) {
-        // Extract the base name without _FL suffix
-        char base_name[256];
-        strncpy(base_name, line, sizeof(base_name) - 1);
-        base_name[sizeof(base_name) - 1] = '\0';
-        
-        // Remove _FL suffix
-        char* fl_suffix = strstr(base_name, "_FL");
-        if (fl_suffix) {
-            *fl_suffix = '\0';
-            
-            // Create source entry
-            strncpy(sources[count].name, base_name, sizeof(sources[count].name) - 1);
-            snprintf(sources[count].port_fl, sizeof(sources[count].port_fl), "%s_FL", base_name);
-            snprintf(sources[count].port_fr, sizeof(sources[count].port_fr), "%s_FR", base_name);
-            sources[count].is_monitor = (strstr(base_name, "Monitor") != NULL || strstr(base_name, "monitor") != NULL);
-            count++;
-        }
-        
-        line = strtok(NULL, "\n");
-    }
-    
-    return count;
+static void* audio_stream_thread(void* arg) {
+    AudioStreamWorker* worker = arg;
+    audio_stream_loop(worker->stream, worker->use_real_audio);
+    return NULL;
 }
 
-// Connect to a specific audio source
-bool audio_connect_to_source(const AudioSource* source) {
-    if (!source) return false;
-    
-    char cmd[512];
-    bool success = true;
-    
-    // Connect left channel
-    snprintf(cmd, sizeof(cmd), "pw-link \"%s\" \"CLIFT:input_FL\" 2>/dev/null", source->port_fl);
-    success &= exec_command(cmd, NULL, 0);
+// Audio input functions
+void* audio_capture_thread(void* arg) {
+    (void)arg;
     
-    // Connect right channel
-    snprintf(cmd, sizeof(cmd), "pw-link \"%s\" \"CLIFT:input_FR\" 2>/dev/null", source->port_fr);
-    success &= exec_command(cmd, NULL, 0);
+    // Initialize audio system
+    bool use_real_audio = audio_pipewire_init("CLIFT");
     
-    return success;
-}
-
-// Connect to system monitor (first available)
-bool audio_connect_to_monitor() {
-    AudioSource sources[50];
-    int count = get_audio_sources(sources, 50);
+    // Extra streams each get a worker; this thread analyses stream 0
+    pthread_t workers[AUDIO_MAX_STREAMS];
+    AudioStreamWorker worker_args[AUDIO_MAX_STREAMS];
+    int worker_count = 0;
     
-    // Find first monitor
-    for (int i = 0; i < count; i++) {
-        if (sources[i].is_monitor) {
-            return audio_connect_to_source(&sources[i]);
+    for (int i = 1; i < vj.audio_stream_count; i++) {
+        if (audio_pipewire_open_stream(vj.audio_stream_names[i]) != i) {
+            fprintf(stderr, "CLIFT: Could not open audio stream '%s'\n", vj.audio_stream_names[i]);
+            break;
         }
-    }
-    
-    // If no monitor found, try alternative approach
-    char output[1024];
-    if (exec_command("pw-link -o | grep -iE 'monitor.*FL' | head -1", output, sizeof(output))) {
-        char* newline = strchr(output, '\n');
-        if (newline) *newline = '\0';
-        
-        if (strlen(output) > 0) {
-            char base_name[256];
-            strncpy(base_name, output, sizeof(base_name) - 1);
-            char* fl_suffix = strstr(base_name, "_FL");
-            if (fl_suffix) {
-                *fl_suffix = '\0';
-                
-                AudioSource monitor;
-                strncpy(monitor.name, base_name, sizeof(monitor.name) - 1);
-                snprintf(monitor.port_fl, sizeof(monitor.port_fl), "%s_FL", base_name);
-                snprintf(monitor.port_fr, sizeof(monitor.port_fr), "%s_FR", base_name);
-                monitor.is_monitor = true;
-                
-                return audio_connect_to_source(&monitor);
-            }
+        worker_args[worker_count].stream = i;
+        worker_args[worker_count].use_real_audio = use_real_audio;
+        if (pthread_create(&workers[worker_count], NULL, audio_stream_thread, &worker_args[worker_count]) == 0) {
+            worker_count++;
         }
     }
     
-    return false;
-}
-
-// Disconnect all audio connections
-bool audio_disconnect_all() {
-    // Get current connections
-    char output[4096];
-    if (!exec_command("pw-link | grep 'CLIFT:input'", output, sizeof(output))) {
-        return true; // No connections to disconnect
+    audio_stream_loop(0, use_real_audio);
+    
+    for (int i = 0; i < worker_count; i++) {
+        pthread_join(workers[i], NULL);
     }
     
-    // Parse and disconnect each connection
-    char* line = strtok(output, "\n");
-    while (line != NULL) {
-        // Format: "source -> destination"
-        char src[256], dst[256];
-        if (sscanf(line, "%s -> %s", src, dst) == 2) {
-            char cmd[512];
-            snprintf(cmd, sizeof(cmd), "pw-link -d \"%s\" \"%s\" 2>/dev/null", src, dst);
-            exec_command(cmd, NULL, 0);
-        }
-        line = strtok(NULL, "\n");
+    // Cleanup
+    if (use_real_audio) {
+        audio_pipewire_cleanup();
     }
     
-    return true;
+    return NULL;
 }
 
-// Count current audio connections
-int audio_count_connections() {
-    char output[32];
-    if (!exec_command("pw-link | grep -c 'CLIFT:input' || echo 0", output, sizeof(output))) {
-        return 0;
+void start_audio_capture() {
+    if (!vj.audio_thread_running) {
+        vj.audio_thread_running = true;
+        pthread_create(&vj.audio_thread, NULL, audio_capture_thread, NULL);
     }
-    
-    return atoi(output);
 }
 
-// Get current connection info
-bool audio_get_connection_info(char* info, size_t info_size) {
-    if (!info || info_size == 0) return false;
-    
-    info[0] = '\0';
-    char output[2048];
-    
-    if (exec_command("pw-link | grep 'CLIFT:input' | head -2", output, sizeof(output))) {
-        // Extract source names
-        char* line = strtok(output, "\n");
-        if (line) {
-            char src[256];
-            if (sscanf(line, "%s ->", src) == 1) {
-                // Remove port suffix to get base name
-                char* colon = strrchr(src, ':');
-                if (colon) *colon = '\0';
-                
-                snprintf(info, info_size, "Connected to: %s", src);
-                return true;
-            }
-        }
+void stop_audio_capture() {
+    if (vj.audio_thread_running) {
+        vj.audio_thread_running = false;
+        pthread_join(vj.audio_thread, NULL);
     }
-    
-    snprintf(info, info_size, "No audio connections");
-    return false;
 }
 
 // BPM functions
@@ -15882,27 +15980,379 @@ void tap_bpm(float current_time) {
             }
         }
     }
-    
-    vj.bpm_system.last_tap_time = current_time;
+    
+    vj.bpm_system.last_tap_time = current_time;
+}
+
+void update_auto_crossfade(float current_time) {
+    if (!vj.bpm_system.auto_crossfade_enabled) return;
+    
+    float beat_duration = 60.0f / vj.bpm_system.bpm;
+    float crossfade_interval = beat_duration * vj.bpm_system.crossfade_beat_interval;
+    
+    if (current_time - vj.bpm_system.last_crossfade_time >= crossfade_interval) {
+        // Cycle through crossfade states
+        vj.crossfade_state = (vj.crossfade_state + 1) % 3;
+        vj.bpm_system.last_crossfade_time = current_time;
+    }
+}
+
+// ============= COST TABLE =============
+
+// Size of the plane a deck's scene draws into at its render scale
+static void deck_render_size(const CLIFTDeck* deck, int* width, int* height) {
+    float scale = render_scales[deck->render_scale];
+    *width = (int)(vj.width * scale + 0.5f);
+    *height = (int)(vj.height * scale + 0.5f);
+    if (*width < 1) *width = 1;
+    if (*height < 1) *height = 1;
+}
+
+// Per-cell cost of each SceneCost class, from the timings the classes
+// were drawn up with
+static const float scene_cost_class_ns[] = { 0.7f, 4.0f, 40.0f };
+
+void cost_table_init(CostTable* costs) {
+    memset(costs, 0, sizeof(*costs));
+    for (int i = 0; i < SCENE_COUNT; i++) {
+        costs->scene_ns[i] = scene_cost_class_ns[scene_registry[i].cost];
+    }
+    for (int i = 0; i < POST_COUNT; i++) {
+        costs->effect_ns[i] = 1.0f;
+    }
+    pthread_mutex_init(&costs->mutex, NULL);
+}
+
+void cost_table_destroy(CostTable* costs) {
+    pthread_mutex_destroy(&costs->mutex);
+}
+
+void cost_table_record_scene(CostTable* costs, int scene_id, int64_t ns, int cells) {
+    float per_cell = (float)ns / cells;
+    pthread_mutex_lock(&costs->mutex);
+    if (costs->measured[scene_id]) {
+        costs->scene_ns[scene_id] = costs->scene_ns[scene_id] * 0.9f + per_cell * 0.1f;
+    } else {
+        costs->scene_ns[scene_id] = per_cell;
+        costs->measured[scene_id] = true;
+    }
+    pthread_mutex_unlock(&costs->mutex);
+}
+
+void cost_table_record_effect(CostTable* costs, PostEffect effect, int64_t ns, int cells) {
+    pthread_mutex_lock(&costs->mutex);
+    costs->effect_ns[effect] = costs->effect_ns[effect] * 0.9f + (float)ns / cells * 0.1f;
+    pthread_mutex_unlock(&costs->mutex);
+}
+
+// Next scene still running on its cost class estimate, or -1 once every
+// scene has been timed
+int cost_table_next_unmeasured(CostTable* costs) {
+    int scene_id = -1;
+    pthread_mutex_lock(&costs->mutex);
+    for (int i = 0; i < SCENE_COUNT && scene_id < 0; i++) {
+        int candidate = (costs->cursor + i) % SCENE_COUNT;
+        if (!costs->measured[candidate]) {
+            scene_id = candidate;
+            costs->cursor = (candidate + 1) % SCENE_COUNT;
+        }
+    }
+    pthread_mutex_unlock(&costs->mutex);
+    return scene_id;
+}
+
+// Time every post effect on a busy test plane. Runs before the render
+// stage starts, so the effects' own state isn't shared yet.
+void cost_table_benchmark_effects(CostTable* costs) {
+    int cells = vj.width * vj.height;
+    char* plane = malloc(cells);
+    if (!plane) return;
+    
+    for (int e = POST_NONE + 1; e < POST_COUNT; e++) {
+        int64_t best = INT64_MAX;
+        for (int run = 0; run < 3; run++) {
+            for (int i = 0; i < cells; i++) {
+                plane[i] = (i * 7 + i / vj.width) % 5 ? ' ' : "#*+=-:."[i % 7];
+            }
+            int64_t start = monotonic_ns();
+            apply_post_effect(plane, e, vj.width, vj.height);
+            int64_t ns = monotonic_ns() - start;
+            if (ns < best) best = ns;
+        }
+        costs->effect_ns[e] = (float)best / cells;
+    }
+    costs->effect_ns[POST_NONE] = 0.0f;
+    
+    // Echo keeps a history of the frames it saw; flush the test plane out
+    memset(plane, ' ', cells);
+    for (int i = 0; i < 3; i++) {
+        apply_post_effect(plane, POST_ECHO, vj.width, vj.height);
+    }
+    free(plane);
+}
+
+// Predicted render time of a deck showing 'scene_id' through 'effect'
+float deck_predicted_ms(const CLIFTDeck* deck, int scene_id, PostEffect effect) {
+    int w, h;
+    deck_render_size(deck, &w, &h);
+    pthread_mutex_lock(&vj.costs.mutex);
+    float ns = vj.costs.scene_ns[scene_id] * w * h + vj.costs.effect_ns[effect] * vj.width * vj.height;
+    pthread_mutex_unlock(&vj.costs.mutex);
+    return ns / 1e6f;
+}
+
+// Frame budget left for deck d once the other deck is paid for
+static float auto_budget_ms(int d) {
+    const CLIFTDeck* other = d == 0 ? &vj.deck_b : &vj.deck_a;
+    float budget = vj.pacer.period_ns / 1e6f * QUALITY_BUDGET_SHARE;
+    return budget - deck_predicted_ms(other, other->scene_id, other->post_effect);
+}
+
+// Random scene for deck d that fits the budget with its current effect,
+// or the cheapest of the candidates if none does
+static int auto_pick_scene(int d) {
+    const CLIFTDeck* deck = d == 0 ? &vj.deck_a : &vj.deck_b;
+    float budget = auto_budget_ms(d);
+    int best = -1;
+    float best_ms = 0.0f;
+    
+    for (int i = 0; i < AUTO_PICK_TRIES; i++) {
+        int candidate = rand() % SCENE_COUNT;
+        float ms = deck_predicted_ms(deck, candidate, deck->post_effect);
+        if (ms <= budget) return candidate;
+        if (best < 0 || ms < best_ms) {
+            best = candidate;
+            best_ms = ms;
+        }
+    }
+    return best;
+}
+
+// Same for deck d's post effect with its current scene
+static PostEffect auto_pick_effect(int d) {
+    const CLIFTDeck* deck = d == 0 ? &vj.deck_a : &vj.deck_b;
+    float budget = auto_budget_ms(d);
+    PostEffect best = POST_NONE;
+    float best_ms = deck_predicted_ms(deck, deck->scene_id, POST_NONE);
+    
+    for (int i = 0; i < AUTO_PICK_TRIES; i++) {
+        PostEffect candidate = rand() % POST_COUNT;
+        float ms = deck_predicted_ms(deck, deck->scene_id, candidate);
+        if (ms <= budget) return candidate;
+        if (ms < best_ms) {
+            best = candidate;
+            best_ms = ms;
+        }
+    }
+    return best;
+}
+
+// ============= SCENE PREWARM =============
+
+bool scene_prewarm_init(ScenePrewarm* warm, int cells) {
+    memset(warm, 0, sizeof(*warm));
+    warm->next_scene[0] = warm->next_scene[1] = -1;
+    warm->request[0] = warm->request[1] = -1;
+    warm->rendering[0] = warm->rendering[1] = -1;
+    warm->busy = -1;
+    
+    warm->buffer = malloc(cells);
+    warm->zbuffer = malloc(cells * sizeof(float));
+    if (!warm->buffer || !warm->zbuffer) {
+        fprintf(stderr, "CLIFT: Cannot allocate scene prewarm buffers (%d cells)\n", cells);
+        free(warm->buffer);
+        free(warm->zbuffer);
+        warm->buffer = NULL;
+        warm->zbuffer = NULL;
+        return false;
+    }
+    
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&warm->wake, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&warm->mutex, NULL);
+    return true;
+}
+
+// Queue deck d's next auto scene for warming. Stateless scenes have no
+// setup to do. Called with vj.state_mutex held.
+static void scene_prewarm_request(ScenePrewarm* warm, int d, const CLIFTDeck* deck) {
+    int scene_id = warm->next_scene[d];
+    if (!warm->started || scene_id < 0 || warm->warmed[scene_id] ||
+        !(scene_registry[scene_id].flags & SCENE_STATEFUL)) {
+        return;
+    }
+    warm->request[d] = scene_id;
+    warm->request_deck[d] = *deck;
+    pthread_cond_signal(&warm->wake);
+}
+
+// Whether two scene ids run the same render function, and so share its
+// statics: some registry entries are the same scene under two names
+static bool scene_same_render(int a, int b) {
+    if (a < 0 || b < 0 || a >= SCENE_COUNT || b >= SCENE_COUNT) return false;
+    return scene_registry[a].render == scene_registry[b].render;
+}
+
+// Record the scenes of the frame entering the render stage, called with
+// vj.state_mutex held. Returns true if one of them is being warmed right
+// now; the caller must then wait for it before rendering, since scenes keep
+// their state in statics and cannot run on two threads at once.
+static bool scene_prewarm_note_frame(ScenePrewarm* warm, const FrameSlot* frame) {
+    bool wait = false;
+    for (int d = 0; d < 2; d++) {
+        int scene_id = frame->decks[d].scene_id;
+        warm->rendering[d] = scene_id;
+        if (scene_id < 0 || scene_id >= SCENE_COUNT) continue;
+        if (frame->render_deck[d]) {
+            warm->warmed[scene_id] = true;
+        }
+        if (scene_same_render(scene_id, warm->busy)) {
+            wait = true;
+        }
+    }
+    return wait;
+}
+
+static void scene_prewarm_wait(ScenePrewarm* warm) {
+    pthread_mutex_lock(&warm->mutex);
+    pthread_mutex_unlock(&warm->mutex);
+}
+
+// Whether the prewarm thread may run a scene: one whose render function is
+// on a deck is set up by the render stage itself and must not run twice at
+// once
+static bool scene_prewarm_free(const ScenePrewarm* warm, int scene_id) {
+    return !scene_same_render(scene_id, vj.deck_a.scene_id) && !scene_same_render(scene_id, vj.deck_b.scene_id) &&
+           !scene_same_render(scene_id, warm->rendering[0]) && !scene_same_render(scene_id, warm->rendering[1]);
+}
+
+// Render a scene on the prewarm thread, first running its setup if that
+// hasn't happened yet. Called with vj.state_mutex held, which is dropped
+// while the scene renders. Returns the time of the last render.
+static int64_t scene_prewarm_run(ScenePrewarm* warm, int scene_id, CLIFTDeck* deck) {
+    float time = vj.time;
+    int renders = warm->warmed[scene_id] ? 1 : 2;
+    warm->busy = scene_id;
+    pthread_mutex_lock(&warm->mutex);
+    pthread_mutex_unlock(&vj.state_mutex);
+    
+    int w, h;
+    deck_render_size(deck, &w, &h);
+    int64_t ns = 0;
+    for (int i = 0; i < renders; i++) {
+        memset(warm->buffer, ' ', w * h);
+        for (int j = 0; j < w * h; j++) {
+            warm->zbuffer[j] = 1000.0f;
+        }
+        int64_t start = monotonic_ns();
+        scene_registry[scene_id].render(warm->buffer, warm->zbuffer, w, h, deck->params, time,
+                                        scene_audio(&scene_registry[scene_id], deck));
+        ns = monotonic_ns() - start;
+    }
+    
+    pthread_mutex_unlock(&warm->mutex);
+    pthread_mutex_lock(&vj.state_mutex);
+    warm->busy = -1;
+    warm->warmed[scene_id] = true;
+    return ns;
+}
+
+static void* scene_prewarm_thread(void* arg) {
+    ScenePrewarm* warm = arg;
+    
+    pthread_mutex_lock(&vj.state_mutex);
+    while (running) {
+        int d = warm->request[0] >= 0 ? 0 : warm->request[1] >= 0 ? 1 : -1;
+        if (d >= 0) {
+            int scene_id = warm->request[d];
+            CLIFTDeck deck = warm->request_deck[d];
+            warm->request[d] = -1;
+            if (!warm->warmed[scene_id] && scene_prewarm_free(warm, scene_id)) {
+                scene_prewarm_run(warm, scene_id, &deck);
+                warm->warmups++;
+            }
+            continue;
+        }
+        
+        // Nothing to warm: profile a scene the cost table only has an
+        // estimate for, as long as the render stage has time to spare
+        struct timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_nsec += COST_PROFILE_IDLE_MS * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        if (pthread_cond_timedwait(&warm->wake, &vj.state_mutex, &deadline) != ETIMEDOUT ||
+            vj.pacer.load >= COST_PROFILE_IDLE_LOAD) {
+            continue;
+        }
+        int scene_id = cost_table_next_unmeasured(&vj.costs);
+        if (scene_id >= 0 && scene_prewarm_free(warm, scene_id)) {
+            CLIFTDeck deck = vj.deck_a;
+            deck.render_scale = RENDER_SCALE_NATIVE;
+            int64_t ns = scene_prewarm_run(warm, scene_id, &deck);
+            // This thread renders without the render stage's workers, so a
+            // scene that splits its work over them is credited with an even
+            // share; the render stage's own timings refine it from there
+            if (scene_registry[scene_id].flags & SCENE_PARALLEL) {
+                ns /= thread_pool_size(vj.pipeline.scene_pool);
+            }
+            cost_table_record_scene(&vj.costs, scene_id, ns, vj.width * vj.height);
+            vj.costs.profiled++;
+        }
+    }
+    pthread_mutex_unlock(&vj.state_mutex);
+    return NULL;
 }
 
-void update_auto_crossfade(float current_time) {
-    if (!vj.bpm_system.auto_crossfade_enabled) return;
-    
-    float beat_duration = 60.0f / vj.bpm_system.bpm;
-    float crossfade_interval = beat_duration * vj.bpm_system.crossfade_beat_interval;
+bool scene_prewarm_start(ScenePrewarm* warm) {
+    if (pthread_create(&warm->thread, NULL, scene_prewarm_thread, warm) != 0) {
+        fprintf(stderr, "CLIFT: Cannot start scene prewarm thread, auto scene changes are not warmed\n");
+        return false;
+    }
+    warm->started = true;
+    return true;
+}
+
+void scene_prewarm_stop(ScenePrewarm* warm) {
+    if (warm->started) {
+        pthread_mutex_lock(&vj.state_mutex);
+        pthread_cond_broadcast(&warm->wake);
+        pthread_mutex_unlock(&vj.state_mutex);
+        
+        pthread_join(warm->thread, NULL);
+        warm->started = false;
+    }
     
-    if (current_time - vj.bpm_system.last_crossfade_time >= crossfade_interval) {
-        // Cycle through crossfade states
-        vj.crossfade_state = (vj.crossfade_state + 1) % 3;
-        vj.bpm_system.last_crossfade_time = current_time;
+    if (warm->buffer) {
+        free(warm->buffer);
+        free(warm->zbuffer);
+        warm->buffer = NULL;
+        warm->zbuffer = NULL;
+        pthread_cond_destroy(&warm->wake);
+        pthread_mutex_destroy(&warm->mutex);
     }
 }
 
 // Full Auto Mode Functions
 void randomize_deck_scene(CLIFTDeck* deck) {
-    // Choose random scene (0-189)
-    deck->scene_id = rand() % 190;
+    int d = deck == &vj.deck_b ? 1 : 0;
+    ScenePrewarm* warm = &vj.prewarm;
+    
+    // Take the scene picked (and warmed) at the last change, then pick the
+    // next one so it has a whole change interval to warm up. Picks are
+    // limited to scenes the cost table says fit next to the other deck.
+    int next = warm->next_scene[d];
+    if (next < 0 || deck_predicted_ms(deck, next, deck->post_effect) > auto_budget_ms(d)) {
+        next = auto_pick_scene(d);  // The other deck changed since and it no longer fits
+    }
+    deck->scene_id = next;
+    warm->next_scene[d] = auto_pick_scene(d);
+    scene_prewarm_request(warm, d, deck);
 }
 
 void randomize_deck_colors(CLIFTDeck* deck) {
@@ -15923,8 +16373,8 @@ void randomize_deck_parameters(CLIFTDeck* deck) {
 }
 
 void randomize_deck_post_effect(CLIFTDeck* deck) {
-    // Random post effect (0-15 to include new effects)
-    deck->post_effect = rand() % POST_COUNT;
+    // Random post effect that fits the frame budget
+    deck->post_effect = auto_pick_effect(deck == &vj.deck_b ? 1 : 0);
 }
 
 // Update Ableton Link state using real Link API
@@ -15953,8 +16403,33 @@ void update_link_state(float current_time) {
 void update_full_auto_mode(float current_time) {
     if (!vj.full_auto_mode) return;
     
+    // A pre-analysed track says when the next drop lands: hold scene changes
+    // through the bar before it, then change both decks right on it
+    bool hold_for_drop = false;
+    if (vj.audio_data.has_features) {
+        static bool drop_armed = false;
+        float bar_duration = 4.0f * 60.0f / vj.bpm_system.bpm;
+        float drop_in = vj.audio_data.next_drop_in;
+        
+        if (drop_armed && (drop_in < 1.0f / 60.0f || drop_in >= bar_duration)) {
+            // Within a frame of the drop, or the marker just moved past it
+            randomize_deck_scene(&vj.deck_a);
+            randomize_deck_colors(&vj.deck_a);
+            randomize_deck_parameters(&vj.deck_a);
+            randomize_deck_scene(&vj.deck_b);
+            randomize_deck_colors(&vj.deck_b);
+            randomize_deck_parameters(&vj.deck_b);
+            vj.crossfade_state = XFADE_MIX;
+            vj.last_auto_change = current_time;
+            drop_armed = false;
+        } else if (drop_in >= 0.0f && drop_in < bar_duration) {
+            drop_armed = true;
+            hold_for_drop = true;
+        }
+    }
+    
     // Check if it's time for a change
-    if (current_time - vj.last_auto_change >= vj.auto_change_interval) {
+    if (!hold_for_drop && current_time - vj.last_auto_change >= vj.auto_change_interval) {
         // Always change scenes AND colors together for maximum impact
         int change_mode = rand() % 3;
         
@@ -16005,7 +16480,31 @@ void update_full_auto_mode(float current_time) {
         vj.last_effect_change = current_time;
         float beat_duration = 60.0f / vj.bpm_system.bpm;
         vj.effect_change_interval = beat_duration; // Every beat
+        if (vj.audio_data.has_features && vj.audio_data.in_breakdown) {
+            vj.effect_change_interval = beat_duration * 2.0f; // Calmer through breakdowns
+        }
+    }
+}
+
+// Time (in vj.time seconds) until the automation may next change the
+// crossfade, or a negative value when nothing is scheduled
+float next_auto_crossfade_in(void) {
+    float next = -1.0f;
+    
+    if (vj.bpm_system.auto_crossfade_enabled && vj.bpm_system.bpm > 0.0f) {
+        float interval = 60.0f / vj.bpm_system.bpm * vj.bpm_system.crossfade_beat_interval;
+        next = fmaxf(0.0f, interval - (vj.time - vj.bpm_system.last_crossfade_time));
+    }
+    
+    if (vj.full_auto_mode) {
+        float change = fmaxf(0.0f, vj.auto_change_interval - (vj.time - vj.last_auto_change));
+        if (vj.audio_data.has_features && vj.audio_data.next_drop_in >= 0.0f) {
+            change = fminf(change, vj.audio_data.next_drop_in);
+        }
+        next = next < 0.0f ? change : fminf(next, change);
     }
+    
+    return next;
 }
 
 void vj_update(float dt) {
@@ -16015,6 +16514,11 @@ void vj_update(float dt) {
     param_update(&vj.master_volume, dt);
     param_update(&vj.master_speed, dt);
     
+    // A pre-analysed track knows its tempo; Link still wins below
+    if (vj.audio_enabled && vj.audio_data.has_features && vj.audio_data.bpm > 0.0f) {
+        vj.bpm_system.bpm = vj.audio_data.bpm;
+    }
+    
     // Update automatic crossfade based on BPM
     update_auto_crossfade(vj.time);
     
@@ -16033,294 +16537,139 @@ void vj_update(float dt) {
     }
 }
 
-void vj_render() {
-    CLIFTDeck* decks[] = {&vj.deck_a, &vj.deck_b};
+// Everything a scene's output depends on. Time only counts at the scene's
+// declared granularity, so a scene without one never matches a later frame.
+static void scene_key_make(const SceneDesc* scene, CLIFTDeck* deck, int w, int h, float time, SceneKey* key) {
+    memset(key, 0, sizeof(*key));   // Compared with memcmp, so padding must be zero too
+    key->scene_id = deck->scene_id;
+    key->width = w;
+    key->height = h;
+    key->resample_mode = vj.resample_mode;
+    for (int i = 0; i < 8; i++) {
+        key->params[i] = deck->params[i].value;
+    }
+    key->quality = render_ctx.quality;
+    
+    // Audio moves every frame, whatever the scene declares
+    bool audio = scene->flags & SCENE_AUDIO_REACTIVE;
+    key->audio = scene_audio(scene, deck);
+    if (scene->change_key && !audio) {
+        key->time_key = scene->change_key(w, h, deck->params, time);
+    } else if (scene->update_hz > 0.0f && !audio) {
+        key->time_key = (uint64_t)(int64_t)floorf(time * scene->update_hz);
+    } else {
+        uint32_t bits;
+        memcpy(&bits, &time, sizeof(bits));
+        key->time_key = bits;
+    }
+}
+
+// Render stage: run both decks' scenes and post effects with the deck
+// settings snapshotted into the frame, then keep a copy of their output
+void vj_render(FrameSlot* frame) {
+    int active_decks = (frame->render_deck[0] ? 1 : 0) + (frame->render_deck[1] ? 1 : 0);
+    float budget_ms = vj.pacer.period_ns / 1e6f * QUALITY_BUDGET_SHARE / (active_decks > 0 ? active_decks : 1);
     
     for (int d = 0; d < 2; d++) {
-        CLIFTDeck* deck = decks[d];
-        if (!deck->active) continue;
+        CLIFTDeck* deck = &frame->decks[d];
+        if (!frame->render_deck[d]) continue;
         
-        // Debug: Check for valid deck and buffers
-        if (!deck) {
-            fprintf(stderr, "ERROR: NULL deck in vj_render\n");
-            continue;
-        }
+        // Nothing to draw into. No message: stderr belongs to ncurses here.
         if (!deck->buffer || !deck->zbuffer) {
-            fprintf(stderr, "ERROR: NULL buffer in deck %d (scene %d)\n", d, deck->scene_id);
             continue;
         }
         
-        if (deck->scene_id < 0 || deck->scene_id > 189) {
+        if (deck->scene_id < 0 || deck->scene_id >= SCENE_COUNT) {
             deck->scene_id = 0;  // Reset to safe scene
         }
         
-        // Render scene
-        switch (deck->scene_id) {
-            // Basic scenes (0-9)
-            case 0: scene_audio_bars(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, vj.audio_enabled ? &vj.audio_data : NULL); break;
-            case 1: scene_cube(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 2: scene_dna_helix(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 3: scene_particle_field(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 4: scene_torus(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 5: scene_fractal_tree(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 6: scene_wave_mesh(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 7: scene_sphere(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 8: scene_spirograph(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 9: scene_matrix_rain(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            
-            // Geometric scenes (10-19)
-            case 10: scene_tunnels(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 11: scene_kaleidoscope(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 12: scene_mandala(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 13: scene_sierpinski(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 14: scene_hexagon_grid(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 15: scene_tessellations(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 16: scene_voronoi_cells(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 17: scene_sacred_geometry(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 18: scene_polyhedra(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 19: scene_maze_generator(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            
-            // Organic scenes (20-29)
-            case 20: scene_fire_simulation(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 21: scene_water_waves(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 22: scene_lightning(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 23: scene_plasma_clouds(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 24: scene_galaxy_spiral(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 25: scene_tree_of_life(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 26: scene_cellular_automata(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 27: scene_flocking_birds(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 28: scene_wind_patterns(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 29: scene_neural_networks(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            
-            // Text/Code scenes (30-39)
-            case 30: scene_matrix_rain(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 31: scene_ascii_art_generator(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 32: scene_code_rain(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 33: scene_binary_stream(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 34: scene_terminal_glitch(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 35: scene_syntax_highlighting(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 36: scene_data_visualization(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 37: scene_network_nodes(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 38: scene_system_monitor(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 39: scene_command_line(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            
-            // Abstract scenes (40-49)
-            case 40: scene_noise_field(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 41: scene_swarm_intelligence(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 42: scene_fractal_zoom(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 43: scene_morphing_shapes(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 44: scene_glitch_corruption(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 45: scene_energy_waves(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 46: scene_digital_rain(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 47: scene_psychedelic_patterns(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 48: scene_quantum_field(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 49: scene_abstract_flow(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            
-            // Infinite Tunnel scenes (50-59)
-            case 50: scene_spiral_tunnel(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 51: scene_hex_tunnel(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 52: scene_star_tunnel(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 53: scene_wormhole(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 54: scene_cyber_tunnel(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 55: scene_ring_tunnel(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 56: scene_matrix_tunnel(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 57: scene_speed_tunnel(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 58: scene_pulse_tunnel(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 59: scene_vortex_tunnel(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            
-            // Nature scenes (60-69)
-            case 60: scene_ocean_waves(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 61: scene_rain_storm(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 62: scene_infinite_forest(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 63: scene_growing_trees(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 64: scene_mountain_range(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 65: scene_aurora_borealis(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 66: scene_flowing_river(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 67: scene_desert_dunes(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 68: scene_coral_reef(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 69: scene_butterfly_garden(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            
-            // Explosion scenes (70-79)
-            case 70: scene_nuclear_blast(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 71: scene_building_collapse(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 72: scene_meteor_impact(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 73: scene_chain_explosions(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 74: scene_volcanic_eruption(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 75: scene_shockwave_blast(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 76: scene_glass_shatter(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 77: scene_demolition_blast(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 78: scene_supernova_burst(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 79: scene_plasma_discharge(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            
-            // City scenes (80-89)
-            case 80: scene_cyberpunk_city(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 81: scene_city_lights(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 82: scene_skyscraper_forest(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 83: scene_urban_decay(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 84: scene_future_metropolis(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 85: scene_city_grid(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 86: scene_digital_city(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 87: scene_city_flythrough(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 88: scene_neon_districts(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 89: scene_urban_canyon(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            
-            // Freestyle scenes (90-99)
-            case 90: scene_black_hole(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 91: scene_quantum_field(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 92: scene_dimensional_rift(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 93: scene_alien_landscape(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 94: scene_robot_factory(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 95: scene_time_vortex(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 96: scene_glitch_world(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 97: scene_neural_network(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 98: scene_cosmic_dance(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 99: scene_reality_glitch(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            
-            // Human scenes (100-109)
-            case 100: scene_human_walker(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 101: scene_dance_party(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 102: scene_martial_arts(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 103: scene_human_pyramid(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 104: scene_yoga_flow(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 105: scene_sports_stadium(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 106: scene_robot_dance(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 107: scene_crowd_wave(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 108: scene_mirror_dance(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 109: scene_human_evolution(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            
-            // Warfare scenes (110-119)
-            case 110: scene_fighter_squadron(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 111: scene_drone_swarm(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 112: scene_strategic_bombing(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 113: scene_dogfight(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 114: scene_helicopter_assault(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 115: scene_stealth_mission(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 116: scene_carrier_strike(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 117: scene_missile_defense(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 118: scene_recon_drone(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            case 119: scene_air_command(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL); break;
-            
-            // Revolution & Eyes scenes (120-129)
-            case 120: scene_120(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 121: scene_121(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 122: scene_122(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 123: scene_123(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 124: scene_124(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 125: scene_125(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 126: scene_126(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 127: scene_127(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 128: scene_128(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 129: scene_129(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            
-            // Film Noir scenes (130-139)
-            case 130: scene_130(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 131: scene_131(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 132: scene_132(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 133: scene_133(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 134: scene_134(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 135: scene_135(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 136: scene_136(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 137: scene_137(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 138: scene_138(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 139: scene_139(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-                
-            // Escher 3D Illusion scenes (140-149)
-            case 140: scene_impossible_stairs(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 141: scene_mobius_strip(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 142: scene_impossible_cube(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 143: scene_penrose_triangle(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 144: scene_infinite_corridor(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 145: scene_tessellated_reality(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 146: scene_gravity_wells(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 147: scene_dimensional_shift(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 148: scene_fractal_architecture(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 149: scene_escher_waterfall(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            
-            // Ikeda-inspired scenes (150-159)
-            case 150: scene_ikeda_data_matrix(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 151: scene_ikeda_test_pattern(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 152: scene_ikeda_sine_wave(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 153: scene_ikeda_barcode(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 154: scene_ikeda_pulse(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 155: scene_ikeda_glitch(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 156: scene_ikeda_spectrum(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 157: scene_ikeda_phase(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 158: scene_ikeda_binary(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 159: scene_ikeda_circuit(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            
-            // Giger-Inspired scenes (160-169)
-            case 160: scene_giger_spine(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 161: scene_giger_eggs(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 162: scene_giger_tentacles(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 163: scene_giger_hive(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 164: scene_giger_skull(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 165: scene_giger_facehugger(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 166: scene_giger_heart(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 167: scene_giger_architecture(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 168: scene_giger_chestburster(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 169: scene_giger_space_jockey(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            
-            // Revolt scenes (170-179)
-            case 170: scene_revolt_rising_fists(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 171: scene_revolt_breaking_chains(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 172: scene_revolt_crowd_march(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 173: scene_revolt_barricade_building(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 174: scene_revolt_molotov_cocktails(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 175: scene_revolt_tear_gas(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 176: scene_revolt_graffiti_wall(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 177: scene_revolt_police_line_breaking(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 178: scene_revolt_flag_burning(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            case 179: scene_revolt_victory_dance(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params); break;
-            
-            // Audio reactive scenes (180-189)
-            case 180: scene_audio_reactive_cubes(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params, vj.audio_enabled ? &vj.audio_data : NULL); break;
-            case 181: scene_audio_flash_strobes(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params, vj.audio_enabled ? &vj.audio_data : NULL); break;
-            case 182: scene_audio_explosions(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params, vj.audio_enabled ? &vj.audio_data : NULL); break;
-            case 183: scene_audio_wave_tunnel(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params, vj.audio_enabled ? &vj.audio_data : NULL); break;
-            case 184: scene_audio_spectrum_3d(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params, vj.audio_enabled ? &vj.audio_data : NULL); break;
-            case 185: scene_audio_reactive_particles(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params, vj.audio_enabled ? &vj.audio_data : NULL); break;
-            case 186: scene_audio_pulse_rings(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params, vj.audio_enabled ? &vj.audio_data : NULL); break;
-            case 187: scene_audio_waveform_3d(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params, vj.audio_enabled ? &vj.audio_data : NULL); break;
-            case 188: scene_audio_matrix_grid(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params, vj.audio_enabled ? &vj.audio_data : NULL); break;
-            case 189: scene_audio_reactive_fractals(deck->buffer, deck->zbuffer, vj.width, vj.height, vj.time, deck->params, vj.audio_enabled ? &vj.audio_data : NULL); break;
-                
-            default:
-                // Fallback to audio bars for any undefined scenes
-                scene_audio_bars(deck->buffer, deck->zbuffer, vj.width, vj.height, deck->params, vj.time, NULL);
-                break;
+        // A new scene starts at full detail and is measured afresh
+        QualityGovernor* gov = &vj.governors[d];
+        if (gov->scene_id != deck->scene_id) {
+            quality_governor_reset(gov, deck->scene_id);
+        }
+        render_ctx.quality = vj.quality_governor ? gov->level : 1.0f;
+        render_ctx.deck = d;
+        int64_t render_start = monotonic_ns();
+        
+        // Off the native resolution the scene draws into the deck's render
+        // plane, which is then resampled onto the terminal grid
+        char* buf = deck->buffer;
+        float* zbuf = deck->zbuffer;
+        int w, h;
+        deck_render_size(deck, &w, &h);
+        if (deck->render_scale != RENDER_SCALE_NATIVE) {
+            buf = deck->render_buffer;
+            zbuf = deck->render_zbuffer;
+        }
+        
+        // Reuse this deck's last output if the scene's inputs haven't
+        // changed since, or deck A's from this frame if they match it
+        const SceneDesc* scene = &scene_registry[deck->scene_id];
+        SceneMemo* memo = &vj.memos[d];
+        SceneKey key;
+        scene_key_make(scene, deck, w, h, frame->time, &key);
+        const SceneMemo* reuse = NULL;
+        if (!(scene->flags & SCENE_OVERWRITES_BUFFER)) {
+            if (memo->valid && memcmp(&memo->key, &key, sizeof(key)) == 0) {
+                reuse = memo;
+            } else if (d == 1 && vj.memos[0].valid && memcmp(&vj.memos[0].key, &key, sizeof(key)) == 0) {
+                reuse = &vj.memos[0];
+            }
+        }
+        
+        int64_t scene_end = render_start;
+        if (reuse) {
+            memcpy(deck->buffer, reuse->plane, vj.width * vj.height);
+            vj.scene_reuses++;
+        } else {
+            // Render scene. The plane (and the depth buffer, for scenes that
+            // depth-test) starts cleared unless the scene manages it itself.
+            if (!(scene->flags & SCENE_OVERWRITES_BUFFER)) {
+                memset(buf, ' ', w * h);
+                if (scene->flags & SCENE_USES_DEPTH) {
+                    for (int i = 0; i < w * h; i++) {
+                        zbuf[i] = 1000.0f;
+                    }
+                }
+            }
+            scene->render(buf, zbuf, w, h, deck->params, frame->time, scene_audio(scene, deck));
+            scene_end = monotonic_ns();
+            
+            if (buf != deck->buffer) {
+                resample_plane(buf, w, h, deck->buffer, vj.width, vj.height, vj.resample_mode);
+            }
+        }
+        if (reuse != memo) {
+            memcpy(memo->plane, deck->buffer, vj.width * vj.height);
+            memo->key = key;
+            memo->valid = true;
         }
         
         // Apply post effect
+        int64_t effect_start = monotonic_ns();
         apply_post_effect(deck->buffer, deck->post_effect, vj.width, vj.height);
-    }
-    
-    // Simple 3-state crossfade mixing
-    for (int i = 0; i < vj.width * vj.height; i++) {
-        char a = vj.deck_a.buffer[i];
-        char b = vj.deck_b.buffer[i];
         
-        switch (vj.crossfade_state) {
-            case XFADE_FULL_A:
-                vj.output_buffer[i] = a;
-                break;
-                
-            case XFADE_FULL_B:
-                vj.output_buffer[i] = b;
-                break;
-                
-            case XFADE_MIX:
-                // Mix both decks - alternate characters for blend effect
-                if (a != ' ' && b != ' ') {
-                    // Both have content - use pattern for mixing
-                    vj.output_buffer[i] = ((i + (int)(vj.time * 8)) % 2) ? a : b;
-                } else if (a != ' ') {
-                    vj.output_buffer[i] = a;
-                } else {
-                    vj.output_buffer[i] = b;
-                }
-                break;
+        // Keep the cost table current. A scene running below full quality
+        // costs less than the table means, so only full-detail frames count.
+        if (!reuse && render_ctx.quality >= 1.0f) {
+            cost_table_record_scene(&vj.costs, deck->scene_id, scene_end - render_start, w * h);
+        }
+        cost_table_record_effect(&vj.costs, deck->post_effect, monotonic_ns() - effect_start, vj.width * vj.height);
+        
+        if (vj.quality_governor) {
+            quality_governor_update(gov, (monotonic_ns() - render_start) / 1e6f, budget_ms);
         }
     }
+    
+    // The mix never reads a hidden deck's plane
+    int size = vj.width * vj.height;
+    if (frame->crossfade_state != XFADE_FULL_B) {
+        memcpy(frame->deck_planes[0], frame->decks[0].buffer, size);
+    }
+    if (frame->crossfade_state != XFADE_FULL_A) {
+        memcpy(frame->deck_planes[1], frame->decks[1].buffer, size);
+    }
 }
 
 // ============= ENHANCED USER INTERFACE =============
@@ -16413,26 +16762,60 @@ int get_visual_color(char c, CLIFTDeck* deck, float audio_intensity, int x, int
     }
 }
 
-void vj_render_ui() {
-    // Render live coding overlay first (before main buffer rendering)
-    render_live_coding_overlay();
+// Compose stage: crossfade the deck planes, lay the live coding overlay on
+// top and resolve every character's color pair
+void vj_compose(FrameSlot* frame, bool colors) {
+    int size = vj.width * vj.height;
+    
+    // Simple 3-state crossfade mixing
+    for (int i = 0; i < size; i++) {
+        char a = frame->deck_planes[0][i];
+        char b = frame->deck_planes[1][i];
+        
+        switch (frame->crossfade_state) {
+            case XFADE_FULL_A:
+                frame->plane[i] = a;
+                break;
+                
+            case XFADE_FULL_B:
+                frame->plane[i] = b;
+                break;
+                
+            case XFADE_MIX:
+                // Mix both decks - alternate characters for blend effect
+                if (a != ' ' && b != ' ') {
+                    // Both have content - use pattern for mixing
+                    frame->plane[i] = ((i + (int)(frame->time * 8)) % 2) ? a : b;
+                } else if (a != ' ') {
+                    frame->plane[i] = a;
+                } else {
+                    frame->plane[i] = b;
+                }
+                break;
+        }
+    }
+    
+    pthread_mutex_lock(&vj.state_mutex);
+    render_live_coding_overlay(frame->plane);
+    pthread_mutex_unlock(&vj.state_mutex);
     
-    // Render main output with enhanced color mapping
+    // Enhanced color mapping
     for (int y = 0; y < vj.height; y++) {
         for (int x = 0; x < vj.width; x++) {
-            char c = vj.output_buffer[y * vj.width + x];
+            char c = frame->plane[y * vj.width + x];
+            chtype cell = (unsigned char)c;
             
-            if (has_colors() && c != ' ') {
+            if (colors && c != ' ') {
                 // Enhanced color selection based on crossfade state
                 int color_pair;
                 
-                switch (vj.crossfade_state) {
+                switch (frame->crossfade_state) {
                     case XFADE_FULL_A:
-                        color_pair = get_visual_color(c, &vj.deck_a, 0.7f, x, y, vj.width, vj.height, vj.time);
+                        color_pair = get_visual_color(c, &frame->decks[0], 0.7f, x, y, vj.width, vj.height, frame->time);
                         break;
                         
                     case XFADE_FULL_B:
-                        color_pair = get_visual_color(c, &vj.deck_b, 0.7f, x, y, vj.width, vj.height, vj.time);
+                        color_pair = get_visual_color(c, &frame->decks[1], 0.7f, x, y, vj.width, vj.height, frame->time);
                         break;
                         
                     case XFADE_MIX:
@@ -16442,7 +16825,7 @@ void vj_render_ui() {
                             bool use_deck_a;
                             
                             // Create different mixing patterns
-                            int pattern = ((int)(vj.time * 0.1f)) % 4;
+                            int pattern = ((int)(frame->time * 0.1f)) % 4;
                             switch (pattern) {
                                 case 0: // Checkerboard pattern
                                     use_deck_a = ((x + y) % 2) == 0;
@@ -16454,7 +16837,7 @@ void vj_render_ui() {
                                     use_deck_a = (x % 4) < 2;
                                     break;
                                 case 3: // Time-based alternating
-                                    use_deck_a = ((int)(vj.time * 2.0f + x + y)) % 2 == 0;
+                                    use_deck_a = ((int)(frame->time * 2.0f + x + y)) % 2 == 0;
                                     break;
                                 default:
                                     use_deck_a = true;
@@ -16463,32 +16846,33 @@ void vj_render_ui() {
                             
                             // Get color from appropriate deck
                             if (use_deck_a) {
-                                color_pair = get_visual_color(c, &vj.deck_a, 0.7f, x, y, vj.width, vj.height, vj.time);
+                                color_pair = get_visual_color(c, &frame->decks[0], 0.7f, x, y, vj.width, vj.height, frame->time);
                             } else {
-                                color_pair = get_visual_color(c, &vj.deck_b, 0.7f, x, y, vj.width, vj.height, vj.time);
+                                color_pair = get_visual_color(c, &frame->decks[1], 0.7f, x, y, vj.width, vj.height, frame->time);
                             }
                         }
                         break;
                         
                     default:
-                        color_pair = get_visual_color(c, &vj.deck_a, 0.7f, x, y, vj.width, vj.height, vj.time);
+                        color_pair = get_visual_color(c, &frame->decks[0], 0.7f, x, y, vj.width, vj.height, frame->time);
                         break;
                 }
                 
-                attron(COLOR_PAIR(color_pair));
-                mvaddch(y, x, c);
-                attroff(COLOR_PAIR(color_pair));
-                
-                // Removed audio beat detection
-            } else {
-                mvaddch(y, x, c);
+                cell |= COLOR_PAIR(color_pair);
             }
+            frame->cells[y * vj.width + x] = cell;
         }
     }
+}
+
+void vj_render_ui(const chtype* cells) {
+    // Composed frame first, UI on top
+    for (int y = 0; y < vj.height; y++) {
+        mvaddchnstr(y, 0, cells + y * vj.width, vj.width);
+    }
     
     // Skip UI rendering if hidden
     if (vj.hide_ui) {
-        refresh();
         return;
     }
     
@@ -16515,8 +16899,9 @@ void vj_render_ui() {
         attron(A_REVERSE);
     }
     mvprintw(ui_y, 0, "+--- CLIFT v2.1 ----------------------------------------------------------+");
-    mvprintw(ui_y + 1, 0, "| FPS:%3d | Speed:%.1fx | BPM:%.0f | Auto:%s | FullAuto:%s | XFade:%s    |",
-             fps, vj.master_speed.value, 
+    mvprintw(ui_y + 1, 0, "| FPS:%3d/%d Late:%llu | Speed:%.1fx | BPM:%.0f | Auto:%s | FullAuto:%s | XFade:%s |",
+             fps, vj.pacer.target_fps, (unsigned long long)vj.pacer.missed,
+             vj.master_speed.value, 
              vj.bpm_system.bpm > 0 ? vj.bpm_system.bpm : 0.0f,
              vj.bpm_system.auto_crossfade_enabled ? "ON " : "OFF",
              vj.full_auto_mode ? "ON " : "OFF",
@@ -16540,13 +16925,15 @@ void vj_render_ui() {
         mvprintw(ui_y + 2, 0, "| DECK A");
         attroff(COLOR_PAIR(vj.deck_a.primary_color));
         
-        mvprintw(ui_y + 2, 8, " %s | %02d:%-12.12s | %s>%s | %s | FX:%-8s",
+        mvprintw(ui_y + 2, 8, " %s | %02d:%-12.12s | %s>%s | %s | FX:%-8s Q:%3d%% R:%-3s",
                  deck_a_indicator, vj.deck_a.scene_id, 
-                 scene_names[vj.deck_a.scene_id],
+                 scene_registry[vj.deck_a.scene_id].name,
                  color_names[vj.deck_a.primary_color], 
                  color_names[vj.deck_a.secondary_color],
                  gradient_names[vj.deck_a.gradient_type],
-                 post_effect_names[vj.deck_a.post_effect]);
+                 post_effect_names[vj.deck_a.post_effect],
+                 (int)(vj.governors[0].level * 100.0f + 0.5f),
+                 render_scale_names[vj.deck_a.render_scale]);
         
         // Add closing border
         mvprintw(ui_y + 2, 78, " |");
@@ -16556,32 +16943,38 @@ void vj_render_ui() {
         mvprintw(ui_y + 3, 0, "| DECK B");
         attroff(COLOR_PAIR(vj.deck_b.primary_color));
         
-        mvprintw(ui_y + 3, 8, " %s | %02d:%-12.12s | %s>%s | %s | FX:%-8s",
+        mvprintw(ui_y + 3, 8, " %s | %02d:%-12.12s | %s>%s | %s | FX:%-8s Q:%3d%% R:%-3s",
                  deck_b_indicator, vj.deck_b.scene_id,
-                 scene_names[vj.deck_b.scene_id],
+                 scene_registry[vj.deck_b.scene_id].name,
                  color_names[vj.deck_b.primary_color], 
                  color_names[vj.deck_b.secondary_color],
                  gradient_names[vj.deck_b.gradient_type],
-                 post_effect_names[vj.deck_b.post_effect]);
+                 post_effect_names[vj.deck_b.post_effect],
+                 (int)(vj.governors[1].level * 100.0f + 0.5f),
+                 render_scale_names[vj.deck_b.render_scale]);
         
         // Add closing border
         mvprintw(ui_y + 3, 78, " |");
     } else {
         // Fallback for no color
-        mvprintw(ui_y + 2, 0, "| DECK A %s | %02d:%-12.12s | %s>%s | %s | FX:%-8s |",
+        mvprintw(ui_y + 2, 0, "| DECK A %s | %02d:%-12.12s | %s>%s | %s | FX:%-8s Q:%3d%% R:%-3s |",
                  deck_a_indicator, vj.deck_a.scene_id, 
-                 scene_names[vj.deck_a.scene_id],
+                 scene_registry[vj.deck_a.scene_id].name,
                  color_names[vj.deck_a.primary_color], 
                  color_names[vj.deck_a.secondary_color],
                  gradient_names[vj.deck_a.gradient_type],
-                 post_effect_names[vj.deck_a.post_effect]);
-        mvprintw(ui_y + 3, 0, "| DECK B %s | %02d:%-12.12s | %s>%s | %s | FX:%-8s |",
+                 post_effect_names[vj.deck_a.post_effect],
+                 (int)(vj.governors[0].level * 100.0f + 0.5f),
+                 render_scale_names[vj.deck_a.render_scale]);
+        mvprintw(ui_y + 3, 0, "| DECK B %s | %02d:%-12.12s | %s>%s | %s | FX:%-8s Q:%3d%% R:%-3s |",
                  deck_b_indicator, vj.deck_b.scene_id,
-                 scene_names[vj.deck_b.scene_id],
+                 scene_registry[vj.deck_b.scene_id].name,
                  color_names[vj.deck_b.primary_color], 
                  color_names[vj.deck_b.secondary_color],
                  gradient_names[vj.deck_b.gradient_type],
-                 post_effect_names[vj.deck_b.post_effect]);
+                 post_effect_names[vj.deck_b.post_effect],
+                 (int)(vj.governors[1].level * 100.0f + 0.5f),
+                 render_scale_names[vj.deck_b.render_scale]);
     }
     
     // Simple 3-state crossfader with BPM display
@@ -16607,16 +17000,15 @@ void vj_render_ui() {
     switch (vj.current_ui_page) {
         case UI_PAGE_PERFORMANCE:
         {
-            const char* category_names[] = {"Basic", "Geometric", "Organic", "Text/Code", "Abstract", "Tunnels", "Nature", "Explosions", "Cities", "Freestyle", "Human", "Warfare", "Revolution&Eyes", "Film Noir", "Escher 3D", "Ikeda", "Giger", "Revolt", "Audio React"};
             int current_scene_id = vj.selected_deck == 0 ? vj.deck_a.scene_id : vj.deck_b.scene_id;
             int current_category = current_scene_id / 10;
             
             mvprintw(ui_y + 7, 0, "| %s (%d0-%d9) | Active: DECK %c | Scene: %02d-%-15.15s        |", 
-                     category_names[current_category], 
+                     scene_category_names[scene_registry[current_scene_id].category], 
                      current_category, current_category,
                      vj.selected_deck == 0 ? 'A' : 'B',
                      current_scene_id,
-                     scene_names[current_scene_id]);
+                     scene_registry[current_scene_id].name);
             mvprintw(ui_y + 8, 0, "| A/B=Deck | 0-9=Scene | PgUp/Dn=Category | V/N=Colors | G=Grad | T=TapBPM |");
             mvprintw(ui_y + 9, 0, "| X/Z/C/M=XFade | Left/Right=Interval±4 | [/]=Interval±1 | F=FullAuto      |");
             break;
@@ -16745,7 +17137,7 @@ void vj_render_ui() {
         {
             mvprintw(ui_y + 7, 0, "| HELP | A/B=Deck | 0-9=Scene | PgUp/Dn=Category | V/N=Colors | G=Grad   |");
             mvprintw(ui_y + 8, 0, "| E=Effects | X/Z/C/M=XFade | T=TapBPM | F=FullAuto | U=HideUI | Q=Quit  |");
-            mvprintw(ui_y + 9, 0, "| Tab=NextPage | S/L/D=Save/Load/Delete Preset | P=Parameter Mode       |");
+            mvprintw(ui_y + 9, 0, "| Tab=NextPage | S/L/D=Save/Load/Delete Preset | P=Params | </>=Res     |");
             break;
         }
         
@@ -16770,7 +17162,19 @@ void vj_render_ui() {
             // Get connection info
             char conn_info[256] = "No connections";
             int conn_count = 0;
-            if (vj.audio_enabled) {
+            if (audio_file_active()) {
+                int len = snprintf(conn_info, sizeof(conn_info), "File: %s %.0f/%.0fs",
+                                   vj.audio_device_name, audio_file_position(), audio_file_duration());
+                if (vj.audio_data.has_features && len > 0 && len < (int)sizeof(conn_info)) {
+                    if (vj.audio_data.next_drop_in >= 0.0f) {
+                        snprintf(conn_info + len, sizeof(conn_info) - len, " | %.1f BPM | Drop in %.0fs",
+                                 vj.audio_data.bpm, vj.audio_data.next_drop_in);
+                    } else {
+                        snprintf(conn_info + len, sizeof(conn_info) - len, " | %.1f BPM%s",
+                                 vj.audio_data.bpm, vj.audio_data.in_breakdown ? " | Breakdown" : "");
+                    }
+                }
+            } else if (vj.audio_enabled) {
                 conn_count = audio_count_connections();
                 if (conn_count > 0) {
                     audio_get_connection_info(conn_info, sizeof(conn_info));
@@ -16842,6 +17246,15 @@ void vj_render_ui() {
                          treble_bar,
                          vol_bar,
                          vj.audio_data.beat_detected ? "BEAT!" : "     ");
+                
+                // With stems, show which stream each deck follows and its beats
+                if (vj.audio_stream_count > 1) {
+                    printw(" A<%s%s B<%s%s Y=Stream |",
+                           vj.audio_stream_names[vj.deck_a.audio_stream],
+                           audio_stream_data(vj.deck_a.audio_stream)->beat_detected ? "*" : " ",
+                           vj.audio_stream_names[vj.deck_b.audio_stream],
+                           audio_stream_data(vj.deck_b.audio_stream)->beat_detected ? "*" : " ");
+                }
                 pthread_mutex_unlock(&vj.audio_mutex);
             } else {
                 mvprintw(ui_y + 9, 0, "| I=Enable Audio | A=Monitor S=Select Source | +/-=Gain | [/]=Smoothing |");
@@ -16859,8 +17272,6 @@ void vj_render_ui() {
     int last_line = ui_y + 9;
     if (vj.current_ui_page == UI_PAGE_PRESETS) last_line = ui_y + 12;
     mvprintw(last_line, 0, "+------------------------------------------------------------------------+");
-    
-    refresh();
 }
 
 // ============= PRESET MANAGEMENT =============
@@ -17040,23 +17451,18 @@ void init_live_coding_monitor() {
 }
 
 void update_cpu_usage() {
-    // Simple CPU usage estimation based on rendering performance
+    // Frame budget used, as measured by the frame pacer
     static float last_time = 0.0f;
-    static int frame_counter = 0;
     float current_time = vj.time;
     
-    frame_counter++;
     if (current_time - last_time >= 1.0f) {
-        // Estimate CPU usage based on frame rate
-        float fps = frame_counter / (current_time - last_time);
-        vj.live_coding.cpu_usage = (60.0f - fps) / 60.0f * 100.0f;
+        vj.live_coding.cpu_usage = vj.pacer.load * 100.0f;
         if (vj.live_coding.cpu_usage < 0) vj.live_coding.cpu_usage = 0;
         if (vj.live_coding.cpu_usage > 100) vj.live_coding.cpu_usage = 100;
         
         // Simple memory usage simulation
         vj.live_coding.memory_usage = 45.0f + sinf(current_time * 0.1f) * 15.0f;
         
-        frame_counter = 0;
         last_time = current_time;
     }
 }
@@ -17142,12 +17548,12 @@ void parse_websocket_message(const char* message) {
     }
 }
 
-void render_live_coding_overlay() {
+void render_live_coding_overlay(char* buffer) {
     if (!vj.live_coding.display_overlay) return;
     
     // Debug: Check for valid buffer
-    if (!vj.output_buffer) {
-        fprintf(stderr, "ERROR: render_live_coding_overlay called with NULL output_buffer\n");
+    if (!buffer) {
+        fprintf(stderr, "ERROR: render_live_coding_overlay called with NULL buffer\n");
         return;
     }
     
@@ -17159,7 +17565,7 @@ void render_live_coding_overlay() {
     if (start_y >= 0 && start_y < vj.height) {
         // Clear the line with spaces (black background)
         for (int x = 0; x < overlay_width && x < vj.width; x++) {
-            vj.output_buffer[start_y * vj.width + x] = ' ';
+            buffer[start_y * vj.width + x] = ' ';
         }
         
         // Format Player 1 info - get first line of code only
@@ -17176,7 +17582,7 @@ void render_live_coding_overlay() {
         
         // Write Player 1 line
         for (int x = 0; x < strlen(p1_line) && x < vj.width; x++) {
-            vj.output_buffer[start_y * vj.width + x] = p1_line[x];
+            buffer[start_y * vj.width + x] = p1_line[x];
         }
     }
     
@@ -17184,7 +17590,7 @@ void render_live_coding_overlay() {
     if (start_y + 1 >= 0 && start_y + 1 < vj.height) {
         // Clear the line with spaces (black background)
         for (int x = 0; x < overlay_width && x < vj.width; x++) {
-            vj.output_buffer[(start_y + 1) * vj.width + x] = ' ';
+            buffer[(start_y + 1) * vj.width + x] = ' ';
         }
         
         // Format Player 2 info - get first line of code only
@@ -17201,7 +17607,7 @@ void render_live_coding_overlay() {
         
         // Write Player 2 line
         for (int x = 0; x < strlen(p2_line) && x < vj.width; x++) {
-            vj.output_buffer[(start_y + 1) * vj.width + x] = p2_line[x];
+            buffer[(start_y + 1) * vj.width + x] = p2_line[x];
         }
     }
 }
@@ -17520,7 +17926,7 @@ void vj_handle_input() {
             int new_scene_id = current_category * 10 + scene_number;
             
             // Ensure the new scene ID is valid (0-169)
-            if (new_scene_id >= 0 && new_scene_id <= 189) {
+            if (new_scene_id >= 0 && new_scene_id < SCENE_COUNT) {
                 deck->scene_id = new_scene_id;
             }
             break;
@@ -17661,6 +18067,22 @@ void vj_handle_input() {
             deck->gradient_type = (deck->gradient_type + 1) % GRADIENT_COUNT; // Cycle through gradients
             break;
         }
+        case 'y': case 'Y': {
+            CLIFTDeck* deck = vj.selected_deck == 0 ? &vj.deck_a : &vj.deck_b;
+            deck->audio_stream = (deck->audio_stream + 1) % vj.audio_stream_count; // Follow the next stream
+            break;
+        }
+        
+        // Selected deck's internal render resolution
+        case '<': case '>': {
+            CLIFTDeck* deck = vj.selected_deck == 0 ? &vj.deck_a : &vj.deck_b;
+            if (ch == '<' && deck->render_scale > 0) {
+                deck->render_scale--;
+            } else if (ch == '>' && deck->render_scale < RENDER_SCALE_COUNT - 1) {
+                deck->render_scale++;
+            }
+            break;
+        }
         
         // Audio input controls
         case 'i': case 'I':
@@ -17770,8 +18192,8 @@ void vj_handle_input() {
                 save_preset(vj.selected_preset, preset_name);
             } else if (vj.current_ui_page == UI_PAGE_AUDIO && vj.audio_enabled) {
                 // Cycle through available audio sources and connect
-                AudioSource sources[50];
-                int count = get_audio_sources(sources, 50);
+                AudioSource sources[AUDIO_MAX_SOURCES];
+                int count = audio_get_sources(sources, AUDIO_MAX_SOURCES);
                 
                 if (count > 0) {
                     // Disconnect current connections first
@@ -17884,7 +18306,7 @@ void vj_handle_input() {
                 CLIFTDeck* deck = vj.selected_deck == 0 ? &vj.deck_a : &vj.deck_b;
                 int current_category = deck->scene_id / 10;
                 int scene_in_category = deck->scene_id % 10;
-                int new_category = (current_category - 1 + 19) % 19;  // Wrap around to 18 if at 0
+                int new_category = (current_category - 1 + SCENE_CATEGORY_COUNT) % SCENE_CATEGORY_COUNT;  // Wrap around to the last one if at 0
                 deck->scene_id = new_category * 10 + scene_in_category;
             }
             break;
@@ -17904,7 +18326,7 @@ void vj_handle_input() {
                 CLIFTDeck* deck = vj.selected_deck == 0 ? &vj.deck_a : &vj.deck_b;
                 int current_category = deck->scene_id / 10;
                 int scene_in_category = deck->scene_id % 10;
-                int new_category = (current_category + 1) % 19;  // Wrap around to 0 if at 18
+                int new_category = (current_category + 1) % SCENE_CATEGORY_COUNT;  // Wrap around to 0 after the last one
                 deck->scene_id = new_category * 10 + scene_in_category;
             }
             break;
@@ -17912,6 +18334,295 @@ void vj_handle_input() {
     }
 }
 
+// ============= FRAME PACER =============
+
+static int64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+void frame_pacer_init(FramePacer* pacer, int target_fps) {
+    if (target_fps < 1) target_fps = 1;
+    if (target_fps > 240) target_fps = 240;
+    
+    memset(pacer, 0, sizeof(*pacer));
+    pacer->target_fps = target_fps;
+    pacer->period_ns = 1000000000LL / target_fps;
+    pacer->anchor_ns = monotonic_ns();
+    pacer->slot = 1;
+}
+
+// End of frame: sleep until the next deadline on the grid. A late frame
+// starts the next one at once so the following frames catch up; once more
+// than FRAME_PACER_MAX_LAG periods behind, whole slots are dropped instead,
+// which keeps the grid's phase.
+void frame_pacer_wait(FramePacer* pacer, int64_t frame_start_ns) {
+    int64_t now = monotonic_ns();
+    int64_t deadline = pacer->anchor_ns + (int64_t)pacer->slot * pacer->period_ns;
+    
+    pacer->frames++;
+    pacer->work_ms = (now - frame_start_ns) / 1e6f;
+    pacer->load = pacer->load * 0.9f + 0.1f * (float)(now - frame_start_ns) / pacer->period_ns;
+    
+    if (now > deadline) {
+        pacer->missed++;
+        int64_t lag = (now - deadline) / pacer->period_ns;
+        if (lag >= FRAME_PACER_MAX_LAG) {
+            pacer->skipped += lag;
+            pacer->slot += lag + 1;
+            deadline = pacer->anchor_ns + (int64_t)pacer->slot * pacer->period_ns;
+        } else {
+            pacer->slot++;
+            return;
+        }
+    } else {
+        pacer->slot++;
+    }
+    
+    struct timespec wake = {
+        .tv_sec = deadline / 1000000000LL,
+        .tv_nsec = deadline % 1000000000LL
+    };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL) == EINTR) {
+        // Interrupted by a signal (e.g. SIGWINCH); the deadline is absolute
+    }
+}
+
+// ============= FRAME PIPELINE =============
+
+bool frame_pipeline_init(FramePipeline* pipeline, int cells) {
+    memset(pipeline, 0, sizeof(*pipeline));
+    
+    for (int i = 0; i < FRAME_PIPELINE_SLOTS; i++) {
+        FrameSlot* slot = &pipeline->slots[i];
+        slot->deck_planes[0] = malloc(cells);
+        slot->deck_planes[1] = malloc(cells);
+        slot->plane = malloc(cells);
+        slot->cells = malloc(cells * sizeof(chtype));
+        if (!slot->deck_planes[0] || !slot->deck_planes[1] || !slot->plane || !slot->cells) {
+            fprintf(stderr, "CLIFT: Cannot allocate frame pipeline buffers (%d cells)\n", cells);
+            return false;
+        }
+        slot->state = FRAME_SLOT_FREE;
+    }
+    
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&pipeline->changed, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&pipeline->mutex, NULL);
+    
+    // Without workers the scenes simply render on the render thread
+    pipeline->scene_pool = thread_pool_create(0);
+    return true;
+}
+
+// Wait for a slot in state 'from' and move it to 'to'. Stages take the
+// oldest frame; with 'latest' the newest is taken and older ones are
+// recycled, so a slow terminal drops frames instead of adding latency.
+// Returns NULL on shutdown or once 'timeout_ms' (if >= 0) has passed.
+static FrameSlot* frame_pipeline_acquire(FramePipeline* pipeline, FrameSlotState from,
+                                         FrameSlotState to, bool latest, int timeout_ms) {
+    struct timespec deadline;
+    if (timeout_ms >= 0) {
+        int64_t end = monotonic_ns() + (int64_t)timeout_ms * 1000000LL;
+        deadline.tv_sec = end / 1000000000LL;
+        deadline.tv_nsec = end % 1000000000LL;
+    }
+    
+    pthread_mutex_lock(&pipeline->mutex);
+    FrameSlot* found = NULL;
+    while (running) {
+        for (int i = 0; i < FRAME_PIPELINE_SLOTS; i++) {
+            FrameSlot* slot = &pipeline->slots[i];
+            if (slot->state != from) continue;
+            if (!found || (latest ? slot->seq > found->seq : slot->seq < found->seq)) {
+                found = slot;
+            }
+        }
+        if (found) break;
+        
+        if (timeout_ms < 0) {
+            pthread_cond_wait(&pipeline->changed, &pipeline->mutex);
+        } else if (pthread_cond_timedwait(&pipeline->changed, &pipeline->mutex, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+    
+    if (found) {
+        if (latest) {
+            for (int i = 0; i < FRAME_PIPELINE_SLOTS; i++) {
+                FrameSlot* slot = &pipeline->slots[i];
+                if (slot != found && slot->state == from) {
+                    slot->state = FRAME_SLOT_FREE;
+                    pipeline->dropped++;
+                }
+            }
+            pthread_cond_broadcast(&pipeline->changed);
+        }
+        if (from == FRAME_SLOT_FREE) {
+            found->seq = pipeline->next_seq++;
+        }
+        found->state = to;
+    }
+    pthread_mutex_unlock(&pipeline->mutex);
+    return found;
+}
+
+static void frame_pipeline_release(FramePipeline* pipeline, FrameSlot* slot, FrameSlotState next) {
+    pthread_mutex_lock(&pipeline->mutex);
+    slot->state = next;
+    pthread_cond_broadcast(&pipeline->changed);
+    pthread_mutex_unlock(&pipeline->mutex);
+}
+
+// Decide which decks render this frame. Called under the state lock.
+static void schedule_deck_renders(FramePipeline* pipeline, FrameSlot* frame) {
+    static unsigned hidden_frames[2];
+    
+    float warmup = DECK_WARMUP_FRAMES * vj.master_speed.value / vj.pacer.target_fps;
+    float next_change = next_auto_crossfade_in();
+    bool warming = next_change >= 0.0f && next_change <= warmup;
+    
+    for (int d = 0; d < 2; d++) {
+        bool visible = frame->crossfade_state == XFADE_MIX ||
+                       frame->crossfade_state == (d == 0 ? XFADE_FULL_A : XFADE_FULL_B);
+        
+        if (visible || warming) {
+            hidden_frames[d] = 0;
+            frame->render_deck[d] = frame->decks[d].active;
+        } else {
+            // Stateful scenes keep ticking at a reduced rate; stateless ones
+            // can be redrawn from the clock alone, so they are suspended.
+            // Either way the first hidden frame is rendered at once.
+            int scene_id = frame->decks[d].scene_id;
+            bool stateful = scene_id < 0 || scene_id >= SCENE_COUNT ||
+                            (scene_registry[scene_id].flags & SCENE_STATEFUL);
+            unsigned n = hidden_frames[d]++;
+            frame->render_deck[d] = frame->decks[d].active && (stateful ? n % HIDDEN_DECK_DIVIDER == 0 : n == 0);
+            if (frame->decks[d].active && !frame->render_deck[d]) {
+                pipeline->hidden_skips++;
+            }
+        }
+    }
+}
+
+// Render stage: simulation step, deck snapshot and scene rendering. This
+// thread owns the frame pacer, so the grid cadence is set here and a slow
+// output stage shows up as back-pressure on the free slots.
+static void* frame_render_thread(void* arg) {
+    FramePipeline* pipeline = arg;
+    int64_t last_time = monotonic_ns();
+    render_ctx.pool = pipeline->scene_pool;
+    
+    while (running) {
+        int64_t frame_start = monotonic_ns();
+        float dt = (frame_start - last_time) / 1000000000.0f;
+        last_time = frame_start;
+        
+        FrameSlot* frame = frame_pipeline_acquire(pipeline, FRAME_SLOT_FREE, FRAME_SLOT_RENDERING, false, -1);
+        if (!frame) break;
+        
+        pthread_mutex_lock(&vj.state_mutex);
+        vj_update(dt);
+        frame->decks[0] = vj.deck_a;
+        frame->decks[1] = vj.deck_b;
+        frame->crossfade_state = vj.crossfade_state;
+        frame->time = vj.time;
+        schedule_deck_renders(pipeline, frame);
+        bool prewarming = scene_prewarm_note_frame(&vj.prewarm, frame);
+        pthread_mutex_unlock(&vj.state_mutex);
+        
+        if (prewarming) {
+            scene_prewarm_wait(&vj.prewarm);
+        }
+        vj_render(frame);
+        frame_pipeline_release(pipeline, frame, FRAME_SLOT_RENDERED);
+        
+        frame_pacer_wait(&vj.pacer, frame_start);
+    }
+    return NULL;
+}
+
+// Compose stage: mix and colorize rendered frames in order
+static void* frame_compose_thread(void* arg) {
+    FramePipeline* pipeline = arg;
+    
+    while (running) {
+        FrameSlot* frame = frame_pipeline_acquire(pipeline, FRAME_SLOT_RENDERED, FRAME_SLOT_COMPOSING, false, -1);
+        if (!frame) break;
+        
+        vj_compose(frame, pipeline->colors);
+        frame_pipeline_release(pipeline, frame, FRAME_SLOT_COMPOSED);
+    }
+    return NULL;
+}
+
+bool frame_pipeline_start(FramePipeline* pipeline) {
+    pipeline->colors = has_colors();
+    
+    if (pthread_create(&pipeline->render_thread, NULL, frame_render_thread, pipeline) != 0) {
+        fprintf(stderr, "CLIFT: Cannot start render thread\n");
+        return false;
+    }
+    if (pthread_create(&pipeline->compose_thread, NULL, frame_compose_thread, pipeline) != 0) {
+        fprintf(stderr, "CLIFT: Cannot start compose thread\n");
+        running = false;
+        pthread_join(pipeline->render_thread, NULL);
+        return false;
+    }
+    pipeline->started = true;
+    return true;
+}
+
+// Output stage, run on the main thread since curses is not thread-safe:
+// poll input, draw the newest composed frame and the UI, then flush it to
+// the terminal outside the state lock while the next frames are in flight.
+void frame_pipeline_output(FramePipeline* pipeline) {
+    FrameSlot* frame = frame_pipeline_acquire(pipeline, FRAME_SLOT_COMPOSED, FRAME_SLOT_DISPLAYING,
+                                              true, FRAME_OUTPUT_POLL_MS);
+    
+    pthread_mutex_lock(&vj.state_mutex);
+    vj_handle_input();
+    if (frame) {
+        vj_render_ui(frame->cells);
+    }
+    pthread_mutex_unlock(&vj.state_mutex);
+    
+    if (frame) {
+        frame_pipeline_release(pipeline, frame, FRAME_SLOT_FREE);
+        refresh();
+    }
+}
+
+// Wake and join the stage threads once 'running' is cleared
+void frame_pipeline_stop(FramePipeline* pipeline) {
+    if (pipeline->started) {
+        pthread_mutex_lock(&pipeline->mutex);
+        pthread_cond_broadcast(&pipeline->changed);
+        pthread_mutex_unlock(&pipeline->mutex);
+        
+        pthread_join(pipeline->render_thread, NULL);
+        pthread_join(pipeline->compose_thread, NULL);
+        pipeline->started = false;
+    }
+    thread_pool_destroy(pipeline->scene_pool);
+    pipeline->scene_pool = NULL;
+    
+    for (int i = 0; i < FRAME_PIPELINE_SLOTS; i++) {
+        FrameSlot* slot = &pipeline->slots[i];
+        free(slot->deck_planes[0]);
+        free(slot->deck_planes[1]);
+        free(slot->plane);
+        free(slot->cells);
+        memset(slot, 0, sizeof(*slot));
+    }
+    pthread_cond_destroy(&pipeline->changed);
+    pthread_mutex_destroy(&pipeline->mutex);
+}
+
 // ============= MAIN APPLICATION =============
 
 int main(int argc, char* argv[]) {
@@ -17921,17 +18632,89 @@ int main(int argc, char* argv[]) {
     
     // Parse command line arguments
     bool start_hidden = false;
+    const char* audio_file_path = NULL;
+    const char* stem_paths[AUDIO_MAX_STREAMS - 1];
+    int stem_count = 0;
+    char stream_names[AUDIO_MAX_STREAMS][32];
+    int stream_count = 1;
+    bool audio_file_realtime = true;
+    bool audio_file_loop = true;
+    const char* analyze_path = NULL;
+    const char* features_path = NULL;
+    int target_fps = FRAME_PACER_DEFAULT_FPS;
+    bool quality_governor = true;
+    int render_scale[2] = { RENDER_SCALE_NATIVE, RENDER_SCALE_NATIVE };
+    ResampleMode resample_mode = RESAMPLE_COVERAGE;
     fprintf(stderr, "DEBUG: Parsing %d command line arguments\n", argc);
     fflush(stderr);
     
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--hide-ui") == 0 || strcmp(argv[i], "--fullscreen") == 0 || strcmp(argv[i], "-h") == 0) {
             start_hidden = true;
+        } else if (strcmp(argv[i], "--audio-file") == 0 && i + 1 < argc) {
+            // Repeat to feed stems into extra streams
+            if (!audio_file_path) {
+                audio_file_path = argv[++i];
+            } else if (stem_count < AUDIO_MAX_STREAMS - 1) {
+                stem_paths[stem_count++] = argv[++i];
+            } else {
+                fprintf(stderr, "CLIFT: At most %d audio streams, ignoring %s\n", AUDIO_MAX_STREAMS, argv[++i]);
+            }
+        } else if (strcmp(argv[i], "--audio-streams") == 0 && i + 1 < argc) {
+            // Comma-separated names of extra live capture streams
+            char names[256];
+            snprintf(names, sizeof(names), "%s", argv[++i]);
+            for (char* name = strtok(names, ","); name && stream_count < AUDIO_MAX_STREAMS; name = strtok(NULL, ",")) {
+                snprintf(stream_names[stream_count++], sizeof(stream_names[0]), "%s", name);
+            }
+        } else if (strcmp(argv[i], "--audio-fast") == 0) {
+            audio_file_realtime = false;
+        } else if (strcmp(argv[i], "--audio-no-loop") == 0) {
+            audio_file_loop = false;
+        } else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            target_fps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--no-governor") == 0) {
+            quality_governor = false;
+        } else if (strcmp(argv[i], "--render-scale") == 0 && i + 1 < argc) {
+            // "A" for both decks or "A,B"; snapped to the nearest supported scale
+            char* next = argv[++i];
+            for (int d = 0; d < 2; d++) {
+                float scale = strtof(next, &next);
+                int best = RENDER_SCALE_NATIVE;
+                for (int k = 0; k < RENDER_SCALE_COUNT; k++) {
+                    if (fabsf(render_scales[k] - scale) < fabsf(render_scales[best] - scale)) best = k;
+                }
+                render_scale[d] = best;
+                if (*next == ',') {
+                    next++;
+                } else {
+                    if (d == 0) render_scale[1] = best;
+                    break;
+                }
+            }
+        } else if (strcmp(argv[i], "--resample") == 0 && i + 1 < argc) {
+            resample_mode = strcmp(argv[++i], "nearest") == 0 ? RESAMPLE_NEAREST : RESAMPLE_COVERAGE;
+        } else if (strcmp(argv[i], "--analyze") == 0 && i + 1 < argc) {
+            analyze_path = argv[++i];
+        } else if (strcmp(argv[i], "--features") == 0 && i + 1 < argc) {
+            features_path = argv[++i];
         } else if (strcmp(argv[i], "--help") == 0) {
             printf("CLIFT VJ Software\n");
             printf("Usage: %s [options]\n", argv[0]);
             printf("Options:\n");
             printf("  --hide-ui, --fullscreen, -h  Start with UI hidden (full-screen mode)\n");
+            printf("  --fps N                      Target frame rate (default %d)\n", FRAME_PACER_DEFAULT_FPS);
+            printf("  --no-governor                Always render scenes at full detail\n");
+            printf("  --render-scale A[,B]         Deck render resolution vs terminal (0.5-2, default 1)\n");
+            printf("  --resample MODE              Resolution mapping: coverage (default) or nearest\n");
+            printf("  --audio-file FILE.wav        Use a WAV file as audio input instead of PipeWire\n");
+            printf("                               (repeat to feed stems into extra streams)\n");
+            printf("  --audio-fast                 Stream the audio file as fast as possible\n");
+            printf("  --audio-no-loop              Stop the audio file at its end instead of looping\n");
+            printf("  --audio-streams a,b,c        Extra capture streams (stems/buses) decks can follow\n");
+            printf("                               (not with more than one --audio-file)\n");
+            printf("  --analyze FILE.wav           Pre-analyse a track (beats, drops) and exit\n");
+            printf("  --features FILE.clft         Feature track to use (default: audio file with .clft)\n");
             printf("  --help                       Show this help message\n");
             printf("\nControls:\n");
             printf("  U - Toggle UI visibility\n");
@@ -17942,6 +18725,58 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    // Offline pre-analysis runs instead of the show
+    char default_features[1024];
+    if (analyze_path) {
+        if (!features_path) {
+            feature_track_default_path(analyze_path, default_features, sizeof(default_features));
+            features_path = default_features;
+        }
+        return feature_track_analyze(analyze_path, features_path, 0) ? 0 : 1;
+    }
+    
+    // A file input replaces live capture, so stems leave no room for named
+    // live streams
+    if (stem_count > 0 && stream_count > 1) {
+        fprintf(stderr, "CLIFT: --audio-streams can't be combined with more than one --audio-file\n");
+        return 1;
+    }
+    
+    // Open the file input before ncurses so errors stay readable
+    if (audio_file_path && !audio_file_open(audio_file_path, audio_file_realtime, audio_file_loop)) {
+        return 1;
+    }
+    
+    // Files after the first become streams 1.., named after the file
+    if (stem_count > 0) {
+        for (int i = 0; i < stem_count; i++) {
+            if (!audio_file_open_stream(stream_count, stem_paths[i], audio_file_realtime, audio_file_loop)) {
+                return 1;
+            }
+            const char* base = strrchr(stem_paths[i], '/');
+            base = base ? base + 1 : stem_paths[i];
+            const char* dot = strrchr(base, '.');
+            snprintf(stream_names[stream_count++], sizeof(stream_names[0]), "%.*s",
+                     dot ? (int)(dot - base) : (int)strlen(base), base);
+        }
+    }
+    
+    // Pick up the file's feature track if it has been analysed
+    FeatureTrack features;
+    bool features_loaded = false;
+    if (audio_file_path) {
+        if (!features_path) {
+            feature_track_default_path(audio_file_path, default_features, sizeof(default_features));
+            if (access(default_features, R_OK) == 0) features_path = default_features;
+        }
+        if (features_path) {
+            if (!feature_track_open(&features, features_path)) {
+                return 1;
+            }
+            features_loaded = true;
+        }
+    }
+    
     fprintf(stderr, "DEBUG: Initializing ncurses...\n");
     fflush(stderr);
     
@@ -17991,6 +18826,26 @@ int main(int argc, char* argv[]) {
     fprintf(stderr, "DEBUG: vj_init completed successfully\n");
     fflush(stderr);
     
+    for (int i = 1; i < stream_count; i++) {
+        memcpy(vj.audio_stream_names[i], stream_names[i], sizeof(vj.audio_stream_names[i]));
+    }
+    vj.audio_stream_count = stream_count;
+    vj.quality_governor = quality_governor;
+    vj.deck_a.render_scale = render_scale[0];
+    vj.deck_b.render_scale = render_scale[1];
+    vj.resample_mode = resample_mode;
+    
+    // A file input is useless without the capture thread, so start it right away
+    if (audio_file_active()) {
+        vj.features = features;
+        vj.features_loaded = features_loaded;
+        
+        const char* base = strrchr(audio_file_path, '/');
+        snprintf(vj.audio_device_name, sizeof(vj.audio_device_name), "%s", base ? base + 1 : audio_file_path);
+        vj.audio_enabled = true;
+        start_audio_capture();
+    }
+    
     // Animated CLIFT splash screen
     if (!start_hidden) {
         clear();
@@ -18059,38 +18914,60 @@ int main(int argc, char* argv[]) {
     
     refresh();
     
-    struct timespec last_time, current_time;
-    clock_gettime(CLOCK_MONOTONIC, &last_time);
+    frame_pacer_init(&vj.pacer, target_fps);
+    int render_size = (int)(vj.width * RENDER_SCALE_MAX + 0.5f) * (int)(vj.height * RENDER_SCALE_MAX + 0.5f);
+    bool prewarm = scene_prewarm_init(&vj.prewarm, render_size);
+    cost_table_init(&vj.costs);
+    cost_table_benchmark_effects(&vj.costs);
+    if (!frame_pipeline_init(&vj.pipeline, vj.width * vj.height) || !frame_pipeline_start(&vj.pipeline)) {
+        endwin();
+        return 1;
+    }
+    if (prewarm) {
+        scene_prewarm_start(&vj.prewarm);
+    }
     
     while (running) {
-        clock_gettime(CLOCK_MONOTONIC, &current_time);
-        float dt = (current_time.tv_sec - last_time.tv_sec) + 
-                   (current_time.tv_nsec - last_time.tv_nsec) / 1000000000.0f;
-        last_time = current_time;
-        
-        vj_update(dt);
-        vj_render();
-        vj_render_ui();
-        vj_handle_input();
-        
-        usleep(16667);  // ~60 FPS
+        frame_pipeline_output(&vj.pipeline);
     }
     
     // Cleanup
     running = false;
+    frame_pipeline_stop(&vj.pipeline);
+    scene_prewarm_stop(&vj.prewarm);
+    cost_table_destroy(&vj.costs);
+    
+    fprintf(stderr, "CLIFT: %llu frames at %d FPS target, %llu missed deadlines, %llu slots skipped, %llu dropped before display\n",
+            (unsigned long long)vj.pacer.frames, vj.pacer.target_fps,
+            (unsigned long long)vj.pacer.missed, (unsigned long long)vj.pacer.skipped,
+            (unsigned long long)vj.pipeline.dropped);
+    fprintf(stderr, "CLIFT: %llu hidden deck renders skipped, %llu scene renders reused, %llu auto scenes prewarmed, %llu scenes profiled while idle\n",
+            (unsigned long long)vj.pipeline.hidden_skips, (unsigned long long)vj.scene_reuses,
+            (unsigned long long)vj.prewarm.warmups, (unsigned long long)vj.costs.profiled);
     
     // Stop websocket server
     stop_websocket_server();
     
     // Stop audio capture
     stop_audio_capture();
+    audio_file_close();
+    if (vj.features_loaded) {
+        feature_track_close(&vj.features);
+        vj.features_loaded = false;
+    }
     pthread_mutex_destroy(&vj.audio_mutex);
+    pthread_mutex_destroy(&vj.state_mutex);
     
     free(vj.deck_a.buffer);
     free(vj.deck_a.zbuffer);
     free(vj.deck_b.buffer);
     free(vj.deck_b.zbuffer);
-    free(vj.output_buffer);
+    free(vj.deck_a.render_buffer);
+    free(vj.deck_a.render_zbuffer);
+    free(vj.deck_b.render_buffer);
+    free(vj.deck_b.render_zbuffer);
+    free(vj.memos[0].plane);
+    free(vj.memos[1].plane);
     free(vj.temp_buffer);
     free(vj.output_zbuffer);
     
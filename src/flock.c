@@ -0,0 +1,297 @@
+#include "flock.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Agents per pool task
+#define FLOCK_CHUNK 512
+
+// Hash cells are at least the neighbour radius wide, but never so many
+// that clearing the grid costs more than the agents do
+#define FLOCK_MAX_CELLS 16384
+
+typedef struct {
+    float sep_x, sep_y;
+    float align_x, align_y;
+    float coh_x, coh_y;
+    float neighbors;
+} Steering;
+
+typedef struct {
+    Flock* flock;
+    const FlockRules* rules;
+} FlockJob;
+
+static float flock_random(Flock* flock) {
+    flock->rng = flock->rng * 1664525u + 1013904223u;
+    return (flock->rng >> 8) / 16777216.0f;
+}
+
+static bool grow_floats(float** array, int count) {
+    float* grown = realloc(*array, sizeof(float) * count);
+    if (!grown) return false;
+    *array = grown;
+    return true;
+}
+
+static bool grow_ints(int** array, int count) {
+    int* grown = realloc(*array, sizeof(int) * count);
+    if (!grown) return false;
+    *array = grown;
+    return true;
+}
+
+bool flock_resize(Flock* flock, int count, float width, float height, float spawn_speed) {
+    if (count < 0) count = 0;
+    if (count > FLOCK_MAX_AGENTS) count = FLOCK_MAX_AGENTS;
+
+    if (count > flock->capacity) {
+        float** floats[] = { &flock->x, &flock->y, &flock->vx, &flock->vy, &flock->prev_x, &flock->prev_y,
+                             &flock->sorted_x, &flock->sorted_y, &flock->sorted_vx, &flock->sorted_vy };
+        for (size_t i = 0; i < sizeof(floats) / sizeof(floats[0]); i++) {
+            if (!grow_floats(floats[i], count)) return false;
+        }
+        if (!grow_ints(&flock->agent_cell, count) || !grow_ints(&flock->sorted_index, count)) return false;
+        flock->capacity = count;
+    }
+
+    if (flock->rng == 0) flock->rng = 0x9E3779B9u;
+    for (int i = flock->count; i < count; i++) {
+        float heading = flock_random(flock) * 2.0f * (float)M_PI;
+        float speed = flock_random(flock) * spawn_speed;
+        flock->x[i] = flock->prev_x[i] = flock_random(flock) * width;
+        flock->y[i] = flock->prev_y[i] = flock_random(flock) * height;
+        flock->vx[i] = cosf(heading) * speed;
+        flock->vy[i] = sinf(heading) * speed;
+    }
+    flock->count = count;
+    flock->width = width;
+    flock->height = height;
+    return true;
+}
+
+// Counting sort of the agents into hash cells
+static bool flock_build_hash(Flock* flock, float radius) {
+    float cell_size = radius > 0.5f ? radius : 0.5f;
+    while ((int)ceilf(flock->width / cell_size) * (int)ceilf(flock->height / cell_size) > FLOCK_MAX_CELLS) {
+        cell_size *= 1.5f;
+    }
+    int grid_w = (int)ceilf(flock->width / cell_size);
+    int grid_h = (int)ceilf(flock->height / cell_size);
+    if (grid_w < 1) grid_w = 1;
+    if (grid_h < 1) grid_h = 1;
+    int cells = grid_w * grid_h;
+
+    if (cells + 1 > flock->grid_capacity) {
+        if (!grow_ints(&flock->cell_start, cells + 1)) return false;
+        flock->grid_capacity = cells + 1;
+    }
+    flock->cell_size = cell_size;
+    flock->grid_w = grid_w;
+    flock->grid_h = grid_h;
+
+    int* start = flock->cell_start;
+    memset(start, 0, sizeof(int) * (cells + 1));
+    for (int i = 0; i < flock->count; i++) {
+        int cx = (int)(flock->x[i] / cell_size);
+        int cy = (int)(flock->y[i] / cell_size);
+        cx = cx < 0 ? 0 : cx >= grid_w ? grid_w - 1 : cx;
+        cy = cy < 0 ? 0 : cy >= grid_h ? grid_h - 1 : cy;
+        flock->agent_cell[i] = cy * grid_w + cx;
+        start[flock->agent_cell[i] + 1]++;
+    }
+    for (int c = 0; c < cells; c++) {
+        start[c + 1] += start[c];
+    }
+    for (int i = 0; i < flock->count; i++) {
+        int slot = start[flock->agent_cell[i]]++;
+        flock->sorted_index[slot] = i;
+        flock->sorted_x[slot] = flock->x[i];
+        flock->sorted_y[slot] = flock->y[i];
+        flock->sorted_vx[slot] = flock->vx[i];
+        flock->sorted_vy[slot] = flock->vy[i];
+    }
+    // The scatter advanced every start to the next cell's; shift them back
+    memmove(start + 1, start, sizeof(int) * cells);
+    start[0] = 0;
+    return true;
+}
+
+// Sum steering from the sorted agents [begin, end) within sqrt(r2) of (px, py)
+static void accumulate_span(const Flock* flock, int begin, int end, float px, float py, float r2, Steering* s) {
+    int j = begin;
+
+#ifdef __SSE2__
+    const __m128 vpx = _mm_set1_ps(px), vpy = _mm_set1_ps(py);
+    const __m128 vr2 = _mm_set1_ps(r2), zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+    __m128 sep_x = zero, sep_y = zero, align_x = zero, align_y = zero;
+    __m128 coh_x = zero, coh_y = zero, neighbors = zero;
+
+    for (; j + 4 <= end; j += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(flock->sorted_x + j), vpx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(flock->sorted_y + j), vpy);
+        __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 near = _mm_and_ps(_mm_cmplt_ps(d2, vr2), _mm_cmpgt_ps(d2, zero));
+
+        // Lanes outside the radius (or the agent itself, where the
+        // inverse distance is inf) are masked off after the multiply
+        __m128 inv = _mm_div_ps(one, _mm_sqrt_ps(d2));
+        sep_x = _mm_sub_ps(sep_x, _mm_and_ps(near, _mm_mul_ps(dx, inv)));
+        sep_y = _mm_sub_ps(sep_y, _mm_and_ps(near, _mm_mul_ps(dy, inv)));
+        align_x = _mm_add_ps(align_x, _mm_and_ps(near, _mm_loadu_ps(flock->sorted_vx + j)));
+        align_y = _mm_add_ps(align_y, _mm_and_ps(near, _mm_loadu_ps(flock->sorted_vy + j)));
+        coh_x = _mm_add_ps(coh_x, _mm_and_ps(near, dx));
+        coh_y = _mm_add_ps(coh_y, _mm_and_ps(near, dy));
+        neighbors = _mm_add_ps(neighbors, _mm_and_ps(near, one));
+    }
+
+    float lanes[7][4];
+    _mm_storeu_ps(lanes[0], sep_x);
+    _mm_storeu_ps(lanes[1], sep_y);
+    _mm_storeu_ps(lanes[2], align_x);
+    _mm_storeu_ps(lanes[3], align_y);
+    _mm_storeu_ps(lanes[4], coh_x);
+    _mm_storeu_ps(lanes[5], coh_y);
+    _mm_storeu_ps(lanes[6], neighbors);
+    for (int l = 0; l < 4; l++) {
+        s->sep_x += lanes[0][l];
+        s->sep_y += lanes[1][l];
+        s->align_x += lanes[2][l];
+        s->align_y += lanes[3][l];
+        s->coh_x += lanes[4][l];
+        s->coh_y += lanes[5][l];
+        s->neighbors += lanes[6][l];
+    }
+#endif
+
+    for (; j < end; j++) {
+        float dx = flock->sorted_x[j] - px;
+        float dy = flock->sorted_y[j] - py;
+        float d2 = dx * dx + dy * dy;
+        if (d2 >= r2 || d2 <= 0.0f) continue;
+
+        float dist = sqrtf(d2);
+        s->sep_x -= dx / dist;
+        s->sep_y -= dy / dist;
+        s->align_x += flock->sorted_vx[j];
+        s->align_y += flock->sorted_vy[j];
+        s->coh_x += dx;
+        s->coh_y += dy;
+        s->neighbors += 1.0f;
+    }
+}
+
+static void flock_step_chunk(void* ctx, int chunk) {
+    const FlockJob* job = ctx;
+    Flock* flock = job->flock;
+    const FlockRules* rules = job->rules;
+    float r2 = rules->radius * rules->radius;
+    bool steer = rules->radius > 0.0f && (rules->separation != 0.0f || rules->alignment != 0.0f || rules->cohesion != 0.0f);
+
+    int end = (chunk + 1) * FLOCK_CHUNK;
+    if (end > flock->count) end = flock->count;
+
+    for (int k = chunk * FLOCK_CHUNK; k < end; k++) {
+        float px = flock->sorted_x[k], py = flock->sorted_y[k];
+        float vx = flock->sorted_vx[k], vy = flock->sorted_vy[k];
+
+        if (steer) {
+            // Each row of the 3x3 block of cells is one contiguous span
+            Steering s = { 0 };
+            int cx = flock->agent_cell[flock->sorted_index[k]] % flock->grid_w;
+            int cy = flock->agent_cell[flock->sorted_index[k]] / flock->grid_w;
+            int x0 = cx - 1 < 0 ? 0 : cx - 1;
+            int x1 = cx + 1 >= flock->grid_w ? flock->grid_w - 1 : cx + 1;
+            for (int gy = cy - 1; gy <= cy + 1; gy++) {
+                if (gy < 0 || gy >= flock->grid_h) continue;
+                int row = gy * flock->grid_w;
+                accumulate_span(flock, flock->cell_start[row + x0], flock->cell_start[row + x1 + 1], px, py, r2, &s);
+            }
+
+            if (s.neighbors > 0.0f) {
+                float inv = 1.0f / s.neighbors;
+                vx += s.sep_x * rules->separation + s.align_x * inv * rules->alignment + s.coh_x * inv * rules->cohesion;
+                vy += s.sep_y * rules->separation + s.align_y * inv * rules->alignment + s.coh_y * inv * rules->cohesion;
+            }
+        }
+
+        if (rules->attract != 0.0f) {
+            float dx = rules->attract_x - px, dy = rules->attract_y - py;
+            float dist = sqrtf(dx * dx + dy * dy);
+            if (dist > 0.0f) {
+                float force = rules->attract / (dist + 1.0f);
+                vx += dx / dist * force;
+                vy += dy / dist * force;
+            }
+        }
+
+        vx *= rules->friction;
+        vy *= rules->friction;
+        float speed = sqrtf(vx * vx + vy * vy);
+        if (rules->max_speed > 0.0f && speed > rules->max_speed) {
+            vx *= rules->max_speed / speed;
+            vy *= rules->max_speed / speed;
+        }
+
+        px += vx;
+        py += vy;
+        if (rules->edges == FLOCK_WRAP) {
+            if (px < 0.0f || px >= flock->width) px -= floorf(px / flock->width) * flock->width;
+            if (py < 0.0f || py >= flock->height) py -= floorf(py / flock->height) * flock->height;
+        } else {
+            if (px < 0.0f) { px = -px; vx = -vx; }
+            if (px >= flock->width) { px = 2.0f * flock->width - px; vx = -vx; }
+            if (py < 0.0f) { py = -py; vy = -vy; }
+            if (py >= flock->height) { py = 2.0f * flock->height - py; vy = -vy; }
+            px = fminf(fmaxf(px, 0.0f), flock->width);
+            py = fminf(fmaxf(py, 0.0f), flock->height);
+        }
+
+        int i = flock->sorted_index[k];
+        flock->x[i] = px;
+        flock->y[i] = py;
+        flock->vx[i] = vx;
+        flock->vy[i] = vy;
+    }
+}
+
+void flock_step(Flock* flock, const FlockRules* rules, ThreadPool* pool) {
+    if (flock->count == 0 || flock->width <= 0.0f || flock->height <= 0.0f) return;
+
+    memcpy(flock->prev_x, flock->x, sizeof(float) * flock->count);
+    memcpy(flock->prev_y, flock->y, sizeof(float) * flock->count);
+    if (!flock_build_hash(flock, rules->radius)) return;
+
+    // Every agent reads the sorted snapshot and writes only its own slot
+    FlockJob job = { flock, rules };
+    thread_pool_run(pool, (flock->count + FLOCK_CHUNK - 1) / FLOCK_CHUNK, flock_step_chunk, &job);
+}
+
+void flock_position(const Flock* flock, int i, float alpha, float* x, float* y) {
+    *x = flock->x[i];
+    *y = flock->y[i];
+    if (fabsf(*x - flock->prev_x[i]) < flock->width / 2 && fabsf(*y - flock->prev_y[i]) < flock->height / 2) {
+        *x = flock->prev_x[i] + (*x - flock->prev_x[i]) * alpha;
+        *y = flock->prev_y[i] + (*y - flock->prev_y[i]) * alpha;
+    }
+}
+
+void flock_free(Flock* flock) {
+    free(flock->x);
+    free(flock->y);
+    free(flock->vx);
+    free(flock->vy);
+    free(flock->prev_x);
+    free(flock->prev_y);
+    free(flock->cell_start);
+    free(flock->agent_cell);
+    free(flock->sorted_index);
+    free(flock->sorted_x);
+    free(flock->sorted_y);
+    free(flock->sorted_vx);
+    free(flock->sorted_vy);
+    memset(flock, 0, sizeof(*flock));
+}
@@ -0,0 +1,75 @@
+#ifndef FLOCK_H
+#define FLOCK_H
+
+#include <stdbool.h>
+#include "thread_pool.h"
+
+// Boids for the swarm scenes. Agents live in structure-of-arrays layout
+// and find their neighbours through a uniform-grid spatial hash rebuilt
+// every step, so a step costs about the same per agent at any flock size.
+#define FLOCK_MAX_AGENTS 10000
+
+typedef enum {
+    FLOCK_WRAP,             // Leaving one edge re-enters at the opposite one
+    FLOCK_BOUNCE            // Edges reflect the velocity
+} FlockEdges;
+
+// Steering applied once per step. Neighbours are the agents within
+// 'radius'; forces are in world units per step.
+typedef struct {
+    float radius;
+    float separation;       // Push away from each neighbour along the unit offset
+    float alignment;        // Pull toward the neighbours' mean velocity
+    float cohesion;         // Pull toward the neighbours' mean offset
+    float attract_x;        // Point every agent is drawn to with strength
+    float attract_y;        //   attract / (distance + 1)
+    float attract;
+    float friction;         // Velocity kept per step (1: none lost)
+    float max_speed;        // Distance per step (0: unlimited)
+    FlockEdges edges;
+} FlockRules;
+
+typedef struct {
+    int count;
+    int capacity;
+    float width, height;    // World size
+    float* x;
+    float* y;
+    float* vx;
+    float* vy;
+    float* prev_x;          // Positions before the latest step
+    float* prev_y;
+
+    // Spatial hash: agents copied out in grid-cell order each step
+    float cell_size;
+    int grid_w, grid_h;
+    int grid_capacity;
+    int* cell_start;        // grid_w * grid_h + 1 offsets into the sorted agents
+    int* agent_cell;
+    int* sorted_index;
+    float* sorted_x;
+    float* sorted_y;
+    float* sorted_vx;
+    float* sorted_vy;
+
+    unsigned rng;
+} Flock;
+
+// Set the world size and number of agents. Existing agents are kept; new
+// ones start at random positions and headings, up to 'spawn_speed' per
+// step. Returns false if the arrays could not grow.
+bool flock_resize(Flock* flock, int count, float width, float height, float spawn_speed);
+
+// Advance one fixed step: rebuild the hash, steer every agent from the
+// neighbours in the 3x3 cells around it, then integrate. Agents are split
+// over 'pool' (NULL runs on the calling thread).
+void flock_step(Flock* flock, const FlockRules* rules, ThreadPool* pool);
+
+// Agent i 'alpha' of the way through the latest step. An agent that
+// wrapped around during it is placed where it is now.
+void flock_position(const Flock* flock, int i, float alpha, float* x, float* y);
+
+// Release a flock's arrays
+void flock_free(Flock* flock);
+
+#endif // FLOCK_H
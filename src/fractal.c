@@ -0,0 +1,414 @@
+#include "fractal.h"
+#include <float.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FRACTAL_X86 1
+#endif
+
+// Escape radius 16 rather than 2: the few extra iterations make the
+// log-log correction of the smooth count accurate
+#define BAILOUT_SQ 256.0
+
+// Points per kernel call when a row is laid out
+#define ROW_CHUNK 64
+
+// Ulps of margin a cell must span before a precision is trusted
+#define PRECISION_MARGIN 64.0
+
+static inline float smooth_count(int n, double mag_sq) {
+    float smooth = (float)n + 1.0f - log2f(0.5f * logf((float)mag_sq));
+    return smooth > 0.0f ? smooth : 0.0f;
+}
+
+// Lanes record the iteration and |z|^2 at which they escaped (n < 0 if
+// they never did); this turns them into smooth counts
+static inline float lane_result(float n, double mag_sq) {
+    return n < 0.0f ? FRACTAL_INSIDE : smooth_count((int)n, mag_sq);
+}
+
+static float escape_float_scalar(float zr, float zi, float cr, float ci, int max_iter) {
+    for (int n = 0; n < max_iter; n++) {
+        float zr2 = zr * zr, zi2 = zi * zi;
+        if (zr2 + zi2 > (float)BAILOUT_SQ) return smooth_count(n, zr2 + zi2);
+        zi = 2.0f * zr * zi + ci;
+        zr = zr2 - zi2 + cr;
+    }
+    return FRACTAL_INSIDE;
+}
+
+static float escape_double_scalar(double zr, double zi, double cr, double ci, int max_iter) {
+    for (int n = 0; n < max_iter; n++) {
+        double zr2 = zr * zr, zi2 = zi * zi;
+        if (zr2 + zi2 > BAILOUT_SQ) return smooth_count(n, zr2 + zi2);
+        zi = 2.0 * zr * zi + ci;
+        zr = zr2 - zi2 + cr;
+    }
+    return FRACTAL_INSIDE;
+}
+
+// ============= SIMD KERNELS =============
+// Each lane iterates one point. Escaped lanes drop out of the active mask
+// (their z keeps running, harmlessly, to inf/nan) and the group stops as
+// soon as the mask is empty. Kernels return how many points they handled;
+// the caller finishes the tail with the scalar loop.
+
+#ifdef FRACTAL_X86
+static bool cpu_has_avx2(void) {
+    static int cached = -1;
+    if (cached < 0) cached = __builtin_cpu_supports("avx2") ? 1 : 0;
+    return cached;
+}
+
+__attribute__((target("avx2")))
+static int escape_float_avx2(FractalKind kind, const float* re, const float* im, int count,
+                             float c_re, float c_im, int max_iter, float* out) {
+    const __m256 bailout = _mm256_set1_ps((float)BAILOUT_SQ);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 pr = _mm256_loadu_ps(re + i), pi = _mm256_loadu_ps(im + i);
+        __m256 zr = pr, zi = pi, cr = _mm256_set1_ps(c_re), ci = _mm256_set1_ps(c_im);
+        if (kind == FRACTAL_MANDELBROT) {
+            zr = zi = _mm256_setzero_ps();
+            cr = pr;
+            ci = pi;
+        }
+        __m256 active = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        __m256 esc_n = _mm256_set1_ps(-1.0f), esc_mag = _mm256_setzero_ps();
+        __m256 n_vec = _mm256_setzero_ps();
+
+        for (int n = 0; n < max_iter; n++) {
+            __m256 zr2 = _mm256_mul_ps(zr, zr), zi2 = _mm256_mul_ps(zi, zi);
+            __m256 mag = _mm256_add_ps(zr2, zi2);
+            __m256 out_now = _mm256_and_ps(active, _mm256_cmp_ps(mag, bailout, _CMP_GT_OQ));
+            esc_n = _mm256_blendv_ps(esc_n, n_vec, out_now);
+            esc_mag = _mm256_blendv_ps(esc_mag, mag, out_now);
+            active = _mm256_andnot_ps(out_now, active);
+            if (_mm256_movemask_ps(active) == 0) break;
+
+            __m256 zri = _mm256_mul_ps(zr, zi);
+            zi = _mm256_add_ps(_mm256_add_ps(zri, zri), ci);
+            zr = _mm256_add_ps(_mm256_sub_ps(zr2, zi2), cr);
+            n_vec = _mm256_add_ps(n_vec, one);
+        }
+
+        float lane_n[8], lane_mag[8];
+        _mm256_storeu_ps(lane_n, esc_n);
+        _mm256_storeu_ps(lane_mag, esc_mag);
+        for (int l = 0; l < 8; l++) out[i + l] = lane_result(lane_n[l], lane_mag[l]);
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static int escape_double_avx2(FractalKind kind, const double* re, const double* im, int count,
+                              double c_re, double c_im, int max_iter, float* out) {
+    const __m256d bailout = _mm256_set1_pd(BAILOUT_SQ);
+    const __m256d one = _mm256_set1_pd(1.0);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d pr = _mm256_loadu_pd(re + i), pi = _mm256_loadu_pd(im + i);
+        __m256d zr = pr, zi = pi, cr = _mm256_set1_pd(c_re), ci = _mm256_set1_pd(c_im);
+        if (kind == FRACTAL_MANDELBROT) {
+            zr = zi = _mm256_setzero_pd();
+            cr = pr;
+            ci = pi;
+        }
+        __m256d active = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        __m256d esc_n = _mm256_set1_pd(-1.0), esc_mag = _mm256_setzero_pd();
+        __m256d n_vec = _mm256_setzero_pd();
+
+        for (int n = 0; n < max_iter; n++) {
+            __m256d zr2 = _mm256_mul_pd(zr, zr), zi2 = _mm256_mul_pd(zi, zi);
+            __m256d mag = _mm256_add_pd(zr2, zi2);
+            __m256d out_now = _mm256_and_pd(active, _mm256_cmp_pd(mag, bailout, _CMP_GT_OQ));
+            esc_n = _mm256_blendv_pd(esc_n, n_vec, out_now);
+            esc_mag = _mm256_blendv_pd(esc_mag, mag, out_now);
+            active = _mm256_andnot_pd(out_now, active);
+            if (_mm256_movemask_pd(active) == 0) break;
+
+            __m256d zri = _mm256_mul_pd(zr, zi);
+            zi = _mm256_add_pd(_mm256_add_pd(zri, zri), ci);
+            zr = _mm256_add_pd(_mm256_sub_pd(zr2, zi2), cr);
+            n_vec = _mm256_add_pd(n_vec, one);
+        }
+
+        double lane_n[4], lane_mag[4];
+        _mm256_storeu_pd(lane_n, esc_n);
+        _mm256_storeu_pd(lane_mag, esc_mag);
+        for (int l = 0; l < 4; l++) out[i + l] = lane_result((float)lane_n[l], lane_mag[l]);
+    }
+    return i;
+}
+
+// SSE2 has no blendv; select with and/andnot/or
+static inline __m128 select_ps(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128d select_pd(__m128d mask, __m128d a, __m128d b) {
+    return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+}
+
+static int escape_float_sse(FractalKind kind, const float* re, const float* im, int count,
+                            float c_re, float c_im, int max_iter, float* out) {
+    const __m128 bailout = _mm_set1_ps((float)BAILOUT_SQ);
+    const __m128 one = _mm_set1_ps(1.0f);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 pr = _mm_loadu_ps(re + i), pi = _mm_loadu_ps(im + i);
+        __m128 zr = pr, zi = pi, cr = _mm_set1_ps(c_re), ci = _mm_set1_ps(c_im);
+        if (kind == FRACTAL_MANDELBROT) {
+            zr = zi = _mm_setzero_ps();
+            cr = pr;
+            ci = pi;
+        }
+        __m128 active = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        __m128 esc_n = _mm_set1_ps(-1.0f), esc_mag = _mm_setzero_ps();
+        __m128 n_vec = _mm_setzero_ps();
+
+        for (int n = 0; n < max_iter; n++) {
+            __m128 zr2 = _mm_mul_ps(zr, zr), zi2 = _mm_mul_ps(zi, zi);
+            __m128 mag = _mm_add_ps(zr2, zi2);
+            __m128 out_now = _mm_and_ps(active, _mm_cmpgt_ps(mag, bailout));
+            esc_n = select_ps(out_now, n_vec, esc_n);
+            esc_mag = select_ps(out_now, mag, esc_mag);
+            active = _mm_andnot_ps(out_now, active);
+            if (_mm_movemask_ps(active) == 0) break;
+
+            __m128 zri = _mm_mul_ps(zr, zi);
+            zi = _mm_add_ps(_mm_add_ps(zri, zri), ci);
+            zr = _mm_add_ps(_mm_sub_ps(zr2, zi2), cr);
+            n_vec = _mm_add_ps(n_vec, one);
+        }
+
+        float lane_n[4], lane_mag[4];
+        _mm_storeu_ps(lane_n, esc_n);
+        _mm_storeu_ps(lane_mag, esc_mag);
+        for (int l = 0; l < 4; l++) out[i + l] = lane_result(lane_n[l], lane_mag[l]);
+    }
+    return i;
+}
+
+static int escape_double_sse(FractalKind kind, const double* re, const double* im, int count,
+                             double c_re, double c_im, int max_iter, float* out) {
+    const __m128d bailout = _mm_set1_pd(BAILOUT_SQ);
+    const __m128d one = _mm_set1_pd(1.0);
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128d pr = _mm_loadu_pd(re + i), pi = _mm_loadu_pd(im + i);
+        __m128d zr = pr, zi = pi, cr = _mm_set1_pd(c_re), ci = _mm_set1_pd(c_im);
+        if (kind == FRACTAL_MANDELBROT) {
+            zr = zi = _mm_setzero_pd();
+            cr = pr;
+            ci = pi;
+        }
+        __m128d active = _mm_castsi128_pd(_mm_set1_epi32(-1));
+        __m128d esc_n = _mm_set1_pd(-1.0), esc_mag = _mm_setzero_pd();
+        __m128d n_vec = _mm_setzero_pd();
+
+        for (int n = 0; n < max_iter; n++) {
+            __m128d zr2 = _mm_mul_pd(zr, zr), zi2 = _mm_mul_pd(zi, zi);
+            __m128d mag = _mm_add_pd(zr2, zi2);
+            __m128d out_now = _mm_and_pd(active, _mm_cmpgt_pd(mag, bailout));
+            esc_n = select_pd(out_now, n_vec, esc_n);
+            esc_mag = select_pd(out_now, mag, esc_mag);
+            active = _mm_andnot_pd(out_now, active);
+            if (_mm_movemask_pd(active) == 0) break;
+
+            __m128d zri = _mm_mul_pd(zr, zi);
+            zi = _mm_add_pd(_mm_add_pd(zri, zri), ci);
+            zr = _mm_add_pd(_mm_sub_pd(zr2, zi2), cr);
+            n_vec = _mm_add_pd(n_vec, one);
+        }
+
+        double lane_n[2], lane_mag[2];
+        _mm_storeu_pd(lane_n, esc_n);
+        _mm_storeu_pd(lane_mag, esc_mag);
+        for (int l = 0; l < 2; l++) out[i + l] = lane_result((float)lane_n[l], lane_mag[l]);
+    }
+    return i;
+}
+#endif
+
+void fractal_escape_points(FractalKind kind, const float* re, const float* im, int count,
+                           float c_re, float c_im, int max_iter, float* out) {
+    int i = 0;
+#ifdef FRACTAL_X86
+    if (cpu_has_avx2()) {
+        i = escape_float_avx2(kind, re, im, count, c_re, c_im, max_iter, out);
+    } else {
+        i = escape_float_sse(kind, re, im, count, c_re, c_im, max_iter, out);
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] = kind == FRACTAL_JULIA
+            ? escape_float_scalar(re[i], im[i], c_re, c_im, max_iter)
+            : escape_float_scalar(0.0f, 0.0f, re[i], im[i], max_iter);
+    }
+}
+
+static void escape_points_double(FractalKind kind, const double* re, const double* im, int count,
+                                 double c_re, double c_im, int max_iter, float* out) {
+    int i = 0;
+#ifdef FRACTAL_X86
+    if (cpu_has_avx2()) {
+        i = escape_double_avx2(kind, re, im, count, c_re, c_im, max_iter, out);
+    } else {
+        i = escape_double_sse(kind, re, im, count, c_re, c_im, max_iter, out);
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] = kind == FRACTAL_JULIA
+            ? escape_double_scalar(re[i], im[i], c_re, c_im, max_iter)
+            : escape_double_scalar(0.0, 0.0, re[i], im[i], max_iter);
+    }
+}
+
+// ============= PERTURBATION =============
+// Past double precision every cell is iterated as a small delta from one
+// reference orbit computed at the view centre in long double:
+//   z = Z_n + d_n,  d_{n+1} = 2 Z_n d_n + d_n^2 (+ dc for Mandelbrot)
+// The deltas stay representable in double however deep the zoom is. When
+// |z| drops below |d| or the reference runs out, the cell rebases onto the
+// start of the orbit (d = z - Z_0) so the delta never loses its precision.
+
+// Writes Z_0..Z_k as doubles and returns the orbit length
+static int reference_orbit(const FractalView* view, double* ref_re, double* ref_im) {
+    long double zr = view->center_re, zi = view->center_im;
+    long double cr = view->c_re, ci = view->c_im;
+    if (view->kind == FRACTAL_MANDELBROT) {
+        zr = zi = 0.0L;
+        cr = view->center_re;
+        ci = view->center_im;
+    }
+
+    for (int n = 0; n <= view->max_iter; n++) {
+        ref_re[n] = (double)zr;
+        ref_im[n] = (double)zi;
+        long double zr2 = zr * zr, zi2 = zi * zi;
+        if (zr2 + zi2 > BAILOUT_SQ) return n + 1;
+        zi = 2.0L * zr * zi + ci;
+        zr = zr2 - zi2 + cr;
+    }
+    return view->max_iter + 1;
+}
+
+static float escape_perturbed(const FractalView* view, const double* ref_re, const double* ref_im, int ref_len,
+                              double offset_re, double offset_im) {
+    double dr = offset_re, di = offset_im, dcr = 0.0, dci = 0.0;
+    if (view->kind == FRACTAL_MANDELBROT) {
+        dr = di = 0.0;
+        dcr = offset_re;
+        dci = offset_im;
+    }
+
+    int m = 0;
+    for (int n = 0; n < view->max_iter; n++) {
+        double zr = ref_re[m] + dr, zi = ref_im[m] + di;
+        double mag = zr * zr + zi * zi;
+        if (mag > BAILOUT_SQ) return smooth_count(n, mag);
+
+        if (mag < dr * dr + di * di || m + 1 >= ref_len) {
+            dr = zr - ref_re[0];
+            di = zi - ref_im[0];
+            m = 0;
+        }
+
+        double Zr = ref_re[m], Zi = ref_im[m];
+        double ndr = 2.0 * (Zr * dr - Zi * di) + dr * dr - di * di + dcr;
+        double ndi = 2.0 * (Zr * di + Zi * dr) + 2.0 * dr * di + dci;
+        dr = ndr;
+        di = ndi;
+        m++;
+    }
+    return FRACTAL_INSIDE;
+}
+
+// ============= VIEW RENDERING =============
+
+typedef struct {
+    const FractalView* view;
+    FractalPrecision precision;
+    float* out;
+    int width;
+    int height;
+    const double* ref_re;
+    const double* ref_im;
+    int ref_len;
+} FractalJob;
+
+FractalPrecision fractal_precision(const FractalView* view) {
+    // Orbits range over |z| <= 2 whatever the view, so that sets the ulp
+    double magnitude = fmax(fmax(fabs((double)view->center_re), fabs((double)view->center_im)), 2.0);
+    double cell = fmin(view->cell_w, view->cell_h);
+
+    if (cell > magnitude * FLT_EPSILON * PRECISION_MARGIN) return FRACTAL_PRECISION_FLOAT;
+    if (cell > magnitude * DBL_EPSILON * PRECISION_MARGIN) return FRACTAL_PRECISION_DOUBLE;
+    return FRACTAL_PRECISION_PERTURBATION;
+}
+
+static void fractal_render_row(void* ctx, int y) {
+    const FractalJob* job = ctx;
+    const FractalView* view = job->view;
+    float* out = job->out + (size_t)y * job->width;
+    double offset_im = (y - job->height * 0.5) * view->cell_h;
+
+    if (job->precision == FRACTAL_PRECISION_PERTURBATION) {
+        for (int x = 0; x < job->width; x++) {
+            double offset_re = (x - job->width * 0.5) * view->cell_w;
+            out[x] = escape_perturbed(view, job->ref_re, job->ref_im, job->ref_len, offset_re, offset_im);
+        }
+        return;
+    }
+
+    double center_re = (double)view->center_re;
+    double row_im = (double)view->center_im + offset_im;
+
+    for (int x0 = 0; x0 < job->width; x0 += ROW_CHUNK) {
+        int count = job->width - x0 < ROW_CHUNK ? job->width - x0 : ROW_CHUNK;
+
+        if (job->precision == FRACTAL_PRECISION_FLOAT) {
+            float re[ROW_CHUNK], im[ROW_CHUNK];
+            for (int i = 0; i < count; i++) {
+                re[i] = (float)(center_re + (x0 + i - job->width * 0.5) * view->cell_w);
+                im[i] = (float)row_im;
+            }
+            fractal_escape_points(view->kind, re, im, count, (float)view->c_re, (float)view->c_im,
+                                  view->max_iter, out + x0);
+        } else {
+            double re[ROW_CHUNK], im[ROW_CHUNK];
+            for (int i = 0; i < count; i++) {
+                re[i] = center_re + (x0 + i - job->width * 0.5) * view->cell_w;
+                im[i] = row_im;
+            }
+            escape_points_double(view->kind, re, im, count, view->c_re, view->c_im, view->max_iter, out + x0);
+        }
+    }
+}
+
+FractalPrecision fractal_render(const FractalView* view, float* out, int width, int height, ThreadPool* pool) {
+    FractalJob job = { view, fractal_precision(view), out, width, height, NULL, NULL, 0 };
+    double* ref = NULL;
+
+    if (job.precision == FRACTAL_PRECISION_PERTURBATION) {
+        ref = malloc(sizeof(double) * 2 * (view->max_iter + 1));
+        if (ref) {
+            job.ref_re = ref;
+            job.ref_im = ref + view->max_iter + 1;
+            job.ref_len = reference_orbit(view, ref, ref + view->max_iter + 1);
+        }
+        // A centre that escapes at once leaves no orbit to rebase onto
+        if (job.ref_len < 2) {
+            job.precision = FRACTAL_PRECISION_DOUBLE;  // Blocky, but still a picture
+        }
+    }
+
+    thread_pool_run(pool, height, fractal_render_row, &job);
+
+    free(ref);
+    return job.precision;
+}
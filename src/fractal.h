@@ -0,0 +1,44 @@
+#ifndef FRACTAL_H
+#define FRACTAL_H
+
+#include "thread_pool.h"
+
+// Escape-time Julia/Mandelbrot iteration shared by the fractal scenes.
+// Results are smooth (fractional) escape counts, or FRACTAL_INSIDE for
+// points still bounded after max_iter.
+#define FRACTAL_INSIDE -1.0f
+
+typedef enum {
+    FRACTAL_JULIA,          // z starts at the point, c is fixed
+    FRACTAL_MANDELBROT      // z starts at 0, c is the point
+} FractalKind;
+
+typedef enum {
+    FRACTAL_PRECISION_FLOAT,        // 8 AVX2 / 4 SSE lanes
+    FRACTAL_PRECISION_DOUBLE,       // 4 AVX2 / 2 SSE lanes
+    FRACTAL_PRECISION_PERTURBATION  // Long double reference orbit, double deltas
+} FractalPrecision;
+
+// A grid of cells laid over the complex plane
+typedef struct {
+    FractalKind kind;
+    long double center_re, center_im;   // Point under the middle of the grid
+    double cell_w, cell_h;              // Plane size of one cell
+    double c_re, c_im;                  // Julia constant
+    int max_iter;
+} FractalView;
+
+// Cheapest arithmetic that still separates neighbouring cells of the view
+FractalPrecision fractal_precision(const FractalView* view);
+
+// Smooth escape counts for a width x height view into 'out', row-major.
+// Rows are spread over 'pool' (NULL runs on the calling thread). Returns
+// the precision used.
+FractalPrecision fractal_render(const FractalView* view, float* out, int width, int height, ThreadPool* pool);
+
+// Same iteration for an arbitrary list of points in float precision, for
+// scenes that warp the plane before iterating
+void fractal_escape_points(FractalKind kind, const float* re, const float* im, int count,
+                           float c_re, float c_im, int max_iter, float* out);
+
+#endif // FRACTAL_H
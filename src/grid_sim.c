@@ -0,0 +1,238 @@
+#include "grid_sim.h"
+#include <stdlib.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Rows per pool task
+#define GRID_BAND_ROWS 16
+
+// Floats before cell 0 of a row: the halo cell, padded so cell 0 starts a
+// 16-byte block
+#define GRID_LEFT_PAD 4
+
+typedef struct GridJob GridJob;
+typedef void (*GridRowKernel)(const GridJob* job, int y);
+
+struct GridJob {
+    GridSim* sim;
+    GridRowKernel kernel;
+    float a, b, c, d;       // Kernel parameters
+};
+
+bool grid_sim_resize(GridSim* sim, int width, int height, int fields, GridEdges edges) {
+    if (fields < 1) fields = 1;
+    if (fields > GRID_SIM_FIELDS) fields = GRID_SIM_FIELDS;
+    if (width < 1) width = 1;
+    if (height < 1) height = 1;
+    sim->edges = edges;
+    if (width == sim->width && height == sim->height && fields == sim->fields) return true;
+
+    // Rows round up to whole SIMD blocks, plus the right halo cell's block
+    int stride = GRID_LEFT_PAD + (width + 3) / 4 * 4 + 4;
+    int plane_size = stride * (height + 2);
+    // Every allocated plane holds 'capacity' floats, so a field added later can't come up short
+    int capacity = plane_size > sim->plane_size ? plane_size : sim->plane_size;
+    for (int f = 0; f < GRID_SIM_FIELDS; f++) {
+        for (int p = 0; p < 2; p++) {
+            if (f >= fields) {
+                free(sim->planes[f][p]);
+                sim->planes[f][p] = NULL;
+                continue;
+            }
+            if (capacity > sim->plane_size || !sim->planes[f][p]) {
+                float* grown = realloc(sim->planes[f][p], sizeof(float) * capacity);
+                if (!grown) {
+                    grid_sim_free(sim);
+                    return false;
+                }
+                sim->planes[f][p] = grown;
+            }
+            memset(sim->planes[f][p], 0, sizeof(float) * plane_size);
+        }
+        sim->front[f] = sim->planes[f][0] ? sim->planes[f][0] + stride + GRID_LEFT_PAD : NULL;
+        sim->back[f] = sim->planes[f][1] ? sim->planes[f][1] + stride + GRID_LEFT_PAD : NULL;
+    }
+    sim->plane_size = capacity;
+
+    sim->width = width;
+    sim->height = height;
+    sim->stride = stride;
+    sim->fields = fields;
+    sim->cleared = true;
+    return true;
+}
+
+// Fill a front plane's halo from its edge cells. Columns go first so the
+// halo rows pick up the corners.
+static void grid_fill_halo(GridSim* sim, int field) {
+    int w = sim->width, h = sim->height;
+    float* top = grid_sim_row(sim, field, -1) - 1;
+    float* bottom = grid_sim_row(sim, field, h) - 1;
+
+    for (int y = 0; y < h; y++) {
+        float* row = grid_sim_row(sim, field, y);
+        switch (sim->edges) {
+            case GRID_EDGE_ZERO: row[-1] = row[w] = 0.0f; break;
+            case GRID_EDGE_CLAMP: row[-1] = row[0]; row[w] = row[w - 1]; break;
+            case GRID_EDGE_WRAP: row[-1] = row[w - 1]; row[w] = row[0]; break;
+        }
+    }
+
+    size_t bytes = sizeof(float) * (w + 2);
+    switch (sim->edges) {
+        case GRID_EDGE_ZERO:
+            memset(top, 0, bytes);
+            memset(bottom, 0, bytes);
+            break;
+        case GRID_EDGE_CLAMP:
+            memcpy(top, grid_sim_row(sim, field, 0) - 1, bytes);
+            memcpy(bottom, grid_sim_row(sim, field, h - 1) - 1, bytes);
+            break;
+        case GRID_EDGE_WRAP:
+            memcpy(top, grid_sim_row(sim, field, h - 1) - 1, bytes);
+            memcpy(bottom, grid_sim_row(sim, field, 0) - 1, bytes);
+            break;
+    }
+}
+
+static void grid_band(void* ctx, int band) {
+    const GridJob* job = ctx;
+    int end = (band + 1) * GRID_BAND_ROWS;
+    if (end > job->sim->height) end = job->sim->height;
+    for (int y = band * GRID_BAND_ROWS; y < end; y++) {
+        job->kernel(job, y);
+    }
+}
+
+// One step: refresh the halos, write every row of the back planes, swap
+static void grid_step(GridJob* job, ThreadPool* pool) {
+    GridSim* sim = job->sim;
+    if (!sim->front[0]) return;
+    for (int f = 0; f < sim->fields; f++) {
+        grid_fill_halo(sim, f);
+    }
+
+    int bands = (sim->height + GRID_BAND_ROWS - 1) / GRID_BAND_ROWS;
+    thread_pool_run(pool, bands, grid_band, job);
+
+    for (int f = 0; f < sim->fields; f++) {
+        float* swap = sim->front[f];
+        sim->front[f] = sim->back[f];
+        sim->back[f] = swap;
+    }
+}
+
+static void fire_row(const GridJob* job, int y) {
+    GridSim* sim = job->sim;
+    const float* below = sim->front[0] + (y + 1) * sim->stride;
+    float* out = sim->back[0] + y * sim->stride;
+    float k = job->a / 3.0f;
+    int x = 0;
+
+#ifdef __SSE2__
+    const __m128 vk = _mm_set1_ps(k);
+    for (; x + 4 <= sim->width; x += 4) {
+        __m128 sum = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(below + x - 1), _mm_loadu_ps(below + x)),
+                                _mm_loadu_ps(below + x + 1));
+        _mm_storeu_ps(out + x, _mm_mul_ps(sum, vk));
+    }
+#endif
+
+    for (; x < sim->width; x++) {
+        out[x] = (below[x - 1] + below[x] + below[x + 1]) * k;
+    }
+}
+
+void grid_sim_fire(GridSim* sim, float cooling, ThreadPool* pool) {
+    GridJob job = { sim, fire_row, cooling };
+    grid_step(&job, pool);
+}
+
+// The back plane holds the state one step older than the front, and each
+// cell only reads its own old value, so the new state overwrites it in place
+static void ripple_row(const GridJob* job, int y) {
+    GridSim* sim = job->sim;
+    const float* row = sim->front[0] + y * sim->stride;
+    const float* up = row - sim->stride;
+    const float* down = row + sim->stride;
+    float* out = sim->back[0] + y * sim->stride;
+    float damping = job->a;
+    int x = 0;
+
+#ifdef __SSE2__
+    const __m128 vd = _mm_set1_ps(damping), half = _mm_set1_ps(0.5f);
+    for (; x + 4 <= sim->width; x += 4) {
+        __m128 sum = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(row + x - 1), _mm_loadu_ps(row + x + 1)),
+                                _mm_add_ps(_mm_loadu_ps(up + x), _mm_loadu_ps(down + x)));
+        __m128 next = _mm_sub_ps(_mm_mul_ps(sum, half), _mm_loadu_ps(out + x));
+        _mm_storeu_ps(out + x, _mm_mul_ps(next, vd));
+    }
+#endif
+
+    for (; x < sim->width; x++) {
+        float sum = row[x - 1] + row[x + 1] + up[x] + down[x];
+        out[x] = (sum * 0.5f - out[x]) * damping;
+    }
+}
+
+void grid_sim_ripple(GridSim* sim, float damping, ThreadPool* pool) {
+    GridJob job = { sim, ripple_row, damping };
+    grid_step(&job, pool);
+}
+
+static void gray_scott_row(const GridJob* job, int y) {
+    GridSim* sim = job->sim;
+    int stride = sim->stride;
+    const float* u = sim->front[0] + y * stride;
+    const float* v = sim->front[1] + y * stride;
+    float* out_u = sim->back[0] + y * stride;
+    float* out_v = sim->back[1] + y * stride;
+    float feed = job->a, kill = job->b, du = job->c, dv = job->d;
+    int x = 0;
+
+#ifdef __SSE2__
+    const __m128 vfeed = _mm_set1_ps(feed), vloss = _mm_set1_ps(feed + kill);
+    const __m128 vdu = _mm_set1_ps(du), vdv = _mm_set1_ps(dv);
+    const __m128 four = _mm_set1_ps(4.0f), one = _mm_set1_ps(1.0f);
+    for (; x + 4 <= sim->width; x += 4) {
+        __m128 cu = _mm_loadu_ps(u + x), cv = _mm_loadu_ps(v + x);
+        __m128 lap_u = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(u + x - 1), _mm_loadu_ps(u + x + 1)),
+                                  _mm_add_ps(_mm_loadu_ps(u + x - stride), _mm_loadu_ps(u + x + stride)));
+        __m128 lap_v = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(v + x - 1), _mm_loadu_ps(v + x + 1)),
+                                  _mm_add_ps(_mm_loadu_ps(v + x - stride), _mm_loadu_ps(v + x + stride)));
+        lap_u = _mm_sub_ps(lap_u, _mm_mul_ps(cu, four));
+        lap_v = _mm_sub_ps(lap_v, _mm_mul_ps(cv, four));
+        __m128 uvv = _mm_mul_ps(cu, _mm_mul_ps(cv, cv));
+        __m128 nu = _mm_add_ps(cu, _mm_sub_ps(_mm_mul_ps(vdu, lap_u), uvv));
+        nu = _mm_add_ps(nu, _mm_mul_ps(vfeed, _mm_sub_ps(one, cu)));
+        __m128 nv = _mm_add_ps(cv, _mm_add_ps(_mm_mul_ps(vdv, lap_v), uvv));
+        nv = _mm_sub_ps(nv, _mm_mul_ps(vloss, cv));
+        _mm_storeu_ps(out_u + x, nu);
+        _mm_storeu_ps(out_v + x, nv);
+    }
+#endif
+
+    for (; x < sim->width; x++) {
+        float lap_u = u[x - 1] + u[x + 1] + u[x - stride] + u[x + stride] - 4.0f * u[x];
+        float lap_v = v[x - 1] + v[x + 1] + v[x - stride] + v[x + stride] - 4.0f * v[x];
+        float uvv = u[x] * v[x] * v[x];
+        out_u[x] = u[x] + du * lap_u - uvv + feed * (1.0f - u[x]);
+        out_v[x] = v[x] + dv * lap_v + uvv - (feed + kill) * v[x];
+    }
+}
+
+void grid_sim_gray_scott(GridSim* sim, float feed, float kill, float diffuse_u, float diffuse_v, ThreadPool* pool) {
+    if (sim->fields < 2) return;
+    GridJob job = { sim, gray_scott_row, feed, kill, diffuse_u, diffuse_v };
+    grid_step(&job, pool);
+}
+
+void grid_sim_free(GridSim* sim) {
+    for (int f = 0; f < GRID_SIM_FIELDS; f++) {
+        free(sim->planes[f][0]);
+        free(sim->planes[f][1]);
+    }
+    memset(sim, 0, sizeof(*sim));
+}
@@ -0,0 +1,65 @@
+#ifndef GRID_SIM_H
+#define GRID_SIM_H
+
+#include <stdbool.h>
+#include "thread_pool.h"
+
+// Cellular simulations over a float grid the size of the deck: fire,
+// ripples and reaction-diffusion. Each field is double buffered in
+// row-major planes with a one-cell halo, so a step reads whole rows of the
+// front plane, writes the back plane, and swaps. After a step the back
+// plane holds the state before it, which scenes blend toward to draw
+// between steps.
+#define GRID_SIM_FIELDS 2
+
+typedef enum {
+    GRID_EDGE_ZERO,         // Cells beyond the edges read as 0
+    GRID_EDGE_CLAMP,        // ...as the nearest edge cell
+    GRID_EDGE_WRAP          // ...as the cell on the opposite edge
+} GridEdges;
+
+typedef struct {
+    int width, height;
+    int stride;             // Floats per row, halo and padding included
+    int fields;
+    GridEdges edges;
+    bool cleared;           // Set when a resize clears the grid; the scene seeds it and resets this
+    float* front[GRID_SIM_FIELDS];  // Cell (0, 0) of each field's current plane
+    float* back[GRID_SIM_FIELDS];   // ...and of the plane before the latest step
+    float* planes[GRID_SIM_FIELDS][2];
+    int plane_size;         // Floats allocated per plane
+} GridSim;
+
+// Size the grid to width x height with 'fields' fields (1 or 2). A grid
+// that changes size is cleared to 0 and flagged 'cleared'. Returns false
+// if the planes could not be allocated.
+bool grid_sim_resize(GridSim* sim, int width, int height, int fields, GridEdges edges);
+
+// Row y of a field's current state, or of the state before the latest
+// step. Indices -1 and width are the halo.
+static inline float* grid_sim_row(GridSim* sim, int field, int y) {
+    return sim->front[field] + y * sim->stride;
+}
+
+static inline float* grid_sim_prev_row(GridSim* sim, int field, int y) {
+    return sim->back[field] + y * sim->stride;
+}
+
+// The steps below split the rows into bands over 'pool' (NULL runs on the
+// calling thread).
+
+// Heat rises: each cell becomes the mean of the three cells below it,
+// times 'cooling'
+void grid_sim_fire(GridSim* sim, float cooling, ThreadPool* pool);
+
+// Wave equation on field 0 with the previous state as the second time
+// level; 'damping' is the amplitude kept per step
+void grid_sim_ripple(GridSim* sim, float damping, ThreadPool* pool);
+
+// Gray-Scott reaction-diffusion of u (field 0) and v (field 1)
+void grid_sim_gray_scott(GridSim* sim, float feed, float kill, float diffuse_u, float diffuse_v, ThreadPool* pool);
+
+// Release a grid's planes
+void grid_sim_free(GridSim* sim);
+
+#endif // GRID_SIM_H
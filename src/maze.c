@@ -0,0 +1,75 @@
+#include "maze.h"
+
+void maze_size(int plane_width, int plane_height, int* width, int* height) {
+    *width = (plane_width - 4) / 4;
+    *height = (plane_height - 2) / 2;
+    if (*width > MAZE_MAX_CELLS) *width = MAZE_MAX_CELLS;
+    if (*height > MAZE_MAX_CELLS) *height = MAZE_MAX_CELLS;
+}
+
+void maze_generate(Maze* maze, int plane_width, int plane_height, int seed) {
+    int width, height;
+    maze_size(plane_width, plane_height, &width, &height);
+    if (maze->seed == seed && maze->width == width && maze->height == height) return;
+    maze->seed = seed;
+    maze->width = width;
+    maze->height = height;
+
+    // Walls everywhere
+    for (int y = 0; y < MAZE_MAX_CELLS; y++) {
+        for (int x = 0; x < MAZE_MAX_CELLS; x++) {
+            maze->h_walls[y][x] = true;
+            maze->v_walls[y][x] = true;
+            maze->visited[y][x] = false;
+        }
+    }
+    if (width < 1 || height < 1) return;
+
+    // Start from the centre and knock walls out along a seeded walk
+    maze->visited[height / 2][width / 2] = true;
+    for (int i = 0; i < width * height / 2; i++) {
+        int x = (seed * 73 + i * 31) % width;
+        int y = (seed * 97 + i * 43) % height;
+        if (x <= 0 || x >= width - 1 || y <= 0 || y >= height - 1) continue;
+
+        maze->visited[y][x] = true;
+        switch ((seed + i) % 4) {
+            case 0: maze->h_walls[y][x] = false; break;
+            case 1: maze->v_walls[y][x] = false; break;
+            case 2: maze->h_walls[y + 1][x] = false; break;
+            case 3: maze->v_walls[y][x - 1] = false; break;
+        }
+    }
+}
+
+void maze_draw(const Maze* maze, char* buffer, int width, int height, int path_length) {
+    for (int my = 0; my < maze->height; my++) {
+        for (int mx = 0; mx < maze->width; mx++) {
+            int x_base = mx * 4 + 2;
+            int y_base = my * 2 + 1;
+            if (x_base >= width - 2 || y_base >= height - 1) continue;
+
+            if (maze->h_walls[my][mx]) {
+                for (int i = 0; i < 3; i++) {
+                    buffer[y_base * width + x_base + i] = '=';
+                }
+            }
+            if (maze->v_walls[my][mx]) {
+                buffer[(y_base + 1) * width + x_base - 1] = '|';
+            }
+            buffer[y_base * width + x_base - 1] = '+';
+        }
+    }
+
+    // Solution path, stepping a cell at a time in seeded directions
+    int px = 2, py = 1;
+    for (int step = 0; step < path_length && px < width - 3 && py < height - 2; step++) {
+        buffer[py * width + px] = '*';
+        switch ((step + maze->seed) % 4) {
+            case 0: if (py < height - 3) py += 2; break;
+            case 1: if (px < width - 5) px += 4; break;
+            case 2: if (py > 3) py -= 2; break;
+            case 3: if (px > 5) px -= 4; break;
+        }
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef MAZE_H
+#define MAZE_H
+
+#include <stdbool.h>
+
+// Maze for the Maze Generator scene. Each maze cell is drawn 4 characters
+// wide and 2 tall; the wall grids are fixed, so a plane larger than
+// MAZE_MAX_CELLS cells (a big terminal at 2x render scale) draws the maze
+// at its largest size in the top-left corner.
+#define MAZE_MAX_CELLS 50
+
+typedef struct {
+    int width, height;      // Cells in use, at most MAZE_MAX_CELLS each
+    int seed;               // -1 until the first generation
+    bool h_walls[MAZE_MAX_CELLS][MAZE_MAX_CELLS];   // Wall above each cell
+    bool v_walls[MAZE_MAX_CELLS][MAZE_MAX_CELLS];   // Wall left of each cell
+    bool visited[MAZE_MAX_CELLS][MAZE_MAX_CELLS];
+} Maze;
+
+// Cells a plane has room for, clamped to the wall grids. Planes too small
+// for a 5x5 maze give less than 5 on an axis.
+void maze_size(int plane_width, int plane_height, int* width, int* height);
+
+// Carve the maze for a plane and seed. Does nothing if neither the size
+// nor the seed has changed since the last call.
+void maze_generate(Maze* maze, int plane_width, int plane_height, int seed);
+
+// Draw the walls, then a solution path 'path_length' steps long
+void maze_draw(const Maze* maze, char* buffer, int width, int height, int path_length);
+
+#endif // MAZE_H
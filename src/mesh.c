@@ -0,0 +1,429 @@
+#include "mesh.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Capacity the first reserve takes
+#define MESH_MIN_CAPACITY 64
+
+static const float tetrahedron_vertices[] = {
+    1, 1, 1,  1, -1, -1,  -1, 1, -1,  -1, -1, 1
+};
+static const unsigned short tetrahedron_edges[] = {
+    0, 1, 0, 2, 0, 3, 1, 2, 1, 3, 2, 3
+};
+static const unsigned short tetrahedron_triangles[] = {
+    2, 0, 1, 1, 0, 3, 3, 0, 2, 2, 1, 3
+};
+
+static const float cube_vertices[] = {
+    -1, -1, -1,  1, -1, -1,  1, 1, -1,  -1, 1, -1,
+    -1, -1, 1,   1, -1, 1,   1, 1, 1,   -1, 1, 1
+};
+static const unsigned short cube_edges[] = {
+    0, 1, 1, 2, 2, 3, 3, 0, 4, 5, 5, 6, 6, 7, 7, 4, 0, 4, 1, 5, 2, 6, 3, 7
+};
+static const unsigned short cube_triangles[] = {
+    1, 0, 3, 1, 3, 2, 4, 0, 1, 4, 1, 5, 3, 0, 4, 3, 4, 7,
+    5, 1, 2, 5, 2, 6, 6, 2, 3, 6, 3, 7, 7, 4, 5, 7, 5, 6
+};
+
+static const float octahedron_vertices[] = {
+    1, 0, 0,  -1, 0, 0,  0, 1, 0,  0, -1, 0,  0, 0, 1,  0, 0, -1
+};
+static const unsigned short octahedron_edges[] = {
+    0, 2, 0, 3, 0, 4, 0, 5, 1, 2, 1, 3, 1, 4, 1, 5, 2, 4, 2, 5, 3, 4, 3, 5
+};
+static const unsigned short octahedron_triangles[] = {
+    4, 0, 2, 2, 0, 5, 3, 0, 4, 5, 0, 3, 2, 1, 4, 5, 1, 2,
+    4, 1, 3, 3, 1, 5
+};
+
+// Cyclic permutations of (0, +-1, +-phi)
+static const float icosahedron_vertices[] = {
+    0, -1, -1.618034f,  -1, -1.618034f, 0,  -1.618034f, 0, -1,
+    0, -1, 1.618034f,   -1, 1.618034f, 0,   1.618034f, 0, -1,
+    0, 1, -1.618034f,   1, -1.618034f, 0,   -1.618034f, 0, 1,
+    0, 1, 1.618034f,    1, 1.618034f, 0,    1.618034f, 0, 1
+};
+static const unsigned short icosahedron_edges[] = {
+    0, 1, 0, 2, 0, 5, 0, 6, 0, 7, 1, 2, 1, 3, 1, 7, 1, 8, 2, 4,
+    2, 6, 2, 8, 3, 7, 3, 8, 3, 9, 3, 11, 4, 6, 4, 8, 4, 9, 4, 10,
+    5, 6, 5, 7, 5, 10, 5, 11, 6, 10, 7, 11, 8, 9, 9, 10, 9, 11, 10, 11
+};
+static const unsigned short icosahedron_triangles[] = {
+    2, 0, 1, 1, 0, 7, 6, 0, 2, 5, 0, 6, 7, 0, 5, 2, 1, 8,
+    3, 1, 7, 8, 1, 3, 6, 2, 4, 4, 2, 8, 11, 3, 7, 8, 3, 9,
+    9, 3, 11, 6, 4, 10, 9, 4, 8, 10, 4, 9, 10, 5, 6, 7, 5, 11,
+    11, 5, 10, 10, 9, 11
+};
+
+// Cube corners plus cyclic permutations of (0, +-1/phi, +-phi)
+static const float dodecahedron_vertices[] = {
+    -1, -1, -1,  -1, -1, 1,  -1, 1, -1,  -1, 1, 1,
+    1, -1, -1,   1, -1, 1,   1, 1, -1,   1, 1, 1,
+    0, -0.618034f, -1.618034f,  -0.618034f, -1.618034f, 0,  -1.618034f, 0, -0.618034f,
+    0, -0.618034f, 1.618034f,   -0.618034f, 1.618034f, 0,   1.618034f, 0, -0.618034f,
+    0, 0.618034f, -1.618034f,   0.618034f, -1.618034f, 0,   -1.618034f, 0, 0.618034f,
+    0, 0.618034f, 1.618034f,    0.618034f, 1.618034f, 0,    1.618034f, 0, 0.618034f
+};
+static const unsigned short dodecahedron_edges[] = {
+    0, 8, 0, 9, 0, 10, 1, 9, 1, 11, 1, 16, 2, 10, 2, 12, 2, 14, 3, 12,
+    3, 16, 3, 17, 4, 8, 4, 13, 4, 15, 5, 11, 5, 15, 5, 19, 6, 13, 6, 14,
+    6, 18, 7, 17, 7, 18, 7, 19, 8, 14, 9, 15, 10, 16, 11, 17, 12, 18, 13, 19
+};
+static const unsigned short dodecahedron_triangles[] = {
+    16, 10, 0, 16, 0, 9, 16, 9, 1, 14, 8, 0, 14, 0, 10, 14, 10, 2,
+    15, 9, 0, 15, 0, 8, 15, 8, 4, 3, 16, 1, 3, 1, 11, 3, 11, 17,
+    5, 11, 1, 5, 1, 9, 5, 9, 15, 3, 12, 2, 3, 2, 10, 3, 10, 16,
+    6, 14, 2, 6, 2, 12, 6, 12, 18, 18, 12, 3, 18, 3, 17, 18, 17, 7,
+    5, 15, 4, 5, 4, 13, 5, 13, 19, 6, 13, 4, 6, 4, 8, 6, 8, 14,
+    17, 11, 5, 17, 5, 19, 17, 19, 7, 19, 13, 6, 19, 6, 18, 19, 18, 7
+};
+
+#define STATIC_MESH(name) \
+    { name##_vertices, sizeof(name##_vertices) / (3 * sizeof(float)), \
+      name##_edges, sizeof(name##_edges) / (2 * sizeof(unsigned short)), \
+      name##_triangles, sizeof(name##_triangles) / (3 * sizeof(unsigned short)), NULL }
+
+const Mesh mesh_tetrahedron = STATIC_MESH(tetrahedron);
+const Mesh mesh_cube = STATIC_MESH(cube);
+const Mesh mesh_octahedron = STATIC_MESH(octahedron);
+const Mesh mesh_icosahedron = STATIC_MESH(icosahedron);
+const Mesh mesh_dodecahedron = STATIC_MESH(dodecahedron);
+
+Mat4 mat4_identity(void) {
+    Mat4 m = { { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } } };
+    return m;
+}
+
+Mat4 mat4_translation(float x, float y, float z) {
+    Mat4 m = mat4_identity();
+    m.m[0][3] = x;
+    m.m[1][3] = y;
+    m.m[2][3] = z;
+    return m;
+}
+
+Mat4 mat4_scaling(float x, float y, float z) {
+    Mat4 m = mat4_identity();
+    m.m[0][0] = x;
+    m.m[1][1] = y;
+    m.m[2][2] = z;
+    return m;
+}
+
+Mat4 mat4_rotation_x(float angle) {
+    Mat4 m = mat4_identity();
+    float c = cosf(angle), s = sinf(angle);
+    m.m[1][1] = c; m.m[1][2] = -s;
+    m.m[2][1] = s; m.m[2][2] = c;
+    return m;
+}
+
+Mat4 mat4_rotation_y(float angle) {
+    Mat4 m = mat4_identity();
+    float c = cosf(angle), s = sinf(angle);
+    m.m[0][0] = c; m.m[0][2] = -s;
+    m.m[2][0] = s; m.m[2][2] = c;
+    return m;
+}
+
+Mat4 mat4_rotation_z(float angle) {
+    Mat4 m = mat4_identity();
+    float c = cosf(angle), s = sinf(angle);
+    m.m[0][0] = c; m.m[0][1] = -s;
+    m.m[1][0] = s; m.m[1][1] = c;
+    return m;
+}
+
+Mat4 mat4_rotation(float angle_x, float angle_y, float angle_z) {
+    Mat4 x = mat4_rotation_x(angle_x), y = mat4_rotation_y(angle_y), z = mat4_rotation_z(angle_z);
+    Mat4 yz = mat4_multiply(&y, &z);
+    return mat4_multiply(&x, &yz);
+}
+
+Mat4 mat4_multiply(const Mat4* a, const Mat4* b) {
+    Mat4 m;
+    for (int r = 0; r < 4; r++) {
+        for (int c = 0; c < 4; c++) {
+            m.m[r][c] = a->m[r][0] * b->m[0][c] + a->m[r][1] * b->m[1][c] +
+                        a->m[r][2] * b->m[2][c] + a->m[r][3] * b->m[3][c];
+        }
+    }
+    return m;
+}
+
+MeshCamera mesh_camera(int width, int height, float focal) {
+    MeshCamera camera = { width * 0.5f, height * 0.5f, focal, 0.1f };
+    return camera;
+}
+
+Mesh mesh_buffer_mesh(const MeshBuffer* buffer) {
+    Mesh mesh = { buffer->vertices, buffer->vertex_count, buffer->edges, buffer->edge_count,
+                  buffer->triangles, buffer->triangle_count, NULL };
+    return mesh;
+}
+
+static bool grow_array(void** array, int count, size_t element) {
+    void* grown = realloc(*array, element * count);
+    if (!grown) return false;
+    *array = grown;
+    return true;
+}
+
+bool mesh_buffer_reserve(MeshBuffer* buffer, int vertices, int edges, int triangles) {
+    if (vertices > buffer->vertex_capacity) {
+        if (!grow_array((void**)&buffer->vertices, vertices, 3 * sizeof(float))) return false;
+        buffer->vertex_capacity = vertices;
+    }
+    if (edges > buffer->edge_capacity) {
+        if (!grow_array((void**)&buffer->edges, edges, 2 * sizeof(unsigned short))) return false;
+        buffer->edge_capacity = edges;
+    }
+    if (triangles > buffer->triangle_capacity) {
+        if (!grow_array((void**)&buffer->triangles, triangles, 3 * sizeof(unsigned short))) return false;
+        buffer->triangle_capacity = triangles;
+    }
+    return true;
+}
+
+static void add_vertex(MeshBuffer* buffer, float x, float y, float z) {
+    float* v = buffer->vertices + 3 * buffer->vertex_count++;
+    v[0] = x;
+    v[1] = y;
+    v[2] = z;
+}
+
+static void add_edge(MeshBuffer* buffer, int a, int b) {
+    unsigned short* e = buffer->edges + 2 * buffer->edge_count++;
+    e[0] = (unsigned short)a;
+    e[1] = (unsigned short)b;
+}
+
+static void add_triangle(MeshBuffer* buffer, int a, int b, int c) {
+    unsigned short* t = buffer->triangles + 3 * buffer->triangle_count++;
+    t[0] = (unsigned short)a;
+    t[1] = (unsigned short)b;
+    t[2] = (unsigned short)c;
+}
+
+bool mesh_build_torus(MeshBuffer* buffer, float major_radius, float minor_radius,
+                      int major_segments, int minor_segments) {
+    int vertices = major_segments * minor_segments;
+    if (vertices > 65536 || !mesh_buffer_reserve(buffer, vertices, 2 * vertices, 2 * vertices)) return false;
+    buffer->vertex_count = 0;
+    buffer->edge_count = 0;
+    buffer->triangle_count = 0;
+
+    for (int i = 0; i < major_segments; i++) {
+        float theta = (float)i / major_segments * 2.0f * (float)M_PI;
+        for (int j = 0; j < minor_segments; j++) {
+            float phi = (float)j / minor_segments * 2.0f * (float)M_PI;
+            float ring = major_radius + minor_radius * cosf(phi);
+            add_vertex(buffer, ring * cosf(theta), minor_radius * sinf(phi), ring * sinf(theta));
+            int here = i * minor_segments + j;
+            int next_j = i * minor_segments + (j + 1) % minor_segments;
+            int next_i = ((i + 1) % major_segments) * minor_segments + j;
+            int next_both = ((i + 1) % major_segments) * minor_segments + (j + 1) % minor_segments;
+            add_edge(buffer, here, next_j);
+            add_edge(buffer, here, next_i);
+            add_triangle(buffer, here, next_j, next_both);
+            add_triangle(buffer, here, next_both, next_i);
+        }
+    }
+    return true;
+}
+
+bool mesh_build_sphere(MeshBuffer* buffer, float radius, int meridians, int segments) {
+    int vertices = meridians * (segments + 1);
+    if (vertices > 65536 || !mesh_buffer_reserve(buffer, vertices, meridians * segments, 0)) return false;
+    buffer->vertex_count = 0;
+    buffer->edge_count = 0;
+    buffer->triangle_count = 0;
+
+    for (int m = 0; m < meridians; m++) {
+        float longitude = (float)m / meridians * 2.0f * (float)M_PI;
+        for (int s = 0; s <= segments; s++) {
+            float t = (float)s / segments * (float)M_PI;
+            add_vertex(buffer, radius * sinf(t) * cosf(longitude), radius * cosf(t), radius * sinf(t) * sinf(longitude));
+            if (s > 0) add_edge(buffer, buffer->vertex_count - 2, buffer->vertex_count - 1);
+        }
+    }
+    return true;
+}
+
+void mesh_buffer_free(MeshBuffer* buffer) {
+    free(buffer->vertices);
+    free(buffer->edges);
+    free(buffer->triangles);
+    memset(buffer, 0, sizeof(*buffer));
+}
+
+bool mesh_view_reserve(MeshView* view, int count) {
+    if (count <= view->capacity) {
+        view->count = count;
+        return true;
+    }
+    int capacity = view->capacity * 2;
+    if (capacity < MESH_MIN_CAPACITY) capacity = MESH_MIN_CAPACITY;
+    if (capacity < count) capacity = count;
+
+    float** arrays[] = { &view->x, &view->y, &view->z, &view->screen_x, &view->screen_y };
+    for (size_t i = 0; i < sizeof(arrays) / sizeof(arrays[0]); i++) {
+        if (!grow_array((void**)arrays[i], capacity, sizeof(float))) return false;
+    }
+    view->capacity = capacity;
+    view->count = count;
+    return true;
+}
+
+void mesh_project(MeshView* view, const MeshCamera* camera) {
+    float focal_y = camera->focal / MESH_CELL_ASPECT;
+    int i = 0;
+
+#ifdef __SSE2__
+    const __m128 center_x = _mm_set1_ps(camera->center_x), center_y = _mm_set1_ps(camera->center_y);
+    const __m128 fx = _mm_set1_ps(camera->focal), fy = _mm_set1_ps(focal_y);
+    const __m128 near = _mm_set1_ps(camera->near), one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= view->count; i += 4) {
+        // Clamped so vertices behind the camera divide safely; callers skip them
+        __m128 inv_z = _mm_div_ps(one, _mm_max_ps(_mm_loadu_ps(view->z + i), near));
+        _mm_storeu_ps(view->screen_x + i, _mm_add_ps(center_x, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(view->x + i), fx), inv_z)));
+        _mm_storeu_ps(view->screen_y + i, _mm_add_ps(center_y, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(view->y + i), fy), inv_z)));
+    }
+#endif
+
+    for (; i < view->count; i++) {
+        float inv_z = 1.0f / fmaxf(view->z[i], camera->near);
+        view->screen_x[i] = camera->center_x + view->x[i] * camera->focal * inv_z;
+        view->screen_y[i] = camera->center_y + view->y[i] * focal_y * inv_z;
+    }
+}
+
+bool mesh_transform(const Mesh* mesh, const Mat4* matrix, const MeshCamera* camera, MeshView* view) {
+    if (!mesh_view_reserve(view, mesh->vertex_count)) return false;
+    const float (*m)[4] = matrix->m;
+    const float* v = mesh->vertices;
+    int i = 0;
+
+#ifdef __SSE2__
+    __m128 row[3][4];
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 4; c++) row[r][c] = _mm_set1_ps(m[r][c]);
+    }
+    for (; i + 4 <= mesh->vertex_count; i += 4) {
+        const float* p = v + 3 * i;
+        __m128 x = _mm_setr_ps(p[0], p[3], p[6], p[9]);
+        __m128 y = _mm_setr_ps(p[1], p[4], p[7], p[10]);
+        __m128 z = _mm_setr_ps(p[2], p[5], p[8], p[11]);
+        float* out[3] = { view->x + i, view->y + i, view->z + i };
+        for (int r = 0; r < 3; r++) {
+            __m128 sum = _mm_add_ps(_mm_mul_ps(row[r][0], x), _mm_mul_ps(row[r][1], y));
+            sum = _mm_add_ps(sum, _mm_add_ps(_mm_mul_ps(row[r][2], z), row[r][3]));
+            _mm_storeu_ps(out[r], sum);
+        }
+    }
+#endif
+
+    for (; i < mesh->vertex_count; i++) {
+        const float* p = v + 3 * i;
+        view->x[i] = m[0][0] * p[0] + m[0][1] * p[1] + m[0][2] * p[2] + m[0][3];
+        view->y[i] = m[1][0] * p[0] + m[1][1] * p[1] + m[1][2] * p[2] + m[1][3];
+        view->z[i] = m[2][0] * p[0] + m[2][1] * p[1] + m[2][2] * p[2] + m[2][3];
+    }
+    mesh_project(view, camera);
+    return true;
+}
+
+// Narrow t0..t1 to where p * t <= q. Returns false once nothing is left.
+static bool clip_edge(float p, float q, float* t0, float* t1) {
+    if (p == 0.0f) return q >= 0.0f;
+    float t = q / p;
+    if (p < 0.0f) {
+        if (t > *t1) return false;
+        if (t > *t0) *t0 = t;
+    } else {
+        if (t < *t0) return false;
+        if (t < *t1) *t1 = t;
+    }
+    return true;
+}
+
+// Rasterize a screen-space segment, interpolating 1/z, which is linear on
+// screen, so depth stays correct along foreshortened edges
+static void draw_segment(float x0, float y0, float inv_z0, float x1, float y1, float inv_z1, char glyph,
+                         char* buffer, float* zbuffer, int width, int height) {
+    // Clip to the cells whose centres round onto the screen
+    float dx = x1 - x0, dy = y1 - y0;
+    float t0 = 0.0f, t1 = 1.0f;
+    float max_x = width - 0.501f, max_y = height - 0.501f;
+    if (!clip_edge(-dx, x0 + 0.5f, &t0, &t1) || !clip_edge(dx, max_x - x0, &t0, &t1) ||
+        !clip_edge(-dy, y0 + 0.5f, &t0, &t1) || !clip_edge(dy, max_y - y0, &t0, &t1)) {
+        return;
+    }
+    float sx = x0 + dx * t0, sy = y0 + dy * t0, sw = inv_z0 + (inv_z1 - inv_z0) * t0;
+    float ex = x0 + dx * t1, ey = y0 + dy * t1, ew = inv_z0 + (inv_z1 - inv_z0) * t1;
+
+    int steps = (int)ceilf(fmaxf(fabsf(ex - sx), fabsf(ey - sy)));
+    float step_x = 0.0f, step_y = 0.0f, step_w = 0.0f;
+    if (steps > 0) {
+        step_x = (ex - sx) / steps;
+        step_y = (ey - sy) / steps;
+        step_w = (ew - sw) / steps;
+    }
+    for (int i = 0; i <= steps; i++) {
+        int x = (int)floorf(sx + step_x * i + 0.5f);
+        int y = (int)floorf(sy + step_y * i + 0.5f);
+        if (x < 0 || x >= width || y < 0 || y >= height) continue;
+        float z = 1.0f / (sw + step_w * i);
+        int idx = y * width + x;
+        if (z < zbuffer[idx]) {
+            buffer[idx] = glyph;
+            zbuffer[idx] = z;
+        }
+    }
+}
+
+void mesh_draw_edges(const Mesh* mesh, const MeshView* view, const MeshCamera* camera, char glyph,
+                     char* buffer, float* zbuffer, int width, int height) {
+    float near = camera->near;
+    float focal_y = camera->focal / MESH_CELL_ASPECT;
+
+    for (int e = 0; e < mesh->edge_count; e++) {
+        int a = mesh->edges[2 * e], b = mesh->edges[2 * e + 1];
+        float za = view->z[a], zb = view->z[b];
+        if (za < near && zb < near) continue;
+        char c = mesh->edge_glyphs ? mesh->edge_glyphs[e] : glyph;
+
+        float x0 = view->screen_x[a], y0 = view->screen_y[a];
+        float x1 = view->screen_x[b], y1 = view->screen_y[b];
+        if (za < near || zb < near) {
+            // Cut the edge where it crosses the near plane and project the cut
+            int behind = za < near ? a : b, front = za < near ? b : a;
+            float t = (near - view->z[behind]) / (view->z[front] - view->z[behind]);
+            float cx = view->x[behind] + (view->x[front] - view->x[behind]) * t;
+            float cy = view->y[behind] + (view->y[front] - view->y[behind]) * t;
+            float px = camera->center_x + cx * camera->focal / near;
+            float py = camera->center_y + cy * focal_y / near;
+            if (behind == a) {
+                x0 = px; y0 = py; za = near;
+            } else {
+                x1 = px; y1 = py; zb = near;
+            }
+        }
+        draw_segment(x0, y0, 1.0f / za, x1, y1, 1.0f / zb, c, buffer, zbuffer, width, height);
+    }
+}
+
+void mesh_view_free(MeshView* view) {
+    free(view->x);
+    free(view->y);
+    free(view->z);
+    free(view->screen_x);
+    free(view->screen_y);
+    memset(view, 0, sizeof(*view));
+}
@@ -0,0 +1,128 @@
+#ifndef MESH_H
+#define MESH_H
+
+#include <stdbool.h>
+
+// Shared 3D pipeline for the mesh scenes. A scene builds one affine
+// matrix per frame, mesh_transform moves every vertex into camera space
+// and projects it four at a time, and mesh_draw_edges clips each edge to
+// the near plane and the screen and rasterizes it with perspective-correct
+// depth. Projection accounts for terminal cells being taller than wide, so
+// a mesh keeps its proportions on screen.
+#define MESH_CELL_ASPECT 2.0f   // Cell height over cell width
+
+// Affine transform applied to column vectors: p' = m * p
+typedef struct {
+    float m[4][4];
+} Mat4;
+
+// Vertices, edges and faces, usually static data or a MeshBuffer's arrays
+typedef struct {
+    const float* vertices;          // x, y, z per vertex
+    int vertex_count;
+    const unsigned short* edges;    // Vertex index pairs
+    int edge_count;
+    const unsigned short* triangles;    // Vertex index triples, counter-clockwise seen from outside
+    int triangle_count;
+    const char* edge_glyphs;        // One per edge (NULL: the glyph mesh_draw_edges is given)
+} Mesh;
+
+// Arrays for meshes generated at run time
+typedef struct {
+    float* vertices;
+    int vertex_count;
+    int vertex_capacity;
+    unsigned short* edges;
+    int edge_count;
+    int edge_capacity;
+    unsigned short* triangles;
+    int triangle_count;
+    int triangle_capacity;
+} MeshBuffer;
+
+typedef struct {
+    float center_x, center_y;   // Screen position of the optical axis
+    float focal;                // Columns per unit of x at depth 1; rows get focal / MESH_CELL_ASPECT
+    float near;                 // Nearest depth drawn
+} MeshCamera;
+
+// Transformed vertices in structure-of-arrays layout
+typedef struct {
+    int count;
+    int capacity;
+    float* x;                   // Camera space, looking down +z
+    float* y;
+    float* z;
+    float* screen_x;            // Projected position, valid where z >= the camera's near
+    float* screen_y;
+} MeshView;
+
+// Platonic solids centred on the origin: the cube spans -1..1, the
+// octahedron and tetrahedron have vertices on the unit axes and cube
+// corners, the icosahedron and dodecahedron circumradii of about 1.9 and 1.7
+extern const Mesh mesh_tetrahedron;
+extern const Mesh mesh_cube;
+extern const Mesh mesh_octahedron;
+extern const Mesh mesh_icosahedron;
+extern const Mesh mesh_dodecahedron;
+
+Mat4 mat4_identity(void);
+Mat4 mat4_translation(float x, float y, float z);
+Mat4 mat4_scaling(float x, float y, float z);
+// Rotations by 'angle' radians: x turns y toward z, y turns x toward -z,
+// z turns x toward y
+Mat4 mat4_rotation_x(float angle);
+Mat4 mat4_rotation_y(float angle);
+Mat4 mat4_rotation_z(float angle);
+// Rotation about z, then y, then x
+Mat4 mat4_rotation(float angle_x, float angle_y, float angle_z);
+// a * b: applies b, then a
+Mat4 mat4_multiply(const Mat4* a, const Mat4* b);
+
+// Camera centred on the screen with the near plane at 0.1
+MeshCamera mesh_camera(int width, int height, float focal);
+
+// A MeshBuffer's contents as a Mesh
+Mesh mesh_buffer_mesh(const MeshBuffer* buffer);
+
+// Torus around the y axis, 'major_segments' rings of 'minor_segments'
+// vertices each; vertex i * minor_segments + j is point j of ring i, and
+// edges join each vertex to the next around its ring and across rings,
+// with two triangles to each quad they enclose. Returns false if the
+// arrays could not grow.
+bool mesh_build_torus(MeshBuffer* buffer, float major_radius, float minor_radius,
+                      int major_segments, int minor_segments);
+
+// Sphere of 'meridians' half circles from pole to pole, evenly spaced in
+// longitude, each of 'segments' edges, and no faces. Returns false if the
+// arrays could not grow.
+bool mesh_build_sphere(MeshBuffer* buffer, float radius, int meridians, int segments);
+
+// Make room for 'vertices' vertices, 'edges' edges and 'triangles'
+// triangles, for scenes that fill a buffer themselves. Returns false if
+// the arrays could not grow.
+bool mesh_buffer_reserve(MeshBuffer* buffer, int vertices, int edges, int triangles);
+
+// Release a buffer's arrays
+void mesh_buffer_free(MeshBuffer* buffer);
+
+// Transform every vertex of 'mesh' by 'matrix' into 'view' and project it
+// through 'camera'. Returns false if the view could not grow.
+bool mesh_transform(const Mesh* mesh, const Mat4* matrix, const MeshCamera* camera, MeshView* view);
+
+// Project a view whose camera-space arrays were filled by the caller
+void mesh_project(MeshView* view, const MeshCamera* camera);
+
+// Size the view to 'count' vertices. Returns false if the arrays could not
+// grow.
+bool mesh_view_reserve(MeshView* view, int count);
+
+// Draw the edges of 'mesh' at the positions in 'view', keeping the nearer
+// glyph where the depth buffer already has one
+void mesh_draw_edges(const Mesh* mesh, const MeshView* view, const MeshCamera* camera, char glyph,
+                     char* buffer, float* zbuffer, int width, int height);
+
+// Release a view's arrays
+void mesh_view_free(MeshView* view);
+
+#endif // MESH_H
@@ -0,0 +1,212 @@
+#include "particles.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Capacity the first emit reserves
+#define PARTICLES_MIN_CAPACITY 256
+
+float particles_random(ParticlePool* pool) {
+    if (pool->rng == 0) pool->rng = 0x9E3779B9u;
+    pool->rng = pool->rng * 1664525u + 1013904223u;
+    return (pool->rng >> 8) / 16777216.0f;
+}
+
+static bool grow_array(void** array, int count, size_t element) {
+    void* grown = realloc(*array, element * count);
+    if (!grown) return false;
+    *array = grown;
+    return true;
+}
+
+// Grow to hold 'needed' particles, doubling so steady emission doesn't realloc every step
+static bool particles_reserve(ParticlePool* pool, int needed) {
+    if (needed <= pool->capacity) return true;
+    int capacity = pool->capacity * 2;
+    if (capacity < PARTICLES_MIN_CAPACITY) capacity = PARTICLES_MIN_CAPACITY;
+    if (capacity < needed) capacity = needed;
+    if (capacity > PARTICLES_MAX) capacity = PARTICLES_MAX;
+
+    float** floats[] = { &pool->x, &pool->y, &pool->vx, &pool->vy, &pool->prev_x, &pool->prev_y,
+                         &pool->age, &pool->life };
+    for (size_t i = 0; i < sizeof(floats) / sizeof(floats[0]); i++) {
+        if (!grow_array((void**)floats[i], capacity, sizeof(float))) return false;
+    }
+    if (!grow_array((void**)&pool->kind, capacity, 1)) return false;
+    pool->capacity = capacity;
+    return true;
+}
+
+int particles_emit(ParticlePool* pool, const ParticleEmitter* emitter, int n) {
+    if (n > PARTICLES_MAX - pool->count) n = PARTICLES_MAX - pool->count;
+    if (n <= 0) return 0;
+    if (!particles_reserve(pool, pool->count + n)) return 0;
+
+    int kind = emitter->kind < 0 ? 0 : emitter->kind >= PARTICLE_KINDS ? PARTICLE_KINDS - 1 : emitter->kind;
+    for (int k = 0; k < n; k++) {
+        int i = pool->count + k;
+        float heading = particles_random(pool) * 2.0f * (float)M_PI;
+        float speed = emitter->speed_min + particles_random(pool) * (emitter->speed_max - emitter->speed_min);
+        pool->x[i] = pool->prev_x[i] = emitter->x + (particles_random(pool) * 2.0f - 1.0f) * emitter->spread_x;
+        pool->y[i] = pool->prev_y[i] = emitter->y + (particles_random(pool) * 2.0f - 1.0f) * emitter->spread_y;
+        pool->vx[i] = emitter->vx + cosf(heading) * speed;
+        pool->vy[i] = emitter->vy + sinf(heading) * speed * emitter->aspect_y;
+        pool->age[i] = 0.0f;
+        pool->life[i] = emitter->life + particles_random(pool) * emitter->life_spread;
+        pool->kind[i] = (unsigned char)kind;
+    }
+    pool->count += n;
+    return n;
+}
+
+// Move particle 'from' into slot 'to'
+static void particles_move(ParticlePool* pool, int to, int from) {
+    pool->x[to] = pool->x[from];
+    pool->y[to] = pool->y[from];
+    pool->vx[to] = pool->vx[from];
+    pool->vy[to] = pool->vy[from];
+    pool->prev_x[to] = pool->prev_x[from];
+    pool->prev_y[to] = pool->prev_y[from];
+    pool->age[to] = pool->age[from];
+    pool->life[to] = pool->life[from];
+    pool->kind[to] = pool->kind[from];
+}
+
+void particles_step(ParticlePool* pool, const ParticleForces* forces) {
+    int count = pool->count;
+    int i = 0;
+
+#ifdef __SSE2__
+    const __m128 gx = _mm_set1_ps(forces->gravity_x), gy = _mm_set1_ps(forces->gravity_y);
+    const __m128 drag = _mm_set1_ps(forces->drag), one = _mm_set1_ps(1.0f);
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(pool->x + i), y = _mm_loadu_ps(pool->y + i);
+        __m128 vx = _mm_add_ps(_mm_loadu_ps(pool->vx + i), gx);
+        __m128 vy = _mm_add_ps(_mm_loadu_ps(pool->vy + i), gy);
+        _mm_storeu_ps(pool->prev_x + i, x);
+        _mm_storeu_ps(pool->prev_y + i, y);
+        _mm_storeu_ps(pool->x + i, _mm_add_ps(x, vx));
+        _mm_storeu_ps(pool->y + i, _mm_add_ps(y, vy));
+        _mm_storeu_ps(pool->vx + i, _mm_mul_ps(vx, drag));
+        _mm_storeu_ps(pool->vy + i, _mm_mul_ps(vy, drag));
+        _mm_storeu_ps(pool->age + i, _mm_add_ps(_mm_loadu_ps(pool->age + i), one));
+    }
+#endif
+
+    for (; i < count; i++) {
+        float vx = pool->vx[i] + forces->gravity_x;
+        float vy = pool->vy[i] + forces->gravity_y;
+        pool->prev_x[i] = pool->x[i];
+        pool->prev_y[i] = pool->y[i];
+        pool->x[i] += vx;
+        pool->y[i] += vy;
+        pool->vx[i] = vx * forces->drag;
+        pool->vy[i] = vy * forces->drag;
+        pool->age[i] += 1.0f;
+    }
+
+    // Edges and recycling. A dead particle takes the last live one's slot,
+    // which is then checked in its place.
+    float w = forces->width, h = forces->height;
+    i = 0;
+    while (i < count) {
+        float x = pool->x[i], y = pool->y[i];
+        bool dead = pool->age[i] >= pool->life[i];
+
+        if (forces->edges == PARTICLES_KILL) {
+            dead = dead || x < 0.0f || x >= w || y >= h;
+        } else if (forces->edges == PARTICLES_WRAP && (x < 0.0f || x >= w || y < 0.0f || y >= h)) {
+            x -= floorf(x / w) * w;
+            y -= floorf(y / h) * h;
+            // Rounding can land exactly on the far edge
+            pool->x[i] = pool->prev_x[i] = x < w ? x : 0.0f;
+            pool->y[i] = pool->prev_y[i] = y < h ? y : 0.0f;
+        }
+
+        if (dead) {
+            particles_move(pool, i, --count);
+        } else {
+            i++;
+        }
+    }
+    pool->count = count;
+}
+
+void particles_position(const ParticlePool* pool, int i, float alpha, float* x, float* y) {
+    *x = pool->prev_x[i] + (pool->x[i] - pool->prev_x[i]) * alpha;
+    *y = pool->prev_y[i] + (pool->y[i] - pool->prev_y[i]) * alpha;
+}
+
+static inline void splat_glyph(char* buffer, float* zbuffer, int width, int height, float x, float y, char c, float z) {
+    if (x < 0.0f || y < 0.0f) return;
+    int cx = (int)x, cy = (int)y;
+    if (cx >= width || cy >= height) return;
+    int idx = cy * width + cx;
+    if (z < zbuffer[idx]) {
+        buffer[idx] = c;
+        zbuffer[idx] = z;
+    }
+}
+
+void particles_splat(const ParticlePool* pool, const ParticleStyle* style, float alpha,
+                     char* buffer, float* zbuffer, int width, int height) {
+    int ramp_len[PARTICLE_KINDS], trail_len[PARTICLE_KINDS];
+    for (int k = 0; k < PARTICLE_KINDS; k++) {
+        ramp_len[k] = style->ramp[k] ? (int)strlen(style->ramp[k]) : 0;
+        trail_len[k] = style->trail[k] ? (int)strlen(style->trail[k]) : 0;
+    }
+    float trail_speed2 = style->trail_speed * style->trail_speed;
+
+    for (int i = 0; i < pool->count; i++) {
+        int kind = pool->kind[i];
+        if (ramp_len[kind] == 0) continue;
+
+        // Infinite lives stay on the first glyph
+        float t = fminf(pool->age[i] / pool->life[i], 1.0f);
+        int g = (int)(t * ramp_len[kind]);
+        if (g >= ramp_len[kind]) g = ramp_len[kind] - 1;
+        char c = style->ramp[kind][g];
+        if (c == ' ') continue;
+
+        float x, y;
+        particles_position(pool, i, alpha, &x, &y);
+        float z = style->depth + style->depth_fade * t;
+        splat_glyph(buffer, zbuffer, width, height, x, y, c, z);
+
+        if (trail_len[kind] > 0) {
+            float vx = pool->vx[i], vy = pool->vy[i];
+            float speed2 = vx * vx + vy * vy;
+            if (speed2 > trail_speed2 && speed2 > 0.0f) {
+                float inv = 1.0f / sqrtf(speed2);
+                for (int k = 0; k < trail_len[kind]; k++) {
+                    if (style->trail[kind][k] == ' ') continue;
+                    float back = (float)(k + 1);
+                    splat_glyph(buffer, zbuffer, width, height, x - vx * inv * back, y - vy * inv * back,
+                                style->trail[kind][k], z + 0.5f);
+                }
+            }
+        }
+    }
+}
+
+void particles_trim(ParticlePool* pool, int count) {
+    if (count < 0) count = 0;
+    if (count < pool->count) pool->count = count;
+}
+
+void particles_free(ParticlePool* pool) {
+    free(pool->x);
+    free(pool->y);
+    free(pool->vx);
+    free(pool->vy);
+    free(pool->prev_x);
+    free(pool->prev_y);
+    free(pool->age);
+    free(pool->life);
+    free(pool->kind);
+    memset(pool, 0, sizeof(*pool));
+}
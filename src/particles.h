@@ -0,0 +1,96 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include <stdbool.h>
+
+// Particle pools for the rain, smoke, spark and burst scenes. Particles
+// live in structure-of-arrays layout so a step integrates four at a time,
+// and a particle that dies is replaced by the last live one, keeping the
+// live particles packed at the front.
+#define PARTICLES_MAX 65536
+#define PARTICLE_KINDS 4    // Tags a scene can give its particles to style them apart
+
+typedef enum {
+    PARTICLES_FREE,         // Particles only die of age
+    PARTICLES_WRAP,         // Leaving one edge re-enters at the opposite one
+    PARTICLES_KILL          // Leaving the sides or bottom kills; above the top is allowed
+                            //   so emitters can spawn there
+} ParticleEdges;
+
+// Where and how new particles start. Lengths are in cells, times in steps.
+typedef struct {
+    float x, y;             // Spawn area centre
+    float spread_x;         // Half size of the spawn area
+    float spread_y;
+    float vx, vy;           // Base velocity
+    float speed_min;        // Plus a random direction at a speed in this range
+    float speed_max;
+    float aspect_y;         // Scales the vertical part of that random velocity
+    float life;             // Steps a particle lives (INFINITY: until the edges kill it)
+    float life_spread;      // Plus up to this many more
+    int kind;               // Tag, 0..PARTICLE_KINDS-1
+} ParticleEmitter;
+
+// Forces for one step
+typedef struct {
+    float gravity_x;        // Added to every velocity
+    float gravity_y;
+    float drag;             // Velocity kept per step (1: none lost)
+    ParticleEdges edges;
+    float width, height;    // World size the edges apply to
+} ParticleForces;
+
+// How particles are drawn into a character plane
+typedef struct {
+    const char* ramp[PARTICLE_KINDS];   // Glyphs over each kind's life, first to last;
+                                        //   ' ' draws nothing, NULL skips the kind
+    const char* trail[PARTICLE_KINDS];  // Glyphs behind the particle, one cell apart along
+                                        //   its direction of travel (NULL: no trail)
+    float trail_speed;      // Speed per step below which no trail is drawn
+    float depth;            // Depth at birth
+    float depth_fade;       // Added to the depth over a particle's life
+} ParticleStyle;
+
+typedef struct {
+    int count;
+    int capacity;
+    float* x;
+    float* y;
+    float* vx;
+    float* vy;
+    float* prev_x;          // Positions before the latest step
+    float* prev_y;
+    float* age;             // Steps lived
+    float* life;
+    unsigned char* kind;
+    unsigned rng;
+} ParticlePool;
+
+// Uniform 0..1 from the pool's own generator
+float particles_random(ParticlePool* pool);
+
+// Spawn up to 'n' particles from 'emitter', as many as fit under
+// PARTICLES_MAX. Returns the number spawned (fewer if the arrays could
+// not grow).
+int particles_emit(ParticlePool* pool, const ParticleEmitter* emitter, int n);
+
+// Advance one fixed step: apply the forces, move, age, and recycle the
+// particles that died of age or left through a killing edge
+void particles_step(ParticlePool* pool, const ParticleForces* forces);
+
+// Particle i 'alpha' of the way through the latest step. A particle that
+// wrapped around during it is placed where it is now.
+void particles_position(const ParticlePool* pool, int i, float alpha, float* x, float* y);
+
+// Draw every live particle 'alpha' of the way through the latest step,
+// keeping the nearer glyph where the depth buffer already has one
+void particles_splat(const ParticlePool* pool, const ParticleStyle* style, float alpha,
+                     char* buffer, float* zbuffer, int width, int height);
+
+// Kill all but the first 'count' particles
+void particles_trim(ParticlePool* pool, int count);
+
+// Release a pool's arrays
+void particles_free(ParticlePool* pool);
+
+#endif // PARTICLES_H
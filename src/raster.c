@@ -0,0 +1,309 @@
+#include "raster.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Capacity the first queue reserves
+#define RASTER_MIN_CAPACITY 256
+
+typedef struct {
+    Rasterizer* raster;
+    char* buffer;
+    float* zbuffer;
+    int tiles_x;
+} RasterJob;
+
+// A triangle corner while it is being clipped: camera space plus shade
+typedef struct {
+    float x, y, z;
+    float shade;
+} RasterCorner;
+
+static bool grow_array(void** array, int count, size_t element) {
+    void* grown = realloc(*array, element * count);
+    if (!grown) return false;
+    *array = grown;
+    return true;
+}
+
+void raster_begin(Rasterizer* raster, int width, int height) {
+    raster->width = width;
+    raster->height = height;
+    raster->count = 0;
+}
+
+static float lambert(const float normal[3], const float light[3], float ambient) {
+    float length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+    if (length <= 0.0f) return ambient;
+    float facing = (normal[0] * light[0] + normal[1] * light[1] + normal[2] * light[2]) / length;
+    return ambient + (1.0f - ambient) * fmaxf(facing, 0.0f);
+}
+
+// Queue a screen-space triangle, wound so its edge functions are positive
+// inside
+static bool emit_triangle(Rasterizer* raster, const float* x, const float* y, const float* inv_z,
+                          const float* shade, const char* ramp, int ramp_last) {
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+    if (fabsf(area) < 1e-6f) return true;
+
+    int min_x = (int)ceilf(fminf(x[0], fminf(x[1], x[2])));
+    int max_x = (int)floorf(fmaxf(x[0], fmaxf(x[1], x[2])));
+    int min_y = (int)ceilf(fminf(y[0], fminf(y[1], y[2])));
+    int max_y = (int)floorf(fmaxf(y[0], fmaxf(y[1], y[2])));
+    if (min_x < 0) min_x = 0;
+    if (min_y < 0) min_y = 0;
+    if (max_x > raster->width - 1) max_x = raster->width - 1;
+    if (max_y > raster->height - 1) max_y = raster->height - 1;
+    if (min_x > max_x || min_y > max_y) return true;
+
+    if (raster->count == raster->capacity) {
+        int capacity = raster->capacity < RASTER_MIN_CAPACITY ? RASTER_MIN_CAPACITY : raster->capacity * 2;
+        if (!grow_array((void**)&raster->triangles, capacity, sizeof(RasterTriangle))) return false;
+        raster->capacity = capacity;
+    }
+    RasterTriangle* t = &raster->triangles[raster->count++];
+    int order[3] = { 0, 1, 2 };
+    if (area < 0.0f) {
+        order[1] = 2;
+        order[2] = 1;
+    }
+    for (int i = 0; i < 3; i++) {
+        t->x[i] = x[order[i]];
+        t->y[i] = y[order[i]];
+        t->inv_z[i] = inv_z[order[i]];
+        t->shade[i] = shade[order[i]];
+    }
+    t->ramp = ramp;
+    t->ramp_last = ramp_last;
+    t->min_x = min_x;
+    t->min_y = min_y;
+    t->max_x = max_x;
+    t->max_y = max_y;
+    return true;
+}
+
+// Clip a triangle to the near plane, project what is left and queue it as
+// one or two triangles
+static bool emit_clipped(Rasterizer* raster, const RasterCorner* corners, const MeshCamera* camera,
+                         const char* ramp, int ramp_last) {
+    RasterCorner kept[4];
+    int n = 0;
+    for (int i = 0; i < 3; i++) {
+        const RasterCorner* a = &corners[i];
+        const RasterCorner* b = &corners[(i + 1) % 3];
+        bool a_in = a->z >= camera->near, b_in = b->z >= camera->near;
+        if (a_in) kept[n++] = *a;
+        if (a_in != b_in) {
+            float t = (camera->near - a->z) / (b->z - a->z);
+            kept[n].x = a->x + (b->x - a->x) * t;
+            kept[n].y = a->y + (b->y - a->y) * t;
+            kept[n].z = camera->near;
+            kept[n].shade = a->shade + (b->shade - a->shade) * t;
+            n++;
+        }
+    }
+
+    float x[4], y[4], inv_z[4], shade[4];
+    float focal_y = camera->focal / MESH_CELL_ASPECT;
+    for (int i = 0; i < n; i++) {
+        inv_z[i] = 1.0f / kept[i].z;
+        x[i] = camera->center_x + kept[i].x * camera->focal * inv_z[i];
+        y[i] = camera->center_y + kept[i].y * focal_y * inv_z[i];
+        shade[i] = kept[i].shade;
+    }
+    for (int i = 1; i + 1 < n; i++) {
+        float fx[3] = { x[0], x[i], x[i + 1] }, fy[3] = { y[0], y[i], y[i + 1] };
+        float fz[3] = { inv_z[0], inv_z[i], inv_z[i + 1] }, fs[3] = { shade[0], shade[i], shade[i + 1] };
+        if (!emit_triangle(raster, fx, fy, fz, fs, ramp, ramp_last)) return false;
+    }
+    return true;
+}
+
+bool raster_add_mesh(Rasterizer* raster, const Mesh* mesh, const MeshView* view, const MeshCamera* camera,
+                     const RasterStyle* style) {
+    int ramp_last = (int)strlen(style->ramp) - 1;
+    if (!mesh->triangles || ramp_last < 0) return true;
+
+    float light[3] = { style->light[0], style->light[1], style->light[2] };
+    float light_length = sqrtf(light[0] * light[0] + light[1] * light[1] + light[2] * light[2]);
+    if (light_length > 0.0f) {
+        for (int i = 0; i < 3; i++) light[i] /= light_length;
+    }
+
+    // Smooth shading lights each vertex by the area-weighted mean of the
+    // normals of the faces around it
+    bool smooth = style->shading == RASTER_SMOOTH;
+    if (smooth) {
+        if (3 * mesh->vertex_count > raster->normal_capacity) {
+            if (!grow_array((void**)&raster->normals, 3 * mesh->vertex_count, sizeof(float))) return false;
+            raster->normal_capacity = 3 * mesh->vertex_count;
+        }
+        memset(raster->normals, 0, sizeof(float) * 3 * mesh->vertex_count);
+    }
+
+    for (int pass = smooth ? 0 : 1; pass < 2; pass++) {
+        for (int t = 0; t < mesh->triangle_count; t++) {
+            const unsigned short* index = mesh->triangles + 3 * t;
+            RasterCorner corners[3];
+            for (int i = 0; i < 3; i++) {
+                corners[i].x = view->x[index[i]];
+                corners[i].y = view->y[index[i]];
+                corners[i].z = view->z[index[i]];
+            }
+            float ux = corners[1].x - corners[0].x, uy = corners[1].y - corners[0].y, uz = corners[1].z - corners[0].z;
+            float vx = corners[2].x - corners[0].x, vy = corners[2].y - corners[0].y, vz = corners[2].z - corners[0].z;
+            float normal[3] = { uy * vz - uz * vy, uz * vx - ux * vz, ux * vy - uy * vx };
+
+            if (pass == 0) {
+                for (int i = 0; i < 3; i++) {
+                    float* vertex_normal = raster->normals + 3 * index[i];
+                    vertex_normal[0] += normal[0];
+                    vertex_normal[1] += normal[1];
+                    vertex_normal[2] += normal[2];
+                }
+                continue;
+            }
+
+            if (corners[0].z < camera->near && corners[1].z < camera->near && corners[2].z < camera->near) continue;
+            // The camera sits at the origin, so a face whose normal points
+            // away from the first corner's ray is seen from behind
+            bool front = normal[0] * corners[0].x + normal[1] * corners[0].y + normal[2] * corners[0].z < 0.0f;
+            if (!front && style->cull_back) continue;
+            // An open mesh shows its back faces lit from that side
+            float side = front ? 1.0f : -1.0f;
+
+            if (smooth) {
+                for (int i = 0; i < 3; i++) {
+                    const float* n = raster->normals + 3 * index[i];
+                    float facing[3] = { n[0] * side, n[1] * side, n[2] * side };
+                    corners[i].shade = lambert(facing, light, style->ambient);
+                }
+            } else {
+                float facing[3] = { normal[0] * side, normal[1] * side, normal[2] * side };
+                corners[0].shade = corners[1].shade = corners[2].shade = lambert(facing, light, style->ambient);
+            }
+
+            bool clipped = corners[0].z < camera->near || corners[1].z < camera->near || corners[2].z < camera->near;
+            if (clipped) {
+                if (!emit_clipped(raster, corners, camera, style->ramp, ramp_last)) return false;
+            } else {
+                float x[3], y[3], inv_z[3], shade[3];
+                for (int i = 0; i < 3; i++) {
+                    x[i] = view->screen_x[index[i]];
+                    y[i] = view->screen_y[index[i]];
+                    inv_z[i] = 1.0f / corners[i].z;
+                    shade[i] = corners[i].shade;
+                }
+                if (!emit_triangle(raster, x, y, inv_z, shade, style->ramp, ramp_last)) return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void raster_tile(void* ctx, int tile) {
+    const RasterJob* job = ctx;
+    const Rasterizer* raster = job->raster;
+    int tile_x0 = (tile % job->tiles_x) * RASTER_TILE_WIDTH;
+    int tile_y0 = (tile / job->tiles_x) * RASTER_TILE_HEIGHT;
+    int tile_x1 = tile_x0 + RASTER_TILE_WIDTH - 1, tile_y1 = tile_y0 + RASTER_TILE_HEIGHT - 1;
+    if (tile_x1 > raster->width - 1) tile_x1 = raster->width - 1;
+    if (tile_y1 > raster->height - 1) tile_y1 = raster->height - 1;
+
+    for (int k = raster->tile_start[tile]; k < raster->tile_start[tile + 1]; k++) {
+        const RasterTriangle* t = &raster->triangles[raster->tile_items[k]];
+        int x0 = t->min_x > tile_x0 ? t->min_x : tile_x0, x1 = t->max_x < tile_x1 ? t->max_x : tile_x1;
+        int y0 = t->min_y > tile_y0 ? t->min_y : tile_y0, y1 = t->max_y < tile_y1 ? t->max_y : tile_y1;
+
+        // Edge i is opposite corner i; its function is that corner's
+        // barycentric weight times twice the area
+        float step_x[3], step_y[3], origin[3];
+        for (int i = 0; i < 3; i++) {
+            int a = (i + 1) % 3, b = (i + 2) % 3;
+            step_x[i] = -(t->y[b] - t->y[a]);
+            step_y[i] = t->x[b] - t->x[a];
+            origin[i] = step_x[i] * (x0 - t->x[a]) + step_y[i] * (y0 - t->y[a]);
+        }
+        float inv_area = 1.0f / (origin[0] + origin[1] + origin[2]);
+        bool flat = t->shade[0] == t->shade[1] && t->shade[1] == t->shade[2];
+        char flat_glyph = t->ramp[(int)(t->shade[0] * t->ramp_last + 0.5f)];
+
+        for (int y = y0; y <= y1; y++) {
+            float e0 = origin[0], e1 = origin[1], e2 = origin[2];
+            char* row = job->buffer + y * raster->width;
+            float* depth = job->zbuffer + y * raster->width;
+            for (int x = x0; x <= x1; x++) {
+                if (e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f) {
+                    float w0 = e0 * inv_area, w1 = e1 * inv_area, w2 = e2 * inv_area;
+                    float z = 1.0f / (w0 * t->inv_z[0] + w1 * t->inv_z[1] + w2 * t->inv_z[2]);
+                    if (z < depth[x]) {
+                        depth[x] = z;
+                        if (flat) {
+                            row[x] = flat_glyph;
+                        } else {
+                            float shade = w0 * t->shade[0] + w1 * t->shade[1] + w2 * t->shade[2];
+                            int level = (int)(shade * t->ramp_last + 0.5f);
+                            row[x] = t->ramp[level < 0 ? 0 : level > t->ramp_last ? t->ramp_last : level];
+                        }
+                    }
+                }
+                e0 += step_x[0];
+                e1 += step_x[1];
+                e2 += step_x[2];
+            }
+            for (int i = 0; i < 3; i++) origin[i] += step_y[i];
+        }
+    }
+}
+
+void raster_flush(Rasterizer* raster, char* buffer, float* zbuffer, ThreadPool* pool) {
+    if (raster->count == 0) return;
+    int tiles_x = (raster->width + RASTER_TILE_WIDTH - 1) / RASTER_TILE_WIDTH;
+    int tiles_y = (raster->height + RASTER_TILE_HEIGHT - 1) / RASTER_TILE_HEIGHT;
+    int tiles = tiles_x * tiles_y;
+
+    // Starts, then a fill cursor per tile
+    if (2 * tiles + 1 > raster->tile_capacity) {
+        if (!grow_array((void**)&raster->tile_start, 2 * tiles + 1, sizeof(int))) return;
+        raster->tile_capacity = 2 * tiles + 1;
+    }
+    int* start = raster->tile_start;
+    int* cursor = start + tiles + 1;
+    memset(start, 0, sizeof(int) * (tiles + 1));
+    for (int i = 0; i < raster->count; i++) {
+        const RasterTriangle* t = &raster->triangles[i];
+        for (int ty = t->min_y / RASTER_TILE_HEIGHT; ty <= t->max_y / RASTER_TILE_HEIGHT; ty++) {
+            for (int tx = t->min_x / RASTER_TILE_WIDTH; tx <= t->max_x / RASTER_TILE_WIDTH; tx++) {
+                start[ty * tiles_x + tx + 1]++;
+            }
+        }
+    }
+    for (int i = 0; i < tiles; i++) {
+        start[i + 1] += start[i];
+        cursor[i] = start[i];
+    }
+    if (start[tiles] > raster->item_capacity) {
+        if (!grow_array((void**)&raster->tile_items, start[tiles], sizeof(int))) return;
+        raster->item_capacity = start[tiles];
+    }
+    for (int i = 0; i < raster->count; i++) {
+        const RasterTriangle* t = &raster->triangles[i];
+        for (int ty = t->min_y / RASTER_TILE_HEIGHT; ty <= t->max_y / RASTER_TILE_HEIGHT; ty++) {
+            for (int tx = t->min_x / RASTER_TILE_WIDTH; tx <= t->max_x / RASTER_TILE_WIDTH; tx++) {
+                raster->tile_items[cursor[ty * tiles_x + tx]++] = i;
+            }
+        }
+    }
+
+    RasterJob job = { raster, buffer, zbuffer, tiles_x };
+    thread_pool_run(pool, tiles, raster_tile, &job);
+    raster->count = 0;
+}
+
+void raster_free(Rasterizer* raster) {
+    free(raster->triangles);
+    free(raster->normals);
+    free(raster->tile_start);
+    free(raster->tile_items);
+    memset(raster, 0, sizeof(*raster));
+}
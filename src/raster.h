@@ -0,0 +1,67 @@
+#ifndef RASTER_H
+#define RASTER_H
+
+#include <stdbool.h>
+#include "mesh.h"
+#include "thread_pool.h"
+
+// Filled, shaded triangles for the mesh scenes. raster_add_mesh lights,
+// culls and near-clips a transformed mesh's triangles and queues them;
+// raster_flush bins the queue into screen tiles and fills the tiles in
+// parallel with half-space edge tests, keeping the nearer glyph per cell.
+// Triangles within a tile are filled in the order they were added.
+#define RASTER_TILE_WIDTH 32
+#define RASTER_TILE_HEIGHT 16
+
+typedef enum {
+    RASTER_FLAT,            // One Lambert intensity per triangle
+    RASTER_SMOOTH           // Lambert intensity at each vertex, blended across
+} RasterShading;
+
+typedef struct {
+    const char* ramp;       // Glyphs from darkest to brightest
+    RasterShading shading;
+    float light[3];         // Direction toward the light in camera space (need not be unit length)
+    float ambient;          // Intensity of surfaces facing away from the light
+    bool cull_back;         // Skip triangles facing away from the camera (closed meshes)
+} RasterStyle;
+
+// A queued triangle in screen space
+typedef struct {
+    float x[3], y[3];
+    float inv_z[3];
+    float shade[3];         // Intensity at each corner, 0..1
+    const char* ramp;
+    int ramp_last;          // Index of the ramp's brightest glyph
+    int min_x, min_y, max_x, max_y;     // Cells covered, clipped to the screen
+} RasterTriangle;
+
+typedef struct {
+    int width, height;
+    RasterTriangle* triangles;
+    int count;
+    int capacity;
+    float* normals;         // Per-vertex normals of the mesh being added
+    int normal_capacity;
+    int* tile_start;        // Each tile's run in tile_items, in tile order
+    int tile_capacity;
+    int* tile_items;        // Triangle indices, binned by tile
+    int item_capacity;
+} Rasterizer;
+
+// Start a frame of 'width' x 'height' cells, dropping anything queued
+void raster_begin(Rasterizer* raster, int width, int height);
+
+// Queue the triangles of 'mesh', already transformed into 'view' through
+// 'camera'. Returns false if the queue could not grow.
+bool raster_add_mesh(Rasterizer* raster, const Mesh* mesh, const MeshView* view, const MeshCamera* camera,
+                     const RasterStyle* style);
+
+// Fill the queued triangles into the planes, splitting tiles over 'pool'
+// (NULL runs on the calling thread), and empty the queue
+void raster_flush(Rasterizer* raster, char* buffer, float* zbuffer, ThreadPool* pool);
+
+// Release a rasterizer's arrays
+void raster_free(Rasterizer* raster);
+
+#endif // RASTER_H
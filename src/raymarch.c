@@ -0,0 +1,273 @@
+#include "raymarch.h"
+#include <math.h>
+#include <stdlib.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// A reused depth is kept while the field puts it within this many stop
+// distances of a surface
+#define REUSE_SLACK 1.5f
+
+typedef struct {
+    Raymarcher* marcher;
+    const RaymarchView* view;
+    char* buffer;
+    float* zbuffer;
+    float focal_y;              // Rows per unit of y at depth 1
+    float threshold;            // Stop distance per unit of distance along the ray
+    int phase;                  // 0: march this frame's cells, 1: resolve the rest
+} RaymarchJob;
+
+// Rays of one row waiting to be marched or checked
+typedef struct {
+    int count;
+    int cell[RAYMARCH_PACKET];
+    float dx[RAYMARCH_PACKET], dy[RAYMARCH_PACKET], dz[RAYMARCH_PACKET];    // Unit direction, world space
+    float depth_scale[RAYMARCH_PACKET];     // Camera-space depth per unit along the ray
+    float t[RAYMARCH_PACKET];               // Depth to check, or to start marching from
+} RayPacket;
+
+// World-space direction of the ray through a cell, assuming the camera
+// matrix is a rotation plus a translation
+static void cell_ray(const RaymarchJob* job, int x, int y, float* dir, float* depth_scale) {
+    const MeshCamera* lens = &job->view->lens;
+    const Mat4* camera = &job->view->camera;
+    float cx = (x - lens->center_x) / lens->focal;
+    float cy = (y - lens->center_y) / job->focal_y;
+    float inv = 1.0f / sqrtf(cx * cx + cy * cy + 1.0f);
+    for (int i = 0; i < 3; i++) {
+        dir[i] = (camera->m[i][0] * cx + camera->m[i][1] * cy + camera->m[i][2]) * inv;
+    }
+    *depth_scale = inv;
+}
+
+static void packet_push(RayPacket* packet, int x, const float* dir, float depth_scale, float t) {
+    int i = packet->count++;
+    packet->cell[i] = x;
+    packet->dx[i] = dir[0];
+    packet->dy[i] = dir[1];
+    packet->dz[i] = dir[2];
+    packet->depth_scale[i] = depth_scale;
+    packet->t[i] = t;
+}
+
+// Record a cell's depth and draw its glyph
+static void finish_cell(const RaymarchJob* job, const RayPacket* packet, int lane, int y, bool hit, float t) {
+    const RaymarchView* view = job->view;
+    const Mat4* camera = &view->camera;
+    Raymarcher* marcher = job->marcher;
+    int index = y * marcher->width + packet->cell[lane];
+    marcher->depth[index] = hit ? t : -1.0f;
+
+    if (!hit) t = view->max_distance;
+    RaymarchHit result = {
+        hit, t,
+        camera->m[0][3] + packet->dx[lane] * t,
+        camera->m[1][3] + packet->dy[lane] * t,
+        camera->m[2][3] + packet->dz[lane] * t
+    };
+    char glyph = view->shade(view->ctx, &result);
+    float z = t * packet->depth_scale[lane];
+    if (glyph != ' ' && z < job->zbuffer[index]) {
+        job->buffer[index] = glyph;
+        job->zbuffer[index] = z;
+    }
+}
+
+// Sphere-trace a packet's rays together from their start depths until
+// every one has hit or missed
+static void march_packet(const RaymarchJob* job, RayPacket* packet, int y) {
+    const RaymarchView* view = job->view;
+    int count = packet->count;
+    // Idle lanes trace a copy of the first ray
+    for (int i = count; i < RAYMARCH_PACKET; i++) {
+        packet->dx[i] = packet->dx[0];
+        packet->dy[i] = packet->dy[0];
+        packet->dz[i] = packet->dz[0];
+        packet->t[i] = packet->t[0];
+    }
+
+    float px[RAYMARCH_PACKET], py[RAYMARCH_PACKET], pz[RAYMARCH_PACKET], d[RAYMARCH_PACKET];
+    float t[RAYMARCH_PACKET];
+    int hits = 0;
+#ifdef __SSE2__
+    __m128 ox = _mm_set1_ps(view->camera.m[0][3]);
+    __m128 oy = _mm_set1_ps(view->camera.m[1][3]);
+    __m128 oz = _mm_set1_ps(view->camera.m[2][3]);
+    __m128 dx = _mm_loadu_ps(packet->dx), dy = _mm_loadu_ps(packet->dy), dz = _mm_loadu_ps(packet->dz);
+    __m128 threshold = _mm_set1_ps(job->threshold);
+    __m128 far = _mm_set1_ps(view->max_distance);
+    __m128 tv = _mm_loadu_ps(packet->t);
+    __m128 active = _mm_castsi128_ps(_mm_cmplt_epi32(_mm_set_epi32(3, 2, 1, 0), _mm_set1_epi32(count)));
+    for (int step = 0; step < view->max_steps && _mm_movemask_ps(active); step++) {
+        _mm_storeu_ps(px, _mm_add_ps(ox, _mm_mul_ps(dx, tv)));
+        _mm_storeu_ps(py, _mm_add_ps(oy, _mm_mul_ps(dy, tv)));
+        _mm_storeu_ps(pz, _mm_add_ps(oz, _mm_mul_ps(dz, tv)));
+        view->distance(view->ctx, px, py, pz, d);
+        __m128 dv = _mm_loadu_ps(d);
+        __m128 close = _mm_and_ps(active, _mm_cmplt_ps(dv, _mm_mul_ps(threshold, tv)));
+        hits |= _mm_movemask_ps(close);
+        active = _mm_andnot_ps(close, active);
+        tv = _mm_add_ps(tv, _mm_and_ps(dv, active));
+        active = _mm_andnot_ps(_mm_cmpgt_ps(tv, far), active);
+    }
+    _mm_storeu_ps(t, tv);
+#else
+    int active = (1 << count) - 1;
+    for (int i = 0; i < RAYMARCH_PACKET; i++) t[i] = packet->t[i];
+    for (int step = 0; step < view->max_steps && active; step++) {
+        for (int i = 0; i < RAYMARCH_PACKET; i++) {
+            px[i] = view->camera.m[0][3] + packet->dx[i] * t[i];
+            py[i] = view->camera.m[1][3] + packet->dy[i] * t[i];
+            pz[i] = view->camera.m[2][3] + packet->dz[i] * t[i];
+        }
+        view->distance(view->ctx, px, py, pz, d);
+        for (int i = 0; i < count; i++) {
+            if (!(active & (1 << i))) continue;
+            if (d[i] < job->threshold * t[i]) {
+                hits |= 1 << i;
+                active &= ~(1 << i);
+            } else {
+                t[i] += d[i];
+                if (t[i] > view->max_distance) active &= ~(1 << i);
+            }
+        }
+    }
+#endif
+
+    // Rays still going when the steps run out count as hits where they stopped
+    for (int i = 0; i < count; i++) {
+        bool hit = (hits & (1 << i)) || t[i] <= view->max_distance;
+        finish_cell(job, packet, i, y, hit, t[i]);
+    }
+    packet->count = 0;
+}
+
+// Keep the reused depths the field agrees with, taking one more step from
+// each, and queue the rest for marching: onward from the reused depth if
+// it lies outside every surface, else from the lens
+static void check_packet(const RaymarchJob* job, RayPacket* packet, RayPacket* retry, int y) {
+    const RaymarchView* view = job->view;
+    const Mat4* camera = &view->camera;
+    float px[RAYMARCH_PACKET], py[RAYMARCH_PACKET], pz[RAYMARCH_PACKET], d[RAYMARCH_PACKET];
+    for (int i = 0; i < RAYMARCH_PACKET; i++) {
+        int lane = i < packet->count ? i : 0;
+        px[i] = camera->m[0][3] + packet->dx[lane] * packet->t[lane];
+        py[i] = camera->m[1][3] + packet->dy[lane] * packet->t[lane];
+        pz[i] = camera->m[2][3] + packet->dz[lane] * packet->t[lane];
+    }
+    view->distance(view->ctx, px, py, pz, d);
+
+    for (int i = 0; i < packet->count; i++) {
+        float t = packet->t[i];
+        if (fabsf(d[i]) <= REUSE_SLACK * job->threshold * t) {
+            finish_cell(job, packet, i, y, true, fmaxf(t + d[i], view->lens.near));
+            continue;
+        }
+        float dir[3] = { packet->dx[i], packet->dy[i], packet->dz[i] };
+        float start = d[i] > 0.0f ? t : view->lens.near;
+        packet_push(retry, packet->cell[i], dir, packet->depth_scale[i], start);
+        if (retry->count == RAYMARCH_PACKET) march_packet(job, retry, y);
+    }
+    packet->count = 0;
+}
+
+// Depth worth checking for a cell left out of this frame's march: the
+// nearest hit among its marched neighbours, else its own last depth.
+// Returns 0 when there is none, and a negative depth when the neighbours
+// and the cell's last frame all missed.
+static float reuse_candidate(const Raymarcher* marcher, int x, int y) {
+    const float* depth = marcher->depth;
+    float nearest = INFINITY;
+    const int dx[4] = { -1, 1, 0, 0 }, dy[4] = { 0, 0, -1, 1 };
+    for (int i = 0; i < 4; i++) {
+        int nx = x + dx[i], ny = y + dy[i];
+        if (nx < 0 || ny < 0 || nx >= marcher->width || ny >= marcher->height) continue;
+        float t = depth[ny * marcher->width + nx];
+        if (t >= 0.0f && t < nearest) nearest = t;
+    }
+    if (nearest < INFINITY) return nearest;
+    return marcher->history ? marcher->previous[y * marcher->width + x] : 0.0f;
+}
+
+static void raymarch_row(void* ctx, int y) {
+    RaymarchJob* job = (RaymarchJob*)ctx;
+    Raymarcher* marcher = job->marcher;
+    bool half_rate = job->view->half_rate;
+    float near = job->view->lens.near;
+    RayPacket march, check;
+    march.count = 0;
+    check.count = 0;
+
+    for (int x = 0; x < marcher->width; x++) {
+        bool marched = !half_rate || ((x + y + marcher->parity) & 1) == 0;
+        if (marched != (job->phase == 0)) continue;
+        float dir[3], depth_scale;
+        cell_ray(job, x, y, dir, &depth_scale);
+
+        float candidate = marched ? 0.0f : reuse_candidate(marcher, x, y);
+        if (candidate < 0.0f) {
+            RayPacket single;
+            single.count = 0;
+            packet_push(&single, x, dir, depth_scale, near);
+            finish_cell(job, &single, 0, y, false, 0.0f);
+        } else if (candidate > 0.0f) {
+            packet_push(&check, x, dir, depth_scale, candidate);
+            if (check.count == RAYMARCH_PACKET) check_packet(job, &check, &march, y);
+        } else {
+            packet_push(&march, x, dir, depth_scale, near);
+            if (march.count == RAYMARCH_PACKET) march_packet(job, &march, y);
+        }
+    }
+    if (check.count > 0) check_packet(job, &check, &march, y);
+    if (march.count > 0) march_packet(job, &march, y);
+}
+
+bool raymarch_render(Raymarcher* marcher, const RaymarchView* view, char* buffer, float* zbuffer,
+                     int width, int height, ThreadPool* pool) {
+    int cells = width * height;
+    if (cells > marcher->capacity) {
+        float* depth = (float*)realloc(marcher->depth, sizeof(float) * cells);
+        if (!depth) return false;
+        marcher->depth = depth;
+        float* previous = (float*)realloc(marcher->previous, sizeof(float) * cells);
+        if (!previous) return false;
+        marcher->previous = previous;
+        marcher->capacity = cells;
+    }
+    if (width != marcher->width || height != marcher->height) {
+        marcher->width = width;
+        marcher->height = height;
+        marcher->history = false;
+    }
+
+    RaymarchJob job = {
+        marcher, view, buffer, zbuffer,
+        view->lens.focal / MESH_CELL_ASPECT,
+        view->epsilon / view->lens.focal,
+        0
+    };
+    thread_pool_run(pool, height, raymarch_row, &job);
+    if (view->half_rate) {
+        job.phase = 1;
+        thread_pool_run(pool, height, raymarch_row, &job);
+        marcher->parity ^= 1;
+    }
+
+    float* swap = marcher->depth;
+    marcher->depth = marcher->previous;
+    marcher->previous = swap;
+    marcher->history = true;
+    return true;
+}
+
+void raymarch_free(Raymarcher* marcher) {
+    free(marcher->depth);
+    free(marcher->previous);
+    marcher->depth = NULL;
+    marcher->previous = NULL;
+    marcher->capacity = 0;
+    marcher->history = false;
+}
@@ -0,0 +1,65 @@
+#ifndef RAYMARCH_H
+#define RAYMARCH_H
+
+#include <stdbool.h>
+#include "mesh.h"
+#include "thread_pool.h"
+
+// Sphere tracing of signed distance fields for the tunnel scenes. A scene
+// supplies a distance function and a glyph for each hit; raymarch_render
+// casts one ray per cell through a MeshCamera lens, marches the rays of a
+// row four at a time and splits the rows over the thread pool.
+//
+// In half-rate mode only one colour of a checkerboard, alternating each
+// frame, is marched. Every other cell first tries the nearest depth its
+// marched neighbours found, or failing that its own depth from last frame,
+// and keeps it if the field says that point on its ray lies on a surface.
+// Otherwise the cell is marched, onward from the candidate when that point
+// is outside every surface, which can miss detail thinner than a cell.
+#define RAYMARCH_PACKET 4       // Rays marched together
+
+// Distance to the nearest surface from each of RAYMARCH_PACKET points;
+// negative inside. Must not overestimate, or rays step through surfaces.
+typedef void (*RaymarchDistance)(const void* ctx, const float* x, const float* y, const float* z,
+                                 float* distance);
+
+typedef struct {
+    bool hit;
+    float t;                    // Distance along the ray
+    float x, y, z;              // Where the ray stopped, in world space
+} RaymarchHit;
+
+// Glyph for a cell's ray; ' ' leaves the cell untouched
+typedef char (*RaymarchShade)(const void* ctx, const RaymarchHit* hit);
+
+typedef struct {
+    RaymarchDistance distance;
+    RaymarchShade shade;
+    const void* ctx;            // Passed to both callbacks
+    Mat4 camera;                // Camera space (looking down +z, y down) to world space
+    MeshCamera lens;            // Rays start at the lens's near distance
+    int max_steps;
+    float max_distance;         // Rays that get this far miss
+    float epsilon;              // Rays stop this many cell widths from a surface
+    bool half_rate;             // March half the cells per frame, reusing depths for the rest
+} RaymarchView;
+
+typedef struct {
+    int width, height;
+    float* depth;               // Distance along each cell's ray this frame (negative: missed)
+    float* previous;            // The same for the frame before
+    int capacity;
+    bool history;               // 'previous' holds a frame of this size
+    int parity;                 // Checkerboard colour marched this frame
+} Raymarcher;
+
+// Render 'view' into the planes, keeping the nearer glyph where the depth
+// buffer already has one, and splitting rows over 'pool' (NULL runs on the
+// calling thread). Returns false if the depth arrays could not grow.
+bool raymarch_render(Raymarcher* marcher, const RaymarchView* view, char* buffer, float* zbuffer,
+                     int width, int height, ThreadPool* pool);
+
+// Release a raymarcher's arrays
+void raymarch_free(Raymarcher* marcher);
+
+#endif // RAYMARCH_H
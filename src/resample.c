@@ -0,0 +1,186 @@
+#include "resample.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define BLANK ' '
+#define RESAMPLE_STRIP 512      // Output columns whose sources are looked up together
+
+#ifdef __SSE2__
+// Lanes of 'cur' that are blank take the value from 'next'
+static inline __m128i fill_blank(__m128i cur, __m128i next, __m128i blank) {
+    __m128i is_blank = _mm_cmpeq_epi8(cur, blank);
+    return _mm_or_si128(_mm_and_si128(is_blank, next), _mm_andnot_si128(is_blank, cur));
+}
+#endif
+
+// Each output cell covers a 2x2 block. Nearest takes the block's lower
+// right cell (the one under the centre, rounding down-right like the
+// generic path); coverage takes the first non-blank cell in reading order.
+static void downscale_2x(const char* src, int src_w, char* dst, int dst_w, int dst_h, ResampleMode mode) {
+    for (int y = 0; y < dst_h; y++) {
+        const uint8_t* r0 = (const uint8_t*)src + (size_t)(2 * y) * src_w;
+        const uint8_t* r1 = r0 + src_w;
+        uint8_t* out = (uint8_t*)dst + (size_t)y * dst_w;
+        int x = 0;
+
+#ifdef __SSE2__
+        const __m128i low_bytes = _mm_set1_epi16(0x00FF);
+        const __m128i blank = _mm_set1_epi8(BLANK);
+        for (; x + 16 <= dst_w; x += 16) {
+            __m128i a0 = _mm_loadu_si128((const __m128i*)(r0 + 2 * x));
+            __m128i a1 = _mm_loadu_si128((const __m128i*)(r0 + 2 * x + 16));
+            __m128i b0 = _mm_loadu_si128((const __m128i*)(r1 + 2 * x));
+            __m128i b1 = _mm_loadu_si128((const __m128i*)(r1 + 2 * x + 16));
+            
+            // Split even and odd columns into 16 lanes each
+            __m128i bottom_odd = _mm_packus_epi16(_mm_srli_epi16(b0, 8), _mm_srli_epi16(b1, 8));
+            __m128i result = bottom_odd;
+            if (mode == RESAMPLE_COVERAGE) {
+                __m128i top_even = _mm_packus_epi16(_mm_and_si128(a0, low_bytes), _mm_and_si128(a1, low_bytes));
+                __m128i top_odd = _mm_packus_epi16(_mm_srli_epi16(a0, 8), _mm_srli_epi16(a1, 8));
+                __m128i bottom_even = _mm_packus_epi16(_mm_and_si128(b0, low_bytes), _mm_and_si128(b1, low_bytes));
+                result = fill_blank(top_even, top_odd, blank);
+                result = fill_blank(result, bottom_even, blank);
+                result = fill_blank(result, bottom_odd, blank);
+            }
+            _mm_storeu_si128((__m128i*)(out + x), result);
+        }
+#endif
+
+        for (; x < dst_w; x++) {
+            if (mode == RESAMPLE_NEAREST) {
+                out[x] = r1[2 * x + 1];
+                continue;
+            }
+            uint8_t c = r0[2 * x];
+            if (c == BLANK) c = r0[2 * x + 1];
+            if (c == BLANK) c = r1[2 * x];
+            if (c == BLANK) c = r1[2 * x + 1];
+            out[x] = c;
+        }
+    }
+}
+
+// Every source cell becomes a 2x2 block
+static void upscale_2x(const char* src, int src_w, int src_h, char* dst, int dst_w) {
+    for (int y = 0; y < src_h; y++) {
+        const uint8_t* row = (const uint8_t*)src + (size_t)y * src_w;
+        uint8_t* out = (uint8_t*)dst + (size_t)(2 * y) * dst_w;
+        int x = 0;
+
+#ifdef __SSE2__
+        for (; x + 16 <= src_w; x += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(row + x));
+            _mm_storeu_si128((__m128i*)(out + 2 * x), _mm_unpacklo_epi8(v, v));
+            _mm_storeu_si128((__m128i*)(out + 2 * x + 16), _mm_unpackhi_epi8(v, v));
+        }
+#endif
+
+        for (; x < src_w; x++) {
+            out[2 * x] = row[x];
+            out[2 * x + 1] = row[x];
+        }
+        memcpy(out + dst_w, out, dst_w);
+    }
+}
+
+// Exact position along one axis, num / den, stepped without dividing
+typedef struct {
+    int index, rem;
+    int step_index, step_rem, den;
+} AxisWalk;
+
+static void axis_walk_init(AxisWalk* walk, long num, long step, long den) {
+    walk->index = (int)(num / den);
+    walk->rem = (int)(num % den);
+    walk->step_index = (int)(step / den);
+    walk->step_rem = (int)(step % den);
+    walk->den = (int)den;
+}
+
+static inline void axis_walk_next(AxisWalk* walk) {
+    walk->index += walk->step_index;
+    walk->rem += walk->step_rem;
+    if (walk->rem >= walk->den) {
+        walk->rem -= walk->den;
+        walk->index++;
+    }
+}
+
+// Any ratio. Output cell x's centre lies at (2x + 1) * src_w / (2 * dst_w)
+// and its block edges at x * src_w / dst_w; positions are kept as exact
+// fractions, so cells on a boundary land where the ratio puts them.
+static void resample_generic(const char* src, int src_w, int src_h,
+                             char* dst, int dst_w, int dst_h, ResampleMode mode) {
+    bool coverage = mode == RESAMPLE_COVERAGE && (src_w > dst_w || src_h > dst_h);
+    
+    if (!coverage) {
+        // Every row samples the same source columns: look them up once per
+        // strip of output columns
+        int columns[RESAMPLE_STRIP];
+        AxisWalk sx;
+        axis_walk_init(&sx, src_w, 2 * (long)src_w, 2 * (long)dst_w);
+        for (int first = 0; first < dst_w; first += RESAMPLE_STRIP) {
+            int count = dst_w - first < RESAMPLE_STRIP ? dst_w - first : RESAMPLE_STRIP;
+            for (int x = 0; x < count; x++, axis_walk_next(&sx)) {
+                columns[x] = sx.index;
+            }
+            for (int y = 0; y < dst_h; y++) {
+                const char* row = src + (size_t)((2 * (long)y + 1) * src_h / (2 * (long)dst_h)) * src_w;
+                char* out = dst + (size_t)y * dst_w + first;
+                for (int x = 0; x < count; x++) {
+                    out[x] = row[columns[x]];
+                }
+            }
+        }
+        return;
+    }
+    
+    for (int y = 0; y < dst_h; y++) {
+        char* out = dst + (size_t)y * dst_w;
+        
+        int y0 = (int)((long)y * src_h / dst_h);
+        int y1 = (int)((long)(y + 1) * src_h / dst_h);
+        if (y1 <= y0) y1 = y0 + 1;
+        
+        AxisWalk edge;
+        axis_walk_init(&edge, 0, src_w, dst_w);
+        for (int x = 0; x < dst_w; x++) {
+            int x0 = edge.index;
+            axis_walk_next(&edge);
+            int x1 = edge.index;
+            if (x1 <= x0) x1 = x0 + 1;
+            
+            char c = BLANK;
+            for (int sy = y0; sy < y1 && c == BLANK; sy++) {
+                const char* row = src + (size_t)sy * src_w;
+                for (int sx = x0; sx < x1; sx++) {
+                    if (row[sx] != BLANK) {
+                        c = row[sx];
+                        break;
+                    }
+                }
+            }
+            out[x] = c;
+        }
+    }
+}
+
+void resample_plane(const char* src, int src_w, int src_h,
+                    char* dst, int dst_w, int dst_h, ResampleMode mode) {
+    if (src_w <= 0 || src_h <= 0 || dst_w <= 0 || dst_h <= 0) return;
+    
+    if (src_w == dst_w && src_h == dst_h) {
+        memcpy(dst, src, (size_t)dst_w * dst_h);
+    } else if (src_w == 2 * dst_w && src_h == 2 * dst_h) {
+        downscale_2x(src, src_w, dst, dst_w, dst_h, mode);
+    } else if (dst_w == 2 * src_w && dst_h == 2 * src_h) {
+        upscale_2x(src, src_w, src_h, dst, dst_w);
+    } else {
+        resample_generic(src, src_w, src_h, dst, dst_w, dst_h, mode);
+    }
+}
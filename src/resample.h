@@ -0,0 +1,16 @@
+#ifndef RESAMPLE_H
+#define RESAMPLE_H
+
+// Character plane resampling, used to map a deck's internal render
+// resolution onto the terminal grid.
+typedef enum {
+    RESAMPLE_NEAREST,     // Take the cell under each output cell's centre
+    RESAMPLE_COVERAGE     // Downscaling keeps any ink in a block, so thin lines survive
+} ResampleMode;
+
+// Resample a src_w x src_h plane into a dst_w x dst_h plane. Exact 2x
+// up/downscales take a SIMD path; other ratios use a scalar one.
+void resample_plane(const char* src, int src_w, int src_h,
+                    char* dst, int dst_w, int dst_h, ResampleMode mode);
+
+#endif // RESAMPLE_H
@@ -0,0 +1,195 @@
+#include "terrain.h"
+#include <math.h>
+#include <stdlib.h>
+
+// Screen columns each render task draws
+#define TERRAIN_BAND_COLUMNS 16
+
+typedef struct {
+    Heightmap* map;
+    int first;              // World row of task 0
+} HeightmapJob;
+
+typedef struct {
+    const Heightmap* map;
+    const TerrainView* view;
+    char* buffer;
+    float* zbuffer;
+    int width, height;
+} TerrainJob;
+
+// Lattice value in 0..1
+static float lattice(int x, int z, unsigned seed) {
+    unsigned h = (unsigned)x * 0x8da6b343u ^ (unsigned)z * 0xd8163841u ^ seed * 0xcb1ab31fu;
+    h ^= h >> 13;
+    h *= 0x5bd1e995u;
+    h ^= h >> 15;
+    return (h & 0xffffff) / 16777216.0f;
+}
+
+static float value_noise(float x, float z, unsigned seed) {
+    float fx = floorf(x), fz = floorf(z);
+    int ix = (int)fx, iz = (int)fz;
+    float tx = x - fx, tz = z - fz;
+    tx = tx * tx * (3.0f - 2.0f * tx);
+    tz = tz * tz * (3.0f - 2.0f * tz);
+    float a = lattice(ix, iz, seed), b = lattice(ix + 1, iz, seed);
+    float c = lattice(ix, iz + 1, seed), d = lattice(ix + 1, iz + 1, seed);
+    float near = a + (b - a) * tx;
+    float far = c + (d - c) * tx;
+    return near + (far - near) * tz;
+}
+
+// Sum of octaves, normalized to 0..1
+static float fractal_noise(const TerrainNoise* noise, float x, float z) {
+    float sum = 0.0f, total = 0.0f;
+    float amplitude = 1.0f, frequency = noise->frequency;
+    for (int octave = 0; octave < noise->octaves; octave++) {
+        float v = value_noise(x * frequency, z * frequency, noise->seed + octave);
+        if (noise->ridged) v = 1.0f - fabsf(2.0f * v - 1.0f);
+        sum += v * amplitude;
+        total += amplitude;
+        amplitude *= noise->gain;
+        frequency *= 2.0f;
+    }
+    return total > 0.0f ? sum / total : 0.0f;
+}
+
+static int ring_slot(const Heightmap* map, int row) {
+    int slot = row % map->rows;
+    return slot < 0 ? slot + map->rows : slot;
+}
+
+bool heightmap_configure(Heightmap* map, int columns, int rows, float spacing, const TerrainNoise* noise) {
+    int samples = columns * rows;
+    if (samples > map->capacity) {
+        float* heights = (float*)realloc(map->heights, sizeof(float) * samples);
+        if (!heights) return false;
+        map->heights = heights;
+        map->capacity = samples;
+    }
+    const TerrainNoise* old = &map->noise;
+    if (columns != map->columns || rows != map->rows || spacing != map->spacing ||
+        noise->frequency != old->frequency || noise->octaves != old->octaves || noise->gain != old->gain ||
+        noise->ridged != old->ridged || noise->seed != old->seed) {
+        map->columns = columns;
+        map->rows = rows;
+        map->spacing = spacing;
+        map->noise = *noise;
+        map->filled = false;
+    }
+    return true;
+}
+
+static void heightmap_row(void* ctx, int index) {
+    HeightmapJob* job = (HeightmapJob*)ctx;
+    Heightmap* map = job->map;
+    int row = job->first + index;
+    float* out = map->heights + ring_slot(map, row) * map->columns;
+    float z = row * map->spacing;
+    float x0 = -0.5f * map->columns * map->spacing;
+    for (int i = 0; i < map->columns; i++) {
+        out[i] = fractal_noise(&map->noise, x0 + i * map->spacing, z);
+    }
+}
+
+void heightmap_scroll(Heightmap* map, float z, ThreadPool* pool) {
+    int first = (int)floorf(z / map->spacing);
+    HeightmapJob job = { map, first };
+    int count = map->rows;
+    if (map->filled && abs(first - map->first_row) < map->rows) {
+        if (first > map->first_row) {
+            // Rows revealed ahead take the slots of the rows left behind
+            job.first = map->first_row + map->rows;
+            count = first - map->first_row;
+        } else {
+            count = map->first_row - first;
+        }
+    }
+    if (count > 0) thread_pool_run(pool, count, heightmap_row, &job);
+    map->first_row = first;
+    map->filled = true;
+}
+
+float heightmap_sample(const Heightmap* map, float x, float z) {
+    float fx = x / map->spacing + 0.5f * map->columns;
+    float fz = z / map->spacing - map->first_row;
+    float max_x = (float)(map->columns - 1), max_z = (float)(map->rows - 1);
+    fx = fx < 0.0f ? 0.0f : (fx > max_x ? max_x : fx);
+    fz = fz < 0.0f ? 0.0f : (fz > max_z ? max_z : fz);
+    int ix = (int)fx, iz = (int)fz;
+    if (ix > map->columns - 2) ix = map->columns - 2;
+    if (iz > map->rows - 2) iz = map->rows - 2;
+    float tx = fx - ix, tz = fz - iz;
+    const float* row0 = map->heights + ring_slot(map, map->first_row + iz) * map->columns;
+    const float* row1 = map->heights + ring_slot(map, map->first_row + iz + 1) * map->columns;
+    float near = row0[ix] + (row0[ix + 1] - row0[ix]) * tx;
+    float far = row1[ix] + (row1[ix + 1] - row1[ix]) * tx;
+    return near + (far - near) * tz;
+}
+
+static void terrain_band(void* ctx, int band) {
+    TerrainJob* job = (TerrainJob*)ctx;
+    const TerrainView* view = job->view;
+    int width = job->width;
+    int start = band * TERRAIN_BAND_COLUMNS;
+    int end = start + TERRAIN_BAND_COLUMNS < width ? start + TERRAIN_BAND_COLUMNS : width;
+    float focal_y = view->focal * 0.5f;
+    float sin_yaw = sinf(view->yaw), cos_yaw = cosf(view->yaw);
+
+    for (int x = start; x < end; x++) {
+        // Ground position per unit of depth along this column
+        float u = (x + 0.5f - width * 0.5f) / view->focal;
+        float dir_x = sin_yaw + cos_yaw * u;
+        float dir_z = cos_yaw - sin_yaw * u;
+
+        int lowest = job->height;   // Rows from here down are already drawn
+        float z = view->near, dz = view->step, taken = view->step;
+        float previous = -INFINITY;
+        while (z < view->far && lowest > 0) {
+            TerrainSample sample;
+            sample.x = view->x + dir_x * z;
+            sample.z = view->z + dir_z * z;
+            sample.height = heightmap_sample(job->map, sample.x, sample.z) * view->height_scale;
+            sample.water = sample.height < view->water;
+            if (sample.water) sample.height = view->water;
+            sample.slope = previous == -INFINITY ? 0.0f : (sample.height - previous) / taken;
+            sample.distance = z;
+            previous = sample.height;
+
+            int top = (int)ceilf(view->horizon + (view->y - sample.height) * focal_y / z);
+            if (top < 0) top = 0;
+            if (top < lowest) {
+                char glyph = view->shade(view->ctx, &sample);
+                if (glyph != ' ') {
+                    for (int y = top; y < lowest; y++) {
+                        int index = y * width + x;
+                        if (z < job->zbuffer[index]) {
+                            job->buffer[index] = glyph;
+                            job->zbuffer[index] = z;
+                        }
+                    }
+                }
+                lowest = top;
+            }
+            taken = dz;
+            z += dz;
+            dz *= TERRAIN_STEP_GROWTH;
+        }
+    }
+}
+
+void terrain_render(const Heightmap* map, const TerrainView* view, char* buffer, float* zbuffer,
+                    int width, int height, ThreadPool* pool) {
+    if (!map->filled) return;
+    TerrainJob job = { map, view, buffer, zbuffer, width, height };
+    int bands = (width + TERRAIN_BAND_COLUMNS - 1) / TERRAIN_BAND_COLUMNS;
+    thread_pool_run(pool, bands, terrain_band, &job);
+}
+
+void heightmap_free(Heightmap* map) {
+    free(map->heights);
+    map->heights = NULL;
+    map->capacity = 0;
+    map->filled = false;
+}
@@ -0,0 +1,79 @@
+#ifndef TERRAIN_H
+#define TERRAIN_H
+
+#include <stdbool.h>
+#include "thread_pool.h"
+
+// Heightfield terrain for the landscape scenes. A Heightmap caches fractal
+// value noise on a grid that scrolls along z: as the camera moves forward
+// only the rows it newly reveals are generated. terrain_render draws the
+// map in the voxel-space style, stepping each screen column's ray front to
+// back and filling only the rows above everything drawn in that column so
+// far, so every cell is written once and the cost is columns x steps.
+#define TERRAIN_STEP_GROWTH 1.02f   // Each depth step is this much longer than the last
+
+typedef struct {
+    float frequency;        // Noise lattice cells per world unit in the first octave
+    int octaves;
+    float gain;             // Amplitude of each octave relative to the one before
+    bool ridged;            // Fold each octave into sharp crests
+    unsigned seed;
+} TerrainNoise;
+
+typedef struct {
+    int columns, rows;      // Samples across x and along z
+    float spacing;          // World units between samples
+    TerrainNoise noise;
+    float* heights;         // 0..1; world row r is stored in slot r mod rows
+    int capacity;
+    int first_row;          // World row of the nearest cached row
+    bool filled;
+} Heightmap;
+
+// A terrain sample being drawn
+typedef struct {
+    float x, z;             // World position
+    float height;           // World height, at the water level where water covers the ground
+    float slope;            // Rise per unit of depth since the previous sample
+    float distance;         // Depth from the camera
+    bool water;
+} TerrainSample;
+
+// Glyph for the cells a sample covers; ' ' leaves them untouched but still
+// hides the terrain behind
+typedef char (*TerrainShade)(const void* ctx, const TerrainSample* sample);
+
+typedef struct {
+    float x, y, z;          // Camera position, y up
+    float yaw;              // Radians from +z toward +x
+    float horizon;          // Screen row level with the camera
+    float focal;            // Columns per unit across at depth 1; rows per unit of height are half that
+    float near, far;        // Depth range drawn; keep 'far' within the map's cached rows
+    float step;             // First depth step
+    float height_scale;     // World height of a map value of 1
+    float water;            // World height water fills up to (below the terrain: none)
+    TerrainShade shade;
+    const void* ctx;
+} TerrainView;
+
+// Size the map, 'columns' centred on x = 0, and set its noise, dropping the
+// cache if either changed. Returns false if the map could not grow.
+bool heightmap_configure(Heightmap* map, int columns, int rows, float spacing, const TerrainNoise* noise);
+
+// Cache the rows from depth 'z' onward, generating only those not already
+// cached and splitting them over 'pool' (NULL runs on the calling thread)
+void heightmap_scroll(Heightmap* map, float z, ThreadPool* pool);
+
+// Map value at a world position, interpolated between samples and clamped
+// to the cached area
+float heightmap_sample(const Heightmap* map, float x, float z);
+
+// Draw the terrain into the planes, keeping the nearer glyph where the
+// depth buffer already has one, with bands of columns split over 'pool'
+void terrain_render(const Heightmap* map, const TerrainView* view, char* buffer, float* zbuffer,
+                    int width, int height, ThreadPool* pool);
+
+// Release a heightmap's samples
+void heightmap_free(Heightmap* map);
+
+#endif // TERRAIN_H
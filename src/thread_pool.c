@@ -0,0 +1,131 @@
+#define _DEFAULT_SOURCE
+#include "thread_pool.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define THREAD_POOL_MAX_THREADS 64
+
+struct ThreadPool {
+    pthread_t threads[THREAD_POOL_MAX_THREADS];
+    int thread_count;
+    
+    pthread_mutex_t mutex;
+    pthread_cond_t work_cond;   // Workers wait here for a new generation
+    pthread_cond_t done_cond;   // Caller waits here for the run to finish
+    
+    ThreadPoolTask task;
+    void* ctx;
+    int task_count;
+    int next_task;              // Claimed with atomics during a run
+    int busy_workers;
+    unsigned generation;
+    bool shutting_down;
+};
+
+static void run_tasks(ThreadPool* pool) {
+    for (;;) {
+        int index = __atomic_fetch_add(&pool->next_task, 1, __ATOMIC_RELAXED);
+        if (index >= pool->task_count) break;
+        pool->task(pool->ctx, index);
+    }
+}
+
+static void* worker_main(void* arg) {
+    ThreadPool* pool = arg;
+    unsigned seen = 0;
+    
+    pthread_mutex_lock(&pool->mutex);
+    for (;;) {
+        while (pool->generation == seen && !pool->shutting_down) {
+            pthread_cond_wait(&pool->work_cond, &pool->mutex);
+        }
+        if (pool->shutting_down) break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->mutex);
+        
+        run_tasks(pool);
+        
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->busy_workers == 0) {
+            pthread_cond_signal(&pool->done_cond);
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    
+    return NULL;
+}
+
+ThreadPool* thread_pool_create(int threads) {
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 1 ? (int)cpus - 1 : 0;
+    }
+    if (threads > THREAD_POOL_MAX_THREADS) threads = THREAD_POOL_MAX_THREADS;
+    
+    ThreadPool* pool = calloc(1, sizeof(ThreadPool));
+    if (!pool) return NULL;
+    
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->work_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+    
+    for (int i = 0; i < threads; i++) {
+        if (pthread_create(&pool->threads[i], NULL, worker_main, pool) != 0) break;
+        pool->thread_count++;
+    }
+    
+    return pool;
+}
+
+void thread_pool_destroy(ThreadPool* pool) {
+    if (!pool) return;
+    
+    pthread_mutex_lock(&pool->mutex);
+    pool->shutting_down = true;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->mutex);
+    
+    for (int i = 0; i < pool->thread_count; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_cond_destroy(&pool->work_cond);
+    pthread_mutex_destroy(&pool->mutex);
+    free(pool);
+}
+
+void thread_pool_run(ThreadPool* pool, int task_count, ThreadPoolTask task, void* ctx) {
+    if (task_count <= 0) return;
+    
+    // Small runs are cheaper inline than waking the workers
+    if (!pool || pool->thread_count == 0 || task_count == 1) {
+        for (int i = 0; i < task_count; i++) {
+            task(ctx, i);
+        }
+        return;
+    }
+    
+    pthread_mutex_lock(&pool->mutex);
+    pool->task = task;
+    pool->ctx = ctx;
+    pool->task_count = task_count;
+    pool->next_task = 0;
+    pool->busy_workers = pool->thread_count;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->mutex);
+    
+    run_tasks(pool);
+    
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->busy_workers > 0) {
+        pthread_cond_wait(&pool->done_cond, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+int thread_pool_size(const ThreadPool* pool) {
+    return pool ? pool->thread_count + 1 : 1;
+}
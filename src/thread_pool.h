@@ -0,0 +1,27 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdbool.h>
+
+// Fixed set of worker threads for data-parallel loops. The calling thread
+// takes part in every run, so a pool of N threads runs N + 1 tasks at once.
+typedef struct ThreadPool ThreadPool;
+
+// Task callback: 'index' runs from 0 to task_count - 1
+typedef void (*ThreadPoolTask)(void* ctx, int index);
+
+// Create a pool with 'threads' workers (0 picks one per online CPU, minus
+// the caller). Returns NULL on failure.
+ThreadPool* thread_pool_create(int threads);
+
+// Stop and join the workers
+void thread_pool_destroy(ThreadPool* pool);
+
+// Run task(ctx, i) for every i in [0, task_count) and wait for all of them.
+// Not reentrant: one run at a time per pool. A NULL pool runs serially.
+void thread_pool_run(ThreadPool* pool, int task_count, ThreadPoolTask task, void* ctx);
+
+// Number of threads that take part in a run (workers + caller)
+int thread_pool_size(const ThreadPool* pool);
+
+#endif // THREAD_POOL_H
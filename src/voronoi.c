@@ -0,0 +1,150 @@
+#include "voronoi.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Seeds per bucket the grid is sized for
+#define SEEDS_PER_BUCKET 2.0f
+
+typedef struct {
+    VoronoiField* field;
+    int width;
+    float y_scale;
+} VoronoiJob;
+
+static bool grow(void** buffer, int* capacity, int needed, size_t element) {
+    if (needed <= *capacity) return true;
+    void* grown = realloc(*buffer, element * needed);
+    if (!grown) return false;
+    *buffer = grown;
+    *capacity = needed;
+    return true;
+}
+
+static inline int bucket_coord(float pos, float bucket_size, int buckets) {
+    int b = (int)floorf(pos / bucket_size);
+    return b < 0 ? 0 : b >= buckets ? buckets - 1 : b;
+}
+
+// Visit the buckets in square rings around the cell's own bucket. Every
+// seed in ring r + 1 is at least r bucket widths away, so the search ends
+// once the second-nearest seed found is closer than that.
+static void voronoi_row(void* ctx, int y) {
+    const VoronoiJob* job = ctx;
+    const VoronoiField* field = job->field;
+    float py = y * job->y_scale;
+    int by = bucket_coord(py, field->bucket_size, field->grid_h);
+    int max_ring = field->grid_w > field->grid_h ? field->grid_w : field->grid_h;
+
+    for (int x = 0; x < job->width; x++) {
+        float px = (float)x;
+        int bx = bucket_coord(px, field->bucket_size, field->grid_w);
+        float best1 = INFINITY, best2 = INFINITY;
+        int nearest = -1;
+
+        for (int ring = 0; ring <= max_ring; ring++) {
+            int y0 = by - ring, y1 = by + ring;
+            int x0 = bx - ring, x1 = bx + ring;
+
+            for (int gy = y0 < 0 ? 0 : y0; gy <= y1 && gy < field->grid_h; gy++) {
+                // Inner rows of the ring only have its two edge buckets
+                bool edge_row = gy == y0 || gy == y1;
+                int step = edge_row ? 1 : x1 - x0;
+                for (int gx = x0; gx <= x1; gx += step) {
+                    if (gx < 0 || gx >= field->grid_w) continue;
+                    int bucket = gy * field->grid_w + gx;
+                    for (int s = field->bucket_start[bucket]; s < field->bucket_start[bucket + 1]; s++) {
+                        float dx = field->sorted_x[s] - px;
+                        float dy = field->sorted_y[s] - py;
+                        float d = dx * dx + dy * dy;
+                        if (d < best1) {
+                            best2 = best1;
+                            best1 = d;
+                            nearest = field->sorted_index[s];
+                        } else if (d < best2) {
+                            best2 = d;
+                        }
+                    }
+                }
+            }
+
+            float reach = ring * field->bucket_size;
+            if (best2 <= reach * reach) break;
+        }
+
+        VoronoiCell* cell = &field->cells[y * job->width + x];
+        cell->nearest = nearest;
+        cell->d1 = sqrtf(best1);
+        cell->d2 = sqrtf(best2);
+    }
+}
+
+bool voronoi_compute(VoronoiField* field, const float* seed_x, const float* seed_y, int seed_count,
+                     int width, int height, float y_scale, ThreadPool* pool) {
+    if (width <= 0 || height <= 0) return true;
+    if (seed_count < 0) seed_count = 0;
+
+    float area = width * (height * y_scale);
+    float bucket_size = sqrtf(area * SEEDS_PER_BUCKET / (seed_count > 0 ? seed_count : 1));
+    if (bucket_size < 1.0f) bucket_size = 1.0f;
+    int grid_w = (int)ceilf(width / bucket_size);
+    int grid_h = (int)ceilf(height * y_scale / bucket_size);
+    if (grid_w < 1) grid_w = 1;
+    if (grid_h < 1) grid_h = 1;
+    int buckets = grid_w * grid_h;
+
+    if (!grow((void**)&field->cells, &field->cell_capacity, width * height, sizeof(VoronoiCell)) ||
+        !grow((void**)&field->bucket_start, &field->bucket_capacity, buckets + 1, sizeof(int))) {
+        return false;
+    }
+    if (seed_count > field->seed_capacity) {
+        // The three seed arrays share one capacity, so it only moves once all have grown
+        int capacity = field->seed_capacity;
+        if (!grow((void**)&field->sorted_x, &capacity, seed_count, sizeof(float))) return false;
+        capacity = field->seed_capacity;
+        if (!grow((void**)&field->sorted_y, &capacity, seed_count, sizeof(float))) return false;
+        capacity = field->seed_capacity;
+        if (!grow((void**)&field->sorted_index, &capacity, seed_count, sizeof(int))) return false;
+        field->seed_capacity = seed_count;
+    }
+
+    field->grid_w = grid_w;
+    field->grid_h = grid_h;
+    field->bucket_size = bucket_size;
+
+    // Counting sort of the seeds by bucket
+    int* start = field->bucket_start;
+    memset(start, 0, sizeof(int) * (buckets + 1));
+    for (int i = 0; i < seed_count; i++) {
+        int bx = bucket_coord(seed_x[i], bucket_size, grid_w);
+        int by = bucket_coord(seed_y[i] * y_scale, bucket_size, grid_h);
+        start[by * grid_w + bx + 1]++;
+    }
+    for (int b = 0; b < buckets; b++) {
+        start[b + 1] += start[b];
+    }
+    for (int i = 0; i < seed_count; i++) {
+        int bx = bucket_coord(seed_x[i], bucket_size, grid_w);
+        int by = bucket_coord(seed_y[i] * y_scale, bucket_size, grid_h);
+        int slot = start[by * grid_w + bx]++;
+        field->sorted_x[slot] = seed_x[i];
+        field->sorted_y[slot] = seed_y[i] * y_scale;
+        field->sorted_index[slot] = i;
+    }
+    // The scatter advanced every start to the next bucket's; shift them back
+    memmove(start + 1, start, sizeof(int) * buckets);
+    start[0] = 0;
+
+    VoronoiJob job = { field, width, y_scale };
+    thread_pool_run(pool, height, voronoi_row, &job);
+    return true;
+}
+
+void voronoi_free(VoronoiField* field) {
+    free(field->cells);
+    free(field->sorted_x);
+    free(field->sorted_y);
+    free(field->sorted_index);
+    free(field->bucket_start);
+    memset(field, 0, sizeof(*field));
+}
@@ -0,0 +1,44 @@
+#ifndef VORONOI_H
+#define VORONOI_H
+
+#include <stdbool.h>
+#include "thread_pool.h"
+
+// Nearest-seed queries over a character grid, for cell, crack and shard
+// patterns. Seeds are bucketed into a uniform grid sized to hold about two
+// each, so a cell only visits the buckets around it and its cost stays
+// flat however many seeds there are.
+typedef struct {
+    int nearest;            // Index of the nearest seed (-1 with no seeds)
+    float d1;               // Distance to the nearest seed
+    float d2;               // Distance to the second nearest; edges are where d2 - d1 is small
+} VoronoiCell;
+
+typedef struct {
+    VoronoiCell* cells;     // width x height results of the last voronoi_compute
+    int cell_capacity;
+
+    // Seeds sorted by bucket, grown on demand
+    float* sorted_x;
+    float* sorted_y;
+    int* sorted_index;
+    int seed_capacity;
+    int* bucket_start;      // grid_w * grid_h + 1 offsets into the sorted seeds
+    int bucket_capacity;
+
+    int grid_w, grid_h;
+    float bucket_size;
+} VoronoiField;
+
+// Nearest and second-nearest seed for every cell of a width x height
+// grid. Distances are in cells, with y multiplied by 'y_scale' to correct
+// for the cell aspect if wanted. Seeds may lie off the grid. Rows are
+// spread over 'pool' (NULL runs on the calling thread). Returns false if
+// the buffers could not be grown.
+bool voronoi_compute(VoronoiField* field, const float* seed_x, const float* seed_y, int seed_count,
+                     int width, int height, float y_scale, ThreadPool* pool);
+
+// Release a field's buffers
+void voronoi_free(VoronoiField* field);
+
+#endif // VORONOI_H
@@ -0,0 +1,25 @@
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+
+// Checks for the C module tests. Each test is its own program: failed
+// checks are reported as they happen and test_finish() turns the count
+// into the exit status. Built and run by "make test" in scripts/.
+static int test_failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "%s:%d: ", __FILE__, __LINE__); \
+        fprintf(stderr, __VA_ARGS__); \
+        fputc('\n', stderr); \
+        test_failures++; \
+    } \
+} while (0)
+
+static inline int test_finish(const char* name) {
+    printf("%s: %s\n", name, test_failures ? "FAILED" : "ok");
+    return test_failures ? 1 : 0;
+}
+
+#endif // TEST_H
@@ -0,0 +1,229 @@
+// Feature tracks: lookups on a hand-built track, the checks made when one
+// is opened, and a full analysis of a synthetic kick track with a breakdown
+#include "test.h"
+#include "audio_features.h"
+#include "audio_pipewire.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define KICK_BPM 128.0
+#define BARS 32
+#define BREAKDOWN_BAR 16            // Bars 16..23 have no kick
+#define DROP_BAR 24
+
+static char dir[] = "/tmp/clift_features_XXXXXX";
+
+static void write_bytes(const char* path, const void* bytes, size_t size) {
+    FILE* fp = fopen(path, "wb");
+    fwrite(bytes, 1, size, fp);
+    fclose(fp);
+}
+
+// A track built by hand: 100 hops, a beat every 10 hops, markers at 0.5 s
+// (breakdown) and 1.2 s (drop)
+typedef struct {
+    FeatureTrackHeader header;
+    FeatureHop hops[100];
+    FeatureBeat beats[10];
+    FeatureMarker markers[2];
+} HandTrack;
+
+static void build_hand_track(HandTrack* track) {
+    memset(track, 0, sizeof(*track));
+    memcpy(track->header.magic, FEATURE_TRACK_MAGIC, 4);
+    track->header.version = FEATURE_TRACK_VERSION;
+    track->header.sample_rate = AUDIO_SAMPLE_RATE;
+    track->header.hop_size = FEATURE_TRACK_HOP;
+    track->header.hop_count = 100;
+    track->header.beat_count = 10;
+    track->header.marker_count = 2;
+    track->header.bpm = 360.0f;
+    for (int h = 0; h < 100; h++) {
+        track->hops[h].volume = (uint8_t)h;
+    }
+    for (int b = 0; b < 10; b++) {
+        track->beats[b].time = (float)(b * 10 * FEATURE_TRACK_HOP) / AUDIO_SAMPLE_RATE;
+        track->beats[b].beat_in_bar = b % 4;
+    }
+    track->markers[0] = (FeatureMarker){ 0.5f, FEATURE_MARKER_BREAKDOWN };
+    track->markers[1] = (FeatureMarker){ 1.2f, FEATURE_MARKER_DROP };
+}
+
+static void check_lookup(void) {
+    static HandTrack hand;
+    char path[64];
+    snprintf(path, sizeof(path), "%s/hand.clft", dir);
+    build_hand_track(&hand);
+    write_bytes(path, &hand, sizeof(hand));
+
+    FeatureTrack track;
+    if (!feature_track_open(&track, path)) {
+        CHECK(0, "hand-built track didn't open");
+        return;
+    }
+    double hop_seconds = (double)FEATURE_TRACK_HOP / AUDIO_SAMPLE_RATE;
+    CHECK(feature_track_hop_at(&track, -0.001) == NULL, "negative time should have no hop");
+    CHECK(feature_track_hop_at(&track, 100 * hop_seconds) == NULL, "time past the end should have no hop");
+    for (int h = 0; h < 100; h++) {
+        const FeatureHop* hop = feature_track_hop_at(&track, (h + 0.5) * hop_seconds);
+        CHECK(hop && hop->volume == h, "hop %d looked up as %d", h, hop ? hop->volume : -1);
+    }
+
+    // Binary search against a linear scan, on and between the beats
+    for (double t = -0.05; t < 2.0; t += hop_seconds / 3) {
+        int expected = -1;
+        for (int b = 0; b < 10; b++) {
+            if (hand.beats[b].time <= t) expected = b;
+        }
+        CHECK(feature_track_beat_at(&track, t) == expected, "beat at %g s is %d, expected %d", t,
+              feature_track_beat_at(&track, t), expected);
+    }
+    CHECK(feature_track_beat_at(&track, hand.beats[3].time) == 3, "a beat's own time should find it");
+
+    CHECK(feature_track_next_marker(&track, 0.0, FEATURE_MARKER_BREAKDOWN) == 0.5, "next breakdown from 0");
+    CHECK(feature_track_next_marker(&track, 0.5, FEATURE_MARKER_BREAKDOWN) == -1.0, "markers are strictly after");
+    CHECK(fabs(feature_track_next_marker(&track, 0.5, FEATURE_MARKER_DROP) - 1.2) < 1e-6, "next drop from 0.5");
+    CHECK(feature_track_next_marker(&track, 1.3, FEATURE_MARKER_DROP) == -1.0, "no drop after 1.3");
+    feature_track_close(&track);
+    CHECK(feature_track_hop_at(&track, 0.0) == NULL && feature_track_beat_at(&track, 1.0) == -1,
+          "a closed track should look up nothing");
+}
+
+static void check_rejected(const char* label, const HandTrack* hand, size_t size) {
+    char path[64];
+    snprintf(path, sizeof(path), "%s/bad.clft", dir);
+    write_bytes(path, hand, size);
+    FeatureTrack track;
+    CHECK(!feature_track_open(&track, path), "%s: should not open", label);
+}
+
+static void check_format(void) {
+    static HandTrack hand;
+    build_hand_track(&hand);
+    check_rejected("truncated", &hand, sizeof(hand) - 1);
+    check_rejected("header only", &hand, sizeof(hand.header));
+    hand.header.version++;
+    check_rejected("newer version", &hand, sizeof(hand));
+    build_hand_track(&hand);
+    hand.header.hop_size = FEATURE_TRACK_HOP / 2;
+    check_rejected("other hop size", &hand, sizeof(hand));
+    build_hand_track(&hand);
+    hand.header.sample_rate = 44100;
+    check_rejected("other sample rate", &hand, sizeof(hand));
+    build_hand_track(&hand);
+    memcpy(hand.header.magic, "RIFF", 4);
+    check_rejected("wrong magic", &hand, sizeof(hand));
+
+    char out[256];
+    feature_track_default_path("/music/set.v2/track.wav", out, sizeof(out));
+    CHECK(strcmp(out, "/music/set.v2/track.clft") == 0, "default path %s", out);
+    feature_track_default_path("/music/set.v2/track", out, sizeof(out));
+    CHECK(strcmp(out, "/music/set.v2/track.clft") == 0, "default path without extension %s", out);
+}
+
+// Mono 16-bit: a decaying 55 Hz kick on every beat except in the breakdown,
+// where a quiet 6 kHz pad (above the bass band) plays instead
+static void write_kick_track(const char* path) {
+    double beat = 60.0 / KICK_BPM;
+    int frames = (int)(BARS * 4 * beat * AUDIO_SAMPLE_RATE);
+    int16_t* samples = malloc(sizeof(int16_t) * frames);
+    for (int i = 0; i < frames; i++) {
+        double t = (double)i / AUDIO_SAMPLE_RATE;
+        int bar = (int)(t / (4 * beat));
+        double since = fmod(t, beat);
+        double v = 0.0;
+        if (bar >= BREAKDOWN_BAR && bar < DROP_BAR) {
+            v = 0.1 * sin(2.0 * M_PI * 6000.0 * t);
+        } else {
+            v = 0.9 * exp(-since * 12.0) * sin(2.0 * M_PI * 55.0 * since);
+        }
+        samples[i] = (int16_t)lrint(v * 32767.0);
+    }
+
+    uint32_t data = frames * 2;
+    uint8_t header[44] = "RIFF\0\0\0\0WAVEfmt \x10\0\0\0\x01\0\x01\0";
+    uint32_t riff = 36 + data, rate = AUDIO_SAMPLE_RATE, byte_rate = AUDIO_SAMPLE_RATE * 2;
+    uint16_t align = 2, bits = 16;
+    memcpy(header + 4, &riff, 4);
+    memcpy(header + 24, &rate, 4);
+    memcpy(header + 28, &byte_rate, 4);
+    memcpy(header + 32, &align, 2);
+    memcpy(header + 34, &bits, 2);
+    memcpy(header + 36, "data", 4);
+    memcpy(header + 40, &data, 4);
+    FILE* fp = fopen(path, "wb");
+    fwrite(header, 1, sizeof(header), fp);
+    fwrite(samples, sizeof(int16_t), frames, fp);
+    fclose(fp);
+    free(samples);
+}
+
+static void check_analysis(void) {
+    char wav_path[64], track_path[64];
+    snprintf(wav_path, sizeof(wav_path), "%s/kick.wav", dir);
+    snprintf(track_path, sizeof(track_path), "%s/kick.clft", dir);
+    write_kick_track(wav_path);
+    CHECK(feature_track_analyze(wav_path, track_path, 0), "analysis failed");
+
+    FeatureTrack track;
+    if (!feature_track_open(&track, track_path)) {
+        CHECK(0, "analysed track didn't open");
+        return;
+    }
+    const FeatureTrackHeader* header = track.header;
+    double beat = 60.0 / KICK_BPM;
+    int frames = (int)(BARS * 4 * beat * AUDIO_SAMPLE_RATE);
+    CHECK(header->hop_count == (uint32_t)(frames / FEATURE_TRACK_HOP), "%u hops for %d frames", header->hop_count,
+          frames);
+    CHECK(fabsf(header->bpm - (float)KICK_BPM) < 1.0f, "tempo %.2f, expected %.0f", header->bpm, KICK_BPM);
+
+    // The grid keeps running through the breakdown, so every beat is there
+    CHECK(abs((int)header->beat_count - BARS * 4) <= 1, "%u beats, expected %d", header->beat_count, BARS * 4);
+    double hop_seconds = (double)FEATURE_TRACK_HOP / AUDIO_SAMPLE_RATE;
+    for (uint32_t i = 0; i < header->beat_count; i++) {
+        const FeatureBeat* b = &track.beats[i];
+        double nearest = round(b->time / beat) * beat;
+        if (fabs(b->time - nearest) > 2 * hop_seconds) {
+            CHECK(0, "beat %u at %.3f s is off the kick grid", i, b->time);
+            break;
+        }
+        const FeatureHop* hop = feature_track_hop_at(&track, b->time + hop_seconds / 2);
+        if (!hop || !(hop->flags & FEATURE_BEAT) || (i > 0 && b->beat_in_bar != (track.beats[i - 1].beat_in_bar + 1) % 4)) {
+            CHECK(0, "beat %u at %.3f s: hop flag or bar position wrong", i, b->time);
+            break;
+        }
+    }
+
+    double bar = 4 * beat;
+    double breakdown = feature_track_next_marker(&track, 0.0, FEATURE_MARKER_BREAKDOWN);
+    double drop = feature_track_next_marker(&track, 0.0, FEATURE_MARKER_DROP);
+    CHECK(fabs(breakdown - BREAKDOWN_BAR * bar) < 2 * hop_seconds, "breakdown at %.3f s, expected %.3f s", breakdown,
+          BREAKDOWN_BAR * bar);
+    CHECK(fabs(drop - DROP_BAR * bar) < 2 * hop_seconds, "drop at %.3f s, expected %.3f s", drop, DROP_BAR * bar);
+    const FeatureHop* quiet = feature_track_hop_at(&track, (BREAKDOWN_BAR + 4) * bar);
+    CHECK(quiet && (quiet->flags & FEATURE_BREAKDOWN), "the middle of the breakdown isn't flagged");
+    feature_track_close(&track);
+    unlink(wav_path);
+    unlink(track_path);
+}
+
+int main(void) {
+    if (!mkdtemp(dir)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    check_lookup();
+    check_format();
+    check_analysis();
+
+    char path[64];
+    const char* names[] = { "hand.clft", "bad.clft" };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        snprintf(path, sizeof(path), "%s/%s", dir, names[i]);
+        unlink(path);
+    }
+    rmdir(dir);
+    return test_finish("audio_features");
+}
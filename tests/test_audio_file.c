@@ -0,0 +1,284 @@
+// WAV parsing, sample decoding, resampling to the output rate and the
+// file input backend, on files written to a temporary directory
+#include "test.h"
+#include "audio_file.h"
+#include "audio_pipewire.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static char dir[] = "/tmp/clift_wav_XXXXXX";
+
+typedef struct {
+    uint8_t bytes[1 << 16];
+    size_t size;
+} Bytes;
+
+static void put(Bytes* b, const void* data, size_t size) {
+    memcpy(b->bytes + b->size, data, size);
+    b->size += size;
+}
+
+static void put_u16(Bytes* b, unsigned v) {
+    uint8_t p[2] = { v & 0xff, (v >> 8) & 0xff };
+    put(b, p, 2);
+}
+
+static void put_u32(Bytes* b, uint32_t v) {
+    uint8_t p[4] = { v & 0xff, (v >> 8) & 0xff, (v >> 16) & 0xff, v >> 24 };
+    put(b, p, 4);
+}
+
+// A sample in -1..1 in the file's encoding
+static void put_sample(Bytes* b, int format, int bits, double v) {
+    if (format == 3) {
+        if (bits == 32) {
+            float f = (float)v;
+            put(b, &f, 4);
+        } else {
+            put(b, &v, 8);
+        }
+        return;
+    }
+    switch (bits) {
+        case 8: { uint8_t s = (uint8_t)lrint(v * 127.0 + 128.0); put(b, &s, 1); break; }
+        case 16: put_u16(b, (uint16_t)(int16_t)lrint(v * 32767.0)); break;
+        case 24: {
+            int32_t s = (int32_t)lrint(v * 8388607.0);
+            uint8_t p[3] = { s & 0xff, (s >> 8) & 0xff, (s >> 16) & 0xff };
+            put(b, p, 3);
+            break;
+        }
+        default: put_u32(b, (uint32_t)(int32_t)lrint(v * 2147483647.0)); break;
+    }
+}
+
+static double test_signal(size_t frame, int channel) {
+    return 0.8 * sin(frame * 0.05 + channel * 1.3);
+}
+
+typedef struct {
+    int format;             // 1 PCM, 3 float, 0xFFFE extensible with this sub-format in 'sub_format'
+    int sub_format;
+    int channels;
+    int rate;
+    int bits;
+    size_t frames;
+    bool odd_chunk;         // An odd-sized chunk before "fmt ", padded to a word
+    size_t truncate;        // Bytes cut from the end of the file
+} WavSpec;
+
+static void write_wav(const char* path, const WavSpec* spec) {
+    static Bytes b;
+    b.size = 0;
+    int sample_format = spec->format == 0xFFFE ? spec->sub_format : spec->format;
+    int block_align = spec->channels * spec->bits / 8;
+    uint32_t data_size = (uint32_t)(spec->frames * block_align);
+
+    put(&b, "RIFF", 4);
+    put_u32(&b, 0);
+    put(&b, "WAVE", 4);
+    if (spec->odd_chunk) {
+        put(&b, "LIST", 4);
+        put_u32(&b, 3);
+        put(&b, "abc\0", 4);
+    }
+    put(&b, "fmt ", 4);
+    put_u32(&b, spec->format == 0xFFFE ? 40 : 16);
+    put_u16(&b, spec->format);
+    put_u16(&b, spec->channels);
+    put_u32(&b, spec->rate);
+    put_u32(&b, spec->rate * block_align);
+    put_u16(&b, block_align);
+    put_u16(&b, spec->bits);
+    if (spec->format == 0xFFFE) {
+        put_u16(&b, 22);
+        put_u16(&b, spec->bits);
+        put_u32(&b, 0);
+        put_u16(&b, spec->sub_format);
+        put(&b, "\x00\x00\x00\x00\x10\x00\x80\x00\x00\xAA\x00\x38\x9B\x71", 14);
+    }
+    put(&b, "data", 4);
+    put_u32(&b, data_size);
+    for (size_t f = 0; f < spec->frames; f++) {
+        for (int c = 0; c < spec->channels; c++) {
+            put_sample(&b, sample_format, spec->bits, test_signal(f, c));
+        }
+    }
+    uint32_t riff = (uint32_t)(b.size - 8);
+    memcpy(b.bytes + 4, &riff, 4);
+
+    FILE* fp = fopen(path, "wb");
+    fwrite(b.bytes, 1, b.size - spec->truncate, fp);
+    fclose(fp);
+}
+
+static void check_format(const char* label, const WavSpec* spec, float tolerance) {
+    char path[64];
+    snprintf(path, sizeof(path), "%s/test.wav", dir);
+    write_wav(path, spec);
+
+    WavFile wav;
+    if (!wav_file_open(&wav, path)) {
+        CHECK(0, "%s: didn't open", label);
+        return;
+    }
+    size_t frames = spec->frames - (spec->truncate + spec->channels * spec->bits / 8 - 1) / (spec->channels * spec->bits / 8);
+    CHECK(wav.channels == spec->channels && wav.sample_rate == spec->rate && wav.bits_per_sample == spec->bits,
+          "%s: header read as %d ch, %d Hz, %d-bit", label, wav.channels, wav.sample_rate, wav.bits_per_sample);
+    CHECK(wav.frames == frames, "%s: %zu frames, expected %zu", label, wav.frames, frames);
+    CHECK(wav.is_float == ((spec->format == 0xFFFE ? spec->sub_format : spec->format) == 3), "%s: float flag", label);
+    for (size_t f = 0; f < wav.frames; f++) {
+        for (int c = 0; c < wav.channels; c++) {
+            float v = wav_file_sample(&wav, f, c);
+            if (fabsf(v - (float)test_signal(f, c)) > tolerance) {
+                CHECK(0, "%s: frame %zu channel %d is %g, expected %g", label, f, c, v, test_signal(f, c));
+                wav_file_close(&wav);
+                return;
+            }
+        }
+    }
+    wav_file_close(&wav);
+}
+
+static void check_rejected(const char* label, const uint8_t* bytes, size_t size) {
+    char path[64];
+    snprintf(path, sizeof(path), "%s/bad.wav", dir);
+    FILE* fp = fopen(path, "wb");
+    fwrite(bytes, 1, size, fp);
+    fclose(fp);
+    WavFile wav;
+    CHECK(!wav_file_open(&wav, path), "%s: should not open", label);
+}
+
+// Off-rate files are linearly interpolated onto AUDIO_SAMPLE_RATE, mono
+// duplicated to both channels
+static void check_resampled(int rate, int channels) {
+    char path[64];
+    snprintf(path, sizeof(path), "%s/rate.wav", dir);
+    WavSpec spec = { 3, 0, channels, rate, 32, 2000, false, 0 };
+    write_wav(path, &spec);
+    WavFile wav;
+    if (!wav_file_open(&wav, path)) {
+        CHECK(0, "%d Hz: didn't open", rate);
+        return;
+    }
+    uint64_t total = wav_file_output_frames(&wav);
+    CHECK(total == (uint64_t)2000 * AUDIO_SAMPLE_RATE / rate, "%d Hz: %llu output frames", rate,
+          (unsigned long long)total);
+
+    // Reading past the end stops at the first output frame after the last source frame
+    float buffer[512 * AUDIO_CHANNELS];
+    uint64_t start = total - 300;
+    int got = wav_file_read_resampled(&wav, start, buffer, 512);
+    int expected = 0;
+    while ((size_t)((double)(start + expected) * rate / AUDIO_SAMPLE_RATE) < 2000) expected++;
+    CHECK(got == expected, "%d Hz: read %d frames at the end, expected %d", rate, got, expected);
+    for (int i = 0; i < got; i++) {
+        double pos = (double)(start + i) * rate / AUDIO_SAMPLE_RATE;
+        size_t i0 = (size_t)pos, i1 = i0 + 1 < 2000 ? i0 + 1 : i0;
+        for (int c = 0; c < 2; c++) {
+            int source = channels > 1 ? c : 0;
+            double want = test_signal(i0, source) + (test_signal(i1, source) - test_signal(i0, source)) * (pos - i0);
+            if (fabs(buffer[i * 2 + c] - want) > 1e-4) {
+                CHECK(0, "%d Hz %d ch: output frame %llu channel %d is %g, expected %g", rate, channels,
+                      (unsigned long long)(start + i), c, buffer[i * 2 + c], want);
+                wav_file_close(&wav);
+                return;
+            }
+        }
+    }
+    wav_file_close(&wav);
+}
+
+// The backend loops a file without pacing and pads a finished one with silence
+static void check_backend(void) {
+    char path[64];
+    snprintf(path, sizeof(path), "%s/stream.wav", dir);
+    WavSpec spec = { 3, 0, 2, AUDIO_SAMPLE_RATE, 32, 1000, false, 0 };
+    write_wav(path, &spec);
+    float buffer[AUDIO_BUFFER_SIZE * AUDIO_CHANNELS];
+
+    CHECK(audio_file_open_stream(1, path, false, true), "looping stream didn't open");
+    CHECK(audio_file_stream_unpaced(1) && !audio_file_stream_unpaced(0), "only stream 1 is unpaced");
+    int got = audio_file_get_stream_buffer(1, buffer, 600);
+    got += audio_file_get_stream_buffer(1, buffer, 600);
+    CHECK(got == 1200, "unpaced reads should fill the buffer, got %d", got);
+    // Frame 1200 of the stream is frame 200 of the file
+    CHECK(fabsf(buffer[599 * 2] - (float)test_signal(199, 0)) < 1e-6f, "loop didn't wrap to the file start");
+
+    CHECK(audio_file_open_stream(1, path, false, false), "non-looping stream didn't open");
+    got = audio_file_get_stream_buffer(1, buffer, 900);
+    got = audio_file_get_stream_buffer(1, buffer, 900);
+    CHECK(got == 900 && fabsf(buffer[99 * 2] - (float)test_signal(999, 0)) < 1e-6f && buffer[100 * 2] == 0.0f,
+          "the end of a non-looping file should be padded with silence");
+    CHECK(audio_file_get_stream_buffer(1, buffer, 900) == 0, "a finished file should return nothing");
+
+    CHECK(audio_file_open_stream(1, path, true, true), "paced stream didn't open");
+    CHECK(!audio_file_stream_unpaced(1), "a paced stream reported unpaced");
+    audio_file_close();
+    CHECK(!audio_file_stream_active(1), "close left the stream open");
+}
+
+int main(void) {
+    if (!mkdtemp(dir)) {
+        perror("mkdtemp");
+        return 1;
+    }
+
+    WavSpec spec = { 1, 0, 2, 44100, 16, 500, false, 0 };
+    check_format("PCM 16-bit stereo", &spec, 1.0f / 16384);
+    spec.bits = 8;
+    check_format("PCM 8-bit", &spec, 1.0f / 64);
+    spec.bits = 24;
+    spec.channels = 1;
+    check_format("PCM 24-bit mono", &spec, 1e-6f);
+    spec.bits = 32;
+    spec.channels = 3;
+    check_format("PCM 32-bit, 3 ch", &spec, 1e-6f);
+    spec = (WavSpec){ 3, 0, 2, 48000, 32, 500, false, 0 };
+    check_format("float 32-bit", &spec, 1e-7f);
+    spec.bits = 64;
+    check_format("float 64-bit", &spec, 1e-7f);
+    spec = (WavSpec){ 0xFFFE, 3, 2, 96000, 32, 500, true, 0 };
+    check_format("extensible float after an odd chunk", &spec, 1e-7f);
+    spec = (WavSpec){ 0xFFFE, 1, 2, 22050, 24, 500, false, 7 };
+    check_format("extensible PCM, truncated data", &spec, 1e-6f);
+
+    uint8_t bytes[64] = "RIFF\0\0\0\0WAVEfmt ";
+    check_rejected("too small", bytes, 20);
+    memcpy(bytes + 8, "AVI ", 4);
+    check_rejected("not WAVE", bytes, sizeof(bytes));
+    static Bytes file;
+    char path[64];
+    snprintf(path, sizeof(path), "%s/test.wav", dir);
+    for (int format = 1; format <= 2; format++) {
+        WavSpec header = { format, 0, 1, 8000, 16, 10, false, 0 };
+        write_wav(path, &header);
+        FILE* fp = fopen(path, "rb");
+        file.size = fread(file.bytes, 1, sizeof(file.bytes), fp);
+        fclose(fp);
+        if (format == 2) {
+            check_rejected("ADPCM", file.bytes, file.size);
+        } else {
+            // RIFF header and "fmt " chunk followed by an empty chunk instead of "data"
+            memcpy(file.bytes + 36, "LIST\0\0\0\0", 8);
+            check_rejected("no data chunk", file.bytes, 44);
+        }
+    }
+
+    check_resampled(44100, 2);
+    check_resampled(22050, 1);
+    check_resampled(96000, 2);
+    check_resampled(48000, 1);
+    check_backend();
+
+    const char* names[] = { "test.wav", "bad.wav", "rate.wav", "stream.wav" };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        snprintf(path, sizeof(path), "%s/%s", dir, names[i]);
+        unlink(path);
+    }
+    rmdir(dir);
+    return test_finish("audio_file");
+}
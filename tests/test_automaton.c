@@ -0,0 +1,103 @@
+// Bit-packed automaton generations against a brute-force count of each
+// cell's eight neighbours on the torus
+#include "test.h"
+#include "automaton.h"
+#include <stdlib.h>
+#include <string.h>
+
+static bool reference_next(const bool* cells, int width, int height, const AutomatonRule* rule, int x, int y) {
+    int n = 0;
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if (dx == 0 && dy == 0) continue;
+            n += cells[((y + dy + height) % height) * width + (x + dx + width) % width];
+        }
+    }
+    bool alive = cells[y * width + x];
+    return ((alive ? rule->survive : rule->birth) >> n) & 1;
+}
+
+static void check_generations(const char* rule_text, int width, int height, float density, ThreadPool* pool) {
+    AutomatonRule rule;
+    CHECK(automaton_parse_rule(rule_text, &rule), "%s: rule didn't parse", rule_text);
+    Automaton automaton = { 0 };
+    CHECK(automaton_resize(&automaton, width, height), "%s %dx%d: resize failed", rule_text, width, height);
+    automaton_randomize(&automaton, density);
+
+    bool* cells = malloc(sizeof(bool) * width * height);
+    bool* next = malloc(sizeof(bool) * width * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            cells[y * width + x] = automaton_cell(&automaton, x, y);
+        }
+    }
+
+    for (int g = 0; g < 6; g++) {
+        automaton_step(&automaton, &rule, 1, pool);
+        int population = 0;
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                next[y * width + x] = reference_next(cells, width, height, &rule, x, y);
+                population += next[y * width + x];
+            }
+        }
+        bool* swap = cells;
+        cells = next;
+        next = swap;
+
+        for (int i = 0; i < width * height; i++) {
+            if (automaton_cell(&automaton, i % width, i / width) != cells[i]) {
+                CHECK(0, "%s %dx%d generation %d: cell (%d, %d) differs from brute force", rule_text, width, height,
+                      g + 1, i % width, i / width);
+                goto done;
+            }
+        }
+        // Also catches stray bits past the last column
+        CHECK(automaton_population(&automaton) == population, "%s %dx%d generation %d: population %d, expected %d",
+              rule_text, width, height, g + 1, automaton_population(&automaton), population);
+    }
+done:
+    free(cells);
+    free(next);
+    automaton_free(&automaton);
+}
+
+static void check_parse(void) {
+    AutomatonRule rule;
+    CHECK(automaton_parse_rule("B3/S23", &rule) && rule.birth == 0x8 && rule.survive == 0xc, "B3/S23");
+    CHECK(automaton_parse_rule("b36/s23", &rule) && rule.birth == 0x48 && rule.survive == 0xc, "b36/s23");
+    CHECK(automaton_parse_rule("B/S", &rule) && rule.birth == 0 && rule.survive == 0, "B/S");
+    CHECK(automaton_parse_rule("B012345678/S012345678", &rule) && rule.birth == 0x1ff && rule.survive == 0x1ff,
+          "every count");
+    CHECK(!automaton_parse_rule("23/3", &rule), "digits before B or S should fail");
+    CHECK(!automaton_parse_rule("B9/S23", &rule), "9 neighbours should fail");
+    CHECK(!automaton_parse_rule("", &rule), "empty rule should fail");
+}
+
+static void check_randomize(void) {
+    Automaton automaton = { 0 };
+    automaton_resize(&automaton, 100, 50);
+    automaton_randomize(&automaton, 0.0f);
+    CHECK(automaton_population(&automaton) == 0, "density 0 left live cells");
+    automaton_randomize(&automaton, 1.0f);
+    CHECK(automaton_population(&automaton) == 100 * 50, "density 1 gave %d of 5000", automaton_population(&automaton));
+    automaton_randomize(&automaton, 0.25f);
+    int population = automaton_population(&automaton);
+    CHECK(population > 1000 && population < 1500, "density 0.25 gave %d of 5000", population);
+    automaton_free(&automaton);
+}
+
+int main(void) {
+    ThreadPool* pool = thread_pool_create(3);
+    const char* rules[] = { "B3/S23", "B36/S23", "B2/S", "B/S012345678", "B012345678/S012345678", "B1357/S02468" };
+    const int sizes[][2] = { { 1, 1 }, { 2, 3 }, { 63, 17 }, { 64, 20 }, { 65, 33 }, { 200, 41 } };
+    for (size_t r = 0; r < sizeof(rules) / sizeof(rules[0]); r++) {
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            check_generations(rules[r], sizes[s][0], sizes[s][1], 0.35f, s % 2 ? pool : NULL);
+        }
+    }
+    check_parse();
+    check_randomize();
+    thread_pool_destroy(pool);
+    return test_finish("automaton");
+}
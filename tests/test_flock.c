@@ -0,0 +1,165 @@
+// Flock steps against a brute-force reference that checks every pair of
+// agents instead of the spatial hash
+#include "test.h"
+#include "flock.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TOLERANCE 1e-3f
+
+typedef struct {
+    int count;
+    float width, height;
+    float x[FLOCK_MAX_AGENTS], y[FLOCK_MAX_AGENTS];
+    float vx[FLOCK_MAX_AGENTS], vy[FLOCK_MAX_AGENTS];
+} Reference;
+
+static void reference_load(Reference* ref, const Flock* flock) {
+    ref->count = flock->count;
+    ref->width = flock->width;
+    ref->height = flock->height;
+    memcpy(ref->x, flock->x, sizeof(float) * flock->count);
+    memcpy(ref->y, flock->y, sizeof(float) * flock->count);
+    memcpy(ref->vx, flock->vx, sizeof(float) * flock->count);
+    memcpy(ref->vy, flock->vy, sizeof(float) * flock->count);
+}
+
+// The rules of flock_step, written out with an O(n^2) neighbour search
+static void reference_step(Reference* ref, const FlockRules* rules) {
+    static float nx[FLOCK_MAX_AGENTS], ny[FLOCK_MAX_AGENTS], nvx[FLOCK_MAX_AGENTS], nvy[FLOCK_MAX_AGENTS];
+    float r2 = rules->radius * rules->radius;
+    for (int i = 0; i < ref->count; i++) {
+        float px = ref->x[i], py = ref->y[i], vx = ref->vx[i], vy = ref->vy[i];
+        float sep_x = 0, sep_y = 0, align_x = 0, align_y = 0, coh_x = 0, coh_y = 0, neighbors = 0;
+        for (int j = 0; j < ref->count; j++) {
+            float dx = ref->x[j] - px, dy = ref->y[j] - py;
+            float d2 = dx * dx + dy * dy;
+            if (d2 >= r2 || d2 <= 0.0f) continue;
+            float dist = sqrtf(d2);
+            sep_x -= dx / dist;
+            sep_y -= dy / dist;
+            align_x += ref->vx[j];
+            align_y += ref->vy[j];
+            coh_x += dx;
+            coh_y += dy;
+            neighbors += 1.0f;
+        }
+        if (neighbors > 0.0f) {
+            vx += sep_x * rules->separation + align_x / neighbors * rules->alignment + coh_x / neighbors * rules->cohesion;
+            vy += sep_y * rules->separation + align_y / neighbors * rules->alignment + coh_y / neighbors * rules->cohesion;
+        }
+        if (rules->attract != 0.0f) {
+            float dx = rules->attract_x - px, dy = rules->attract_y - py;
+            float dist = sqrtf(dx * dx + dy * dy);
+            if (dist > 0.0f) {
+                float force = rules->attract / (dist + 1.0f);
+                vx += dx / dist * force;
+                vy += dy / dist * force;
+            }
+        }
+        vx *= rules->friction;
+        vy *= rules->friction;
+        float speed = sqrtf(vx * vx + vy * vy);
+        if (rules->max_speed > 0.0f && speed > rules->max_speed) {
+            vx *= rules->max_speed / speed;
+            vy *= rules->max_speed / speed;
+        }
+        px += vx;
+        py += vy;
+        if (rules->edges == FLOCK_WRAP) {
+            if (px < 0.0f || px >= ref->width) px -= floorf(px / ref->width) * ref->width;
+            if (py < 0.0f || py >= ref->height) py -= floorf(py / ref->height) * ref->height;
+        } else {
+            if (px < 0.0f) { px = -px; vx = -vx; }
+            if (px >= ref->width) { px = 2.0f * ref->width - px; vx = -vx; }
+            if (py < 0.0f) { py = -py; vy = -vy; }
+            if (py >= ref->height) { py = 2.0f * ref->height - py; vy = -vy; }
+            px = fminf(fmaxf(px, 0.0f), ref->width);
+            py = fminf(fmaxf(py, 0.0f), ref->height);
+        }
+        nx[i] = px;
+        ny[i] = py;
+        nvx[i] = vx;
+        nvy[i] = vy;
+    }
+    memcpy(ref->x, nx, sizeof(float) * ref->count);
+    memcpy(ref->y, ny, sizeof(float) * ref->count);
+    memcpy(ref->vx, nvx, sizeof(float) * ref->count);
+    memcpy(ref->vy, nvy, sizeof(float) * ref->count);
+}
+
+// Positions that wrapped may differ by a world width from rounding at the edge
+static float wrapped_distance(float a, float b, float size) {
+    float d = fabsf(a - b);
+    return d > size / 2 ? size - d : d;
+}
+
+// One step from the same state: a single step keeps the float summation
+// order differences small enough to compare
+static void check_step(const char* label, int count, float width, float height, const FlockRules* rules,
+                       ThreadPool* pool) {
+    static Reference ref;
+    Flock flock = { 0 };
+    CHECK(flock_resize(&flock, count, width, height, 1.5f), "%s: resize failed", label);
+    for (int warm = 0; warm < 5; warm++) {
+        flock_step(&flock, rules, pool);
+    }
+    reference_load(&ref, &flock);
+    flock_step(&flock, rules, pool);
+    reference_step(&ref, rules);
+
+    for (int i = 0; i < count; i++) {
+        float dx = wrapped_distance(flock.x[i], ref.x[i], width);
+        float dy = wrapped_distance(flock.y[i], ref.y[i], height);
+        float dv = fabsf(flock.vx[i] - ref.vx[i]) + fabsf(flock.vy[i] - ref.vy[i]);
+        if (dx > TOLERANCE || dy > TOLERANCE || dv > TOLERANCE) {
+            CHECK(0, "%s: agent %d at (%g, %g) v (%g, %g), brute force (%g, %g) v (%g, %g)", label, i,
+                  flock.x[i], flock.y[i], flock.vx[i], flock.vy[i], ref.x[i], ref.y[i], ref.vx[i], ref.vy[i]);
+            break;
+        }
+    }
+    flock_free(&flock);
+}
+
+// The pool only splits the agents, so it must not change the result
+static void check_pool_matches_serial(ThreadPool* pool, const FlockRules* rules) {
+    Flock serial = { 0 }, parallel = { 0 };
+    flock_resize(&serial, 3000, 160.0f, 90.0f, 1.0f);
+    flock_resize(&parallel, 3000, 160.0f, 90.0f, 1.0f);
+    for (int step = 0; step < 20; step++) {
+        flock_step(&serial, rules, NULL);
+        flock_step(&parallel, rules, pool);
+    }
+    CHECK(memcmp(serial.x, parallel.x, sizeof(float) * serial.count) == 0 &&
+          memcmp(serial.y, parallel.y, sizeof(float) * serial.count) == 0,
+          "pooled steps differ from serial ones");
+    flock_free(&serial);
+    flock_free(&parallel);
+}
+
+int main(void) {
+    ThreadPool* pool = thread_pool_create(3);
+    FlockRules rules = { 6.0f, 0.05f, 0.08f, 0.01f, 80.0f, 45.0f, 0.0f, 0.99f, 1.5f, FLOCK_WRAP };
+
+    check_step("wrap", 1500, 160.0f, 90.0f, &rules, NULL);
+    check_step("wrap, pooled", 1500, 160.0f, 90.0f, &rules, pool);
+
+    rules.edges = FLOCK_BOUNCE;
+    rules.attract = 0.3f;
+    check_step("bounce, attractor", 1500, 160.0f, 90.0f, &rules, pool);
+
+    // A radius wider than the world makes every agent every other's neighbour
+    rules.radius = 50.0f;
+    check_step("wide radius", 400, 40.0f, 30.0f, &rules, pool);
+
+    // Small radius on a big world: the hash is capped at FLOCK_MAX_CELLS
+    rules.radius = 0.7f;
+    check_step("capped grid", 2000, 400.0f, 300.0f, &rules, pool);
+
+    rules.radius = 6.0f;
+    check_pool_matches_serial(pool, &rules);
+
+    thread_pool_destroy(pool);
+    return test_finish("flock");
+}
@@ -0,0 +1,185 @@
+// Grid simulation steps against plain 2D reference stencils, for every
+// edge mode and widths that leave a scalar tail after the SIMD blocks
+#include "test.h"
+#include "grid_sim.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TOLERANCE 1e-4f
+#define MAX_CELLS (64 * 64)
+
+typedef struct {
+    int width, height;
+    GridEdges edges;
+    float cur[GRID_SIM_FIELDS][MAX_CELLS];
+    float old[GRID_SIM_FIELDS][MAX_CELLS];
+} Reference;
+
+static const char* edge_names[] = { "zero", "clamp", "wrap" };
+
+static float ref_at(const Reference* ref, int field, int x, int y) {
+    int w = ref->width, h = ref->height;
+    if (x < 0 || x >= w || y < 0 || y >= h) {
+        switch (ref->edges) {
+            case GRID_EDGE_ZERO: return 0.0f;
+            case GRID_EDGE_CLAMP:
+                x = x < 0 ? 0 : x >= w ? w - 1 : x;
+                y = y < 0 ? 0 : y >= h ? h - 1 : y;
+                break;
+            case GRID_EDGE_WRAP:
+                x = (x + w) % w;
+                y = (y + h) % h;
+                break;
+        }
+    }
+    return ref->cur[field][y * w + x];
+}
+
+static unsigned rng = 12345u;
+
+static float random_unit(void) {
+    rng = rng * 1664525u + 1013904223u;
+    return (rng >> 8) / 16777216.0f;
+}
+
+// Same random state in both; the grid's back plane holds 'old'
+static void seed(GridSim* sim, Reference* ref, int fields) {
+    for (int f = 0; f < fields; f++) {
+        for (int y = 0; y < sim->height; y++) {
+            float* row = grid_sim_row(sim, f, y);
+            float* prev = grid_sim_prev_row(sim, f, y);
+            for (int x = 0; x < sim->width; x++) {
+                row[x] = ref->cur[f][y * sim->width + x] = random_unit();
+                prev[x] = ref->old[f][y * sim->width + x] = random_unit();
+            }
+        }
+    }
+}
+
+static void reference_fire(Reference* ref, float cooling) {
+    float next[MAX_CELLS];
+    for (int y = 0; y < ref->height; y++) {
+        for (int x = 0; x < ref->width; x++) {
+            float sum = ref_at(ref, 0, x - 1, y + 1) + ref_at(ref, 0, x, y + 1) + ref_at(ref, 0, x + 1, y + 1);
+            next[y * ref->width + x] = sum * (cooling / 3.0f);
+        }
+    }
+    memcpy(ref->old[0], ref->cur[0], sizeof(next));
+    memcpy(ref->cur[0], next, sizeof(next));
+}
+
+static void reference_ripple(Reference* ref, float damping) {
+    float next[MAX_CELLS];
+    for (int y = 0; y < ref->height; y++) {
+        for (int x = 0; x < ref->width; x++) {
+            float sum = ref_at(ref, 0, x - 1, y) + ref_at(ref, 0, x + 1, y) + ref_at(ref, 0, x, y - 1) +
+                        ref_at(ref, 0, x, y + 1);
+            next[y * ref->width + x] = (sum * 0.5f - ref->old[0][y * ref->width + x]) * damping;
+        }
+    }
+    memcpy(ref->old[0], ref->cur[0], sizeof(next));
+    memcpy(ref->cur[0], next, sizeof(next));
+}
+
+static void reference_gray_scott(Reference* ref, float feed, float kill, float du, float dv) {
+    float next_u[MAX_CELLS], next_v[MAX_CELLS];
+    for (int y = 0; y < ref->height; y++) {
+        for (int x = 0; x < ref->width; x++) {
+            float u = ref_at(ref, 0, x, y), v = ref_at(ref, 1, x, y);
+            float lap_u = ref_at(ref, 0, x - 1, y) + ref_at(ref, 0, x + 1, y) + ref_at(ref, 0, x, y - 1) +
+                          ref_at(ref, 0, x, y + 1) - 4.0f * u;
+            float lap_v = ref_at(ref, 1, x - 1, y) + ref_at(ref, 1, x + 1, y) + ref_at(ref, 1, x, y - 1) +
+                          ref_at(ref, 1, x, y + 1) - 4.0f * v;
+            float uvv = u * v * v;
+            next_u[y * ref->width + x] = u + du * lap_u - uvv + feed * (1.0f - u);
+            next_v[y * ref->width + x] = v + dv * lap_v + uvv - (feed + kill) * v;
+        }
+    }
+    for (int f = 0; f < 2; f++) {
+        memcpy(ref->old[f], ref->cur[f], sizeof(next_u));
+    }
+    memcpy(ref->cur[0], next_u, sizeof(next_u));
+    memcpy(ref->cur[1], next_v, sizeof(next_v));
+}
+
+// Both the current state and the one before it must match
+static void compare(const char* label, GridSim* sim, const Reference* ref, int fields) {
+    for (int f = 0; f < fields; f++) {
+        for (int y = 0; y < sim->height; y++) {
+            const float* row = grid_sim_row(sim, f, y);
+            const float* prev = grid_sim_prev_row(sim, f, y);
+            for (int x = 0; x < sim->width; x++) {
+                float want = ref->cur[f][y * sim->width + x], was = ref->old[f][y * sim->width + x];
+                if (fabsf(row[x] - want) > TOLERANCE || fabsf(prev[x] - was) > TOLERANCE) {
+                    CHECK(0, "%s: field %d cell (%d, %d) is %g (was %g), reference %g (was %g)", label, f, x, y,
+                          row[x], prev[x], want, was);
+                    return;
+                }
+            }
+        }
+    }
+}
+
+static void check_kernels(int width, int height, GridEdges edges, ThreadPool* pool) {
+    static Reference ref;
+    char label[64];
+    GridSim sim = { 0 };
+    ref.width = width;
+    ref.height = height;
+    ref.edges = edges;
+
+    snprintf(label, sizeof(label), "fire %dx%d %s", width, height, edge_names[edges]);
+    CHECK(grid_sim_resize(&sim, width, height, 1, edges), "%s: resize failed", label);
+    seed(&sim, &ref, 1);
+    for (int step = 0; step < 4; step++) {
+        grid_sim_fire(&sim, 0.97f, pool);
+        reference_fire(&ref, 0.97f);
+    }
+    compare(label, &sim, &ref, 1);
+
+    snprintf(label, sizeof(label), "ripple %dx%d %s", width, height, edge_names[edges]);
+    seed(&sim, &ref, 1);
+    for (int step = 0; step < 4; step++) {
+        grid_sim_ripple(&sim, 0.98f, pool);
+        reference_ripple(&ref, 0.98f);
+    }
+    compare(label, &sim, &ref, 1);
+
+    // Growing to two fields must give the new field full-size planes
+    snprintf(label, sizeof(label), "gray-scott %dx%d %s", width, height, edge_names[edges]);
+    CHECK(grid_sim_resize(&sim, width, height, 2, edges), "%s: resize failed", label);
+    seed(&sim, &ref, 2);
+    for (int step = 0; step < 4; step++) {
+        grid_sim_gray_scott(&sim, 0.037f, 0.06f, 0.2f, 0.1f, pool);
+        reference_gray_scott(&ref, 0.037f, 0.06f, 0.2f, 0.1f);
+    }
+    compare(label, &sim, &ref, 2);
+    grid_sim_free(&sim);
+}
+
+static void check_resize(void) {
+    GridSim sim = { 0 };
+    CHECK(grid_sim_resize(&sim, 20, 10, 2, GRID_EDGE_ZERO) && sim.cleared, "first resize should clear");
+    sim.cleared = false;
+    grid_sim_row(&sim, 0, 3)[5] = 1.0f;
+    CHECK(grid_sim_resize(&sim, 20, 10, 2, GRID_EDGE_WRAP) && !sim.cleared && sim.edges == GRID_EDGE_WRAP,
+          "changing only the edges should keep the grid");
+    CHECK(grid_sim_row(&sim, 0, 3)[5] == 1.0f, "changing only the edges lost a cell");
+    CHECK(grid_sim_resize(&sim, 21, 10, 2, GRID_EDGE_WRAP) && sim.cleared, "a new size should clear");
+    CHECK(grid_sim_row(&sim, 0, 3)[5] == 0.0f, "a new size should zero the cells");
+    grid_sim_free(&sim);
+}
+
+int main(void) {
+    ThreadPool* pool = thread_pool_create(3);
+    const int sizes[][2] = { { 1, 1 }, { 3, 5 }, { 37, 23 }, { 64, 40 }, { 61, 64 } };
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        for (int edges = GRID_EDGE_ZERO; edges <= GRID_EDGE_WRAP; edges++) {
+            check_kernels(sizes[s][0], sizes[s][1], (GridEdges)edges, s % 2 ? pool : NULL);
+        }
+    }
+    check_resize();
+    thread_pool_destroy(pool);
+    return test_finish("grid_sim");
+}
@@ -0,0 +1,76 @@
+// Maze generation and drawing on planes of every deck render scale, up to
+// a big terminal at 2x, where the maze outgrows its wall grids
+#include "test.h"
+#include "maze.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define GUARD 64
+
+// The scales decks can render at, as in the engine
+static const float scales[] = { 0.5f, 0.75f, 1.0f, 1.5f, 2.0f };
+
+static int expected_cells(int plane, int border, int per_cell) {
+    int cells = (plane - border) / per_cell;
+    return cells > MAZE_MAX_CELLS ? MAZE_MAX_CELLS : cells;
+}
+
+static void check(Maze* maze, int width, int height, int seed) {
+    maze_generate(maze, width, height, seed);
+    CHECK(maze->width == expected_cells(width, 4, 4) && maze->height == expected_cells(height, 2, 2),
+          "%dx%d plane: maze is %dx%d cells", width, height, maze->width, maze->height);
+    if (maze->width < 5 || maze->height < 5) return;
+
+    // Carving stays inside the cells in use
+    for (int y = 0; y < MAZE_MAX_CELLS; y++) {
+        for (int x = 0; x < MAZE_MAX_CELLS; x++) {
+            bool inside = x < maze->width && y < maze->height;
+            if (!inside && (!maze->h_walls[y][x] || !maze->v_walls[y][x] || maze->visited[y][x])) {
+                CHECK(0, "%dx%d plane, seed %d: cell (%d, %d) outside the %dx%d maze was carved", width, height,
+                      seed, x, y, maze->width, maze->height);
+                return;
+            }
+        }
+    }
+
+    size_t cells = (size_t)width * height;
+    char* plane = malloc(cells + 2 * GUARD);
+    memset(plane, '#', cells + 2 * GUARD);
+    memset(plane + GUARD, ' ', cells);
+    maze_draw(maze, plane + GUARD, width, height, maze->width);
+    for (int i = 0; i < GUARD; i++) {
+        if (plane[i] != '#' || plane[GUARD + cells + i] != '#') {
+            CHECK(0, "%dx%d plane, seed %d: drew outside the plane", width, height, seed);
+            break;
+        }
+    }
+
+    // Below the cap the maze reaches the plane's last whole cell
+    int last_column = (maze->width - 1) * 4 + 1;
+    if (maze->width < MAZE_MAX_CELLS) {
+        CHECK(plane[GUARD + width + last_column] == '+', "%dx%d plane, seed %d: no corner in the last cell column",
+              width, height, seed);
+    }
+    free(plane);
+}
+
+int main(void) {
+    static Maze maze = { .seed = -1 };
+    const int terminals[][2] = { { 80, 24 }, { 120, 50 }, { 160, 45 }, { 237, 63 }, { 23, 13 }, { 1, 1 } };
+    for (size_t t = 0; t < sizeof(terminals) / sizeof(terminals[0]); t++) {
+        for (size_t s = 0; s < sizeof(scales) / sizeof(scales[0]); s++) {
+            // Planes are sized as the engine sizes them
+            int w = (int)(terminals[t][0] * scales[s] + 0.5f), h = (int)(terminals[t][1] * scales[s] + 0.5f);
+            if (w < 1) w = 1;
+            if (h < 1) h = 1;
+            for (int seed = 0; seed < 100; seed += 7) {
+                check(&maze, w, h, seed);
+            }
+        }
+    }
+
+    // A plane shrinking under an unchanged seed carves the smaller maze
+    check(&maze, 240, 100, 3);
+    check(&maze, 80, 24, 3);
+    return test_finish("maze");
+}
@@ -0,0 +1,95 @@
+// Plane resampling at the deck render scales against a reference written
+// with exact integer arithmetic, for both modes and odd terminal sizes
+#include "test.h"
+#include "resample.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLANK ' '
+
+// The scales decks can render at, as in the engine
+static const float scales[] = { 0.5f, 0.75f, 1.0f, 1.5f, 2.0f };
+
+// Nearest: the source cell under the output cell's centre. Coverage when
+// shrinking: the first ink, in reading order, among the source cells the
+// output cell covers (at least one).
+static void reference(const char* src, int src_w, int src_h, char* dst, int dst_w, int dst_h, ResampleMode mode) {
+    bool coverage = mode == RESAMPLE_COVERAGE && (src_w > dst_w || src_h > dst_h);
+    for (int y = 0; y < dst_h; y++) {
+        for (int x = 0; x < dst_w; x++) {
+            if (!coverage) {
+                int sx = (int)((2 * (long)x + 1) * src_w / (2 * (long)dst_w));
+                int sy = (int)((2 * (long)y + 1) * src_h / (2 * (long)dst_h));
+                dst[y * dst_w + x] = src[sy * src_w + sx];
+                continue;
+            }
+            int x0 = (int)((long)x * src_w / dst_w), x1 = (int)((long)(x + 1) * src_w / dst_w);
+            int y0 = (int)((long)y * src_h / dst_h), y1 = (int)((long)(y + 1) * src_h / dst_h);
+            if (x1 <= x0) x1 = x0 + 1;
+            if (y1 <= y0) y1 = y0 + 1;
+            char c = BLANK;
+            for (int sy = y0; sy < y1 && c == BLANK; sy++) {
+                for (int sx = x0; sx < x1 && c == BLANK; sx++) {
+                    c = src[sy * src_w + sx];
+                }
+            }
+            dst[y * dst_w + x] = c;
+        }
+    }
+}
+
+static unsigned rng = 2024u;
+
+// Mostly blank, so coverage has ink to find and lose
+static void fill(char* plane, int cells) {
+    for (int i = 0; i < cells; i++) {
+        rng = rng * 1664525u + 1013904223u;
+        unsigned r = rng >> 16;
+        plane[i] = r % 8 == 0 ? (char)('!' + r / 8 % 90) : BLANK;
+    }
+}
+
+static void check(int src_w, int src_h, int dst_w, int dst_h, ResampleMode mode) {
+    char* src = malloc((size_t)src_w * src_h);
+    char* got = malloc((size_t)dst_w * dst_h + 1);
+    char* want = malloc((size_t)dst_w * dst_h);
+    fill(src, src_w * src_h);
+    got[dst_w * dst_h] = '#';
+
+    resample_plane(src, src_w, src_h, got, dst_w, dst_h, mode);
+    reference(src, src_w, src_h, want, dst_w, dst_h, mode);
+    for (int i = 0; i < dst_w * dst_h; i++) {
+        if (got[i] != want[i]) {
+            CHECK(0, "%dx%d -> %dx%d %s: cell (%d, %d) is '%c', expected '%c'", src_w, src_h, dst_w, dst_h,
+                  mode == RESAMPLE_NEAREST ? "nearest" : "coverage", i % dst_w, i / dst_w, got[i], want[i]);
+            break;
+        }
+    }
+    CHECK(got[dst_w * dst_h] == '#', "%dx%d -> %dx%d wrote past the plane", src_w, src_h, dst_w, dst_h);
+    free(src);
+    free(got);
+    free(want);
+}
+
+int main(void) {
+    const int terminals[][2] = { { 160, 45 }, { 81, 25 }, { 17, 3 }, { 1, 1 }, { 2, 1 }, { 237, 63 } };
+    for (size_t t = 0; t < sizeof(terminals) / sizeof(terminals[0]); t++) {
+        int w = terminals[t][0], h = terminals[t][1];
+        for (size_t s = 0; s < sizeof(scales) / sizeof(scales[0]); s++) {
+            // Render planes are sized as the engine sizes them
+            int rw = (int)(w * scales[s] + 0.5f), rh = (int)(h * scales[s] + 0.5f);
+            if (rw < 1) rw = 1;
+            if (rh < 1) rh = 1;
+            for (int mode = RESAMPLE_NEAREST; mode <= RESAMPLE_COVERAGE; mode++) {
+                check(rw, rh, w, h, (ResampleMode)mode);
+            }
+        }
+    }
+    // Shrinking one axis while growing the other
+    check(300, 20, 160, 45, RESAMPLE_COVERAGE);
+    check(40, 90, 160, 45, RESAMPLE_COVERAGE);
+    // Wider than one strip of looked-up columns
+    check(733, 40, 1100, 30, RESAMPLE_NEAREST);
+    return test_finish("resample");
+}
@@ -0,0 +1,112 @@
+// Bucketed nearest-seed search against a brute-force scan of every seed,
+// with seeds spread, clustered and off the grid
+#include "test.h"
+#include "voronoi.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define TOLERANCE 1e-3f
+
+typedef enum {
+    SEEDS_SPREAD,
+    SEEDS_CLUSTERED,        // All in one corner, so far cells search many rings
+    SEEDS_OFF_GRID          // Up to a grid size beyond every edge
+} SeedLayout;
+
+static unsigned rng = 7u;
+
+static float random_unit(void) {
+    rng = rng * 1664525u + 1013904223u;
+    return (rng >> 8) / 16777216.0f;
+}
+
+static void make_seeds(float* x, float* y, int count, int width, int height, SeedLayout layout) {
+    for (int i = 0; i < count; i++) {
+        switch (layout) {
+            case SEEDS_SPREAD:
+                x[i] = random_unit() * width;
+                y[i] = random_unit() * height;
+                break;
+            case SEEDS_CLUSTERED:
+                x[i] = random_unit() * width * 0.1f;
+                y[i] = random_unit() * height * 0.1f;
+                break;
+            case SEEDS_OFF_GRID:
+                x[i] = (random_unit() * 3.0f - 1.0f) * width;
+                y[i] = (random_unit() * 3.0f - 1.0f) * height;
+                break;
+        }
+    }
+}
+
+static bool close_enough(float a, float b) {
+    if (isinf(a) || isinf(b)) return a == b;
+    return fabsf(a - b) <= TOLERANCE * (1.0f + b);
+}
+
+static void check(VoronoiField* field, int width, int height, int count, float y_scale, SeedLayout layout,
+                  ThreadPool* pool) {
+    static const char* layouts[] = { "spread", "clustered", "off grid" };
+    float* x = malloc(sizeof(float) * (count > 0 ? count : 1));
+    float* y = malloc(sizeof(float) * (count > 0 ? count : 1));
+    make_seeds(x, y, count, width, height, layout);
+    CHECK(voronoi_compute(field, x, y, count, width, height, y_scale, pool), "compute failed");
+
+    for (int cy = 0; cy < height; cy++) {
+        for (int cx = 0; cx < width; cx++) {
+            float best1 = INFINITY, best2 = INFINITY;
+            for (int i = 0; i < count; i++) {
+                float dx = x[i] - cx, dy = (y[i] - cy) * y_scale;
+                float d = dx * dx + dy * dy;
+                if (d < best1) {
+                    best2 = best1;
+                    best1 = d;
+                } else if (d < best2) {
+                    best2 = d;
+                }
+            }
+            best1 = sqrtf(best1);
+            best2 = sqrtf(best2);
+
+            // Ties may pick either seed, so the nearest is checked by its distance
+            const VoronoiCell* cell = &field->cells[cy * width + cx];
+            float chosen = INFINITY;
+            if (cell->nearest >= 0 && cell->nearest < count) {
+                float dx = x[cell->nearest] - cx, dy = (y[cell->nearest] - cy) * y_scale;
+                chosen = sqrtf(dx * dx + dy * dy);
+            }
+            bool nearest_ok = count == 0 ? cell->nearest == -1 : close_enough(chosen, best1);
+            if (!nearest_ok || !close_enough(cell->d1, best1) || !close_enough(cell->d2, best2)) {
+                CHECK(0, "%dx%d, %d %s seeds, y scale %g: cell (%d, %d) has seed %d at %g, second %g; "
+                      "brute force %g, %g", width, height, count, layouts[layout], y_scale, cx, cy, cell->nearest,
+                      cell->d1, cell->d2, best1, best2);
+                goto done;
+            }
+        }
+    }
+done:
+    free(x);
+    free(y);
+}
+
+int main(void) {
+    ThreadPool* pool = thread_pool_create(3);
+    // One field throughout, so its buffers grow and shrink in use between runs
+    VoronoiField field = { 0 };
+    const int sizes[][2] = { { 160, 45 }, { 37, 11 }, { 1, 1 }, { 3, 90 } };
+    const int counts[] = { 0, 1, 2, 7, 60, 1000, 5000 };
+    const float y_scales[] = { 1.0f, 2.0f, 0.5f };
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+            for (size_t k = 0; k < sizeof(y_scales) / sizeof(y_scales[0]); k++) {
+                for (int layout = SEEDS_SPREAD; layout <= SEEDS_OFF_GRID; layout++) {
+                    check(&field, sizes[s][0], sizes[s][1], counts[c], y_scales[k], (SeedLayout)layout,
+                          c % 2 ? pool : NULL);
+                }
+            }
+        }
+    }
+    voronoi_free(&field);
+    thread_pool_destroy(pool);
+    return test_finish("voronoi");
+}